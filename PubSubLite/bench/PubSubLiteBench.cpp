@@ -0,0 +1,2172 @@
+/*!
+ * \author Ezbeat, Ji Hoon Park
+ */
+
+#include "PubSubLite.h"
+#include "TypedChannel.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <functional>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#if defined(__linux__)
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+namespace
+{
+
+using BenchClock = std::chrono::steady_clock;
+
+std::atomic<uint64_t> gReceivedDataCount(0);
+std::atomic<uint64_t> gSlowReceivedDataCount(0);
+std::vector<uint64_t> gLatencyList; // Nanoseconds, only written by the fire thread.
+
+void CountingSubscriberCallback(_In_ const uint8_t* data, _In_ uint32_t dataSize, _In_opt_ void* userContext)
+{
+    (void)data;
+    (void)dataSize;
+    (void)userContext;
+
+    gReceivedDataCount.fetch_add(1, std::memory_order_relaxed);
+}
+
+void CountingBatchSubscriberCallback(_In_ const EzPubSub::FiredData* firedDataList, _In_ uint32_t firedDataCount)
+{
+    (void)firedDataList;
+
+    gReceivedDataCount.fetch_add(firedDataCount, std::memory_order_relaxed);
+}
+
+// Takes 100 microseconds per data, as a subscriber doing I/O would.
+void SlowSubscriberCallback(_In_ const uint8_t* data, _In_ uint32_t dataSize, _In_opt_ void* userContext)
+{
+    (void)data;
+    (void)dataSize;
+    (void)userContext;
+
+    std::this_thread::sleep_for(std::chrono::microseconds(100));
+    gSlowReceivedDataCount.fetch_add(1, std::memory_order_relaxed);
+}
+
+uint64_t NowNanoseconds()
+{
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(BenchClock::now().time_since_epoch()).count());
+}
+
+// The first 8 bytes of the published data are the publish time.
+void LatencySubscriberCallback(_In_ const uint8_t* data, _In_ uint32_t dataSize, _In_opt_ void* userContext)
+{
+    uint64_t publishedTime = 0;
+
+    (void)userContext;
+
+    if (dataSize >= sizeof(publishedTime))
+    {
+        memcpy(&publishedTime, data, sizeof(publishedTime));
+        gLatencyList.push_back(NowNanoseconds() - publishedTime);
+    }
+    gReceivedDataCount.fetch_add(1, std::memory_order_release);
+}
+
+double ElapsedSeconds(_In_ BenchClock::time_point startTime, _In_ BenchClock::time_point endTime)
+{
+    return std::chrono::duration<double>(endTime - startTime).count();
+}
+
+bool WaitReceivedDataCount(_In_ uint64_t expectedDataCount, _In_ uint32_t timeoutMilliseconds)
+{
+    BenchClock::time_point deadline = BenchClock::now() + std::chrono::milliseconds(timeoutMilliseconds);
+
+    while (gReceivedDataCount.load(std::memory_order_relaxed) < expectedDataCount)
+    {
+        if (BenchClock::now() > deadline)
+        {
+            return false;
+        }
+        std::this_thread::sleep_for(std::chrono::microseconds(100));
+    }
+
+    return true;
+}
+
+// producerCount threads publish dataCount messages of dataSize bytes in total to one channel with one subscriber.
+void BenchPublishThroughput(_In_ EzPubSub::QueueType queueType, _In_ uint32_t producerCount, _In_ uint32_t dataCount, _In_ uint32_t dataSize)
+{
+    std::wstring channelName = L"BenchPublishThroughput";
+    EzPubSub::ChannelOption channelOption;
+    std::vector<std::thread> producerThreadList;
+    std::atomic<uint64_t> fullRetryCount(0);
+    uint32_t dataCountPerProducer = dataCount / producerCount;
+    uint64_t lostDataCount = 0;
+
+    dataCount = dataCountPerProducer * producerCount;
+
+    // The buffer holds every message so the measurement does not depend on the fire thread keeping up.
+    channelOption.fireMode = EzPubSub::FireMode::kEvent;
+    channelOption.maxBufferedDataSize = static_cast<uint32_t>(std::min<uint64_t>(0xFFFFFFFFull, static_cast<uint64_t>(dataCount) * dataSize));
+    channelOption.queueType = queueType;
+    EzPubSub::PubSubLite::CreateChannel(channelName, channelOption);
+    EzPubSub::PubSubLite::RegisterSubscriber(channelName, CountingSubscriberCallback);
+
+    gReceivedDataCount.store(0);
+
+    BenchClock::time_point startTime = BenchClock::now();
+    for (uint32_t producerIndex = 0; producerIndex < producerCount; producerIndex++)
+    {
+        producerThreadList.emplace_back([&channelName, &fullRetryCount, dataCountPerProducer, dataSize]()
+        {
+            std::vector<uint8_t> publishData(dataSize, 0x5A);
+
+            for (uint32_t index = 0; index < dataCountPerProducer; index++)
+            {
+                // A full ring rejects the data, so the producer retries until the fire thread makes room.
+                while (EzPubSub::PubSubLite::PublishData(channelName, publishData.data(), dataSize) == EzPubSub::Error::kNotEnoughBufferSize)
+                {
+                    fullRetryCount.fetch_add(1, std::memory_order_relaxed);
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+    for (auto& producerThread : producerThreadList)
+    {
+        producerThread.join();
+    }
+    BenchClock::time_point publishedTime = BenchClock::now();
+
+    bool isDelivered = WaitReceivedDataCount(dataCount, 60000);
+    BenchClock::time_point deliveredTime = BenchClock::now();
+
+    EzPubSub::PubSubLite::GetLostDataCount(channelName, lostDataCount);
+    EzPubSub::PubSubLite::DeleteChannel(channelName);
+
+    printf("publish_throughput queue=%s producers=%u data_count=%u data_size=%u publish_msgs_per_sec=%.0f deliver_msgs_per_sec=%.0f deliver_mb_per_sec=%.1f lost=%llu full_retry=%llu%s\n",
+        (queueType == EzPubSub::QueueType::kRing) ? "ring" : "list",
+        producerCount,
+        dataCount,
+        dataSize,
+        dataCount / ElapsedSeconds(startTime, publishedTime),
+        dataCount / ElapsedSeconds(startTime, deliveredTime),
+        (static_cast<double>(dataCount) * dataSize) / (1024.0 * 1024.0) / ElapsedSeconds(startTime, deliveredTime),
+        static_cast<unsigned long long>(lostDataCount),
+        static_cast<unsigned long long>(fullRetryCount.load()),
+        (isDelivered == true) ? "" : " timeout=1");
+}
+
+uint64_t Percentile(_In_ const std::vector<uint64_t>& sortedList, _In_ double percentile)
+{
+    size_t index = 0;
+
+    if (sortedList.size() == 0)
+    {
+        return 0;
+    }
+
+    index = static_cast<size_t>(percentile / 100.0 * static_cast<double>(sortedList.size() - 1));
+    return sortedList[index];
+}
+
+// Publish dataCount messages spaced by intervalMicroseconds and measure publish-to-delivery latency.
+void BenchFireLatency(_In_ EzPubSub::FireMode fireMode, _In_ uint32_t flushTime, _In_ uint32_t dataCount, _In_ uint32_t intervalMicroseconds)
+{
+    std::wstring channelName = L"BenchFireLatency";
+    EzPubSub::ChannelOption channelOption;
+    uint8_t publishData[64] = { 0, };
+    uint64_t publishedTime = 0;
+    std::vector<uint64_t> bucketList(64, 0);
+    const char* fireModeName = (fireMode == EzPubSub::FireMode::kEvent) ? "event" : "polling";
+
+    channelOption.flushTime = flushTime;
+    channelOption.fireMode = fireMode;
+    EzPubSub::PubSubLite::CreateChannel(channelName, channelOption);
+    EzPubSub::PubSubLite::RegisterSubscriber(channelName, LatencySubscriberCallback);
+
+    gReceivedDataCount.store(0);
+    gLatencyList.clear();
+    gLatencyList.reserve(dataCount);
+
+    for (uint32_t index = 0; index < dataCount; index++)
+    {
+        publishedTime = NowNanoseconds();
+        memcpy(publishData, &publishedTime, sizeof(publishedTime));
+        EzPubSub::PubSubLite::PublishData(channelName, publishData, sizeof(publishData));
+        std::this_thread::sleep_for(std::chrono::microseconds(intervalMicroseconds));
+    }
+
+    WaitReceivedDataCount(dataCount, 60000);
+    EzPubSub::PubSubLite::DeleteChannel(channelName);
+
+    std::sort(gLatencyList.begin(), gLatencyList.end());
+    printf("fire_latency mode=%s flush_time_ms=%u data_count=%u p50_us=%.1f p99_us=%.1f p999_us=%.1f max_us=%.1f\n",
+        fireModeName,
+        flushTime,
+        static_cast<uint32_t>(gLatencyList.size()),
+        Percentile(gLatencyList, 50.0) / 1000.0,
+        Percentile(gLatencyList, 99.0) / 1000.0,
+        Percentile(gLatencyList, 99.9) / 1000.0,
+        Percentile(gLatencyList, 100.0) / 1000.0);
+
+    // Power of two histogram of the latency in microseconds.
+    for (auto latency : gLatencyList)
+    {
+        uint32_t bucketIndex = 0;
+        uint64_t latencyMicroseconds = latency / 1000;
+
+        while ((latencyMicroseconds > 0) && (bucketIndex < bucketList.size() - 1))
+        {
+            latencyMicroseconds >>= 1;
+            bucketIndex++;
+        }
+        bucketList[bucketIndex]++;
+    }
+    for (size_t bucketIndex = 0; bucketIndex < bucketList.size(); bucketIndex++)
+    {
+        if (bucketList[bucketIndex] != 0)
+        {
+            printf("  mode=%s latency_us<%llu count=%llu\n",
+                fireModeName,
+                1ull << bucketIndex,
+                static_cast<unsigned long long>(bucketList[bucketIndex]));
+        }
+    }
+}
+
+// Publish large frames by copying them, or by writing them into reserved channel-owned storage.
+void BenchZeroCopyPublish(_In_ bool isReserved, _In_ uint32_t dataCount, _In_ uint32_t dataSize)
+{
+    std::wstring channelName = L"BenchZeroCopyPublish";
+    EzPubSub::ChannelOption channelOption;
+    std::vector<uint8_t> frameData(dataSize);
+    EzPubSub::DataBuffer dataBuffer;
+
+    channelOption.fireMode = EzPubSub::FireMode::kEvent;
+    channelOption.maxBufferedDataSize = static_cast<uint32_t>(std::min<uint64_t>(0xFFFFFFFFull, 64ull * dataSize));
+    EzPubSub::PubSubLite::CreateChannel(channelName, channelOption);
+    EzPubSub::PubSubLite::RegisterSubscriber(channelName, CountingSubscriberCallback);
+
+    gReceivedDataCount.store(0);
+
+    BenchClock::time_point startTime = BenchClock::now();
+    for (uint32_t index = 0; index < dataCount; index++)
+    {
+        // Both ways write the frame once, as a producer filling its frame would.
+        if (isReserved == true)
+        {
+            EzPubSub::PubSubLite::ReserveData(channelName, dataSize, dataBuffer);
+            memset(dataBuffer.GetWritableData(), static_cast<int>(index), dataSize);
+            EzPubSub::PubSubLite::PublishData(channelName, std::move(dataBuffer));
+        }
+        else
+        {
+            memset(frameData.data(), static_cast<int>(index), dataSize);
+            EzPubSub::PubSubLite::PublishData(channelName, frameData.data(), dataSize);
+        }
+
+        // Keep the buffer from overflowing, so that every frame is delivered.
+        while (gReceivedDataCount.load(std::memory_order_relaxed) + 32 < index)
+        {
+            std::this_thread::yield();
+        }
+    }
+    WaitReceivedDataCount(dataCount, 60000);
+    BenchClock::time_point deliveredTime = BenchClock::now();
+
+    EzPubSub::DataPoolStatistics dataPoolStatistics;
+    EzPubSub::PubSubLite::GetDataPoolStatistics(channelName, dataPoolStatistics);
+    EzPubSub::PubSubLite::DeleteChannel(channelName);
+
+    printf("zero_copy_publish mode=%s data_count=%u data_size=%u deliver_msgs_per_sec=%.0f deliver_mb_per_sec=%.1f pool_slab_size=%llu pool_fallback=%llu\n",
+        (isReserved == true) ? "reserve" : "copy",
+        dataCount,
+        dataSize,
+        dataCount / ElapsedSeconds(startTime, deliveredTime),
+        (static_cast<double>(dataCount) * dataSize) / (1024.0 * 1024.0) / ElapsedSeconds(startTime, deliveredTime),
+        static_cast<unsigned long long>(dataPoolStatistics.slabSize),
+        static_cast<unsigned long long>(dataPoolStatistics.fallbackBlockCount));
+}
+
+// One publisher thread publishes dataCount messages of 64 bytes to a subscriber or a batch subscriber.
+void BenchBatchSubscriber(_In_ EzPubSub::QueueType queueType, _In_ bool isBatch, _In_ uint32_t dataCount)
+{
+    std::wstring channelName = L"BenchBatchSubscriber";
+    EzPubSub::ChannelOption channelOption;
+    uint8_t publishData[64] = { 0, };
+
+    channelOption.fireMode = EzPubSub::FireMode::kEvent;
+    channelOption.maxBufferedDataSize = static_cast<uint32_t>(std::min<uint64_t>(0xFFFFFFFFull, static_cast<uint64_t>(dataCount) * sizeof(publishData)));
+    channelOption.queueType = queueType;
+    channelOption.ringCapacity = dataCount;
+    EzPubSub::PubSubLite::CreateChannel(channelName, channelOption);
+    if (isBatch == true)
+    {
+        EzPubSub::PubSubLite::RegisterSubscriber(channelName, CountingBatchSubscriberCallback);
+    }
+    else
+    {
+        EzPubSub::PubSubLite::RegisterSubscriber(channelName, CountingSubscriberCallback);
+    }
+
+    gReceivedDataCount.store(0);
+
+    BenchClock::time_point startTime = BenchClock::now();
+    for (uint32_t index = 0; index < dataCount; index++)
+    {
+        EzPubSub::PubSubLite::PublishData(channelName, publishData, sizeof(publishData));
+    }
+    WaitReceivedDataCount(dataCount, 60000);
+    BenchClock::time_point deliveredTime = BenchClock::now();
+
+    EzPubSub::PubSubLite::DeleteChannel(channelName);
+
+    printf("batch_subscriber queue=%s subscriber=%s data_count=%u deliver_msgs_per_sec=%.0f\n",
+        (queueType == EzPubSub::QueueType::kRing) ? "ring" : "list",
+        (isBatch == true) ? "batch" : "single",
+        dataCount,
+        dataCount / ElapsedSeconds(startTime, deliveredTime));
+}
+
+// One publisher thread publishes dataCount messages of 64 bytes to half of subscriberCount subscribers,
+// targeted by a subscriber callback list or by a subscriber mask.
+void BenchTargetedPublish(_In_ bool isMask, _In_ uint32_t subscriberCount, _In_ uint32_t dataCount)
+{
+    // Distinct callbacks are needed to register several subscribers to a channel.
+    static const EzPubSub::SUBSCRIBER_CALLBACK kSubscriberCallbackList[] = {
+        [](const uint8_t*, uint32_t, void*) { gReceivedDataCount.fetch_add(1, std::memory_order_relaxed); },
+        [](const uint8_t*, uint32_t, void*) { gReceivedDataCount.fetch_add(1, std::memory_order_relaxed); },
+        [](const uint8_t*, uint32_t, void*) { gReceivedDataCount.fetch_add(1, std::memory_order_relaxed); },
+        [](const uint8_t*, uint32_t, void*) { gReceivedDataCount.fetch_add(1, std::memory_order_relaxed); },
+        [](const uint8_t*, uint32_t, void*) { gReceivedDataCount.fetch_add(1, std::memory_order_relaxed); },
+        [](const uint8_t*, uint32_t, void*) { gReceivedDataCount.fetch_add(1, std::memory_order_relaxed); },
+        [](const uint8_t*, uint32_t, void*) { gReceivedDataCount.fetch_add(1, std::memory_order_relaxed); },
+        [](const uint8_t*, uint32_t, void*) { gReceivedDataCount.fetch_add(1, std::memory_order_relaxed); }
+    };
+    std::wstring channelName = L"BenchTargetedPublish";
+    EzPubSub::ChannelOption channelOption;
+    std::vector<EzPubSub::SUBSCRIBER_CALLBACK> fireCallbackList;
+    EzPubSub::SubscriberMask fireSubscriberMask;
+    uint32_t subscriberId = 0;
+    uint8_t publishData[64] = { 0, };
+
+    subscriberCount = std::min<uint32_t>(subscriberCount, sizeof(kSubscriberCallbackList) / sizeof(kSubscriberCallbackList[0]));
+
+    channelOption.fireMode = EzPubSub::FireMode::kEvent;
+    channelOption.maxBufferedDataSize = static_cast<uint32_t>(std::min<uint64_t>(0xFFFFFFFFull, static_cast<uint64_t>(dataCount) * sizeof(publishData)));
+    EzPubSub::PubSubLite::CreateChannel(channelName, channelOption);
+    fireSubscriberMask.Clear();
+    for (uint32_t index = 0; index < subscriberCount; index++)
+    {
+        EzPubSub::PubSubLite::RegisterSubscriber(channelName, kSubscriberCallbackList[index], &subscriberId);
+        if ((index % 2) == 0)
+        {
+            fireCallbackList.push_back(kSubscriberCallbackList[index]);
+            fireSubscriberMask.Set(subscriberId);
+        }
+    }
+
+    gReceivedDataCount.store(0);
+
+    BenchClock::time_point startTime = BenchClock::now();
+    for (uint32_t index = 0; index < dataCount; index++)
+    {
+        if (isMask == true)
+        {
+            EzPubSub::PubSubLite::PublishData(channelName, publishData, sizeof(publishData), nullptr, fireSubscriberMask);
+        }
+        else
+        {
+            EzPubSub::PubSubLite::PublishData(channelName, publishData, sizeof(publishData), nullptr, &fireCallbackList);
+        }
+    }
+    BenchClock::time_point publishedTime = BenchClock::now();
+    WaitReceivedDataCount(static_cast<uint64_t>(dataCount) * fireCallbackList.size(), 60000);
+    BenchClock::time_point deliveredTime = BenchClock::now();
+
+    EzPubSub::PubSubLite::DeleteChannel(channelName);
+
+    printf("targeted_publish target=%s subscribers=%u data_count=%u publish_msgs_per_sec=%.0f deliver_msgs_per_sec=%.0f\n",
+        (isMask == true) ? "mask" : "callback_list",
+        subscriberCount,
+        dataCount,
+        dataCount / ElapsedSeconds(startTime, publishedTime),
+        dataCount / ElapsedSeconds(startTime, deliveredTime));
+}
+
+// One publisher thread publishes dataCount messages to a channel with a fast subscriber and a slow subscriber,
+// and the time until the fast subscriber received every message is measured.
+void BenchSlowSubscriber(_In_ EzPubSub::FireThreadType fireThreadType, _In_ uint32_t dataCount)
+{
+    std::wstring channelName = L"BenchSlowSubscriber";
+    EzPubSub::ChannelOption channelOption;
+    uint8_t publishData[64] = { 0, };
+
+    channelOption.fireMode = EzPubSub::FireMode::kEvent;
+    channelOption.maxBufferedDataSize = static_cast<uint32_t>(std::min<uint64_t>(0xFFFFFFFFull, static_cast<uint64_t>(dataCount) * sizeof(publishData)));
+    channelOption.fireThreadType = fireThreadType;
+    EzPubSub::PubSubLite::CreateChannel(channelName, channelOption);
+    EzPubSub::PubSubLite::RegisterSubscriber(channelName, SlowSubscriberCallback);
+    EzPubSub::PubSubLite::RegisterSubscriber(channelName, CountingSubscriberCallback);
+
+    gReceivedDataCount.store(0);
+    gSlowReceivedDataCount.store(0);
+
+    BenchClock::time_point startTime = BenchClock::now();
+    for (uint32_t index = 0; index < dataCount; index++)
+    {
+        EzPubSub::PubSubLite::PublishData(channelName, publishData, sizeof(publishData));
+    }
+    WaitReceivedDataCount(dataCount, 60000);
+    BenchClock::time_point deliveredTime = BenchClock::now();
+
+    // Deleting the channel waits for the slow subscriber.
+    EzPubSub::PubSubLite::DeleteChannel(channelName);
+
+    printf("slow_subscriber fire_thread=%s data_count=%u fast_deliver_msgs_per_sec=%.0f slow_received=%llu\n",
+        (fireThreadType == EzPubSub::FireThreadType::kShared) ? "shared" : "dedicated",
+        dataCount,
+        dataCount / ElapsedSeconds(startTime, deliveredTime),
+        static_cast<unsigned long long>(gSlowReceivedDataCount.load()));
+}
+
+// A slow subscriber with overflowPolicy and a max lag of 1024 data next to a fast subscriber.
+// The buffer holds every data, so only the slow subscriber loses data.
+void BenchOverflowPolicy(_In_ EzPubSub::OverflowPolicy overflowPolicy, _In_ uint32_t dataCount)
+{
+    std::wstring channelName = L"BenchOverflowPolicy";
+    EzPubSub::ChannelOption channelOption;
+    EzPubSub::SubscriberOption subscriberOption;
+    EzPubSub::SubscriberStatistics subscriberStatistics;
+    uint32_t slowSubscriberId = 0;
+    uint8_t publishData[64] = { 0, };
+    const char* policyName = "drop_oldest";
+
+    channelOption.fireMode = EzPubSub::FireMode::kEvent;
+    channelOption.maxBufferedDataSize = static_cast<uint32_t>(std::min<uint64_t>(0xFFFFFFFFull, static_cast<uint64_t>(dataCount) * sizeof(publishData)));
+    channelOption.fireThreadType = EzPubSub::FireThreadType::kShared;
+    subscriberOption.overflowPolicy = overflowPolicy;
+    subscriberOption.maxLagDataSize = 1024 * sizeof(publishData);
+    EzPubSub::PubSubLite::CreateChannel(channelName, channelOption);
+    EzPubSub::PubSubLite::RegisterSubscriber(channelName, SlowSubscriberCallback, subscriberOption, &slowSubscriberId);
+    EzPubSub::PubSubLite::RegisterSubscriber(channelName, CountingSubscriberCallback);
+
+    gReceivedDataCount.store(0);
+    gSlowReceivedDataCount.store(0);
+
+    BenchClock::time_point startTime = BenchClock::now();
+    for (uint32_t index = 0; index < dataCount; index++)
+    {
+        EzPubSub::PubSubLite::PublishData(channelName, publishData, sizeof(publishData));
+    }
+    BenchClock::time_point publishedTime = BenchClock::now();
+    WaitReceivedDataCount(dataCount, 60000);
+    BenchClock::time_point deliveredTime = BenchClock::now();
+
+    EzPubSub::PubSubLite::GetSubscriberStatistics(channelName, slowSubscriberId, subscriberStatistics);
+    EzPubSub::PubSubLite::DeleteChannel(channelName);
+
+    if (overflowPolicy == EzPubSub::OverflowPolicy::kDropNewest)
+    {
+        policyName = "drop_newest";
+    }
+    else if (overflowPolicy == EzPubSub::OverflowPolicy::kBlock)
+    {
+        policyName = "block";
+    }
+    printf("overflow_policy policy=%s data_count=%u publish_msgs_per_sec=%.0f fast_deliver_msgs_per_sec=%.0f slow_fired=%llu slow_lost=%llu slow_lag=%llu\n",
+        policyName,
+        dataCount,
+        dataCount / ElapsedSeconds(startTime, publishedTime),
+        dataCount / ElapsedSeconds(startTime, deliveredTime),
+        static_cast<unsigned long long>(subscriberStatistics.firedDataCount),
+        static_cast<unsigned long long>(subscriberStatistics.lostDataCount),
+        static_cast<unsigned long long>(subscriberStatistics.lagDataCount));
+}
+
+// Publishes data of 16 ~ 1024 bytes to a full 64 KB buffer drained by a slow subscriber, so every PublishData overflows.
+void BenchChannelOverflow(_In_ EzPubSub::QueueType queueType, _In_ EzPubSub::OverflowPolicy overflowPolicy, _In_ uint32_t dataCount)
+{
+    std::wstring channelName = L"BenchChannelOverflow";
+    EzPubSub::ChannelOption channelOption;
+    uint8_t publishData[1024] = { 0, };
+    uint32_t randomValue = 1;
+    uint32_t dataSize = 0;
+    uint64_t acceptedDataCount = 0;
+    uint64_t rejectedDataCount = 0;
+    uint64_t lostDataCount = 0;
+
+    channelOption.fireMode = EzPubSub::FireMode::kEvent;
+    channelOption.maxBufferedDataSize = 65536;
+    channelOption.queueType = queueType;
+    channelOption.overflowPolicy = overflowPolicy;
+    EzPubSub::PubSubLite::CreateChannel(channelName, channelOption);
+    EzPubSub::PubSubLite::RegisterSubscriber(channelName, SlowSubscriberCallback);
+
+    BenchClock::time_point startTime = BenchClock::now();
+    for (uint32_t index = 0; index < dataCount; index++)
+    {
+        randomValue = randomValue * 1103515245 + 12345;
+        dataSize = 16 + ((randomValue >> 16) % (sizeof(publishData) - 15));
+        if (EzPubSub::PubSubLite::PublishData(channelName, publishData, dataSize) == EzPubSub::Error::kSuccess)
+        {
+            acceptedDataCount++;
+        }
+        else
+        {
+            rejectedDataCount++;
+        }
+    }
+    BenchClock::time_point publishedTime = BenchClock::now();
+
+    EzPubSub::PubSubLite::GetLostDataCount(channelName, lostDataCount);
+    EzPubSub::PubSubLite::DeleteChannel(channelName);
+
+    printf("channel_overflow queue=%s policy=%s data_count=%u publish_msgs_per_sec=%.0f accepted=%llu rejected=%llu lost=%llu\n",
+        (queueType == EzPubSub::QueueType::kRing) ? "ring" : "list",
+        (overflowPolicy == EzPubSub::OverflowPolicy::kDropNewest) ? "drop_newest" : "drop_oldest",
+        dataCount,
+        dataCount / ElapsedSeconds(startTime, publishedTime),
+        static_cast<unsigned long long>(acceptedDataCount),
+        static_cast<unsigned long long>(rejectedDataCount),
+        static_cast<unsigned long long>(lostDataCount));
+}
+
+// Each of channelCount publisher threads publishes to its own channel.
+void CountingCompletionCallback(_In_ EzPubSub::Error publishResult, _In_opt_ void* completionContext)
+{
+    (void)publishResult;
+
+    static_cast<std::atomic<uint64_t>*>(completionContext)->fetch_add(1, std::memory_order_relaxed);
+}
+
+// Publishes to a slow subscriber by kWait, kTry or kAsync, and measures how long the publisher is held.
+void BenchPublishMode(_In_ EzPubSub::PublishMode publishMode, _In_ uint32_t dataCount)
+{
+    std::wstring channelName = L"BenchPublishMode";
+    EzPubSub::ChannelOption channelOption;
+    uint8_t publishData[1024] = { 0, };
+    uint64_t acceptedDataCount = 0;
+    uint64_t rejectedDataCount = 0;
+    std::atomic<uint64_t> completedDataCount(0);
+    EzPubSub::Error publishResult = EzPubSub::Error::kUnsuccess;
+    const char* publishModeName = "wait";
+
+    channelOption.fireMode = EzPubSub::FireMode::kEvent;
+    channelOption.maxBufferedDataSize = 65536;
+    EzPubSub::PubSubLite::CreateChannel(channelName, channelOption);
+    gSlowReceivedDataCount = 0;
+    EzPubSub::PubSubLite::RegisterSubscriber(channelName, SlowSubscriberCallback);
+
+    BenchClock::time_point startTime = BenchClock::now();
+    for (uint32_t index = 0; index < dataCount; index++)
+    {
+        if (publishMode == EzPubSub::PublishMode::kTry)
+        {
+            publishModeName = "try";
+            publishResult = EzPubSub::PubSubLite::TryPublishData(channelName, publishData, sizeof(publishData));
+        }
+        else if (publishMode == EzPubSub::PublishMode::kAsync)
+        {
+            publishModeName = "async";
+            publishResult = EzPubSub::PubSubLite::PublishDataAsync(channelName, publishData, sizeof(publishData), nullptr, CountingCompletionCallback, &completedDataCount);
+        }
+        else
+        {
+            publishResult = EzPubSub::PubSubLite::PublishData(channelName, publishData, sizeof(publishData), nullptr, BenchClock::now() + std::chrono::seconds(1));
+        }
+
+        if (publishResult == EzPubSub::Error::kSuccess)
+        {
+            acceptedDataCount++;
+        }
+        else
+        {
+            rejectedDataCount++;
+        }
+    }
+    BenchClock::time_point publishedTime = BenchClock::now();
+
+    while (gSlowReceivedDataCount < acceptedDataCount)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    BenchClock::time_point firedTime = BenchClock::now();
+    EzPubSub::PubSubLite::DeleteChannel(channelName);
+
+    printf("publish_mode mode=%s data_count=%u publish_msgs_per_sec=%.0f fire_msgs_per_sec=%.0f accepted=%llu rejected=%llu completed=%llu\n",
+        publishModeName,
+        dataCount,
+        dataCount / ElapsedSeconds(startTime, publishedTime),
+        acceptedDataCount / ElapsedSeconds(startTime, firedTime),
+        static_cast<unsigned long long>(acceptedDataCount),
+        static_cast<unsigned long long>(rejectedDataCount),
+        static_cast<unsigned long long>(completedDataCount.load()));
+}
+
+// Publishes to one of many channels with a long name, by the channel name or by ChannelHandle.
+void BenchChannelHandle(_In_ EzPubSub::QueueType queueType, _In_ bool isHandle, _In_ uint32_t dataCount)
+{
+    const uint32_t channelCount = 64;
+    std::wstring channelNamePrefix = L"BenchChannelHandle/instrument/quote/level2/";
+    EzPubSub::ChannelOption channelOption;
+    EzPubSub::ChannelHandle channelHandle;
+    uint8_t publishData[64] = { 0, };
+    uint64_t fullRetryCount = 0;
+
+    channelOption.fireMode = EzPubSub::FireMode::kEvent;
+    channelOption.maxBufferedDataSize = dataCount * sizeof(publishData);
+    channelOption.queueType = queueType;
+    for (uint32_t channelIndex = 0; channelIndex < channelCount; channelIndex++)
+    {
+        EzPubSub::PubSubLite::CreateChannel(channelNamePrefix + std::to_wstring(channelIndex), channelOption, channelHandle);
+    }
+    EzPubSub::PubSubLite::RegisterSubscriber(channelHandle, CountingSubscriberCallback);
+
+    gReceivedDataCount.store(0);
+
+    std::wstring channelName = channelHandle.GetChannelName();
+    BenchClock::time_point startTime = BenchClock::now();
+    for (uint32_t index = 0; index < dataCount; index++)
+    {
+        if (isHandle == true)
+        {
+            while (EzPubSub::PubSubLite::PublishData(channelHandle, publishData, sizeof(publishData)) == EzPubSub::Error::kNotEnoughBufferSize)
+            {
+                fullRetryCount++;
+                std::this_thread::yield();
+            }
+        }
+        else
+        {
+            while (EzPubSub::PubSubLite::PublishData(channelName, publishData, sizeof(publishData)) == EzPubSub::Error::kNotEnoughBufferSize)
+            {
+                fullRetryCount++;
+                std::this_thread::yield();
+            }
+        }
+    }
+    BenchClock::time_point publishedTime = BenchClock::now();
+
+    bool isDelivered = WaitReceivedDataCount(dataCount, 60000);
+
+    for (uint32_t channelIndex = 0; channelIndex < channelCount; channelIndex++)
+    {
+        EzPubSub::PubSubLite::DeleteChannel(channelNamePrefix + std::to_wstring(channelIndex));
+    }
+
+    printf("channel_handle queue=%s by=%s channels=%u data_count=%u publish_msgs_per_sec=%.0f full_retry=%llu%s\n",
+        (queueType == EzPubSub::QueueType::kRing) ? "ring" : "list",
+        (isHandle == true) ? "handle" : "name",
+        channelCount,
+        dataCount,
+        dataCount / ElapsedSeconds(startTime, publishedTime),
+        static_cast<unsigned long long>(fullRetryCount),
+        (isDelivered == true) ? "" : " timeout=1");
+}
+
+struct BenchQuote
+{
+    uint64_t instrumentId;
+    uint64_t sequence;
+    double bidPrice;
+    double askPrice;
+    uint32_t bidQuantity;
+    uint32_t askQuantity;
+    uint64_t timestamp;
+};
+
+std::atomic<uint64_t> gReceivedQuantity(0);
+
+void RawQuoteSubscriberCallback(_In_ const uint8_t* data, _In_ uint32_t dataSize, _In_opt_ void* userContext)
+{
+    BenchQuote quote;
+
+    (void)userContext;
+
+    if (dataSize != sizeof(quote))
+    {
+        return;
+    }
+
+    memcpy(&quote, data, sizeof(quote));
+    gReceivedQuantity.fetch_add(quote.bidQuantity, std::memory_order_relaxed);
+    gReceivedDataCount.fetch_add(1, std::memory_order_relaxed);
+}
+
+// One publisher thread publishes dataCount quotes to a subscriber parsing raw bytes,
+// and to a TypedChannel subscriber of std::function and of a lambda type.
+template <typename Subscriber>
+double BenchTypedQuote(_In_ EzPubSub::TypedChannel<BenchQuote, Subscriber>& typedChannel, _In_ const Subscriber& subscriber, _In_ uint32_t dataCount)
+{
+    EzPubSub::ChannelOption channelOption;
+    BenchQuote quote = {};
+
+    channelOption.fireMode = EzPubSub::FireMode::kEvent;
+    channelOption.maxBufferedDataSize = dataCount * 128;
+    typedChannel.Create(L"BenchTypedChannel", channelOption);
+    typedChannel.Subscribe(subscriber);
+
+    gReceivedDataCount.store(0);
+
+    BenchClock::time_point startTime = BenchClock::now();
+    for (uint32_t index = 0; index < dataCount; index++)
+    {
+        quote.sequence = index;
+        quote.bidQuantity = 1;
+        typedChannel.Publish(quote);
+    }
+    WaitReceivedDataCount(dataCount, 60000);
+    BenchClock::time_point deliveredTime = BenchClock::now();
+
+    typedChannel.Delete();
+
+    return dataCount / ElapsedSeconds(startTime, deliveredTime);
+}
+
+void BenchTypedChannel(_In_ uint32_t dataCount)
+{
+    std::wstring channelName = L"BenchTypedChannel";
+    EzPubSub::ChannelOption channelOption;
+    BenchQuote quote = {};
+    double rawMessagesPerSecond = 0;
+    double functionMessagesPerSecond = 0;
+    double lambdaMessagesPerSecond = 0;
+
+    channelOption.fireMode = EzPubSub::FireMode::kEvent;
+    channelOption.maxBufferedDataSize = dataCount * 128;
+    EzPubSub::PubSubLite::CreateChannel(channelName, channelOption);
+    EzPubSub::PubSubLite::RegisterSubscriber(channelName, RawQuoteSubscriberCallback);
+
+    gReceivedDataCount.store(0);
+
+    BenchClock::time_point startTime = BenchClock::now();
+    for (uint32_t index = 0; index < dataCount; index++)
+    {
+        quote.sequence = index;
+        quote.bidQuantity = 1;
+        EzPubSub::PubSubLite::PublishData(channelName, reinterpret_cast<const uint8_t*>(&quote), sizeof(quote));
+    }
+    WaitReceivedDataCount(dataCount, 60000);
+    BenchClock::time_point deliveredTime = BenchClock::now();
+    rawMessagesPerSecond = dataCount / ElapsedSeconds(startTime, deliveredTime);
+
+    EzPubSub::PubSubLite::DeleteChannel(channelName);
+
+    {
+        EzPubSub::TypedChannel<BenchQuote> typedChannel;
+        std::function<void(const BenchQuote&)> subscriber = [](const BenchQuote& receivedQuote)
+        {
+            gReceivedQuantity.fetch_add(receivedQuote.bidQuantity, std::memory_order_relaxed);
+            gReceivedDataCount.fetch_add(1, std::memory_order_relaxed);
+        };
+
+        functionMessagesPerSecond = BenchTypedQuote(typedChannel, subscriber, dataCount);
+    }
+    {
+        auto subscriber = [](const BenchQuote& receivedQuote)
+        {
+            gReceivedQuantity.fetch_add(receivedQuote.bidQuantity, std::memory_order_relaxed);
+            gReceivedDataCount.fetch_add(1, std::memory_order_relaxed);
+        };
+        EzPubSub::TypedChannel<BenchQuote, decltype(subscriber)> typedChannel;
+
+        lambdaMessagesPerSecond = BenchTypedQuote(typedChannel, subscriber, dataCount);
+    }
+
+    printf("typed_channel data_size=%u data_count=%u raw_deliver_msgs_per_sec=%.0f function_deliver_msgs_per_sec=%.0f lambda_deliver_msgs_per_sec=%.0f\n",
+        static_cast<uint32_t>(sizeof(BenchQuote)),
+        dataCount,
+        rawMessagesPerSecond,
+        functionMessagesPerSecond,
+        lambdaMessagesPerSecond);
+}
+
+// Publishes to many topic channels, whose subscriber is registered to each channel by name or once by a topic filter.
+// Unrelated topic filters are registered too, they cost nothing at publish time.
+void BenchWildcardSubscriber(_In_ bool isWildcard, _In_ uint32_t dataCount)
+{
+    const uint32_t channelCount = 64;
+    const uint32_t unrelatedFilterCount = 1000;
+    EzPubSub::ChannelOption channelOption;
+    std::vector<std::wstring> channelNameList;
+    uint8_t publishData[64] = { 0, };
+    uint64_t fullRetryCount = 0;
+
+    for (uint32_t filterIndex = 0; filterIndex < unrelatedFilterCount; filterIndex++)
+    {
+        EzPubSub::PubSubLite::RegisterWildcardSubscriber(L"BenchWildcard/unrelated" + std::to_wstring(filterIndex) + L"/#", CountingSubscriberCallback);
+    }
+    if (isWildcard == true)
+    {
+        EzPubSub::PubSubLite::RegisterWildcardSubscriber(L"BenchWildcard/*/quote", CountingSubscriberCallback);
+    }
+
+    channelOption.fireMode = EzPubSub::FireMode::kEvent;
+    channelOption.maxBufferedDataSize = dataCount * sizeof(publishData);
+    BenchClock::time_point createStartTime = BenchClock::now();
+    for (uint32_t channelIndex = 0; channelIndex < channelCount; channelIndex++)
+    {
+        channelNameList.push_back(L"BenchWildcard/instrument" + std::to_wstring(channelIndex) + L"/quote");
+        EzPubSub::PubSubLite::CreateChannel(channelNameList[channelIndex], channelOption);
+        if (isWildcard == false)
+        {
+            EzPubSub::PubSubLite::RegisterSubscriber(channelNameList[channelIndex], CountingSubscriberCallback);
+        }
+    }
+    BenchClock::time_point createdTime = BenchClock::now();
+
+    gReceivedDataCount.store(0);
+
+    BenchClock::time_point startTime = BenchClock::now();
+    for (uint32_t index = 0; index < dataCount; index++)
+    {
+        while (EzPubSub::PubSubLite::PublishData(channelNameList[index % channelCount], publishData, sizeof(publishData)) == EzPubSub::Error::kNotEnoughBufferSize)
+        {
+            fullRetryCount++;
+            std::this_thread::yield();
+        }
+    }
+    BenchClock::time_point publishedTime = BenchClock::now();
+
+    bool isDelivered = WaitReceivedDataCount(dataCount, 60000);
+    BenchClock::time_point deliveredTime = BenchClock::now();
+
+    for (auto& channelName : channelNameList)
+    {
+        EzPubSub::PubSubLite::DeleteChannel(channelName);
+    }
+    if (isWildcard == true)
+    {
+        EzPubSub::PubSubLite::UnregisterWildcardSubscriber(L"BenchWildcard/*/quote", CountingSubscriberCallback);
+    }
+    for (uint32_t filterIndex = 0; filterIndex < unrelatedFilterCount; filterIndex++)
+    {
+        EzPubSub::PubSubLite::UnregisterWildcardSubscriber(L"BenchWildcard/unrelated" + std::to_wstring(filterIndex) + L"/#", CountingSubscriberCallback);
+    }
+
+    printf("wildcard_subscriber by=%s channels=%u unrelated_filters=%u data_count=%u create_us_per_channel=%.1f publish_msgs_per_sec=%.0f deliver_msgs_per_sec=%.0f full_retry=%llu%s\n",
+        (isWildcard == true) ? "filter" : "name",
+        channelCount,
+        unrelatedFilterCount,
+        dataCount,
+        ElapsedSeconds(createStartTime, createdTime) * 1000000 / channelCount,
+        dataCount / ElapsedSeconds(startTime, publishedTime),
+        dataCount / ElapsedSeconds(startTime, deliveredTime),
+        static_cast<unsigned long long>(fullRetryCount),
+        (isDelivered == true) ? "" : " timeout=1");
+}
+
+// logSyncDataCount 0: not logged, UINT32_MAX: logged without being written to the disk by count.
+void BenchChannelLog(_In_ EzPubSub::QueueType queueType, _In_ uint32_t logSyncDataCount, _In_ uint32_t dataCount, _In_ uint32_t dataSize)
+{
+    std::wstring channelName = L"BenchChannelLog";
+    EzPubSub::ChannelOption channelOption;
+    EzPubSub::ChannelLogStatistics channelLogStatistics;
+    std::vector<uint8_t> publishData(dataSize, 0x5A);
+    uint64_t fullRetryCount = 0;
+    uint64_t replayedDataCount = 0;
+    bool isLogged = (logSyncDataCount != 0);
+
+    channelOption.fireMode = EzPubSub::FireMode::kEvent;
+    channelOption.maxBufferedDataSize = static_cast<uint32_t>(std::min<uint64_t>(0xFFFFFFFFull, static_cast<uint64_t>(dataCount) * dataSize));
+    channelOption.queueType = queueType;
+    if (isLogged == true)
+    {
+        channelOption.logDirectory = L"PubSubLiteBenchLog";
+        channelOption.logSyncDataCount = (logSyncDataCount != UINT32_MAX) ? logSyncDataCount : 0;
+    }
+    if (EzPubSub::PubSubLite::CreateChannel(channelName, channelOption) != EzPubSub::Error::kSuccess)
+    {
+        printf("channel_log unsupported=1\n");
+        return;
+    }
+    EzPubSub::PubSubLite::RegisterSubscriber(channelName, CountingSubscriberCallback);
+
+    gReceivedDataCount.store(0);
+
+    BenchClock::time_point startTime = BenchClock::now();
+    for (uint32_t index = 0; index < dataCount; index++)
+    {
+        while (EzPubSub::PubSubLite::PublishData(channelName, publishData.data(), dataSize) == EzPubSub::Error::kNotEnoughBufferSize)
+        {
+            fullRetryCount++;
+            std::this_thread::yield();
+        }
+    }
+    BenchClock::time_point publishedTime = BenchClock::now();
+
+    bool isDelivered = WaitReceivedDataCount(dataCount, 60000);
+    EzPubSub::PubSubLite::SyncChannelLog(channelName);
+    BenchClock::time_point syncedTime = BenchClock::now();
+
+    EzPubSub::PubSubLite::GetChannelLogStatistics(channelName, channelLogStatistics);
+    BenchClock::time_point replayStartTime = BenchClock::now();
+    EzPubSub::PubSubLite::ReplayChannelLog(channelName, channelLogStatistics.nextLogOffset - dataCount,
+        [](_In_ uint64_t logOffset, _In_ const uint8_t* data, _In_ uint32_t dataSize, _In_opt_ void* replayContext)
+        {
+            (void)logOffset;
+            (void)data;
+            (void)dataSize;
+
+            (*static_cast<uint64_t*>(replayContext))++;
+        }, &replayedDataCount);
+    BenchClock::time_point replayedTime = BenchClock::now();
+
+    EzPubSub::PubSubLite::DeleteChannel(channelName);
+    if (isLogged == true)
+    {
+        std::error_code errorCode;
+        std::filesystem::remove_all(channelOption.logDirectory, errorCode);
+    }
+
+    printf("channel_log queue=%s log=%s sync_data_count=%u data_count=%u data_size=%u publish_msgs_per_sec=%.0f publish_mb_per_sec=%.1f synced_msgs_per_sec=%.0f replay_msgs_per_sec=%.0f full_retry=%llu%s\n",
+        (queueType == EzPubSub::QueueType::kRing) ? "ring" : "list",
+        (isLogged == true) ? "on" : "off",
+        (logSyncDataCount != UINT32_MAX) ? logSyncDataCount : 0,
+        dataCount,
+        dataSize,
+        dataCount / ElapsedSeconds(startTime, publishedTime),
+        (static_cast<double>(dataCount) * dataSize) / (1024.0 * 1024.0) / ElapsedSeconds(startTime, publishedTime),
+        dataCount / ElapsedSeconds(startTime, syncedTime),
+        (replayedDataCount != 0) ? replayedDataCount / ElapsedSeconds(replayStartTime, replayedTime) : 0.0,
+        static_cast<unsigned long long>(fullRetryCount),
+        (isDelivered == true) ? "" : " timeout=1");
+}
+
+#if defined(__linux__)
+// kSharedMemory: the subscriber runs in a forked process and reports when it received every data through a pipe.
+// kRing: the subscriber runs in this process, for comparison.
+void BenchSharedMemory(_In_ EzPubSub::QueueType queueType, _In_ uint32_t dataCount, _In_ uint32_t dataSize)
+{
+    std::wstring channelName = L"BenchSharedMemory";
+    EzPubSub::ChannelOption channelOption;
+    std::vector<uint8_t> publishData(dataSize, 0x5A);
+    uint64_t fullRetryCount = 0;
+    int readyPipe[2] = { -1, -1 };
+    int deliveredPipe[2] = { -1, -1 };
+    pid_t subscriberProcessId = -1;
+    uint8_t isDelivered = 0;
+
+    channelOption.fireMode = EzPubSub::FireMode::kEvent;
+    channelOption.maxBufferedDataSize = 4 * 1024 * 1024;
+    channelOption.queueType = queueType;
+    channelOption.overflowPolicy = EzPubSub::OverflowPolicy::kBlock;
+
+    gReceivedDataCount.store(0);
+
+    if (queueType == EzPubSub::QueueType::kSharedMemory)
+    {
+        if ((pipe(readyPipe) != 0) || (pipe(deliveredPipe) != 0))
+        {
+            return;
+        }
+
+        fflush(stdout);
+        subscriberProcessId = fork();
+        if (subscriberProcessId == 0)
+        {
+            EzPubSub::PubSubLite::CreateChannel(channelName, channelOption);
+            EzPubSub::PubSubLite::RegisterSubscriber(channelName, CountingSubscriberCallback);
+            isDelivered = 1;
+            (void)!write(readyPipe[1], &isDelivered, sizeof(isDelivered));
+
+            isDelivered = (WaitReceivedDataCount(dataCount, 60000) == true) ? 1 : 0;
+            (void)!write(deliveredPipe[1], &isDelivered, sizeof(isDelivered));
+            EzPubSub::PubSubLite::DeleteChannel(channelName);
+            _exit(0);
+        }
+        (void)!read(readyPipe[0], &isDelivered, sizeof(isDelivered));
+    }
+
+    // The subscriber process attached first, so it receives every data published below.
+    if (EzPubSub::PubSubLite::CreateChannel(channelName, channelOption) != EzPubSub::Error::kSuccess)
+    {
+        printf("shared_memory queue=%s unsupported=1\n", (queueType == EzPubSub::QueueType::kRing) ? "ring" : "shared_memory");
+    }
+    else
+    {
+        if (queueType == EzPubSub::QueueType::kRing)
+        {
+            EzPubSub::PubSubLite::RegisterSubscriber(channelName, CountingSubscriberCallback);
+        }
+
+        BenchClock::time_point startTime = BenchClock::now();
+        for (uint32_t index = 0; index < dataCount; index++)
+        {
+            while (EzPubSub::PubSubLite::PublishData(channelName, publishData.data(), dataSize) == EzPubSub::Error::kNotEnoughBufferSize)
+            {
+                fullRetryCount++;
+                std::this_thread::yield();
+            }
+        }
+        BenchClock::time_point publishedTime = BenchClock::now();
+
+        if (queueType == EzPubSub::QueueType::kSharedMemory)
+        {
+            (void)!read(deliveredPipe[0], &isDelivered, sizeof(isDelivered));
+        }
+        else
+        {
+            isDelivered = (WaitReceivedDataCount(dataCount, 60000) == true) ? 1 : 0;
+        }
+        BenchClock::time_point deliveredTime = BenchClock::now();
+
+        EzPubSub::PubSubLite::DeleteChannel(channelName);
+
+        printf("shared_memory queue=%s subscriber=%s data_count=%u data_size=%u publish_msgs_per_sec=%.0f deliver_msgs_per_sec=%.0f deliver_mb_per_sec=%.1f full_retry=%llu%s\n",
+            (queueType == EzPubSub::QueueType::kRing) ? "ring" : "shared_memory",
+            (queueType == EzPubSub::QueueType::kRing) ? "thread" : "process",
+            dataCount,
+            dataSize,
+            dataCount / ElapsedSeconds(startTime, publishedTime),
+            dataCount / ElapsedSeconds(startTime, deliveredTime),
+            (static_cast<double>(dataCount) * dataSize) / (1024.0 * 1024.0) / ElapsedSeconds(startTime, deliveredTime),
+            static_cast<unsigned long long>(fullRetryCount),
+            (isDelivered == 1) ? "" : " timeout=1");
+    }
+
+    if (subscriberProcessId > 0)
+    {
+        waitpid(subscriberProcessId, nullptr, 0);
+        close(readyPipe[0]);
+        close(readyPipe[1]);
+        close(deliveredPipe[0]);
+        close(deliveredPipe[1]);
+    }
+}
+#endif
+
+void BenchChannelScaling(_In_ EzPubSub::FireThreadType fireThreadType, _In_ uint32_t channelCount, _In_ uint32_t dataCountPerChannel)
+{
+    EzPubSub::ChannelOption channelOption;
+    std::vector<std::wstring> channelNameList;
+    std::vector<std::thread> publisherThreadList;
+    uint64_t totalDataCount = static_cast<uint64_t>(channelCount) * dataCountPerChannel;
+
+    channelOption.fireMode = EzPubSub::FireMode::kEvent;
+    channelOption.maxBufferedDataSize = dataCountPerChannel * 64;
+    channelOption.fireThreadType = fireThreadType;
+    for (uint32_t index = 0; index < channelCount; index++)
+    {
+        channelNameList.push_back(L"BenchChannelScaling" + std::to_wstring(index));
+        EzPubSub::PubSubLite::CreateChannel(channelNameList[index], channelOption);
+        EzPubSub::PubSubLite::RegisterSubscriber(channelNameList[index], CountingSubscriberCallback);
+    }
+
+    gReceivedDataCount.store(0);
+
+    BenchClock::time_point startTime = BenchClock::now();
+    for (uint32_t index = 0; index < channelCount; index++)
+    {
+        publisherThreadList.emplace_back([&channelNameList, index, dataCountPerChannel]()
+        {
+            uint8_t publishData[64] = { 0, };
+
+            for (uint32_t dataIndex = 0; dataIndex < dataCountPerChannel; dataIndex++)
+            {
+                EzPubSub::PubSubLite::PublishData(channelNameList[index], publishData, sizeof(publishData));
+            }
+        });
+    }
+    for (auto& publisherThread : publisherThreadList)
+    {
+        publisherThread.join();
+    }
+    BenchClock::time_point publishedTime = BenchClock::now();
+
+    WaitReceivedDataCount(totalDataCount, 60000);
+    BenchClock::time_point deliveredTime = BenchClock::now();
+
+    for (auto& channelName : channelNameList)
+    {
+        EzPubSub::PubSubLite::DeleteChannel(channelName);
+    }
+
+    printf("channel_scaling fire_thread=%s channel_count=%u data_count=%llu publish_msgs_per_sec=%.0f deliver_msgs_per_sec=%.0f\n",
+        (fireThreadType == EzPubSub::FireThreadType::kShared) ? "shared" : "dedicated",
+        channelCount,
+        static_cast<unsigned long long>(totalDataCount),
+        totalDataCount / ElapsedSeconds(startTime, publishedTime),
+        totalDataCount / ElapsedSeconds(startTime, deliveredTime));
+}
+
+// Two publishers per channel, so that the channel lock is contended, and the statistics of every channel are printed at the end.
+// Build with PUBSUBLITE_DISABLE_STATISTICS to compare the throughput without them.
+void BenchChannelStatistics(_In_ uint32_t dataCount)
+{
+    EzPubSub::ChannelOption channelOption;
+    std::vector<std::wstring> channelNameList;
+    std::vector<EzPubSub::ChannelStatistics> channelStatisticsList;
+    uint32_t dataCountPerProducer = dataCount / 2;
+
+    dataCount = dataCountPerProducer * 2;
+    channelOption.fireMode = EzPubSub::FireMode::kEvent;
+    channelOption.maxBufferedDataSize = static_cast<uint32_t>(std::min<uint64_t>(0xFFFFFFFFull, static_cast<uint64_t>(dataCount) * 64));
+    for (auto fireThreadType : { EzPubSub::FireThreadType::kDedicated, EzPubSub::FireThreadType::kShared })
+    {
+        for (auto queueType : { EzPubSub::QueueType::kList, EzPubSub::QueueType::kRing })
+        {
+            channelOption.queueType = queueType;
+            channelOption.fireThreadType = fireThreadType;
+            channelNameList.push_back(std::wstring(L"BenchChannelStatistics.") +
+                ((queueType == EzPubSub::QueueType::kRing) ? L"ring" : L"list") + L"." +
+                ((fireThreadType == EzPubSub::FireThreadType::kShared) ? L"shared" : L"dedicated"));
+            EzPubSub::PubSubLite::CreateChannel(channelNameList.back(), channelOption);
+            EzPubSub::PubSubLite::RegisterSubscriber(channelNameList.back(), CountingSubscriberCallback);
+        }
+    }
+
+    for (auto& channelName : channelNameList)
+    {
+        std::vector<std::thread> producerThreadList;
+
+        gReceivedDataCount.store(0);
+
+        BenchClock::time_point startTime = BenchClock::now();
+        for (uint32_t producerIndex = 0; producerIndex < 2; producerIndex++)
+        {
+            producerThreadList.emplace_back([&channelName, dataCountPerProducer]()
+            {
+                uint8_t publishData[64] = { 0, };
+
+                for (uint32_t index = 0; index < dataCountPerProducer; index++)
+                {
+                    while (EzPubSub::PubSubLite::PublishData(channelName, publishData, sizeof(publishData)) == EzPubSub::Error::kNotEnoughBufferSize)
+                    {
+                        std::this_thread::yield();
+                    }
+                }
+            });
+        }
+        for (auto& producerThread : producerThreadList)
+        {
+            producerThread.join();
+        }
+
+        bool isDelivered = WaitReceivedDataCount(dataCount, 60000);
+        BenchClock::time_point deliveredTime = BenchClock::now();
+
+        printf("channel_statistics_throughput channel=%ls statistics=%s data_count=%u deliver_msgs_per_sec=%.0f%s\n",
+            channelName.c_str(),
+            (EzPubSub::kIsStatisticsEnabled == true) ? "on" : "off",
+            dataCount,
+            dataCount / ElapsedSeconds(startTime, deliveredTime),
+            (isDelivered == true) ? "" : " timeout=1");
+    }
+
+    EzPubSub::PubSubLite::GetAllChannelStatistics(channelStatisticsList);
+    for (auto& channelStatistics : channelStatisticsList)
+    {
+        const EzPubSub::HistogramSnapshot& callbackTime = channelStatistics.subscriberStatisticsList.at(0).callbackTime;
+
+        printf("channel_statistics channel=%ls fired=%llu lost=%llu latency_p50_ns=%llu latency_p99_ns=%llu latency_p999_ns=%llu latency_max_ns=%llu callback_p50_ns=%llu callback_p99_ns=%llu lock_wait_count=%llu lock_wait_p99_ns=%llu buffered_count_p50=%llu buffered_count_max=%llu buffered_size_max=%llu\n",
+            channelStatistics.channelName.c_str(),
+            static_cast<unsigned long long>(channelStatistics.firedDataCount),
+            static_cast<unsigned long long>(channelStatistics.lostDataCount),
+            static_cast<unsigned long long>(channelStatistics.deliveryLatency.GetPercentile(50.0)),
+            static_cast<unsigned long long>(channelStatistics.deliveryLatency.GetPercentile(99.0)),
+            static_cast<unsigned long long>(channelStatistics.deliveryLatency.GetPercentile(99.9)),
+            static_cast<unsigned long long>(channelStatistics.deliveryLatency.maxValue),
+            static_cast<unsigned long long>(callbackTime.GetPercentile(50.0)),
+            static_cast<unsigned long long>(callbackTime.GetPercentile(99.0)),
+            static_cast<unsigned long long>(channelStatistics.lockWaitTime.count),
+            static_cast<unsigned long long>(channelStatistics.lockWaitTime.GetPercentile(99.0)),
+            static_cast<unsigned long long>(channelStatistics.bufferedDataCountSample.GetPercentile(50.0)),
+            static_cast<unsigned long long>(channelStatistics.bufferedDataCountSample.maxValue),
+            static_cast<unsigned long long>(channelStatistics.bufferedDataSizeSample.maxValue));
+    }
+
+    for (auto& channelName : channelNameList)
+    {
+        EzPubSub::PubSubLite::DeleteChannel(channelName);
+    }
+}
+
+std::atomic<uint64_t> gBatchCount(0);
+
+// The first 8 bytes of each published data are the publish time.
+void LatencyBatchSubscriberCallback(_In_ const EzPubSub::FiredData* firedDataList, _In_ uint32_t firedDataCount)
+{
+    uint64_t publishedTime = 0;
+    uint64_t currentTime = NowNanoseconds();
+
+    for (uint32_t index = 0; index < firedDataCount; index++)
+    {
+        if (firedDataList[index].dataSize >= sizeof(publishedTime))
+        {
+            memcpy(&publishedTime, firedDataList[index].data, sizeof(publishedTime));
+            gLatencyList.push_back(currentTime - publishedTime);
+        }
+    }
+    gBatchCount.fetch_add(1, std::memory_order_relaxed);
+    gReceivedDataCount.fetch_add(firedDataCount, std::memory_order_release);
+}
+
+// Publishes dataCount messages in bursts of 8 spaced by intervalMicroseconds to a batch subscriber,
+// and measures how many data each call delivers and what the coalescedTime adds to the latency.
+void BenchCoalescing(_In_ EzPubSub::FireThreadType fireThreadType, _In_ EzPubSub::QueueType queueType, _In_ uint32_t coalescedTime, _In_ uint32_t dataCount, _In_ uint32_t intervalMicroseconds)
+{
+    std::wstring channelName = L"BenchCoalescing";
+    EzPubSub::ChannelOption channelOption;
+    uint8_t publishData[64] = { 0, };
+    uint64_t publishedTime = 0;
+    const uint32_t burstDataCount = 8;
+
+    dataCount = std::max<uint32_t>(burstDataCount, dataCount - (dataCount % burstDataCount));
+    channelOption.fireMode = EzPubSub::FireMode::kEvent;
+    channelOption.queueType = queueType;
+    channelOption.ringCapacity = dataCount;
+    channelOption.fireThreadType = fireThreadType;
+    channelOption.coalescedTime = coalescedTime;
+    EzPubSub::PubSubLite::CreateChannel(channelName, channelOption);
+    EzPubSub::PubSubLite::RegisterSubscriber(channelName, LatencyBatchSubscriberCallback);
+
+    gReceivedDataCount.store(0);
+    gBatchCount.store(0);
+    gLatencyList.clear();
+    gLatencyList.reserve(dataCount);
+
+    BenchClock::time_point startTime = BenchClock::now();
+    for (uint32_t index = 0; index < dataCount; index++)
+    {
+        publishedTime = NowNanoseconds();
+        memcpy(publishData, &publishedTime, sizeof(publishedTime));
+        EzPubSub::PubSubLite::PublishData(channelName, publishData, sizeof(publishData));
+        if ((index % burstDataCount) == burstDataCount - 1)
+        {
+            std::this_thread::sleep_for(std::chrono::microseconds(intervalMicroseconds));
+        }
+    }
+    WaitReceivedDataCount(dataCount, 60000);
+    BenchClock::time_point deliveredTime = BenchClock::now();
+
+    EzPubSub::PubSubLite::DeleteChannel(channelName);
+
+    std::sort(gLatencyList.begin(), gLatencyList.end());
+    printf("coalescing thread=%s queue=%s coalesced_time_us=%u data_count=%u deliver_msgs_per_sec=%.0f calls=%llu data_per_call=%.1f p50_us=%.1f p99_us=%.1f max_us=%.1f\n",
+        (fireThreadType == EzPubSub::FireThreadType::kShared) ? "shared" : "dedicated",
+        (queueType == EzPubSub::QueueType::kRing) ? "ring" : "list",
+        coalescedTime,
+        static_cast<uint32_t>(gLatencyList.size()),
+        dataCount / ElapsedSeconds(startTime, deliveredTime),
+        static_cast<unsigned long long>(gBatchCount.load()),
+        (gBatchCount.load() != 0) ? static_cast<double>(gLatencyList.size()) / static_cast<double>(gBatchCount.load()) : 0.0,
+        Percentile(gLatencyList, 50.0) / 1000.0,
+        Percentile(gLatencyList, 99.0) / 1000.0,
+        Percentile(gLatencyList, 100.0) / 1000.0);
+}
+
+std::atomic<uint64_t> gControlDataCount(0);
+
+// Bulk data takes about a microsecond each, so it piles up in the buffer.
+// Control data, published with a non-null userContext, records its latency.
+void PrioritySubscriberCallback(_In_ const uint8_t* data, _In_ uint32_t dataSize, _In_opt_ void* userContext)
+{
+    uint64_t publishedTime = 0;
+    uint64_t spinTime = 0;
+
+    if (userContext == nullptr)
+    {
+        spinTime = NowNanoseconds() + 1000;
+        while (NowNanoseconds() < spinTime)
+        {
+        }
+    }
+    else if (dataSize >= sizeof(publishedTime))
+    {
+        memcpy(&publishedTime, data, sizeof(publishedTime));
+        gLatencyList.push_back(NowNanoseconds() - publishedTime);
+        gControlDataCount.fetch_add(1, std::memory_order_relaxed);
+    }
+    gReceivedDataCount.fetch_add(1, std::memory_order_release);
+}
+
+// A producer floods priority 0 of a kList channel faster than its subscriber takes it, while controlDataCount control data
+// are published every intervalMicroseconds to the highest priority, and measures the latency and the delivered count of the control data
+// with a single lane and with priority lanes.
+void BenchPriorityLane(_In_ EzPubSub::FireThreadType fireThreadType, _In_ uint32_t priorityLaneCount, _In_ EzPubSub::LaneScheduling laneScheduling, _In_ uint32_t controlDataCount, _In_ uint32_t intervalMicroseconds)
+{
+    std::wstring channelName = L"BenchPriorityLane";
+    EzPubSub::ChannelOption channelOption;
+    uint8_t controlData[64] = { 0, };
+    uint64_t publishedTime = 0;
+    std::atomic<bool> isBulkExit(false);
+    uint64_t bulkDataCount = 0;
+    uint64_t lostDataCount = 0;
+    EzPubSub::ChannelStatistics channelStatistics;
+
+    channelOption.fireMode = EzPubSub::FireMode::kEvent;
+    channelOption.fireThreadType = fireThreadType;
+    channelOption.maxBufferedDataSize = 64 * 1024;
+    channelOption.priorityLaneCount = priorityLaneCount;
+    channelOption.laneScheduling = laneScheduling;
+    EzPubSub::PubSubLite::CreateChannel(channelName, channelOption);
+    EzPubSub::PubSubLite::RegisterSubscriber(channelName, PrioritySubscriberCallback);
+
+    gReceivedDataCount.store(0);
+    gControlDataCount.store(0);
+    gLatencyList.clear();
+    gLatencyList.reserve(controlDataCount);
+
+    std::thread bulkThread([&channelName, &isBulkExit, &bulkDataCount]()
+    {
+        uint8_t bulkData[64] = { 0, };
+
+        while (isBulkExit.load(std::memory_order_relaxed) == false)
+        {
+            EzPubSub::PubSubLite::PublishData(channelName, bulkData, sizeof(bulkData));
+            bulkDataCount++;
+        }
+    });
+
+    for (uint32_t index = 0; index < controlDataCount; index++)
+    {
+        std::this_thread::sleep_for(std::chrono::microseconds(intervalMicroseconds));
+        publishedTime = NowNanoseconds();
+        memcpy(controlData, &publishedTime, sizeof(publishedTime));
+        EzPubSub::PubSubLite::PublishPriorityData(channelName, priorityLaneCount - 1, controlData, sizeof(controlData), controlData);
+    }
+
+    // Control data in the lane of the bulk data may be dropped by kDropOldest, so it is not waited for long.
+    BenchClock::time_point waitTime = BenchClock::now() + std::chrono::seconds(1);
+    while ((gControlDataCount.load(std::memory_order_relaxed) < controlDataCount) && (BenchClock::now() < waitTime))
+    {
+        std::this_thread::sleep_for(std::chrono::microseconds(100));
+    }
+    isBulkExit.store(true);
+    bulkThread.join();
+
+    EzPubSub::PubSubLite::GetChannelStatistics(channelName, channelStatistics);
+    lostDataCount = channelStatistics.lostDataCount;
+    EzPubSub::PubSubLite::DeleteChannel(channelName);
+
+    std::sort(gLatencyList.begin(), gLatencyList.end());
+    printf("priority thread=%s lanes=%u scheduling=%s delivered_control_count=%u bulk_count=%llu lost_count=%llu p50_us=%.1f p99_us=%.1f max_us=%.1f\n",
+        (fireThreadType == EzPubSub::FireThreadType::kShared) ? "shared" : "dedicated",
+        priorityLaneCount,
+        (laneScheduling == EzPubSub::LaneScheduling::kWeighted) ? "weighted" : "strict",
+        static_cast<uint32_t>(gLatencyList.size()),
+        static_cast<unsigned long long>(bulkDataCount),
+        static_cast<unsigned long long>(lostDataCount),
+        Percentile(gLatencyList, 50.0) / 1000.0,
+        Percentile(gLatencyList, 99.0) / 1000.0,
+        Percentile(gLatencyList, 100.0) / 1000.0);
+}
+
+const uint32_t kFilterSubscriberCount = 16;
+
+// Counts only the data of its own symbol, the first 4 bytes of the data, as a subscriber without a filter has to check.
+template <uint32_t SubscriberIndex>
+void SymbolSubscriberCallback(_In_ const uint8_t* data, _In_ uint32_t dataSize, _In_opt_ void* userContext)
+{
+    uint32_t symbol = 0;
+
+    (void)userContext;
+
+    if (dataSize >= sizeof(symbol))
+    {
+        memcpy(&symbol, data, sizeof(symbol));
+        if (symbol == SubscriberIndex)
+        {
+            gReceivedDataCount.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+}
+
+template <uint32_t... SubscriberIndex>
+std::vector<EzPubSub::SUBSCRIBER_CALLBACK> MakeSymbolSubscriberCallbackList(_In_ std::integer_sequence<uint32_t, SubscriberIndex...>)
+{
+    return { SymbolSubscriberCallback<SubscriberIndex>... };
+}
+
+// Publishes dataCount data of 16 symbols round robin to 16 subscribers of one symbol each,
+// which check the symbol themselves or are registered with a SubscriberFilter on it.
+void BenchSubscriberFilter(_In_ EzPubSub::QueueType queueType, _In_ bool isFilter, _In_ uint32_t dataCount)
+{
+    std::wstring channelName = L"BenchSubscriberFilter";
+    EzPubSub::ChannelOption channelOption;
+    EzPubSub::SubscriberOption subscriberOption;
+    std::vector<EzPubSub::SUBSCRIBER_CALLBACK> subscriberCallbackList =
+        MakeSymbolSubscriberCallbackList(std::make_integer_sequence<uint32_t, kFilterSubscriberCount>());
+    uint8_t publishData[64] = { 0, };
+    uint32_t symbol = 0;
+
+    channelOption.fireMode = EzPubSub::FireMode::kEvent;
+    channelOption.queueType = queueType;
+    channelOption.ringCapacity = dataCount;
+    channelOption.maxBufferedDataSize = static_cast<uint32_t>(std::min<uint64_t>(0xFFFFFFFFull, static_cast<uint64_t>(dataCount) * sizeof(publishData)));
+    EzPubSub::PubSubLite::CreateChannel(channelName, channelOption);
+    for (uint32_t index = 0; index < kFilterSubscriberCount; index++)
+    {
+        if (isFilter == true)
+        {
+            subscriberOption.subscriberFilter = EzPubSub::SubscriberFilter::MakeMaskValue(0, sizeof(symbol), 0xFFFFFFFFull, index);
+            EzPubSub::PubSubLite::RegisterSubscriber(channelName, subscriberCallbackList[index], subscriberOption);
+        }
+        else
+        {
+            EzPubSub::PubSubLite::RegisterSubscriber(channelName, subscriberCallbackList[index]);
+        }
+    }
+
+    gReceivedDataCount.store(0);
+
+    BenchClock::time_point startTime = BenchClock::now();
+    for (uint32_t index = 0; index < dataCount; index++)
+    {
+        symbol = index % kFilterSubscriberCount;
+        memcpy(publishData, &symbol, sizeof(symbol));
+        EzPubSub::PubSubLite::PublishData(channelName, publishData, sizeof(publishData));
+    }
+    WaitReceivedDataCount(dataCount, 60000);
+    BenchClock::time_point deliveredTime = BenchClock::now();
+
+    EzPubSub::PubSubLite::DeleteChannel(channelName);
+
+    printf("subscriber_filter queue=%s filter=%s subscribers=%u data_count=%u deliver_msgs_per_sec=%.0f\n",
+        (queueType == EzPubSub::QueueType::kRing) ? "ring" : "list",
+        (isFilter == true) ? "mask_value" : "callback",
+        kFilterSubscriberCount,
+        dataCount,
+        dataCount / ElapsedSeconds(startTime, deliveredTime));
+}
+
+// Publishes dataCount updates of keyCount keys to a 64 KB kDropOldest buffer drained by a slow subscriber,
+// which loses the oldest updates without conflation, and receives only the latest update of each key with it.
+void BenchConflation(_In_ EzPubSub::ConflationMode conflationMode, _In_ uint32_t keyCount, _In_ uint32_t dataCount)
+{
+    std::wstring channelName = L"BenchConflation";
+    EzPubSub::ChannelOption channelOption;
+    EzPubSub::ChannelStatistics channelStatistics;
+    uint8_t publishData[64] = { 0, };
+    uint64_t dataKey = 0;
+    const char* modeName = "none";
+
+    channelOption.fireMode = EzPubSub::FireMode::kEvent;
+    channelOption.maxBufferedDataSize = 65536;
+    channelOption.overflowPolicy = EzPubSub::OverflowPolicy::kDropOldest;
+    channelOption.conflationMode = conflationMode;
+    EzPubSub::PubSubLite::CreateChannel(channelName, channelOption);
+    EzPubSub::PubSubLite::RegisterSubscriber(channelName, SlowSubscriberCallback);
+
+    gSlowReceivedDataCount.store(0);
+
+    BenchClock::time_point startTime = BenchClock::now();
+    for (uint32_t index = 0; index < dataCount; index++)
+    {
+        dataKey = index % keyCount;
+        memcpy(publishData, &dataKey, sizeof(dataKey));
+        EzPubSub::PubSubLite::PublishKeyedData(channelName, dataKey, publishData, sizeof(publishData));
+    }
+    BenchClock::time_point publishedTime = BenchClock::now();
+
+    // The latest update of every key is delivered once the buffer is empty and the slow subscriber returns,
+    // deleting the channel waits for the slow subscriber.
+    EzPubSub::PubSubLite::GetChannelStatistics(channelName, channelStatistics);
+    while ((channelStatistics.bufferedDataCount != 0) && (ElapsedSeconds(publishedTime, BenchClock::now()) < 60.0))
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        EzPubSub::PubSubLite::GetChannelStatistics(channelName, channelStatistics);
+    }
+    EzPubSub::PubSubLite::DeleteChannel(channelName);
+    BenchClock::time_point drainedTime = BenchClock::now();
+
+    if (conflationMode == EzPubSub::ConflationMode::kConflate)
+    {
+        modeName = "conflate";
+    }
+    else if (conflationMode == EzPubSub::ConflationMode::kLastValueCache)
+    {
+        modeName = "last_value_cache";
+    }
+    printf("conflation mode=%s keys=%u data_count=%u publish_msgs_per_sec=%.0f drain_ms=%.1f slow_received=%llu lost=%llu conflated=%llu\n",
+        modeName,
+        keyCount,
+        dataCount,
+        dataCount / ElapsedSeconds(startTime, publishedTime),
+        ElapsedSeconds(publishedTime, drainedTime) * 1000.0,
+        static_cast<unsigned long long>(gSlowReceivedDataCount.load()),
+        static_cast<unsigned long long>(channelStatistics.lostDataCount),
+        static_cast<unsigned long long>(channelStatistics.conflatedDataCount));
+}
+
+const uint32_t kCompressionMessageCount = 1024;
+
+// JSON quotes of about 150 bytes, as a market data channel would carry.
+std::vector<std::string> MakeCompressionMessageList()
+{
+    std::vector<std::string> messageList;
+    char message[256] = { 0, };
+    int messageSize = 0;
+
+    for (uint32_t index = 0; index < kCompressionMessageCount; index++)
+    {
+        messageSize = snprintf(message, sizeof(message),
+            "{\"type\":\"quote\",\"symbol\":\"SYM%04u\",\"venue\":\"XNAS\",\"bid\":%u.%02u,\"ask\":%u.%02u,"
+            "\"bid_size\":%u,\"ask_size\":%u,\"conditions\":[\"regular\",\"lit\"],\"sequence\":%u}",
+            index % 97, 100 + (index % 13), index % 100, 100 + (index % 13), (index + 1) % 100, (index % 50) * 100, (index % 30) * 100, index);
+        messageList.emplace_back(message, static_cast<size_t>(messageSize));
+    }
+
+    return messageList;
+}
+
+// Publishes dataCount JSON quotes without compression, with a compression threshold, and with a dictionary of a sample quote,
+// and reports the bytes buffered per data and the throughput paid for them.
+void BenchCompression(_In_ EzPubSub::QueueType queueType, _In_ uint32_t compressionThreshold, _In_ bool isDictionary, _In_ uint32_t dataCount)
+{
+    std::wstring channelName = L"BenchCompression";
+    EzPubSub::ChannelOption channelOption;
+    EzPubSub::ChannelStatistics channelStatistics;
+    std::vector<std::string> messageList = MakeCompressionMessageList();
+    uint64_t publishedDataSize = 0;
+
+    channelOption.fireMode = EzPubSub::FireMode::kEvent;
+    channelOption.queueType = queueType;
+    channelOption.ringCapacity = dataCount;
+    channelOption.maxBufferedDataSize = static_cast<uint32_t>(std::min<uint64_t>(0xFFFFFFFFull, static_cast<uint64_t>(dataCount) * 256));
+    channelOption.compressionThreshold = compressionThreshold;
+    if (isDictionary == true)
+    {
+        channelOption.compressionDictionary.assign(messageList[0].begin(), messageList[0].end());
+    }
+    EzPubSub::PubSubLite::CreateChannel(channelName, channelOption);
+    EzPubSub::PubSubLite::RegisterSubscriber(channelName, CountingSubscriberCallback);
+
+    gReceivedDataCount.store(0);
+
+    BenchClock::time_point startTime = BenchClock::now();
+    for (uint32_t index = 0; index < dataCount; index++)
+    {
+        const std::string& message = messageList[index % kCompressionMessageCount];
+
+        EzPubSub::PubSubLite::PublishData(channelName, reinterpret_cast<const uint8_t*>(message.data()), static_cast<uint32_t>(message.size()));
+        publishedDataSize += message.size();
+    }
+    BenchClock::time_point publishedTime = BenchClock::now();
+    WaitReceivedDataCount(dataCount, 60000);
+    BenchClock::time_point deliveredTime = BenchClock::now();
+
+    EzPubSub::PubSubLite::GetChannelStatistics(channelName, channelStatistics);
+    EzPubSub::PubSubLite::DeleteChannel(channelName);
+
+    printf("compression queue=%s threshold=%u dictionary=%s data_count=%u publish_msgs_per_sec=%.0f deliver_msgs_per_sec=%.0f "
+        "bytes_per_msg=%.1f buffered_bytes_per_msg=%.1f compressed=%llu\n",
+        (queueType == EzPubSub::QueueType::kRing) ? "ring" : "list",
+        compressionThreshold,
+        (isDictionary == true) ? "yes" : "no",
+        dataCount,
+        dataCount / ElapsedSeconds(startTime, publishedTime),
+        dataCount / ElapsedSeconds(startTime, deliveredTime),
+        static_cast<double>(publishedDataSize) / dataCount,
+        static_cast<double>(publishedDataSize - channelStatistics.compressionSavedSize) / dataCount,
+        static_cast<unsigned long long>(channelStatistics.compressedDataCount));
+}
+
+// Publishes dataCount data of 64 bytes from producerCount producers, batchDataCount data per PublishBatch,
+// or one PublishData per data if batchDataCount is 1, as a producer draining a socket buffer of small messages would.
+void BenchPublishBatch(_In_ EzPubSub::QueueType queueType, _In_ uint32_t producerCount, _In_ uint32_t batchDataCount, _In_ uint32_t dataCount)
+{
+    std::wstring channelName = L"BenchPublishBatch";
+    EzPubSub::ChannelOption channelOption;
+    std::vector<std::thread> producerThreadList;
+    std::atomic<uint64_t> fullRetryCount(0);
+    uint32_t dataCountPerProducer = (dataCount / producerCount / batchDataCount) * batchDataCount;
+    const uint32_t dataSize = 64;
+
+    dataCount = dataCountPerProducer * producerCount;
+
+    // The buffer holds every message so the measurement does not depend on the fire thread keeping up.
+    channelOption.fireMode = EzPubSub::FireMode::kEvent;
+    channelOption.maxBufferedDataSize = static_cast<uint32_t>(std::min<uint64_t>(0xFFFFFFFFull, static_cast<uint64_t>(dataCount) * dataSize));
+    channelOption.queueType = queueType;
+    channelOption.ringCapacity = dataCount;
+    EzPubSub::PubSubLite::CreateChannel(channelName, channelOption);
+    EzPubSub::PubSubLite::RegisterSubscriber(channelName, CountingSubscriberCallback);
+
+    gReceivedDataCount.store(0);
+
+    BenchClock::time_point startTime = BenchClock::now();
+    for (uint32_t producerIndex = 0; producerIndex < producerCount; producerIndex++)
+    {
+        producerThreadList.emplace_back([&channelName, &fullRetryCount, dataCountPerProducer, batchDataCount, dataSize]()
+        {
+            std::vector<uint8_t> socketBuffer(static_cast<size_t>(batchDataCount) * dataSize, 0x5A);
+            std::vector<EzPubSub::PublishBatchData> batchDataList(batchDataCount);
+
+            for (uint32_t index = 0; index < batchDataCount; index++)
+            {
+                batchDataList[index].data = socketBuffer.data() + static_cast<size_t>(index) * dataSize;
+                batchDataList[index].dataSize = dataSize;
+            }
+
+            for (uint32_t index = 0; index < dataCountPerProducer; index += batchDataCount)
+            {
+                if (batchDataCount == 1)
+                {
+                    while (EzPubSub::PubSubLite::PublishData(channelName, socketBuffer.data(), dataSize) == EzPubSub::Error::kNotEnoughBufferSize)
+                    {
+                        fullRetryCount.fetch_add(1, std::memory_order_relaxed);
+                        std::this_thread::yield();
+                    }
+                    continue;
+                }
+
+                while (EzPubSub::PubSubLite::PublishBatch(channelName, batchDataList.data(), batchDataCount) == EzPubSub::Error::kNotEnoughBufferSize)
+                {
+                    fullRetryCount.fetch_add(1, std::memory_order_relaxed);
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+    for (auto& producerThread : producerThreadList)
+    {
+        producerThread.join();
+    }
+    BenchClock::time_point publishedTime = BenchClock::now();
+
+    bool isDelivered = WaitReceivedDataCount(dataCount, 60000);
+    BenchClock::time_point deliveredTime = BenchClock::now();
+
+    EzPubSub::PubSubLite::DeleteChannel(channelName);
+
+    printf("publish_batch queue=%s producers=%u batch=%u data_count=%u publish_msgs_per_sec=%.0f deliver_msgs_per_sec=%.0f full_retry=%llu%s\n",
+        (queueType == EzPubSub::QueueType::kRing) ? "ring" : "list",
+        producerCount,
+        batchDataCount,
+        dataCount,
+        dataCount / ElapsedSeconds(startTime, publishedTime),
+        dataCount / ElapsedSeconds(startTime, deliveredTime),
+        static_cast<unsigned long long>(fullRetryCount.load()),
+        (isDelivered == true) ? "" : " timeout=1");
+}
+
+const uint32_t kSuiteSubscriberCount = 64;
+const uint32_t kSuiteMaxBufferedDataSize = 67108864; // 64 MB, Unit: Byte
+
+std::vector<uint64_t> gSuiteLatencyList[kSuiteSubscriberCount]; // Nanoseconds, only written by the thread firing to the subscriber.
+
+// The first 8 bytes of the published data are the publish time of a sampled data, or 0.
+template <uint32_t SubscriberIndex>
+void SuiteSubscriberCallback(_In_ const uint8_t* data, _In_ uint32_t dataSize, _In_opt_ void* userContext)
+{
+    uint64_t publishedTime = 0;
+
+    (void)userContext;
+
+    if (dataSize >= sizeof(publishedTime))
+    {
+        memcpy(&publishedTime, data, sizeof(publishedTime));
+        if (publishedTime != 0)
+        {
+            gSuiteLatencyList[SubscriberIndex].push_back(NowNanoseconds() - publishedTime);
+        }
+    }
+    gReceivedDataCount.fetch_add(1, std::memory_order_relaxed);
+}
+
+// Distinct callbacks are needed to register several subscribers to a channel.
+template <uint32_t... SubscriberIndex>
+std::vector<EzPubSub::SUBSCRIBER_CALLBACK> MakeSuiteSubscriberCallbackList(_In_ std::integer_sequence<uint32_t, SubscriberIndex...>)
+{
+    return { SuiteSubscriberCallback<SubscriberIndex>... };
+}
+
+struct SuiteCase
+{
+    const char* caseName;
+    EzPubSub::QueueType queueType;
+    EzPubSub::FireThreadType fireThreadType;
+    uint32_t channelCount;
+    uint32_t producerCount; // Each producer publishes to the channels in turn.
+    uint32_t subscriberCount; // Of each channel, channelCount * subscriberCount is at most kSuiteSubscriberCount.
+    uint32_t dataSize; // At least 8 bytes for the publish time.
+    uint32_t dataCount; // In total, for a scale of 100 percent.
+    bool isTargeted; // Each data is fired to one subscriber in turn by a subscriber mask, otherwise to every subscriber.
+    bool isChurned; // 64 KB buffer overflowed with kDropOldest, otherwise every data is delivered and publishers wait for room.
+};
+
+struct SuiteResult
+{
+    double msgsPerSec;
+    double deliveriesPerSec;
+    uint64_t lostDataCount;
+    bool isDelivered;
+};
+
+SuiteResult RunSuiteCase(_In_ const SuiteCase& suiteCase, _In_ uint32_t dataCount)
+{
+    static const std::vector<EzPubSub::SUBSCRIBER_CALLBACK> kSubscriberCallbackList =
+        MakeSuiteSubscriberCallbackList(std::make_integer_sequence<uint32_t, kSuiteSubscriberCount>());
+    EzPubSub::ChannelOption channelOption;
+    std::vector<std::wstring> channelNameList;
+    std::vector<std::vector<EzPubSub::SubscriberMask>> fireSubscriberMaskList(suiteCase.channelCount);
+    std::vector<std::thread> producerThreadList;
+    std::atomic<uint64_t> acceptedDataCount(0);
+    uint32_t dataCountPerProducer = dataCount / suiteCase.producerCount;
+    // Reading the clock costs more than publishing small data, so one in 16 small data is timed.
+    uint32_t sampleInterval = (suiteCase.dataSize >= 4096) ? 1 : 16;
+    uint32_t subscriberId = 0;
+    uint64_t lostDataCount = 0;
+    uint64_t expectedDataCount = 0;
+    SuiteResult suiteResult;
+
+    dataCount = dataCountPerProducer * suiteCase.producerCount;
+
+    channelOption.fireMode = EzPubSub::FireMode::kEvent;
+    channelOption.queueType = suiteCase.queueType;
+    channelOption.fireThreadType = suiteCase.fireThreadType;
+    if (suiteCase.isChurned == true)
+    {
+        channelOption.maxBufferedDataSize = 65536;
+        channelOption.overflowPolicy = EzPubSub::OverflowPolicy::kDropOldest;
+    }
+    else
+    {
+        channelOption.maxBufferedDataSize = static_cast<uint32_t>(std::min<uint64_t>(kSuiteMaxBufferedDataSize, static_cast<uint64_t>(dataCount) * suiteCase.dataSize));
+        channelOption.overflowPolicy = EzPubSub::OverflowPolicy::kBlock;
+    }
+    for (uint32_t channelIndex = 0; channelIndex < suiteCase.channelCount; channelIndex++)
+    {
+        channelNameList.push_back(L"BenchSuite" + std::to_wstring(channelIndex));
+        EzPubSub::PubSubLite::CreateChannel(channelNameList[channelIndex], channelOption);
+        for (uint32_t subscriberIndex = 0; subscriberIndex < suiteCase.subscriberCount; subscriberIndex++)
+        {
+            EzPubSub::PubSubLite::RegisterSubscriber(
+                channelNameList[channelIndex],
+                kSubscriberCallbackList[channelIndex * suiteCase.subscriberCount + subscriberIndex],
+                &subscriberId
+            );
+            fireSubscriberMaskList[channelIndex].emplace_back();
+            fireSubscriberMaskList[channelIndex].back().Clear();
+            fireSubscriberMaskList[channelIndex].back().Set(subscriberId);
+        }
+    }
+
+    gReceivedDataCount.store(0);
+    for (auto& latencyList : gSuiteLatencyList)
+    {
+        latencyList.clear();
+    }
+
+    BenchClock::time_point startTime = BenchClock::now();
+    for (uint32_t producerIndex = 0; producerIndex < suiteCase.producerCount; producerIndex++)
+    {
+        producerThreadList.emplace_back([&suiteCase, &channelNameList, &fireSubscriberMaskList, &acceptedDataCount, producerIndex, dataCountPerProducer, sampleInterval]()
+        {
+            std::vector<uint8_t> publishData(suiteCase.dataSize, 0x5A);
+            uint64_t publishedTime = 0;
+            uint32_t channelIndex = 0;
+            uint64_t producerAcceptedDataCount = 0;
+            EzPubSub::Error publishResult = EzPubSub::Error::kUnsuccess;
+
+            for (uint32_t index = 0; index < dataCountPerProducer; index++)
+            {
+                // Producers start at different channels, so that they meet on a channel only by chance.
+                channelIndex = (producerIndex + index) % suiteCase.channelCount;
+                publishedTime = ((index % sampleInterval) == 0) ? NowNanoseconds() : 0;
+                memcpy(publishData.data(), &publishedTime, sizeof(publishedTime));
+                do
+                {
+                    if (suiteCase.isTargeted == true)
+                    {
+                        publishResult = EzPubSub::PubSubLite::PublishData(
+                            channelNameList[channelIndex],
+                            publishData.data(),
+                            suiteCase.dataSize,
+                            nullptr,
+                            fireSubscriberMaskList[channelIndex][index % suiteCase.subscriberCount]
+                        );
+                    }
+                    else
+                    {
+                        publishResult = EzPubSub::PubSubLite::PublishData(channelNameList[channelIndex], publishData.data(), suiteCase.dataSize);
+                    }
+                    // A full ring rejects the data, so the producer retries until the fire thread makes room.
+                } while ((publishResult == EzPubSub::Error::kNotEnoughBufferSize) && (suiteCase.isChurned == false));
+
+                if (publishResult == EzPubSub::Error::kSuccess)
+                {
+                    producerAcceptedDataCount++;
+                }
+            }
+            acceptedDataCount.fetch_add(producerAcceptedDataCount, std::memory_order_relaxed);
+        });
+    }
+    for (auto& producerThread : producerThreadList)
+    {
+        producerThread.join();
+    }
+
+    if (suiteCase.isChurned == true)
+    {
+        // Each accepted data is delivered or lost.
+        expectedDataCount = acceptedDataCount.load() * ((suiteCase.isTargeted == true) ? 1 : suiteCase.subscriberCount);
+        BenchClock::time_point deadline = BenchClock::now() + std::chrono::milliseconds(60000);
+        suiteResult.isDelivered = false;
+        while (BenchClock::now() < deadline)
+        {
+            lostDataCount = 0;
+            for (auto& channelName : channelNameList)
+            {
+                uint64_t channelLostDataCount = 0;
+
+                EzPubSub::PubSubLite::GetLostDataCount(channelName, channelLostDataCount);
+                lostDataCount += channelLostDataCount;
+            }
+            if (gReceivedDataCount.load(std::memory_order_relaxed) + lostDataCount * ((suiteCase.isTargeted == true) ? 1 : suiteCase.subscriberCount) >= expectedDataCount)
+            {
+                suiteResult.isDelivered = true;
+                break;
+            }
+            std::this_thread::sleep_for(std::chrono::microseconds(100));
+        }
+    }
+    else
+    {
+        expectedDataCount = static_cast<uint64_t>(dataCount) * ((suiteCase.isTargeted == true) ? 1 : suiteCase.subscriberCount);
+        suiteResult.isDelivered = WaitReceivedDataCount(expectedDataCount, 60000);
+    }
+    BenchClock::time_point deliveredTime = BenchClock::now();
+
+    for (auto& channelName : channelNameList)
+    {
+        EzPubSub::PubSubLite::DeleteChannel(channelName);
+    }
+
+    suiteResult.msgsPerSec = acceptedDataCount.load() / ElapsedSeconds(startTime, deliveredTime);
+    suiteResult.deliveriesPerSec = gReceivedDataCount.load() / ElapsedSeconds(startTime, deliveredTime);
+    suiteResult.lostDataCount = lostDataCount;
+    return suiteResult;
+}
+
+/*
+    Fixed cases, each run once to warm up and then repeatCount times, printed as one line of key=value pairs.
+    msgs_per_sec is the median of the published data per second until they are delivered, and bytes_per_sec is of their data size.
+    The latency percentiles are of the sampled data of every measured run, from PublishData to each subscriber.
+    dataCountScale(Unit: Percent) scales the data count of every case, for a quick run.
+*/
+void BenchSuite(_In_ uint32_t repeatCount, _In_ uint32_t dataCountScale)
+{
+    static const SuiteCase kSuiteCaseList[] = {
+        { "producer.1",         EzPubSub::QueueType::kList, EzPubSub::FireThreadType::kDedicated, 1,  1, 1,  64,      1000000, false, false },
+        { "producer.4",         EzPubSub::QueueType::kList, EzPubSub::FireThreadType::kDedicated, 1,  4, 1,  64,      1000000, false, false },
+        { "producer.1",         EzPubSub::QueueType::kRing, EzPubSub::FireThreadType::kDedicated, 1,  1, 1,  64,      1000000, false, false },
+        { "producer.4",         EzPubSub::QueueType::kRing, EzPubSub::FireThreadType::kDedicated, 1,  4, 1,  64,      1000000, false, false },
+        { "fanout.1",           EzPubSub::QueueType::kList, EzPubSub::FireThreadType::kDedicated, 1,  1, 1,  64,      1000000, false, false },
+        { "fanout.8",           EzPubSub::QueueType::kList, EzPubSub::FireThreadType::kDedicated, 1,  1, 8,  64,      250000,  false, false },
+        { "fanout.64",          EzPubSub::QueueType::kList, EzPubSub::FireThreadType::kDedicated, 1,  1, 64, 64,      50000,   false, false },
+        { "fanout.8",           EzPubSub::QueueType::kList, EzPubSub::FireThreadType::kShared,    1,  1, 8,  64,      250000,  false, false },
+        { "fanout.64",          EzPubSub::QueueType::kList, EzPubSub::FireThreadType::kShared,    1,  1, 64, 64,      50000,   false, false },
+        { "payload.16",         EzPubSub::QueueType::kList, EzPubSub::FireThreadType::kDedicated, 1,  1, 1,  16,      1000000, false, false },
+        { "payload.256",        EzPubSub::QueueType::kList, EzPubSub::FireThreadType::kDedicated, 1,  1, 1,  256,     1000000, false, false },
+        { "payload.4096",       EzPubSub::QueueType::kList, EzPubSub::FireThreadType::kDedicated, 1,  1, 1,  4096,    65536,   false, false },
+        { "payload.65536",      EzPubSub::QueueType::kList, EzPubSub::FireThreadType::kDedicated, 1,  1, 1,  65536,   4096,    false, false },
+        { "payload.1048576",    EzPubSub::QueueType::kList, EzPubSub::FireThreadType::kDedicated, 1,  1, 1,  1048576, 512,     false, false },
+        { "payload.4194304",    EzPubSub::QueueType::kList, EzPubSub::FireThreadType::kDedicated, 1,  1, 1,  4194304, 128,     false, false },
+        { "delivery.broadcast", EzPubSub::QueueType::kList, EzPubSub::FireThreadType::kDedicated, 1,  1, 8,  64,      250000,  false, false },
+        { "delivery.targeted",  EzPubSub::QueueType::kList, EzPubSub::FireThreadType::kDedicated, 1,  1, 8,  64,      1000000, true,  false },
+        { "overflow.churn",     EzPubSub::QueueType::kList, EzPubSub::FireThreadType::kDedicated, 1,  4, 1,  256,     1000000, false, true },
+        { "overflow.churn",     EzPubSub::QueueType::kRing, EzPubSub::FireThreadType::kDedicated, 1,  4, 1,  256,     1000000, false, true },
+        { "contention.64",      EzPubSub::QueueType::kList, EzPubSub::FireThreadType::kDedicated, 64, 8, 1,  64,      2000000, false, false },
+        { "contention.64",      EzPubSub::QueueType::kList, EzPubSub::FireThreadType::kShared,    64, 8, 1,  64,      2000000, false, false }
+    };
+    std::vector<double> msgsPerSecList;
+    std::vector<uint64_t> latencyList;
+    uint32_t dataCount = 0;
+    uint64_t lostDataCount = 0;
+    bool isDelivered = true;
+    double deliveriesPerSec = 0;
+
+    printf("suite_info repeat=%u data_count_scale=%u hardware_concurrency=%u pointer_bits=%u statistics=%s\n",
+        repeatCount,
+        dataCountScale,
+        std::thread::hardware_concurrency(),
+        static_cast<uint32_t>(sizeof(void*) * 8),
+        (EzPubSub::kIsStatisticsEnabled == true) ? "on" : "off");
+
+    for (auto& suiteCase : kSuiteCaseList)
+    {
+        dataCount = static_cast<uint32_t>(std::max<uint64_t>(suiteCase.producerCount, static_cast<uint64_t>(suiteCase.dataCount) * dataCountScale / 100));
+        msgsPerSecList.clear();
+        latencyList.clear();
+        lostDataCount = 0;
+        isDelivered = true;
+        deliveriesPerSec = 0;
+
+        for (uint32_t runIndex = 0; runIndex <= repeatCount; runIndex++)
+        {
+            SuiteResult suiteResult = RunSuiteCase(suiteCase, dataCount);
+
+            // The first run warms up the data pool and the caches.
+            if (runIndex == 0)
+            {
+                continue;
+            }
+            msgsPerSecList.push_back(suiteResult.msgsPerSec);
+            deliveriesPerSec += suiteResult.deliveriesPerSec / repeatCount;
+            lostDataCount += suiteResult.lostDataCount;
+            isDelivered = isDelivered && suiteResult.isDelivered;
+            for (auto& subscriberLatencyList : gSuiteLatencyList)
+            {
+                latencyList.insert(latencyList.end(), subscriberLatencyList.begin(), subscriberLatencyList.end());
+            }
+        }
+
+        std::sort(msgsPerSecList.begin(), msgsPerSecList.end());
+        std::sort(latencyList.begin(), latencyList.end());
+        printf("suite case=%s queue=%s fire_thread=%s channels=%u producers=%u subscribers=%u delivery=%s data_size=%u data_count=%u "
+            "msgs_per_sec=%.0f msgs_per_sec_min=%.0f msgs_per_sec_max=%.0f bytes_per_sec=%.0f deliveries_per_sec=%.0f "
+            "latency_p50_ns=%llu latency_p99_ns=%llu latency_p999_ns=%llu latency_samples=%llu lost=%llu%s\n",
+            suiteCase.caseName,
+            (suiteCase.queueType == EzPubSub::QueueType::kRing) ? "ring" : "list",
+            (suiteCase.fireThreadType == EzPubSub::FireThreadType::kShared) ? "shared" : "dedicated",
+            suiteCase.channelCount,
+            suiteCase.producerCount,
+            suiteCase.subscriberCount,
+            (suiteCase.isTargeted == true) ? "targeted" : "broadcast",
+            suiteCase.dataSize,
+            dataCount,
+            msgsPerSecList[msgsPerSecList.size() / 2],
+            msgsPerSecList.front(),
+            msgsPerSecList.back(),
+            msgsPerSecList[msgsPerSecList.size() / 2] * suiteCase.dataSize,
+            deliveriesPerSec,
+            static_cast<unsigned long long>(Percentile(latencyList, 50.0)),
+            static_cast<unsigned long long>(Percentile(latencyList, 99.0)),
+            static_cast<unsigned long long>(Percentile(latencyList, 99.9)),
+            static_cast<unsigned long long>(latencyList.size()),
+            static_cast<unsigned long long>(lostDataCount),
+            (isDelivered == true) ? "" : " timeout=1");
+        fflush(stdout);
+    }
+}
+
+}
+
+int main(int argc, char* argv[])
+{
+    std::string benchName = "all";
+    uint32_t firstArgument = 0;
+    uint32_t secondArgument = 0;
+
+    if (argc > 1)
+    {
+        benchName = argv[1];
+    }
+    if (argc > 2)
+    {
+        firstArgument = static_cast<uint32_t>(strtoul(argv[2], nullptr, 10));
+    }
+    if (argc > 3)
+    {
+        secondArgument = static_cast<uint32_t>(strtoul(argv[3], nullptr, 10));
+    }
+
+    // A sleeping subscriber holds a worker, so the shared FireExecutor has more workers than processors.
+    EzPubSub::PubSubLite::SetSharedFireThreadCount(std::max<uint32_t>(4, std::thread::hardware_concurrency()));
+
+    if ((benchName == "all") || (benchName == "throughput"))
+    {
+        // throughput [dataCount] [dataSize]
+        for (uint32_t producerCount : { 1, 4 })
+        {
+            BenchPublishThroughput(EzPubSub::QueueType::kList, producerCount, (firstArgument != 0) ? firstArgument : 1000000, (secondArgument != 0) ? secondArgument : 64);
+            BenchPublishThroughput(EzPubSub::QueueType::kRing, producerCount, (firstArgument != 0) ? firstArgument : 1000000, (secondArgument != 0) ? secondArgument : 64);
+        }
+    }
+    if ((benchName == "all") || (benchName == "latency"))
+    {
+        // latency [dataCount] [intervalMicroseconds]
+        BenchFireLatency(EzPubSub::FireMode::kPolling, 1, (firstArgument != 0) ? firstArgument : 2000, (secondArgument != 0) ? secondArgument : 200);
+        BenchFireLatency(EzPubSub::FireMode::kEvent, EzPubSub::kDefaultFlushTime, (firstArgument != 0) ? firstArgument : 2000, (secondArgument != 0) ? secondArgument : 200);
+    }
+    if ((benchName == "all") || (benchName == "zerocopy"))
+    {
+        // zerocopy [dataCount] [dataSize]
+        BenchZeroCopyPublish(false, (firstArgument != 0) ? firstArgument : 1000, (secondArgument != 0) ? secondArgument : 4194304);
+        BenchZeroCopyPublish(true, (firstArgument != 0) ? firstArgument : 1000, (secondArgument != 0) ? secondArgument : 4194304);
+    }
+    if ((benchName == "all") || (benchName == "batch"))
+    {
+        // batch [dataCount]
+        for (auto queueType : { EzPubSub::QueueType::kList, EzPubSub::QueueType::kRing })
+        {
+            BenchBatchSubscriber(queueType, false, (firstArgument != 0) ? firstArgument : 1000000);
+            BenchBatchSubscriber(queueType, true, (firstArgument != 0) ? firstArgument : 1000000);
+        }
+    }
+    if ((benchName == "all") || (benchName == "targeted"))
+    {
+        // targeted [dataCount]
+        BenchTargetedPublish(false, 8, (firstArgument != 0) ? firstArgument : 1000000);
+        BenchTargetedPublish(true, 8, (firstArgument != 0) ? firstArgument : 1000000);
+    }
+    if ((benchName == "all") || (benchName == "slow"))
+    {
+        // slow [dataCount]
+        BenchSlowSubscriber(EzPubSub::FireThreadType::kDedicated, (firstArgument != 0) ? firstArgument : 5000);
+        BenchSlowSubscriber(EzPubSub::FireThreadType::kShared, (firstArgument != 0) ? firstArgument : 5000);
+    }
+    if ((benchName == "all") || (benchName == "policy"))
+    {
+        // policy [dataCount]
+        for (auto overflowPolicy : { EzPubSub::OverflowPolicy::kDropOldest, EzPubSub::OverflowPolicy::kDropNewest, EzPubSub::OverflowPolicy::kBlock })
+        {
+            BenchOverflowPolicy(overflowPolicy, (firstArgument != 0) ? firstArgument : 10000);
+        }
+    }
+    if ((benchName == "all") || (benchName == "overflow"))
+    {
+        // overflow [dataCount]
+        for (auto queueType : { EzPubSub::QueueType::kList, EzPubSub::QueueType::kRing })
+        {
+            BenchChannelOverflow(queueType, EzPubSub::OverflowPolicy::kDropOldest, (firstArgument != 0) ? firstArgument : 1000000);
+            BenchChannelOverflow(queueType, EzPubSub::OverflowPolicy::kDropNewest, (firstArgument != 0) ? firstArgument : 1000000);
+        }
+    }
+    if ((benchName == "all") || (benchName == "mode"))
+    {
+        // mode [dataCount]
+        for (auto publishMode : { EzPubSub::PublishMode::kWait, EzPubSub::PublishMode::kTry, EzPubSub::PublishMode::kAsync })
+        {
+            BenchPublishMode(publishMode, (firstArgument != 0) ? firstArgument : 5000);
+        }
+    }
+    if ((benchName == "all") || (benchName == "handle"))
+    {
+        // handle [dataCount]
+        for (auto queueType : { EzPubSub::QueueType::kList, EzPubSub::QueueType::kRing })
+        {
+            BenchChannelHandle(queueType, false, (firstArgument != 0) ? firstArgument : 1000000);
+            BenchChannelHandle(queueType, true, (firstArgument != 0) ? firstArgument : 1000000);
+        }
+    }
+    if ((benchName == "all") || (benchName == "typed"))
+    {
+        // typed [dataCount]
+        BenchTypedChannel((firstArgument != 0) ? firstArgument : 1000000);
+    }
+    if ((benchName == "all") || (benchName == "wildcard"))
+    {
+        // wildcard [dataCount]
+        BenchWildcardSubscriber(false, (firstArgument != 0) ? firstArgument : 1000000);
+        BenchWildcardSubscriber(true, (firstArgument != 0) ? firstArgument : 1000000);
+    }
+    if ((benchName == "all") || (benchName == "log"))
+    {
+        // log [dataCount] [dataSize]
+        for (auto queueType : { EzPubSub::QueueType::kList, EzPubSub::QueueType::kRing })
+        {
+            for (uint32_t logSyncDataCount : { 0u, UINT32_MAX, 10000u, 100u })
+            {
+                BenchChannelLog(queueType, logSyncDataCount, (firstArgument != 0) ? firstArgument : 1000000, (secondArgument != 0) ? secondArgument : 64);
+            }
+        }
+    }
+    if ((benchName == "all") || (benchName == "statistics"))
+    {
+        // statistics [dataCount]
+        BenchChannelStatistics((firstArgument != 0) ? firstArgument : 1000000);
+    }
+#if defined(__linux__)
+    if ((benchName == "all") || (benchName == "shm"))
+    {
+        // shm [dataCount] [dataSize]
+        BenchSharedMemory(EzPubSub::QueueType::kRing, (firstArgument != 0) ? firstArgument : 1000000, (secondArgument != 0) ? secondArgument : 64);
+        BenchSharedMemory(EzPubSub::QueueType::kSharedMemory, (firstArgument != 0) ? firstArgument : 1000000, (secondArgument != 0) ? secondArgument : 64);
+    }
+#endif
+    if ((benchName == "all") || (benchName == "coalescing"))
+    {
+        // coalescing [dataCount] [intervalMicroseconds]
+        for (auto fireThreadType : { EzPubSub::FireThreadType::kDedicated, EzPubSub::FireThreadType::kShared })
+        {
+            for (auto queueType : { EzPubSub::QueueType::kList, EzPubSub::QueueType::kRing })
+            {
+                for (uint32_t coalescedTime : { 0u, 50u, 200u, 1000u })
+                {
+                    BenchCoalescing(fireThreadType, queueType, coalescedTime, (firstArgument != 0) ? firstArgument : 40000, (secondArgument != 0) ? secondArgument : 20);
+                }
+            }
+        }
+    }
+    if ((benchName == "all") || (benchName == "priority"))
+    {
+        // priority [controlDataCount] [intervalMicroseconds]
+        for (auto fireThreadType : { EzPubSub::FireThreadType::kDedicated, EzPubSub::FireThreadType::kShared })
+        {
+            BenchPriorityLane(fireThreadType, 1, EzPubSub::LaneScheduling::kStrict, (firstArgument != 0) ? firstArgument : 2000, (secondArgument != 0) ? secondArgument : 500);
+            BenchPriorityLane(fireThreadType, 2, EzPubSub::LaneScheduling::kStrict, (firstArgument != 0) ? firstArgument : 2000, (secondArgument != 0) ? secondArgument : 500);
+            BenchPriorityLane(fireThreadType, 2, EzPubSub::LaneScheduling::kWeighted, (firstArgument != 0) ? firstArgument : 2000, (secondArgument != 0) ? secondArgument : 500);
+        }
+    }
+    if ((benchName == "all") || (benchName == "filter"))
+    {
+        // filter [dataCount]
+        for (auto queueType : { EzPubSub::QueueType::kList, EzPubSub::QueueType::kRing })
+        {
+            BenchSubscriberFilter(queueType, false, (firstArgument != 0) ? firstArgument : 1000000);
+            BenchSubscriberFilter(queueType, true, (firstArgument != 0) ? firstArgument : 1000000);
+        }
+    }
+    if ((benchName == "all") || (benchName == "conflation"))
+    {
+        // conflation [keyCount] [dataCount]
+        for (auto conflationMode : { EzPubSub::ConflationMode::kNone, EzPubSub::ConflationMode::kConflate, EzPubSub::ConflationMode::kLastValueCache })
+        {
+            BenchConflation(conflationMode, (firstArgument != 0) ? firstArgument : 64, (secondArgument != 0) ? secondArgument : 1000000);
+        }
+    }
+    if ((benchName == "all") || (benchName == "compression"))
+    {
+        // compression [dataCount] [compressionThreshold]
+        for (auto queueType : { EzPubSub::QueueType::kList, EzPubSub::QueueType::kRing })
+        {
+            BenchCompression(queueType, 0, false, (firstArgument != 0) ? firstArgument : 1000000);
+            BenchCompression(queueType, (secondArgument != 0) ? secondArgument : 128, false, (firstArgument != 0) ? firstArgument : 1000000);
+            BenchCompression(queueType, (secondArgument != 0) ? secondArgument : 128, true, (firstArgument != 0) ? firstArgument : 1000000);
+        }
+    }
+    if ((benchName == "all") || (benchName == "publishbatch"))
+    {
+        // publishbatch [dataCount] [batchDataCount]
+        for (auto queueType : { EzPubSub::QueueType::kList, EzPubSub::QueueType::kRing })
+        {
+            for (uint32_t producerCount : { 1, 4 })
+            {
+                BenchPublishBatch(queueType, producerCount, 1, (firstArgument != 0) ? firstArgument : 1000000);
+                BenchPublishBatch(queueType, producerCount, (secondArgument != 0) ? secondArgument : 16, (firstArgument != 0) ? firstArgument : 1000000);
+                BenchPublishBatch(queueType, producerCount, (secondArgument != 0) ? secondArgument * 16 : 256, (firstArgument != 0) ? firstArgument : 1000000);
+            }
+        }
+    }
+    if ((benchName == "all") || (benchName == "suite"))
+    {
+        // suite [repeatCount] [dataCountScale]
+        BenchSuite((firstArgument != 0) ? firstArgument : 5, (secondArgument != 0) ? secondArgument : 100);
+    }
+    if ((benchName == "all") || (benchName == "scaling"))
+    {
+        // scaling [maxChannelCount] [dataCountPerChannel]
+        uint32_t maxChannelCount = (firstArgument != 0) ? firstArgument : std::max<uint32_t>(8, 2 * std::thread::hardware_concurrency());
+
+        for (uint32_t channelCount = 1; channelCount <= maxChannelCount; channelCount *= 2)
+        {
+            BenchChannelScaling(EzPubSub::FireThreadType::kDedicated, channelCount, (secondArgument != 0) ? secondArgument : 200000);
+            BenchChannelScaling(EzPubSub::FireThreadType::kShared, channelCount, (secondArgument != 0) ? secondArgument : 200000);
+        }
+    }
+
+    return 0;
+}
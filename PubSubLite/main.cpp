@@ -1,6 +1,8 @@
 #include "src/PubSubLite.h"
 
 #include <iostream>
+#include <chrono>
+#include <thread>
 
 class ExtDataProcessor
 {
@@ -36,7 +38,9 @@ void SubscriberCallbackSecond(_In_ const uint8_t* data, _In_ uint32_t dataSize,
 
 int main(void)
 {
+#ifdef _MSC_VER
     _CrtSetDbgFlag(_CRTDBG_ALLOC_MEM_DF | _CRTDBG_LEAK_CHECK_DF);
+#endif
 
     std::string stringData = "teststring_";
     std::string publishData;
@@ -72,13 +76,16 @@ int main(void)
         }
     }
 
-    Sleep(10000);
+    std::this_thread::sleep_for(std::chrono::milliseconds(10000));
 
-    uint32_t firedDataCount = 0;
-    uint32_t lostDataCount = 0;
+    uint64_t firedDataCount = 0;
+    uint64_t lostDataCount = 0;
     EzPubSub::PubSubLite::GetFiredDataCount(channelName, firedDataCount);
     EzPubSub::PubSubLite::GetLostDataCount(channelName, lostDataCount);
-    printf("fired/lost/sum data count: %d %d %d \n", firedDataCount, lostDataCount, firedDataCount + lostDataCount);
+    printf("fired/lost/sum data count: %llu %llu %llu \n",
+        static_cast<unsigned long long>(firedDataCount),
+        static_cast<unsigned long long>(lostDataCount),
+        static_cast<unsigned long long>(firedDataCount + lostDataCount));
 
     //EzPubSub::PubSubLite::UnregisterSubscriber(channelName, SubscriberCallbackSecond);
     EzPubSub::PubSubLite::DeleteChannel(channelName);
@@ -0,0 +1,840 @@
+/*!
+ * \author Ezbeat, Ji Hoon Park
+ */
+
+#include "ChannelLog.h"
+#include "ChannelName.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <mutex>
+
+#if defined(__linux__)
+#include <cerrno>
+#include <cstdlib>
+#include <dirent.h>
+#include <fcntl.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace EzPubSub
+{
+
+struct ChannelLogSegment
+{
+    uint64_t baseOffset; // Offset of the first record.
+    int fileHandle;
+    uint8_t* segment;
+    size_t segmentSize;
+    size_t writePosition;
+    size_t syncedPosition;
+};
+
+// Followed by the data. A record is valid if its offset is the next one and its checksum matches, so the zero-filled end of a segment is not.
+struct ChannelLogRecord
+{
+    uint32_t dataSize;
+    uint32_t checksum;
+    uint64_t offset;
+};
+
+}
+
+namespace
+{
+
+const size_t kChannelLogPageSize = 4096;
+const int kChannelLogOffsetDigitCount = 20;
+const uint32_t kChannelLogCompressedFlag = 0x80000000; // Set in the data size of a record whose data is compressed by DataCodec.
+
+uint32_t GetRecordDataSize(_In_ uint32_t recordDataSize)
+{
+    return recordDataSize & ~kChannelLogCompressedFlag;
+}
+
+uint64_t GetRecordSize(_In_ uint32_t recordDataSize)
+{
+    return (sizeof(EzPubSub::ChannelLogRecord) + static_cast<uint64_t>(GetRecordDataSize(recordDataSize)) + EzPubSub::kChannelLogRecordAlignment - 1) &
+        ~static_cast<uint64_t>(EzPubSub::kChannelLogRecordAlignment - 1);
+}
+
+uint32_t GetRecordChecksum(_In_ uint64_t offset, _In_ const uint8_t* data, _In_ uint32_t recordDataSize)
+{
+    // Mixes 8 bytes per multiplication, so checking the data costs much less than copying it to the disk.
+    // The compressed flag is mixed with the size, so a record is not read as the other kind.
+    uint64_t hashValue = 0x9E3779B97F4A7C15ull ^ (offset * 0xC2B2AE3D27D4EB4Full) ^ recordDataSize;
+    uint32_t dataSize = GetRecordDataSize(recordDataSize);
+    uint64_t word = 0;
+    uint32_t index = 0;
+
+    for (index = 0; index + sizeof(word) <= dataSize; index += sizeof(word))
+    {
+        memcpy(&word, data + index, sizeof(word));
+        hashValue = (hashValue ^ word) * 0x100000001B3ull;
+        hashValue ^= hashValue >> 32;
+    }
+    if (index < dataSize)
+    {
+        word = 0;
+        memcpy(&word, data + index, dataSize - index);
+        hashValue = (hashValue ^ word) * 0x100000001B3ull;
+        hashValue ^= hashValue >> 32;
+    }
+
+    hashValue ^= hashValue >> 29;
+    hashValue *= 0xBF58476D1CE4E5B9ull;
+    hashValue ^= hashValue >> 32;
+
+    return static_cast<uint32_t>(hashValue);
+}
+
+// Returns the record at position if it is the valid record of offset, otherwise nullptr.
+const EzPubSub::ChannelLogRecord* GetValidRecord(_In_ const uint8_t* segment, _In_ size_t segmentSize, _In_ size_t position, _In_ uint64_t offset)
+{
+    const EzPubSub::ChannelLogRecord* channelLogRecord = nullptr;
+
+    if (position + sizeof(EzPubSub::ChannelLogRecord) > segmentSize)
+    {
+        return nullptr;
+    }
+
+    channelLogRecord = reinterpret_cast<const EzPubSub::ChannelLogRecord*>(segment + position);
+    if ((channelLogRecord->offset != offset) ||
+        (GetRecordSize(channelLogRecord->dataSize) > segmentSize - position) ||
+        (channelLogRecord->checksum != GetRecordChecksum(offset, reinterpret_cast<const uint8_t*>(channelLogRecord + 1), channelLogRecord->dataSize)))
+    {
+        return nullptr;
+    }
+
+    return channelLogRecord;
+}
+
+}
+
+EzPubSub::ChannelLog::ChannelLog()
+{
+    lockFileHandle_ = -1;
+    segmentSize_ = kDefaultLogSegmentSize;
+    syncDataCount_ = 0;
+    syncTime_ = 0;
+    retentionSegmentCount_ = 0;
+    retentionSize_ = 0;
+    currentSegment_ = nullptr;
+    totalSegmentSize_ = 0;
+    nextOffset_ = 0;
+    writingRecordSize_ = 0;
+    writingRecordCount_ = 0;
+    isDirectorySyncNeeded_ = false;
+    isSyncRequested_ = false;
+    isClosed_ = true;
+    syncedOffset_ = 0;
+    unloggedDataCount_ = 0;
+    syncThread_ = nullptr;
+    dataCodec_ = nullptr;
+}
+
+EzPubSub::ChannelLog::~ChannelLog()
+{
+    Close();
+}
+
+bool EzPubSub::ChannelLog::Open(
+    _In_ const std::wstring& logDirectory,
+    _In_ const std::wstring& channelName,
+    _In_ uint32_t segmentSize,
+    _In_ uint32_t syncDataCount,
+    _In_ uint32_t syncTime,
+    _In_ uint32_t retentionSegmentCount,
+    _In_ uint64_t retentionSize,
+    _In_opt_ const DataCodec* dataCodec
+)
+{
+#if defined(__linux__)
+    std::string segmentPrefix;
+    std::string segmentSuffix = ".log";
+    std::string fileName;
+    DIR* directory = nullptr;
+    struct dirent* directoryEntry = nullptr;
+    char* parsedEnd = nullptr;
+    uint64_t baseOffset = 0;
+    struct stat segmentStat;
+
+    if ((lockFileHandle_ != -1) || (logDirectory.length() == 0))
+    {
+        return false;
+    }
+
+    logDirectory_ = ConvertToUtf8(logDirectory);
+    encodedChannelName_ = EncodeChannelName(channelName);
+    segmentSize_ = std::max<uint32_t>(segmentSize, kChannelLogPageSize);
+    syncDataCount_ = syncDataCount;
+    syncTime_ = syncTime;
+    retentionSegmentCount_ = retentionSegmentCount;
+    retentionSize_ = retentionSize;
+    dataCodec_ = dataCodec;
+
+    if ((::mkdir(logDirectory_.c_str(), 0755) != 0) && (errno != EEXIST))
+    {
+        return false;
+    }
+
+    // The log is written by one process at a time.
+    lockFileHandle_ = ::open((logDirectory_ + "/" + encodedChannelName_ + ".lock").c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+    if (lockFileHandle_ == -1)
+    {
+        return false;
+    }
+    if (::flock(lockFileHandle_, LOCK_EX | LOCK_NB) != 0)
+    {
+        ::close(lockFileHandle_);
+        lockFileHandle_ = -1;
+        return false;
+    }
+
+    segmentPrefix = encodedChannelName_ + ".";
+    directory = ::opendir(logDirectory_.c_str());
+    if (directory == nullptr)
+    {
+        Close();
+        return false;
+    }
+    while ((directoryEntry = ::readdir(directory)) != nullptr)
+    {
+        fileName = directoryEntry->d_name;
+        if ((fileName.length() != segmentPrefix.length() + kChannelLogOffsetDigitCount + segmentSuffix.length()) ||
+            (fileName.compare(0, segmentPrefix.length(), segmentPrefix) != 0) ||
+            (fileName.compare(fileName.length() - segmentSuffix.length(), segmentSuffix.length(), segmentSuffix) != 0))
+        {
+            continue;
+        }
+
+        baseOffset = strtoull(fileName.c_str() + segmentPrefix.length(), &parsedEnd, 10);
+        if (parsedEnd == fileName.c_str() + segmentPrefix.length() + kChannelLogOffsetDigitCount)
+        {
+            segmentOffsetList_.push_back(baseOffset);
+            if (::stat((logDirectory_ + "/" + fileName).c_str(), &segmentStat) == 0)
+            {
+                totalSegmentSize_ += static_cast<uint64_t>(segmentStat.st_size);
+            }
+        }
+    }
+    ::closedir(directory);
+    std::sort(segmentOffsetList_.begin(), segmentOffsetList_.end());
+
+    // Only the last segment may end in the middle, the sync thread is not started yet.
+    if (((segmentOffsetList_.size() != 0) && (RecoverSegment_(segmentOffsetList_.back()) == false)) ||
+        ((segmentOffsetList_.size() == 0) && (CreateSegment_(0, 0) == false)))
+    {
+        Close();
+        return false;
+    }
+    // The retention may have been lowered since the log was written.
+    RemoveOldSegments_();
+    syncedOffset_ = nextOffset_;
+    unloggedDataCount_ = 0;
+    isClosed_ = false;
+
+    syncThread_ = new std::thread(&ChannelLog::SyncThread_, this);
+
+    return true;
+#else
+    (void)logDirectory;
+    (void)channelName;
+    (void)segmentSize;
+    (void)syncDataCount;
+    (void)syncTime;
+    (void)retentionSegmentCount;
+    (void)retentionSize;
+    (void)dataCodec;
+
+    return false;
+#endif
+}
+
+void EzPubSub::ChannelLog::Close()
+{
+#if defined(__linux__)
+    /*
+        Data appended after Close are counted as unlogged.
+        Replay and Sync may still be called, the segments are closed under syncSync_ and Replay maps them by itself.
+    */
+
+    std::vector<ChannelLogSegment*> closingSegmentList;
+
+    if (lockFileHandle_ == -1)
+    {
+        return;
+    }
+
+    appendSync_.lock();
+    isClosed_ = true;
+    syncEvent_.notify_all();
+    appendSync_.unlock();
+
+    if (syncThread_ != nullptr)
+    {
+        syncThread_->join();
+        delete syncThread_;
+        syncThread_ = nullptr;
+    }
+
+    // The log is closed by DeleteChannel, so everything published to the channel is on the disk after it.
+    Sync();
+
+    syncSync_.lock();
+    appendSync_.lock();
+    closingSegmentList.swap(retiredSegmentList_);
+    if (currentSegment_ != nullptr)
+    {
+        closingSegmentList.push_back(currentSegment_);
+        currentSegment_ = nullptr;
+    }
+    segmentOffsetList_.clear();
+    totalSegmentSize_ = 0;
+    appendSync_.unlock();
+    for (auto closingSegment : closingSegmentList)
+    {
+        CloseSegment_(closingSegment);
+    }
+    syncSync_.unlock();
+
+    ::flock(lockFileHandle_, LOCK_UN);
+    ::close(lockFileHandle_);
+    lockFileHandle_ = -1;
+#endif
+
+    return;
+}
+
+void EzPubSub::ChannelLog::BeginAppend(
+    _In_ const uint8_t* data,
+    _In_ uint32_t dataSize,
+    _In_opt_ bool isCompressed /*= false*/
+)
+{
+    ChannelLogData logData;
+
+    logData.data = data;
+    logData.dataSize = dataSize;
+    logData.isCompressed = isCompressed;
+    BeginAppend(&logData, 1);
+
+    return;
+}
+
+void EzPubSub::ChannelLog::BeginAppend(
+    _In_ const ChannelLogData* logDataList,
+    _In_ uint32_t logDataCount
+)
+{
+    uint32_t recordDataSize = 0;
+    uint64_t recordSize = 0;
+    size_t recordPosition = 0;
+    ChannelLogRecord* channelLogRecord = nullptr;
+
+    for (uint32_t index = 0; index < logDataCount; index++)
+    {
+        recordSize += GetRecordSize(logDataList[index].dataSize);
+    }
+
+    appendSync_.lock();
+    writingRecordSize_ = 0;
+    writingRecordCount_ = logDataCount;
+    if (isClosed_ == true)
+    {
+        return;
+    }
+
+    // A full segment is retired to the sync thread, which writes it to the disk and unmaps it.
+    if ((currentSegment_ == nullptr) || (currentSegment_->writePosition + recordSize > currentSegment_->segmentSize))
+    {
+        if (currentSegment_ != nullptr)
+        {
+            retiredSegmentList_.push_back(currentSegment_);
+            currentSegment_ = nullptr;
+            isSyncRequested_ = true;
+            syncEvent_.notify_one();
+        }
+
+        if (CreateSegment_(nextOffset_, recordSize) == false)
+        {
+            return;
+        }
+        RemoveOldSegments_();
+    }
+
+    // The header is written after the data, so a record is only valid once it is complete.
+    recordPosition = currentSegment_->writePosition;
+    for (uint32_t index = 0; index < logDataCount; index++)
+    {
+        recordDataSize = (logDataList[index].isCompressed == true) ? (logDataList[index].dataSize | kChannelLogCompressedFlag) : logDataList[index].dataSize;
+        channelLogRecord = reinterpret_cast<ChannelLogRecord*>(currentSegment_->segment + recordPosition);
+        memcpy(channelLogRecord + 1, logDataList[index].data, logDataList[index].dataSize);
+        channelLogRecord->dataSize = recordDataSize;
+        channelLogRecord->checksum = GetRecordChecksum(nextOffset_ + index, logDataList[index].data, recordDataSize);
+        channelLogRecord->offset = nextOffset_ + index;
+        recordPosition += static_cast<size_t>(GetRecordSize(recordDataSize));
+    }
+    writingRecordSize_ = recordSize;
+
+    return;
+}
+
+void EzPubSub::ChannelLog::EndAppend(
+    _In_ bool isAppended
+)
+{
+    size_t recordPosition = 0;
+    ChannelLogRecord* channelLogRecord = nullptr;
+
+    if ((writingRecordSize_ != 0) && (isAppended == true))
+    {
+        currentSegment_->writePosition += static_cast<size_t>(writingRecordSize_);
+        nextOffset_ += writingRecordCount_;
+        if ((syncDataCount_ != 0) && (nextOffset_ - syncedOffset_ >= syncDataCount_) && (isSyncRequested_ == false))
+        {
+            isSyncRequested_ = true;
+            syncEvent_.notify_one();
+        }
+    }
+    else if (writingRecordSize_ != 0)
+    {
+        // Not valid after a crash either, each record is cleared so that shorter records written later do not end where one of them starts.
+        recordPosition = currentSegment_->writePosition;
+        while (recordPosition < currentSegment_->writePosition + writingRecordSize_)
+        {
+            channelLogRecord = reinterpret_cast<ChannelLogRecord*>(currentSegment_->segment + recordPosition);
+            recordPosition += static_cast<size_t>(GetRecordSize(channelLogRecord->dataSize));
+            memset(channelLogRecord, 0, sizeof(ChannelLogRecord));
+        }
+    }
+    else if (isAppended == true)
+    {
+        unloggedDataCount_ += writingRecordCount_;
+    }
+    writingRecordSize_ = 0;
+    writingRecordCount_ = 0;
+    appendSync_.unlock();
+
+    return;
+}
+
+void EzPubSub::ChannelLog::Append(
+    _In_ const uint8_t* data,
+    _In_ uint32_t dataSize,
+    _In_opt_ bool isCompressed /*= false*/
+)
+{
+    BeginAppend(data, dataSize, isCompressed);
+    EndAppend(true);
+
+    return;
+}
+
+void EzPubSub::ChannelLog::Sync()
+{
+#if defined(__linux__)
+    /*
+        The ranges written since the last sync are taken under appendSync_, and written to the disk without it,
+        so publishers keep appending while a sync is in progress.
+        Retired segments and the current segment are only unmapped under syncSync_, so they stay mapped until the sync is done.
+    */
+
+    std::lock_guard<SyncLock> syncGuard(syncSync_);
+    std::vector<ChannelLogSegment*> retiredSegmentList;
+    ChannelLogSegment* syncingSegment = nullptr;
+    size_t syncStartPosition = 0;
+    size_t syncEndPosition = 0;
+    uint64_t syncingOffset = 0;
+    bool isDirectorySyncNeeded = false;
+    int directoryHandle = -1;
+
+    appendSync_.lock();
+    syncingOffset = nextOffset_;
+    if ((syncingOffset == syncedOffset_) && (retiredSegmentList_.size() == 0))
+    {
+        isSyncRequested_ = false;
+        appendSync_.unlock();
+        return;
+    }
+    retiredSegmentList.swap(retiredSegmentList_);
+    syncingSegment = currentSegment_;
+    if (syncingSegment != nullptr)
+    {
+        syncStartPosition = syncingSegment->syncedPosition & ~(kChannelLogPageSize - 1);
+        syncEndPosition = syncingSegment->writePosition;
+        syncingSegment->syncedPosition = syncEndPosition;
+    }
+    isDirectorySyncNeeded = isDirectorySyncNeeded_;
+    isDirectorySyncNeeded_ = false;
+    isSyncRequested_ = false;
+    appendSync_.unlock();
+
+    for (auto retiredSegment : retiredSegmentList)
+    {
+        CloseSegment_(retiredSegment);
+    }
+    if ((syncingSegment != nullptr) && (syncEndPosition > syncStartPosition))
+    {
+        ::msync(syncingSegment->segment + syncStartPosition, syncEndPosition - syncStartPosition, MS_SYNC);
+    }
+    if (isDirectorySyncNeeded == true)
+    {
+        // The entries of new segment files.
+        directoryHandle = ::open(logDirectory_.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+        if (directoryHandle != -1)
+        {
+            ::fsync(directoryHandle);
+            ::close(directoryHandle);
+        }
+    }
+    syncedOffset_ = syncingOffset;
+#endif
+
+    return;
+}
+
+uint64_t EzPubSub::ChannelLog::Replay(
+    _In_ uint64_t logOffset,
+    _In_ LOG_REPLAY_CALLBACK replayCallback,
+    _In_opt_ void* replayContext
+)
+{
+#if defined(__linux__)
+    /*
+        Segments are mapped again read-only, so replaying neither blocks publishers nor depends on the mappings of the log.
+        The mappings of a file share the page cache, so the data appended through the other mapping are read.
+        A segment deleted by the retention after the list is taken cannot be opened and is skipped,
+        so replaying continues from the first data of the next segment, as for logOffset older than the first segment.
+    */
+
+    std::vector<uint64_t> segmentOffsetList;
+    uint64_t endOffset = 0;
+    uint64_t recordOffset = 0;
+    size_t position = 0;
+    int segmentHandle = -1;
+    struct stat segmentStat;
+    uint8_t* segment = nullptr;
+    const ChannelLogRecord* channelLogRecord = nullptr;
+    const uint8_t* recordData = nullptr;
+    uint32_t dataSize = 0;
+    DataCodec defaultDataCodec;
+    const DataCodec* dataCodec = (dataCodec_ != nullptr) ? dataCodec_ : &defaultDataCodec;
+    std::vector<uint8_t> decompressedData;
+
+    appendSync_.lock();
+    segmentOffsetList = segmentOffsetList_;
+    endOffset = nextOffset_;
+    appendSync_.unlock();
+
+    if ((segmentOffsetList.size() != 0) && (logOffset < segmentOffsetList.front()))
+    {
+        logOffset = segmentOffsetList.front();
+    }
+
+    for (size_t segmentIndex = 0; (segmentIndex < segmentOffsetList.size()) && (logOffset < endOffset); segmentIndex++)
+    {
+        if ((segmentIndex + 1 < segmentOffsetList.size()) && (segmentOffsetList[segmentIndex + 1] <= logOffset))
+        {
+            continue;
+        }
+
+        segmentHandle = ::open(GetSegmentPath_(segmentOffsetList[segmentIndex]).c_str(), O_RDONLY | O_CLOEXEC);
+        if (segmentHandle == -1)
+        {
+            continue;
+        }
+        segment = nullptr;
+        if ((::fstat(segmentHandle, &segmentStat) == 0) && (segmentStat.st_size != 0))
+        {
+            segment = static_cast<uint8_t*>(::mmap(nullptr, static_cast<size_t>(segmentStat.st_size), PROT_READ, MAP_SHARED, segmentHandle, 0));
+            segment = (segment == MAP_FAILED) ? nullptr : segment;
+        }
+        ::close(segmentHandle);
+        if (segment == nullptr)
+        {
+            continue;
+        }
+
+        position = 0;
+        recordOffset = segmentOffsetList[segmentIndex];
+        while ((recordOffset < endOffset) &&
+            ((channelLogRecord = GetValidRecord(segment, static_cast<size_t>(segmentStat.st_size), position, recordOffset)) != nullptr))
+        {
+            if (recordOffset >= logOffset)
+            {
+                // Compressed data is replayed decompressed, and skipped if it is not compressed by the dictionary of the channel.
+                recordData = reinterpret_cast<const uint8_t*>(channelLogRecord + 1);
+                dataSize = GetRecordDataSize(channelLogRecord->dataSize);
+                if ((channelLogRecord->dataSize & kChannelLogCompressedFlag) != 0)
+                {
+                    decompressedData.resize(DataCodec::GetDecompressedSize(recordData, dataSize));
+                    if (dataCodec->Decompress(recordData, dataSize, decompressedData.data(), static_cast<uint32_t>(decompressedData.size())) == true)
+                    {
+                        replayCallback(recordOffset, decompressedData.data(), static_cast<uint32_t>(decompressedData.size()), replayContext);
+                    }
+                }
+                else
+                {
+                    replayCallback(recordOffset, recordData, dataSize, replayContext);
+                }
+                logOffset = recordOffset + 1;
+            }
+            position += static_cast<size_t>(GetRecordSize(channelLogRecord->dataSize));
+            recordOffset++;
+        }
+        ::munmap(segment, static_cast<size_t>(segmentStat.st_size));
+    }
+
+    return logOffset;
+#else
+    (void)replayCallback;
+    (void)replayContext;
+
+    return logOffset;
+#endif
+}
+
+void EzPubSub::ChannelLog::GetStatistics(
+    _Out_ ChannelLogStatistics& channelLogStatistics
+)
+{
+    appendSync_.lock();
+    channelLogStatistics.firstLogOffset = (segmentOffsetList_.size() != 0) ? segmentOffsetList_.front() : nextOffset_;
+    channelLogStatistics.nextLogOffset = nextOffset_;
+    channelLogStatistics.segmentCount = static_cast<uint32_t>(segmentOffsetList_.size());
+    appendSync_.unlock();
+    channelLogStatistics.syncedLogOffset = syncedOffset_;
+    channelLogStatistics.unloggedDataCount = unloggedDataCount_;
+
+    return;
+}
+
+bool EzPubSub::ChannelLog::CreateSegment_(
+    _In_ uint64_t baseOffset,
+    _In_ uint64_t minimumSize
+)
+{
+#if defined(__linux__)
+    /*
+        The caller using this method must synchronize.
+        A segment is at least large enough for the record that did not fit.
+    */
+
+    ChannelLogSegment* channelLogSegment = new ChannelLogSegment;
+    struct stat segmentStat;
+
+    channelLogSegment->baseOffset = baseOffset;
+    channelLogSegment->segmentSize = static_cast<size_t>(std::max<uint64_t>(segmentSize_, (minimumSize + kChannelLogPageSize - 1) & ~static_cast<uint64_t>(kChannelLogPageSize - 1)));
+    channelLogSegment->writePosition = 0;
+    channelLogSegment->syncedPosition = 0;
+    channelLogSegment->segment = nullptr;
+    if ((segmentOffsetList_.size() != 0) && (segmentOffsetList_.back() == baseOffset) &&
+        (::stat(GetSegmentPath_(baseOffset).c_str(), &segmentStat) == 0))
+    {
+        // The segment is created again over an empty one, whose size is no longer counted.
+        totalSegmentSize_ -= std::min<uint64_t>(totalSegmentSize_, static_cast<uint64_t>(segmentStat.st_size));
+    }
+    channelLogSegment->fileHandle = ::open(GetSegmentPath_(baseOffset).c_str(), O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if ((channelLogSegment->fileHandle == -1) ||
+        (::ftruncate(channelLogSegment->fileHandle, static_cast<off_t>(channelLogSegment->segmentSize)) != 0))
+    {
+        if (channelLogSegment->fileHandle != -1)
+        {
+            ::close(channelLogSegment->fileHandle);
+            ::unlink(GetSegmentPath_(baseOffset).c_str());
+        }
+        delete channelLogSegment;
+        return false;
+    }
+
+    channelLogSegment->segment = static_cast<uint8_t*>(::mmap(nullptr, channelLogSegment->segmentSize, PROT_READ | PROT_WRITE, MAP_SHARED, channelLogSegment->fileHandle, 0));
+    if (channelLogSegment->segment == MAP_FAILED)
+    {
+        ::close(channelLogSegment->fileHandle);
+        ::unlink(GetSegmentPath_(baseOffset).c_str());
+        delete channelLogSegment;
+        return false;
+    }
+
+    currentSegment_ = channelLogSegment;
+    if ((segmentOffsetList_.size() == 0) || (segmentOffsetList_.back() != baseOffset))
+    {
+        segmentOffsetList_.push_back(baseOffset);
+    }
+    totalSegmentSize_ += channelLogSegment->segmentSize;
+    isDirectorySyncNeeded_ = true;
+
+    return true;
+#else
+    (void)baseOffset;
+    (void)minimumSize;
+
+    return false;
+#endif
+}
+
+bool EzPubSub::ChannelLog::RecoverSegment_(
+    _In_ uint64_t baseOffset
+)
+{
+#if defined(__linux__)
+    /*
+        The caller using this method must synchronize.
+        Maps the last segment and finds the end of the log, the first record that is not valid.
+        A segment cut short by a crash while it was created is extended to the segment size.
+    */
+
+    ChannelLogSegment* channelLogSegment = new ChannelLogSegment;
+    const ChannelLogRecord* channelLogRecord = nullptr;
+    struct stat segmentStat;
+
+    channelLogSegment->baseOffset = baseOffset;
+    channelLogSegment->writePosition = 0;
+    channelLogSegment->fileHandle = ::open(GetSegmentPath_(baseOffset).c_str(), O_RDWR | O_CLOEXEC);
+    if ((channelLogSegment->fileHandle == -1) || (::fstat(channelLogSegment->fileHandle, &segmentStat) != 0))
+    {
+        if (channelLogSegment->fileHandle != -1)
+        {
+            ::close(channelLogSegment->fileHandle);
+        }
+        delete channelLogSegment;
+        return false;
+    }
+
+    channelLogSegment->segmentSize = static_cast<size_t>(segmentStat.st_size);
+    if ((channelLogSegment->segmentSize < segmentSize_) &&
+        (::ftruncate(channelLogSegment->fileHandle, static_cast<off_t>(segmentSize_)) == 0))
+    {
+        totalSegmentSize_ += segmentSize_ - channelLogSegment->segmentSize;
+        channelLogSegment->segmentSize = segmentSize_;
+    }
+
+    channelLogSegment->segment = static_cast<uint8_t*>(::mmap(nullptr, channelLogSegment->segmentSize, PROT_READ | PROT_WRITE, MAP_SHARED, channelLogSegment->fileHandle, 0));
+    if (channelLogSegment->segment == MAP_FAILED)
+    {
+        ::close(channelLogSegment->fileHandle);
+        delete channelLogSegment;
+        return false;
+    }
+
+    nextOffset_ = baseOffset;
+    while ((channelLogRecord = GetValidRecord(channelLogSegment->segment, channelLogSegment->segmentSize, channelLogSegment->writePosition, nextOffset_)) != nullptr)
+    {
+        channelLogSegment->writePosition += static_cast<size_t>(GetRecordSize(channelLogRecord->dataSize));
+        nextOffset_++;
+    }
+    channelLogSegment->syncedPosition = channelLogSegment->writePosition;
+    currentSegment_ = channelLogSegment;
+
+    return true;
+#else
+    (void)baseOffset;
+
+    return false;
+#endif
+}
+
+void EzPubSub::ChannelLog::RemoveOldSegments_()
+{
+#if defined(__linux__)
+    /*
+        The caller using this method must synchronize.
+        Deletes the oldest segment files beyond retentionSegmentCount_ or retentionSize_, but never the last one, the current segment.
+        A deleted segment still retired is written to the unlinked file and unmapped by the next sync,
+        and Replay keeps reading a deleted segment it has already mapped.
+    */
+
+    std::string segmentPath;
+    struct stat segmentStat;
+    size_t removedSegmentCount = 0;
+
+    while ((segmentOffsetList_.size() - removedSegmentCount > 1) &&
+        (((retentionSegmentCount_ != 0) && (segmentOffsetList_.size() - removedSegmentCount > retentionSegmentCount_)) ||
+        ((retentionSize_ != 0) && (totalSegmentSize_ > retentionSize_))))
+    {
+        segmentPath = GetSegmentPath_(segmentOffsetList_[removedSegmentCount]);
+        // A segment file deleted by someone else is taken as a segment of segmentSize_.
+        totalSegmentSize_ -= std::min<uint64_t>(totalSegmentSize_, (::stat(segmentPath.c_str(), &segmentStat) == 0) ? static_cast<uint64_t>(segmentStat.st_size) : segmentSize_);
+        ::unlink(segmentPath.c_str());
+        removedSegmentCount++;
+    }
+    if (removedSegmentCount != 0)
+    {
+        segmentOffsetList_.erase(segmentOffsetList_.begin(), segmentOffsetList_.begin() + static_cast<std::ptrdiff_t>(removedSegmentCount));
+    }
+#endif
+
+    return;
+}
+
+void EzPubSub::ChannelLog::CloseSegment_(
+    _Inout_ ChannelLogSegment* channelLogSegment
+)
+{
+#if defined(__linux__)
+    size_t syncStartPosition = channelLogSegment->syncedPosition & ~(kChannelLogPageSize - 1);
+
+    if (channelLogSegment->writePosition > syncStartPosition)
+    {
+        ::msync(channelLogSegment->segment + syncStartPosition, channelLogSegment->writePosition - syncStartPosition, MS_SYNC);
+    }
+    ::munmap(channelLogSegment->segment, channelLogSegment->segmentSize);
+    ::close(channelLogSegment->fileHandle);
+#endif
+    delete channelLogSegment;
+
+    return;
+}
+
+std::string EzPubSub::ChannelLog::GetSegmentPath_(
+    _In_ uint64_t baseOffset
+) const
+{
+    char offsetName[32] = { 0, };
+
+    snprintf(offsetName, sizeof(offsetName), "%0*llu", kChannelLogOffsetDigitCount, static_cast<unsigned long long>(baseOffset));
+
+    return logDirectory_ + "/" + encodedChannelName_ + "." + offsetName + ".log";
+}
+
+void EzPubSub::ChannelLog::SyncThread_()
+{
+    /*
+        Syncs when Append or a full segment requests it, and syncTime after the last sync if data were appended since.
+    */
+
+    std::unique_lock<SyncLock> appendGuard(appendSync_);
+
+    while (isClosed_ == false)
+    {
+        if (isSyncRequested_ == false)
+        {
+            if (syncTime_ != 0)
+            {
+                syncEvent_.wait_for(appendGuard, std::chrono::milliseconds(syncTime_));
+            }
+            else
+            {
+                syncEvent_.wait(appendGuard);
+            }
+        }
+
+        if ((isClosed_ == true) ||
+            ((isSyncRequested_ == false) && ((syncTime_ == 0) || (nextOffset_ == syncedOffset_))))
+        {
+            continue;
+        }
+
+        appendGuard.unlock();
+        Sync();
+        appendGuard.lock();
+    }
+
+    return;
+}
@@ -0,0 +1,156 @@
+/*!
+ * \author Ezbeat, Ji Hoon Park
+ */
+
+#pragma once
+
+#include "DataCodec.h"
+#include "PubSubLiteSync.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace EzPubSub
+{
+
+const uint32_t kDefaultLogSegmentSize = 67108864; // 64 MB, Unit: Byte
+const uint32_t kChannelLogRecordAlignment = 8; // Unit: Byte
+
+// Called for each logged data by ReplayChannelLog, logOffset is the sequence of the data in the log of the channel.
+typedef void(*LOG_REPLAY_CALLBACK)(_In_ uint64_t logOffset, _In_ const uint8_t* data, _In_ uint32_t dataSize, _In_opt_ void* replayContext);
+
+struct ChannelLogStatistics
+{
+    ChannelLogStatistics()
+    {
+        firstLogOffset = 0;
+        nextLogOffset = 0;
+        syncedLogOffset = 0;
+        unloggedDataCount = 0;
+        segmentCount = 0;
+    }
+
+    uint64_t firstLogOffset; // Oldest data kept in the segment files.
+    uint64_t nextLogOffset; // Offset of the next published data.
+    uint64_t syncedLogOffset; // Data before it were written to the disk.
+    uint64_t unloggedDataCount; // Published data that could not be logged, because a segment file could not be created.
+    uint32_t segmentCount;
+};
+
+// Data of a record appended by BeginAppend of a list.
+struct ChannelLogData
+{
+    ChannelLogData()
+    {
+        data = nullptr;
+        dataSize = 0;
+        isCompressed = false;
+    }
+
+    const uint8_t* data;
+    uint32_t dataSize;
+    bool isCompressed; // data is a block compressed by DataCodec.
+};
+
+struct ChannelLogSegment;
+
+/*
+    Append-only log of the data published to a channel, in segment files of the log directory mapped into memory.
+    A segment is named "<channel name>.<offset of its first data>.log", and is filled by records of a header and the data, aligned to 8 bytes.
+    Data compressed by the channel is logged compressed, flagged in the header, and replayed decompressed.
+    A record is written into the mapping by the publisher, so it survives a crash of the process once PublishData returns,
+    and the sync thread of the log writes the mapped pages to the disk by msync, which is what survives a crash of the machine.
+    Many records are written to the disk by one sync (group commit): when syncDataCount data are appended since the last sync,
+    at the latest syncTime after data are appended, when a segment is full, and by Sync.
+    Open recovers the end of the log from the last segment, where records are checked by their offset and checksum.
+    With a retention limit, the oldest segments beyond it are deleted whole when a segment is created and by Open, never the current segment.
+    A lock file keeps other processes from opening the same log. Only supported on Linux, Open fails on the other platforms.
+*/
+class ChannelLog
+{
+public:
+    ChannelLog();
+    ~ChannelLog();
+
+    ChannelLog(const ChannelLog&) = delete;
+    ChannelLog& operator=(const ChannelLog&) = delete;
+
+    // Opens the log of channelName in logDirectory, which is created if it does not exist, and continues after the logged data.
+    // syncDataCount, syncTime(Unit: Millisecond): 0 is not used.
+    // retentionSegmentCount, retentionSize(Unit: Byte): the segments kept, 0 is not used.
+    // dataCodec decompresses the compressed data for Replay, it must outlive the log. Without it, a codec without a dictionary is used.
+    bool Open(
+        _In_ const std::wstring& logDirectory,
+        _In_ const std::wstring& channelName,
+        _In_ uint32_t segmentSize,
+        _In_ uint32_t syncDataCount,
+        _In_ uint32_t syncTime,
+        _In_ uint32_t retentionSegmentCount,
+        _In_ uint64_t retentionSize,
+        _In_opt_ const DataCodec* dataCodec
+    );
+    // Syncs the logged data and closes the segments.
+    void Close();
+
+    // BeginAppend writes the data at the end of the log and keeps the log locked, and EndAppend appends it if isAppended, or discards it.
+    // So the data is logged in the order it is buffered, and only if it is buffered.
+    // isCompressed: data is a block compressed by DataCodec.
+    void BeginAppend(_In_ const uint8_t* data, _In_ uint32_t dataSize, _In_opt_ bool isCompressed = false);
+    // Writes the records of logDataList in one segment, and EndAppend appends or discards all of them.
+    void BeginAppend(_In_ const ChannelLogData* logDataList, _In_ uint32_t logDataCount);
+    void EndAppend(_In_ bool isAppended);
+    void Append(_In_ const uint8_t* data, _In_ uint32_t dataSize, _In_opt_ bool isCompressed = false);
+
+    // Returns after the data appended so far are written to the disk. A caller finding them written by another caller returns at once.
+    void Sync();
+
+    // Calls replayCallback for the data from logOffset up to the data appended when it is called, from the calling thread.
+    // Data older than the first segment, deleted by the retention or with their segment file, are skipped,
+    // and the offset after the last replayed data is returned.
+    uint64_t Replay(_In_ uint64_t logOffset, _In_ LOG_REPLAY_CALLBACK replayCallback, _In_opt_ void* replayContext);
+    void GetStatistics(_Out_ ChannelLogStatistics& channelLogStatistics);
+
+private:
+    bool CreateSegment_(_In_ uint64_t baseOffset, _In_ uint64_t minimumSize);
+    bool RecoverSegment_(_In_ uint64_t baseOffset);
+    void RemoveOldSegments_();
+    void CloseSegment_(_Inout_ ChannelLogSegment* channelLogSegment);
+    std::string GetSegmentPath_(_In_ uint64_t baseOffset) const;
+    void SyncThread_();
+
+private:
+    std::string logDirectory_;
+    std::string encodedChannelName_;
+    int lockFileHandle_;
+    uint32_t segmentSize_;
+    uint32_t syncDataCount_;
+    uint32_t syncTime_;
+    uint32_t retentionSegmentCount_;
+    uint64_t retentionSize_;
+    const DataCodec* dataCodec_;
+
+    // Synchronizes the members below, held from BeginAppend to EndAppend.
+    SyncLock appendSync_;
+    ChannelLogSegment* currentSegment_;
+    std::vector<ChannelLogSegment*> retiredSegmentList_; // Full segments, unmapped by the next sync.
+    std::vector<uint64_t> segmentOffsetList_; // Base offsets of the segment files, in ascending order.
+    uint64_t totalSegmentSize_; // Size of the segment files.
+    uint64_t nextOffset_;
+    uint64_t writingRecordSize_; // Records written by BeginAppend, 0 if they could not be written.
+    uint32_t writingRecordCount_;
+    bool isDirectorySyncNeeded_; // A segment file was created since the last sync.
+    bool isSyncRequested_;
+    bool isClosed_;
+    std::condition_variable_any syncEvent_;
+
+    SyncLock syncSync_; // One sync at a time.
+    std::atomic<uint64_t> syncedOffset_;
+    std::atomic<uint64_t> unloggedDataCount_;
+    std::thread* syncThread_;
+};
+
+}
@@ -0,0 +1,91 @@
+/*!
+ * \author Ezbeat, Ji Hoon Park
+ */
+
+#pragma once
+
+#include "PubSubLiteSync.h"
+
+#include <cstdint>
+#include <cstdio>
+#include <functional>
+#include <string>
+
+namespace EzPubSub
+{
+
+const size_t kMaxEncodedChannelNameLength = 200; // Longer names are shortened by their hash, file names are limited to 255 bytes.
+
+inline std::string ConvertToUtf8(_In_ const std::wstring& wideString)
+{
+    std::string utf8String;
+
+    for (auto character : wideString)
+    {
+        uint32_t codePoint = static_cast<uint32_t>(character);
+
+        if (codePoint < 0x80)
+        {
+            utf8String.push_back(static_cast<char>(codePoint));
+        }
+        else if (codePoint < 0x800)
+        {
+            utf8String.push_back(static_cast<char>(0xC0 | (codePoint >> 6)));
+            utf8String.push_back(static_cast<char>(0x80 | (codePoint & 0x3F)));
+        }
+        else if (codePoint < 0x10000)
+        {
+            utf8String.push_back(static_cast<char>(0xE0 | (codePoint >> 12)));
+            utf8String.push_back(static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F)));
+            utf8String.push_back(static_cast<char>(0x80 | (codePoint & 0x3F)));
+        }
+        else
+        {
+            utf8String.push_back(static_cast<char>(0xF0 | (codePoint >> 18)));
+            utf8String.push_back(static_cast<char>(0x80 | ((codePoint >> 12) & 0x3F)));
+            utf8String.push_back(static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F)));
+            utf8String.push_back(static_cast<char>(0x80 | (codePoint & 0x3F)));
+        }
+    }
+
+    return utf8String;
+}
+
+// Channel name usable as a file name, such as a shared memory segment or a log file.
+// The UTF-8 bytes other than letters, digits, '-' and '_' are written as %XX, so different names never collide, but for a long name replaced by its hash.
+inline std::string EncodeChannelName(_In_ const std::wstring& channelName)
+{
+    const char hexDigitList[] = "0123456789ABCDEF";
+    std::string utf8Name = ConvertToUtf8(channelName);
+    std::string encodedName;
+    char hashName[32] = { 0, };
+
+    for (auto byte : utf8Name)
+    {
+        uint8_t unsignedByte = static_cast<uint8_t>(byte);
+
+        if (((unsignedByte >= '0') && (unsignedByte <= '9')) ||
+            ((unsignedByte >= 'A') && (unsignedByte <= 'Z')) ||
+            ((unsignedByte >= 'a') && (unsignedByte <= 'z')) ||
+            (unsignedByte == '-') || (unsignedByte == '_'))
+        {
+            encodedName.push_back(static_cast<char>(unsignedByte));
+        }
+        else
+        {
+            encodedName.push_back('%');
+            encodedName.push_back(hexDigitList[unsignedByte >> 4]);
+            encodedName.push_back(hexDigitList[unsignedByte & 0x0F]);
+        }
+    }
+
+    if (encodedName.length() > kMaxEncodedChannelNameLength)
+    {
+        snprintf(hashName, sizeof(hashName), "%016llX", static_cast<unsigned long long>(std::hash<std::string>()(utf8Name)));
+        encodedName = encodedName.substr(0, kMaxEncodedChannelNameLength - 17) + "." + hashName;
+    }
+
+    return encodedName;
+}
+
+}
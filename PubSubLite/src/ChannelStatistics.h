@@ -0,0 +1,318 @@
+/*!
+ * \author Ezbeat, Ji Hoon Park
+ */
+
+#pragma once
+
+#include "PubSubLiteSync.h"
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace EzPubSub
+{
+
+// Statistics other than the fired and lost data count are compiled out by defining PUBSUBLITE_DISABLE_STATISTICS,
+// then GetStatisticsTime returns 0, Histogram records nothing and the snapshots of the histograms are empty.
+#if defined(PUBSUBLITE_DISABLE_STATISTICS)
+const bool kIsStatisticsEnabled = false;
+#else
+const bool kIsStatisticsEnabled = true;
+#endif
+
+const uint32_t kStatisticsSampleInterval = 16; // One in this many data published by a thread is timed to its subscribers.
+const uint32_t kHistogramSubBucketBits = 4; // Each power of two is divided into 16 buckets, so a value is kept within 1/16 of it.
+const uint32_t kHistogramSubBucketCount = 1 << kHistogramSubBucketBits;
+const uint32_t kHistogramValueBits = 40; // Larger values are recorded as the largest value, about 18 minutes in nanoseconds.
+const uint32_t kHistogramBucketCount = (kHistogramValueBits - kHistogramSubBucketBits + 1) * kHistogramSubBucketCount;
+
+// Nanoseconds of the steady clock, the time unit of the statistics.
+inline uint64_t GetStatisticsTime()
+{
+#if defined(PUBSUBLITE_DISABLE_STATISTICS)
+    return 0;
+#else
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count());
+#endif
+}
+
+// Reading the clock costs more than firing small data, so only the sampled data are timed.
+inline bool IsStatisticsSample()
+{
+#if defined(PUBSUBLITE_DISABLE_STATISTICS)
+    return false;
+#else
+    static thread_local uint32_t sampleCount = 0;
+
+    sampleCount++;
+    return ((sampleCount % kStatisticsSampleInterval) == 0);
+#endif
+}
+
+// 0 if endTime is not after startTime, such as a time that was not recorded.
+inline uint64_t GetElapsedTime(_In_ uint64_t startTime, _In_ uint64_t endTime)
+{
+    return (endTime > startTime) ? endTime - startTime : 0;
+}
+
+inline uint32_t GetHighestBitIndex(_In_ uint64_t value)
+{
+    // value must not be 0.
+#if defined(_MSC_VER)
+    unsigned long bitIndex = 0;
+
+    if (_BitScanReverse(&bitIndex, static_cast<unsigned long>(value >> 32)) != 0)
+    {
+        return static_cast<uint32_t>(bitIndex) + 32;
+    }
+    _BitScanReverse(&bitIndex, static_cast<unsigned long>(value));
+    return static_cast<uint32_t>(bitIndex);
+#else
+    return 63 - static_cast<uint32_t>(__builtin_clzll(value));
+#endif
+}
+
+/*
+    Buckets of a log-linear histogram, as HdrHistogram does.
+    Values below kHistogramSubBucketCount have a bucket each, and each larger power of two is divided into kHistogramSubBucketCount buckets.
+*/
+inline uint32_t GetHistogramBucketIndex(_In_ uint64_t value)
+{
+    uint32_t highestBitIndex = 0;
+
+    if (value < kHistogramSubBucketCount)
+    {
+        return static_cast<uint32_t>(value);
+    }
+    if (value >= (1ull << kHistogramValueBits))
+    {
+        value = (1ull << kHistogramValueBits) - 1;
+    }
+
+    highestBitIndex = GetHighestBitIndex(value);
+    return ((highestBitIndex - kHistogramSubBucketBits + 1) << kHistogramSubBucketBits) +
+        static_cast<uint32_t>((value >> (highestBitIndex - kHistogramSubBucketBits)) & (kHistogramSubBucketCount - 1));
+}
+
+// The smallest value of the bucket.
+inline uint64_t GetHistogramBucketValue(_In_ uint32_t bucketIndex)
+{
+    uint32_t highestBitIndex = 0;
+
+    if (bucketIndex < kHistogramSubBucketCount)
+    {
+        return bucketIndex;
+    }
+
+    highestBitIndex = (bucketIndex >> kHistogramSubBucketBits) + kHistogramSubBucketBits - 1;
+    return (static_cast<uint64_t>(kHistogramSubBucketCount + (bucketIndex & (kHistogramSubBucketCount - 1)))) << (highestBitIndex - kHistogramSubBucketBits);
+}
+
+struct HistogramSnapshot
+{
+    HistogramSnapshot()
+    {
+        count = 0;
+        totalValue = 0;
+        minValue = 0;
+        maxValue = 0;
+        for (auto& bucketCount : bucketCountList)
+        {
+            bucketCount = 0;
+        }
+    }
+
+    // The largest value of the bucket holding the given percentile(0 ~ 100) of the recorded values, at most maxValue.
+    uint64_t GetPercentile(_In_ double percentile) const
+    {
+        uint64_t requiredCount = 0;
+        uint64_t accumulatedCount = 0;
+        uint64_t bucketValue = 0;
+
+        if (count == 0)
+        {
+            return 0;
+        }
+
+        requiredCount = static_cast<uint64_t>(percentile / 100.0 * static_cast<double>(count) + 0.5);
+        if (requiredCount == 0)
+        {
+            requiredCount = 1;
+        }
+
+        for (uint32_t bucketIndex = 0; bucketIndex < kHistogramBucketCount; bucketIndex++)
+        {
+            accumulatedCount += bucketCountList[bucketIndex];
+            if (accumulatedCount >= requiredCount)
+            {
+                bucketValue = (bucketIndex + 1 < kHistogramBucketCount) ? GetHistogramBucketValue(bucketIndex + 1) - 1 : maxValue;
+                return (bucketValue < maxValue) ? bucketValue : maxValue;
+            }
+        }
+
+        return maxValue;
+    }
+
+    uint64_t GetMean() const
+    {
+        return (count != 0) ? totalValue / count : 0;
+    }
+
+    uint64_t count;
+    uint64_t totalValue;
+    uint64_t minValue;
+    uint64_t maxValue;
+    uint64_t bucketCountList[kHistogramBucketCount];
+};
+
+/*
+    Lock-free histogram, recorded by any thread with relaxed atomic operations.
+    A snapshot taken while values are recorded may miss the latest values, but each bucket is exact.
+*/
+class Histogram
+{
+public:
+    Histogram()
+    {
+#if !defined(PUBSUBLITE_DISABLE_STATISTICS)
+        for (auto& bucketCount : bucketCountList_)
+        {
+            bucketCount.store(0, std::memory_order_relaxed);
+        }
+        totalValue_.store(0, std::memory_order_relaxed);
+        minValue_.store(UINT64_MAX, std::memory_order_relaxed);
+        maxValue_.store(0, std::memory_order_relaxed);
+#endif
+    }
+
+    Histogram(const Histogram&) = delete;
+    Histogram& operator=(const Histogram&) = delete;
+
+    void Record(_In_ uint64_t value)
+    {
+#if !defined(PUBSUBLITE_DISABLE_STATISTICS)
+        uint64_t boundValue = 0;
+
+        // The bounds are rarely moved once values are recorded, so they are only read most of the time.
+        boundValue = minValue_.load(std::memory_order_relaxed);
+        while ((value < boundValue) && (minValue_.compare_exchange_weak(boundValue, value, std::memory_order_relaxed) == false))
+        {
+        }
+        boundValue = maxValue_.load(std::memory_order_relaxed);
+        while ((value > boundValue) && (maxValue_.compare_exchange_weak(boundValue, value, std::memory_order_relaxed) == false))
+        {
+        }
+
+        bucketCountList_[GetHistogramBucketIndex(value)].fetch_add(1, std::memory_order_relaxed);
+        totalValue_.fetch_add(value, std::memory_order_relaxed);
+#else
+        (void)value;
+#endif
+        return;
+    }
+
+    void GetSnapshot(_Out_ HistogramSnapshot& histogramSnapshot) const
+    {
+        histogramSnapshot = HistogramSnapshot();
+#if !defined(PUBSUBLITE_DISABLE_STATISTICS)
+        for (uint32_t bucketIndex = 0; bucketIndex < kHistogramBucketCount; bucketIndex++)
+        {
+            histogramSnapshot.bucketCountList[bucketIndex] = bucketCountList_[bucketIndex].load(std::memory_order_relaxed);
+            histogramSnapshot.count += histogramSnapshot.bucketCountList[bucketIndex];
+        }
+        if (histogramSnapshot.count != 0)
+        {
+            histogramSnapshot.totalValue = totalValue_.load(std::memory_order_relaxed);
+            histogramSnapshot.minValue = minValue_.load(std::memory_order_relaxed);
+            histogramSnapshot.maxValue = maxValue_.load(std::memory_order_relaxed);
+            // A value being recorded may be counted before its bound is seen.
+            if (histogramSnapshot.minValue > histogramSnapshot.maxValue)
+            {
+                histogramSnapshot.minValue = histogramSnapshot.maxValue;
+            }
+        }
+#endif
+        return;
+    }
+
+private:
+#if !defined(PUBSUBLITE_DISABLE_STATISTICS)
+    std::atomic<uint64_t> bucketCountList_[kHistogramBucketCount];
+    std::atomic<uint64_t> totalValue_;
+    std::atomic<uint64_t> minValue_;
+    std::atomic<uint64_t> maxValue_;
+#endif
+};
+
+struct SubscriberCallbackStatistics
+{
+    SubscriberCallbackStatistics()
+    {
+        subscriberId = 0;
+    }
+
+    uint32_t subscriberId;
+    HistogramSnapshot callbackTime; // Duration of the calls of the subscriber callback for sampled data, and of every batch. Unit: Nanosecond
+};
+
+struct PriorityLaneStatistics
+{
+    PriorityLaneStatistics()
+    {
+        priority = 0;
+        firedDataCount = 0;
+        lostDataCount = 0;
+        bufferedDataCount = 0;
+        bufferedDataSize = 0;
+    }
+
+    uint32_t priority;
+    uint64_t firedDataCount;
+    uint64_t lostDataCount;
+    uint64_t bufferedDataCount;
+    uint64_t bufferedDataSize; // Unit: Byte
+};
+
+// Snapshot of a channel returned by GetChannelStatistics and GetAllChannelStatistics.
+struct ChannelStatistics
+{
+    ChannelStatistics()
+    {
+        firedDataCount = 0;
+        lostDataCount = 0;
+        bufferedDataCount = 0;
+        bufferedDataSize = 0;
+        conflatedDataCount = 0;
+        lastValueCount = 0;
+        compressedDataCount = 0;
+        compressionSavedSize = 0;
+    }
+
+    std::wstring channelName;
+    uint64_t firedDataCount;
+    uint64_t lostDataCount;
+    uint64_t conflatedDataCount; // conflationMode, buffered data replaced by data of the same key, not counted as fired or lost.
+    uint64_t lastValueCount; // kLastValueCache, keys whose last data is kept.
+    uint64_t compressedDataCount; // compressionThreshold, published data that got smaller by the compression.
+    uint64_t compressionSavedSize; // Bytes the compression saved from those data, Unit: Byte
+    uint64_t bufferedDataCount; // When the snapshot is taken, without the data queued by PublishDataAsync.
+    uint64_t bufferedDataSize; // Unit: Byte
+
+    // Unit: Nanosecond
+    HistogramSnapshot deliveryLatency; // From PublishData of sampled data to the call of each subscriber, not recorded by kSharedMemory.
+    HistogramSnapshot lockWaitTime; // Acquisitions of the channel lock that had to wait for another thread.
+    // Sampled whenever buffered data is taken out to be fired.
+    HistogramSnapshot bufferedDataCountSample;
+    HistogramSnapshot bufferedDataSizeSample; // Unit: Byte
+    std::vector<SubscriberCallbackStatistics> subscriberStatisticsList; // In registration order.
+    std::vector<PriorityLaneStatistics> laneStatisticsList; // kList, each priority lane from priority 0.
+};
+
+}
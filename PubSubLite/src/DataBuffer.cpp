@@ -0,0 +1,409 @@
+/*!
+ * \author Ezbeat, Ji Hoon Park
+ */
+
+#include "DataBuffer.h"
+
+#include <cstring>
+#include <utility>
+
+namespace
+{
+
+void DeleteArrayData(_In_ uint8_t* data, _In_ uint32_t dataSize, _In_opt_ void* releaseContext)
+{
+    (void)dataSize;
+    (void)releaseContext;
+
+    delete[] data;
+}
+
+}
+
+EzPubSub::DataBuffer::DataBuffer()
+{
+    data_ = nullptr;
+    dataSize_ = 0;
+    isShared_ = false;
+    releaseCallback_ = nullptr;
+    releaseContext_ = nullptr;
+}
+
+EzPubSub::DataBuffer::DataBuffer(
+    _Inout_ std::vector<uint8_t>&& data
+) : DataBuffer()
+{
+    // Moving a vector keeps its heap memory, so data_ stays valid.
+    vectorData_ = std::move(data);
+    data_ = vectorData_.data();
+    dataSize_ = static_cast<uint32_t>(vectorData_.size());
+}
+
+EzPubSub::DataBuffer::DataBuffer(
+    _Inout_ std::unique_ptr<uint8_t[]>&& data,
+    _In_ uint32_t dataSize
+) : DataBuffer()
+{
+    data_ = data.release();
+    dataSize_ = dataSize;
+    releaseCallback_ = DeleteArrayData;
+}
+
+EzPubSub::DataBuffer::DataBuffer(
+    _In_ uint8_t* data,
+    _In_ uint32_t dataSize,
+    _In_ DATA_RELEASE_CALLBACK releaseCallback,
+    _In_opt_ void* releaseContext /*= nullptr*/
+) : DataBuffer()
+{
+    data_ = data;
+    dataSize_ = dataSize;
+    releaseCallback_ = releaseCallback;
+    releaseContext_ = releaseContext;
+}
+
+EzPubSub::DataBuffer::DataBuffer(
+    _In_ std::shared_ptr<const uint8_t> data,
+    _In_ uint32_t dataSize
+) : DataBuffer()
+{
+    data_ = const_cast<uint8_t*>(data.get());
+    dataSize_ = dataSize;
+    isShared_ = true;
+    owner_ = std::move(data);
+}
+
+EzPubSub::DataBuffer::DataBuffer(
+    _Inout_ DataBuffer&& dataBuffer
+) noexcept : DataBuffer()
+{
+    *this = std::move(dataBuffer);
+}
+
+EzPubSub::DataBuffer::~DataBuffer()
+{
+    Release();
+}
+
+EzPubSub::DataBuffer& EzPubSub::DataBuffer::operator=(
+    _Inout_ DataBuffer&& dataBuffer
+) noexcept
+{
+    if (this == &dataBuffer)
+    {
+        return *this;
+    }
+
+    Release();
+
+    data_ = dataBuffer.data_;
+    dataSize_ = dataBuffer.dataSize_;
+    isShared_ = dataBuffer.isShared_;
+    vectorData_ = std::move(dataBuffer.vectorData_);
+    owner_ = std::move(dataBuffer.owner_);
+    releaseCallback_ = dataBuffer.releaseCallback_;
+    releaseContext_ = dataBuffer.releaseContext_;
+
+    dataBuffer.data_ = nullptr;
+    dataBuffer.dataSize_ = 0;
+    dataBuffer.isShared_ = false;
+    dataBuffer.releaseCallback_ = nullptr;
+    dataBuffer.releaseContext_ = nullptr;
+
+    return *this;
+}
+
+const uint8_t* EzPubSub::DataBuffer::GetData() const
+{
+    return data_;
+}
+
+uint32_t EzPubSub::DataBuffer::GetDataSize() const
+{
+    return dataSize_;
+}
+
+uint8_t* EzPubSub::DataBuffer::GetWritableData()
+{
+    if (isShared_ == true)
+    {
+        return nullptr;
+    }
+
+    return data_;
+}
+
+void EzPubSub::DataBuffer::Release()
+{
+    // The release callback runs before owner_ is dropped, because it may belong to the owner. (DataPool)
+    if ((releaseCallback_ != nullptr) && (data_ != nullptr))
+    {
+        releaseCallback_(data_, dataSize_, releaseContext_);
+    }
+
+    data_ = nullptr;
+    dataSize_ = 0;
+    isShared_ = false;
+    releaseCallback_ = nullptr;
+    releaseContext_ = nullptr;
+    owner_.reset();
+    if (vectorData_.capacity() != 0)
+    {
+        std::vector<uint8_t>().swap(vectorData_);
+    }
+
+    return;
+}
+
+EzPubSub::DataPool::DataPool(
+    _In_ uint64_t limitSize
+)
+{
+    limitSize_ = limitSize;
+    slabSize_ = 0;
+    usedBlockSize_ = 0;
+    usedBlockCount_ = 0;
+    allocatedBlockCount_ = 0;
+    fallbackBlockCount_ = 0;
+    for (auto& freeBlock : freeBlockList_)
+    {
+        freeBlock = nullptr;
+    }
+}
+
+EzPubSub::DataPool::~DataPool()
+{
+    for (auto slab : slabList_)
+    {
+        delete[] slab;
+    }
+}
+
+bool EzPubSub::DataPool::Allocate(
+    _In_ uint32_t dataSize,
+    _Out_ DataBuffer& dataBuffer
+)
+{
+    return AllocateList(&dataSize, 1, &dataBuffer);
+}
+
+bool EzPubSub::DataPool::AllocateList(
+    _In_ const uint32_t* dataSizeList,
+    _In_ uint32_t dataCount,
+    _Out_ DataBuffer* dataBufferList
+)
+{
+    // The pool is locked once for all of the blocks, and fallback blocks are allocated after it is unlocked.
+    std::shared_ptr<DataPool> dataPool;
+    uint32_t blockClass = 0;
+    uint8_t* block = nullptr;
+
+    for (uint32_t index = 0; index < dataCount; index++)
+    {
+        dataBufferList[index].Release();
+        if (dataSizeList[index] == 0)
+        {
+            return false;
+        }
+    }
+
+    poolSync_.lock();
+    for (uint32_t index = 0; index < dataCount; index++)
+    {
+        DataBuffer& dataBuffer = dataBufferList[index];
+
+        blockClass = GetBlockClass_(dataSizeList[index]);
+        block = nullptr;
+        if (blockClass < kDataPoolBlockClassCount)
+        {
+            block = freeBlockList_[blockClass];
+            if (block != nullptr)
+            {
+                memcpy(&freeBlockList_[blockClass], block, sizeof(uint8_t*));
+            }
+            else
+            {
+                block = AllocateSlabBlock_(blockClass);
+            }
+        }
+
+        if (block != nullptr)
+        {
+            usedBlockSize_ += GetBlockSize_(blockClass);
+            dataBuffer.releaseCallback_ = ReleaseBlock_;
+        }
+        else
+        {
+            usedBlockSize_ += dataSizeList[index];
+            fallbackBlockCount_++;
+            dataBuffer.releaseCallback_ = ReleaseFallbackBlock_;
+        }
+        usedBlockCount_++;
+        allocatedBlockCount_++;
+        dataBuffer.data_ = block;
+    }
+    poolSync_.unlock();
+
+    dataPool = shared_from_this();
+    for (uint32_t index = 0; index < dataCount; index++)
+    {
+        DataBuffer& dataBuffer = dataBufferList[index];
+
+        if (dataBuffer.data_ == nullptr)
+        {
+            dataBuffer.data_ = new uint8_t[dataSizeList[index]];
+        }
+        dataBuffer.dataSize_ = dataSizeList[index];
+        dataBuffer.releaseContext_ = this;
+        dataBuffer.owner_ = dataPool;
+    }
+
+    return true;
+}
+
+void EzPubSub::DataPool::SetLimitSize(
+    _In_ uint64_t limitSize
+)
+{
+    // Slabs allocated already are kept, a smaller limit only stops new slabs.
+    poolSync_.lock();
+    limitSize_ = limitSize;
+    poolSync_.unlock();
+
+    return;
+}
+
+void EzPubSub::DataPool::GetStatistics(
+    _Out_ DataPoolStatistics& dataPoolStatistics
+)
+{
+    poolSync_.lock();
+    dataPoolStatistics.limitSize = limitSize_;
+    dataPoolStatistics.slabSize = slabSize_;
+    dataPoolStatistics.usedBlockSize = usedBlockSize_;
+    dataPoolStatistics.usedBlockCount = usedBlockCount_;
+    dataPoolStatistics.allocatedBlockCount = allocatedBlockCount_;
+    dataPoolStatistics.fallbackBlockCount = fallbackBlockCount_;
+    poolSync_.unlock();
+
+    return;
+}
+
+void EzPubSub::DataPool::ReleaseBlock_(
+    _In_ uint8_t* data,
+    _In_ uint32_t dataSize,
+    _In_opt_ void* releaseContext
+)
+{
+    DataPool* dataPool = static_cast<DataPool*>(releaseContext);
+    uint32_t blockClass = GetBlockClass_(dataSize);
+
+    dataPool->poolSync_.lock();
+    memcpy(data, &dataPool->freeBlockList_[blockClass], sizeof(uint8_t*));
+    dataPool->freeBlockList_[blockClass] = data;
+    dataPool->usedBlockSize_ -= GetBlockSize_(blockClass);
+    dataPool->usedBlockCount_--;
+    dataPool->poolSync_.unlock();
+
+    return;
+}
+
+void EzPubSub::DataPool::ReleaseFallbackBlock_(
+    _In_ uint8_t* data,
+    _In_ uint32_t dataSize,
+    _In_opt_ void* releaseContext
+)
+{
+    DataPool* dataPool = static_cast<DataPool*>(releaseContext);
+
+    delete[] data;
+
+    dataPool->poolSync_.lock();
+    dataPool->usedBlockSize_ -= dataSize;
+    dataPool->usedBlockCount_--;
+    dataPool->poolSync_.unlock();
+
+    return;
+}
+
+uint32_t EzPubSub::DataPool::GetBlockClass_(
+    _In_ uint32_t dataSize
+)
+{
+    /*
+        Class 0 is kDataPoolMinBlockSize, and (base, base * 2] is split into 4 classes from base = kDataPoolMinBlockSize.
+        Returns kDataPoolBlockClassCount or more if dataSize is larger than the largest class.
+    */
+
+    uint32_t powerIndex = 0;
+    uint64_t baseSize = kDataPoolMinBlockSize;
+    uint64_t stepIndex = 0;
+
+    if (dataSize <= kDataPoolMinBlockSize)
+    {
+        return 0;
+    }
+
+    while ((baseSize << 1) < dataSize)
+    {
+        baseSize <<= 1;
+        powerIndex++;
+    }
+
+    // 1 ~ 4
+    stepIndex = ((dataSize - baseSize) + (baseSize / 4) - 1) / (baseSize / 4);
+    return 1 + (powerIndex * 4) + static_cast<uint32_t>(stepIndex - 1);
+}
+
+uint64_t EzPubSub::DataPool::GetBlockSize_(
+    _In_ uint32_t blockClass
+)
+{
+    uint64_t baseSize = 0;
+
+    if (blockClass == 0)
+    {
+        return kDataPoolMinBlockSize;
+    }
+
+    baseSize = static_cast<uint64_t>(kDataPoolMinBlockSize) << ((blockClass - 1) / 4);
+    return baseSize + ((baseSize / 4) * (((blockClass - 1) % 4) + 1));
+}
+
+uint8_t* EzPubSub::DataPool::AllocateSlabBlock_(
+    _In_ uint32_t blockClass
+)
+{
+    /*
+        The caller using this method must synchronize.
+        Carves a new slab into blocks of blockClass. The first block is returned and the others go to the free list.
+    */
+
+    uint64_t blockSize = GetBlockSize_(blockClass);
+    uint64_t blockCount = (blockSize < kDataPoolSlabSize) ? (kDataPoolSlabSize / blockSize) : 1;
+    uint8_t* slab = nullptr;
+
+    // A smaller slab is tried before giving up, so that a small pool is still used.
+    while ((blockCount > 1) && (slabSize_ + (blockSize * blockCount) > limitSize_))
+    {
+        blockCount /= 2;
+    }
+    if (slabSize_ + (blockSize * blockCount) > limitSize_)
+    {
+        return nullptr;
+    }
+
+    slab = new uint8_t[static_cast<size_t>(blockSize * blockCount)];
+    slabList_.push_back(slab);
+    slabSize_ += blockSize * blockCount;
+
+    for (uint64_t blockIndex = blockCount - 1; blockIndex > 0; blockIndex--)
+    {
+        uint8_t* block = slab + (blockSize * blockIndex);
+
+        memcpy(block, &freeBlockList_[blockClass], sizeof(uint8_t*));
+        freeBlockList_[blockClass] = block;
+    }
+
+    return slab;
+}
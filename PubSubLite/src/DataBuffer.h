@@ -0,0 +1,130 @@
+/*!
+ * \author Ezbeat, Ji Hoon Park
+ */
+
+#pragma once
+
+#include "PubSubLiteSync.h"
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace EzPubSub
+{
+
+const uint32_t kDataPoolMinBlockSize = 64; // Unit: Byte
+const uint32_t kDataPoolBlockClassCount = 81; // 64 Byte ~ 64 MB, 4 classes per power of two.
+const uint32_t kDataPoolSlabSize = 1048576; // 1 MB, Unit: Byte
+
+typedef void(*DATA_RELEASE_CALLBACK)(_In_ uint8_t* data, _In_ uint32_t dataSize, _In_opt_ void* releaseContext);
+
+/*
+    Published data whose memory is owned by the channel until every subscriber is fired.
+    The memory is moved in, never copied, and it is released when the DataBuffer is destroyed:
+    - std::vector<uint8_t>: moved in.
+    - std::unique_ptr<uint8_t[]>: deleted by delete[].
+    - Raw pointer and DATA_RELEASE_CALLBACK: the callback is called with the data, data size and release context.
+    - std::shared_ptr<const uint8_t>: the reference is dropped, so the same data can be published to several channels.
+    - Copied by PubSubLite::PublishData or reserved by PubSubLite::ReserveData: returned to the data pool of the channel.
+*/
+class DataBuffer
+{
+public:
+    DataBuffer();
+    DataBuffer(_Inout_ std::vector<uint8_t>&& data);
+    DataBuffer(_Inout_ std::unique_ptr<uint8_t[]>&& data, _In_ uint32_t dataSize);
+    DataBuffer(_In_ uint8_t* data, _In_ uint32_t dataSize, _In_ DATA_RELEASE_CALLBACK releaseCallback, _In_opt_ void* releaseContext = nullptr);
+    DataBuffer(_In_ std::shared_ptr<const uint8_t> data, _In_ uint32_t dataSize);
+    DataBuffer(_Inout_ DataBuffer&& dataBuffer) noexcept;
+    ~DataBuffer();
+
+    DataBuffer& operator=(_Inout_ DataBuffer&& dataBuffer) noexcept;
+
+    DataBuffer(const DataBuffer&) = delete;
+    DataBuffer& operator=(const DataBuffer&) = delete;
+
+    const uint8_t* GetData() const;
+    uint32_t GetDataSize() const;
+    // nullptr if the data is shared, because other owners may read it.
+    uint8_t* GetWritableData();
+
+    void Release();
+
+private:
+    friend class DataPool;
+
+    uint8_t* data_;
+    uint32_t dataSize_;
+    bool isShared_;
+    std::vector<uint8_t> vectorData_;
+    std::shared_ptr<const void> owner_; // Keeps shared data or the data pool alive.
+    DATA_RELEASE_CALLBACK releaseCallback_;
+    void* releaseContext_;
+};
+
+struct DataPoolStatistics
+{
+    DataPoolStatistics()
+    {
+        limitSize = 0;
+        slabSize = 0;
+        usedBlockSize = 0;
+        usedBlockCount = 0;
+        allocatedBlockCount = 0;
+        fallbackBlockCount = 0;
+        recycledDataCount = 0;
+    }
+
+    uint64_t limitSize; // Slabs are not allocated beyond this size.
+    uint64_t slabSize; // Memory allocated for slabs.
+    uint64_t usedBlockSize; // Memory of blocks handed out and not released yet, including fallback blocks.
+    uint64_t usedBlockCount;
+    uint64_t allocatedBlockCount; // Total number of blocks handed out.
+    uint64_t fallbackBlockCount; // Total number of blocks allocated by the global allocator because the pool was full.
+    uint64_t recycledDataCount; // Published data list nodes kept by the channel for reuse.
+};
+
+/*
+    Channel-owned storage of published data.
+    Blocks of 4 size classes per power of two are carved from slabs, and a released block goes to the free list of its class,
+    so published data does not go through the global allocator in steady state.
+    Slabs are never allocated beyond limitSize, which wastes at most 25% per block,
+    and blocks that do not fit are allocated by the global allocator. (fallback)
+    Any thread can allocate and release.
+*/
+class DataPool : public std::enable_shared_from_this<DataPool>
+{
+public:
+    explicit DataPool(_In_ uint64_t limitSize);
+    ~DataPool();
+
+    DataPool(const DataPool&) = delete;
+    DataPool& operator=(const DataPool&) = delete;
+
+    bool Allocate(_In_ uint32_t dataSize, _Out_ DataBuffer& dataBuffer);
+    // A block for each of dataSizeList, with one lock of the pool.
+    bool AllocateList(_In_ const uint32_t* dataSizeList, _In_ uint32_t dataCount, _Out_ DataBuffer* dataBufferList);
+    void SetLimitSize(_In_ uint64_t limitSize);
+    void GetStatistics(_Out_ DataPoolStatistics& dataPoolStatistics);
+
+private:
+    static void ReleaseBlock_(_In_ uint8_t* data, _In_ uint32_t dataSize, _In_opt_ void* releaseContext);
+    static void ReleaseFallbackBlock_(_In_ uint8_t* data, _In_ uint32_t dataSize, _In_opt_ void* releaseContext);
+    static uint32_t GetBlockClass_(_In_ uint32_t dataSize);
+    static uint64_t GetBlockSize_(_In_ uint32_t blockClass);
+    uint8_t* AllocateSlabBlock_(_In_ uint32_t blockClass);
+
+private:
+    SyncLock poolSync_;
+    uint64_t limitSize_;
+    uint64_t slabSize_;
+    uint64_t usedBlockSize_;
+    uint64_t usedBlockCount_;
+    uint64_t allocatedBlockCount_;
+    uint64_t fallbackBlockCount_;
+    std::vector<uint8_t*> slabList_;
+    uint8_t* freeBlockList_[kDataPoolBlockClassCount]; // Singly linked through the first bytes of each free block.
+};
+
+}
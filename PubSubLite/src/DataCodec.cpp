@@ -0,0 +1,386 @@
+/*!
+ * \author Ezbeat, Ji Hoon Park
+ */
+
+#include "DataCodec.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace
+{
+
+const uint32_t kCodecHeaderSize = 4; // Decompressed size, Unit: Byte
+const uint32_t kCodecMinMatchSize = 4; // Unit: Byte
+const uint32_t kCodecLastLiteralSize = 5; // The last bytes of the data are always literals, as LZ4 does.
+const uint32_t kCodecMatchSearchEnd = 12; // No match starts in the last bytes of the data.
+const uint32_t kCodecSkipShift = 6; // The search steps faster through data that does not match, 1 more byte per 64 bytes.
+const uint32_t kCodecLengthMask = 15; // Lengths of the token, longer lengths continue in bytes of 255.
+
+uint32_t ReadUint32(_In_ const uint8_t* data)
+{
+    uint32_t value = 0;
+
+    memcpy(&value, data, sizeof(value));
+    return value;
+}
+
+uint32_t GetCodecHash(_In_ uint32_t value)
+{
+    return (value * 2654435761u) >> (32 - EzPubSub::kCodecHashBits);
+}
+
+uint32_t GetMatchSize(_In_ const uint8_t* data, _In_ const uint8_t* matchData, _In_ uint32_t maxMatchSize)
+{
+    uint32_t matchSize = 0;
+
+    while ((matchSize < maxMatchSize) && (data[matchSize] == matchData[matchSize]))
+    {
+        matchSize++;
+    }
+
+    return matchSize;
+}
+
+// false if the length does not fit in maxCompressedSize.
+bool WriteLength(_Inout_ uint8_t* compressedData, _Inout_ uint32_t& position, _In_ uint32_t maxCompressedSize, _In_ uint32_t length)
+{
+    while (length >= 255)
+    {
+        if (position == maxCompressedSize)
+        {
+            return false;
+        }
+        compressedData[position++] = 255;
+        length -= 255;
+    }
+    if (position == maxCompressedSize)
+    {
+        return false;
+    }
+    compressedData[position++] = static_cast<uint8_t>(length);
+
+    return true;
+}
+
+bool ReadLength(_In_ const uint8_t* compressedData, _Inout_ uint32_t& position, _In_ uint32_t compressedSize, _In_ uint32_t maxLength, _Inout_ uint32_t& length)
+{
+    uint8_t lengthByte = 255;
+
+    while (lengthByte == 255)
+    {
+        if (position == compressedSize)
+        {
+            return false;
+        }
+        lengthByte = compressedData[position++];
+        length += lengthByte;
+        if (length > maxLength)
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+// Writes a sequence of literalSize literals and a match of matchSize bytes at offset, or only the literals if matchSize is 0.
+bool WriteSequence(
+    _In_ const uint8_t* literalData,
+    _In_ uint32_t literalSize,
+    _In_ uint32_t offset,
+    _In_ uint32_t matchSize,
+    _Inout_ uint8_t* compressedData,
+    _Inout_ uint32_t& position,
+    _In_ uint32_t maxCompressedSize
+)
+{
+    uint32_t matchLength = (matchSize != 0) ? matchSize - kCodecMinMatchSize : 0;
+
+    if (position == maxCompressedSize)
+    {
+        return false;
+    }
+    compressedData[position++] = static_cast<uint8_t>((std::min(literalSize, kCodecLengthMask) << 4) | std::min(matchLength, kCodecLengthMask));
+    if ((literalSize >= kCodecLengthMask) && (WriteLength(compressedData, position, maxCompressedSize, literalSize - kCodecLengthMask) == false))
+    {
+        return false;
+    }
+    if (literalSize > maxCompressedSize - position)
+    {
+        return false;
+    }
+    memcpy(compressedData + position, literalData, literalSize);
+    position += literalSize;
+
+    if (matchSize == 0)
+    {
+        return true;
+    }
+    if (maxCompressedSize - position < 2)
+    {
+        return false;
+    }
+    compressedData[position++] = static_cast<uint8_t>(offset);
+    compressedData[position++] = static_cast<uint8_t>(offset >> 8);
+    if ((matchLength >= kCodecLengthMask) && (WriteLength(compressedData, position, maxCompressedSize, matchLength - kCodecLengthMask) == false))
+    {
+        return false;
+    }
+
+    return true;
+}
+
+/*
+    Positions of the hash table of a thread are stored from a base that grows by the size of each compressed data,
+    so positions of the previous data are older than the base, and the table is not cleared for each data.
+*/
+struct CodecHashTable
+{
+    CodecHashTable()
+    {
+        memset(positionList, 0, sizeof(positionList));
+        basePosition = 1;
+    }
+
+    uint32_t positionList[EzPubSub::kCodecHashTableSize];
+    uint32_t basePosition; // positionList holds basePosition + the position in the data being compressed.
+};
+
+}
+
+EzPubSub::DataCodec::DataCodec()
+{
+}
+
+EzPubSub::DataCodec::DataCodec(
+    _In_ const std::vector<uint8_t>& dictionary
+)
+{
+    size_t dictionaryOffset = (dictionary.size() > kCodecMaxDictionarySize) ? dictionary.size() - kCodecMaxDictionarySize : 0;
+
+    dictionary_.assign(dictionary.begin() + dictionaryOffset, dictionary.end());
+    if (dictionary_.size() < kCodecMinMatchSize)
+    {
+        dictionary_.clear();
+        return;
+    }
+
+    // The later position of a hash is kept, which is closer to the data.
+    dictionaryHashTable_.assign(kCodecHashTableSize, 0);
+    for (uint32_t position = 0; position + kCodecMinMatchSize <= dictionary_.size(); position++)
+    {
+        dictionaryHashTable_[GetCodecHash(ReadUint32(dictionary_.data() + position))] = position + 1;
+    }
+}
+
+uint32_t EzPubSub::DataCodec::Compress(
+    _In_ const uint8_t* data,
+    _In_ uint32_t dataSize,
+    _Out_ uint8_t* compressedData,
+    _In_ uint32_t maxCompressedSize
+) const
+{
+    /*
+        Greedy parsing as LZ4 does: each position is looked up by the hash of its 4 bytes in the positions of the data,
+        then in the dictionary, and a match is extended as far as it goes. A match in the dictionary ends at the end of the dictionary.
+    */
+
+    static thread_local CodecHashTable codecHashTable;
+    uint32_t* positionList = codecHashTable.positionList;
+    uint32_t basePosition = 0;
+    uint32_t dictionarySize = static_cast<uint32_t>(dictionary_.size());
+    uint32_t position = 0;
+    uint32_t literalPosition = 0;
+    uint32_t compressedPosition = kCodecHeaderSize;
+    uint32_t searchEnd = 0;
+    uint32_t matchEnd = 0;
+    uint32_t value = 0;
+    uint32_t hashValue = 0;
+    uint32_t matchPosition = 0;
+    uint32_t offset = 0;
+    uint32_t matchSize = 0;
+
+    if ((data == nullptr) || (compressedData == nullptr) || (maxCompressedSize <= kCodecHeaderSize))
+    {
+        return 0;
+    }
+
+    if (dataSize >= UINT32_MAX - codecHashTable.basePosition)
+    {
+        codecHashTable = CodecHashTable();
+    }
+    basePosition = codecHashTable.basePosition;
+    codecHashTable.basePosition += dataSize + 1;
+
+    memcpy(compressedData, &dataSize, kCodecHeaderSize);
+    if (dataSize > kCodecMatchSearchEnd)
+    {
+        searchEnd = dataSize - kCodecMatchSearchEnd;
+        matchEnd = dataSize - kCodecLastLiteralSize;
+    }
+
+    while (position < searchEnd)
+    {
+        value = ReadUint32(data + position);
+        hashValue = GetCodecHash(value);
+        matchPosition = positionList[hashValue];
+        positionList[hashValue] = basePosition + position;
+        matchSize = 0;
+
+        if ((matchPosition >= basePosition) &&
+            (matchPosition - basePosition < position) &&
+            (position - (matchPosition - basePosition) <= kCodecMaxOffset) &&
+            (ReadUint32(data + matchPosition - basePosition) == value))
+        {
+            matchPosition -= basePosition;
+            offset = position - matchPosition;
+            matchSize = kCodecMinMatchSize +
+                GetMatchSize(data + position + kCodecMinMatchSize, data + matchPosition + kCodecMinMatchSize, matchEnd - position - kCodecMinMatchSize);
+        }
+        else if ((dictionarySize != 0) && (dictionaryHashTable_[hashValue] != 0))
+        {
+            matchPosition = dictionaryHashTable_[hashValue] - 1;
+            offset = position + dictionarySize - matchPosition;
+            if ((offset <= kCodecMaxOffset) && (ReadUint32(dictionary_.data() + matchPosition) == value))
+            {
+                matchSize = kCodecMinMatchSize +
+                    GetMatchSize(
+                        data + position + kCodecMinMatchSize,
+                        dictionary_.data() + matchPosition + kCodecMinMatchSize,
+                        std::min(matchEnd - position, dictionarySize - matchPosition) - kCodecMinMatchSize);
+            }
+        }
+
+        if (matchSize == 0)
+        {
+            position += 1 + ((position - literalPosition) >> kCodecSkipShift);
+            continue;
+        }
+
+        if (WriteSequence(data + literalPosition, position - literalPosition, offset, matchSize, compressedData, compressedPosition, maxCompressedSize) == false)
+        {
+            return 0;
+        }
+        position += matchSize;
+        literalPosition = position;
+    }
+
+    if (WriteSequence(data + literalPosition, dataSize - literalPosition, 0, 0, compressedData, compressedPosition, maxCompressedSize) == false)
+    {
+        return 0;
+    }
+
+    return (compressedPosition < maxCompressedSize) ? compressedPosition : 0;
+}
+
+bool EzPubSub::DataCodec::Decompress(
+    _In_ const uint8_t* compressedData,
+    _In_ uint32_t compressedSize,
+    _Out_ uint8_t* data,
+    _In_ uint32_t dataSize
+) const
+{
+    // Every length and offset is checked, a block read from a damaged log must not write out of data.
+
+    uint32_t dictionarySize = static_cast<uint32_t>(dictionary_.size());
+    uint32_t compressedPosition = kCodecHeaderSize;
+    uint32_t position = 0;
+    uint8_t token = 0;
+    uint32_t literalSize = 0;
+    uint32_t offset = 0;
+    uint32_t matchSize = 0;
+    uint32_t dictionaryMatchSize = 0;
+
+    if ((data == nullptr) || (dataSize == 0) || (GetDecompressedSize(compressedData, compressedSize) != dataSize))
+    {
+        return false;
+    }
+
+    while (true)
+    {
+        if (compressedPosition == compressedSize)
+        {
+            return false;
+        }
+        token = compressedData[compressedPosition++];
+
+        literalSize = token >> 4;
+        if ((literalSize == kCodecLengthMask) && (ReadLength(compressedData, compressedPosition, compressedSize, dataSize, literalSize) == false))
+        {
+            return false;
+        }
+        if ((literalSize > compressedSize - compressedPosition) || (literalSize > dataSize - position))
+        {
+            return false;
+        }
+        memcpy(data + position, compressedData + compressedPosition, literalSize);
+        compressedPosition += literalSize;
+        position += literalSize;
+
+        if (compressedPosition == compressedSize)
+        {
+            return (position == dataSize);
+        }
+
+        if (compressedSize - compressedPosition < 2)
+        {
+            return false;
+        }
+        offset = compressedData[compressedPosition] | (static_cast<uint32_t>(compressedData[compressedPosition + 1]) << 8);
+        compressedPosition += 2;
+        matchSize = token & kCodecLengthMask;
+        if ((matchSize == kCodecLengthMask) && (ReadLength(compressedData, compressedPosition, compressedSize, dataSize, matchSize) == false))
+        {
+            return false;
+        }
+        matchSize += kCodecMinMatchSize;
+        if ((offset == 0) || (offset > position + dictionarySize) || (matchSize > dataSize - position))
+        {
+            return false;
+        }
+
+        // A match before the data is in the end of the dictionary, and continues into the data.
+        if (offset > position)
+        {
+            dictionaryMatchSize = std::min(matchSize, offset - position);
+            memcpy(data + position, dictionary_.data() + dictionarySize - (offset - position), dictionaryMatchSize);
+            position += dictionaryMatchSize;
+            matchSize -= dictionaryMatchSize;
+        }
+        // A match that ends in the dictionary has nothing left to copy from the data.
+        if (matchSize != 0)
+        {
+            if (offset >= matchSize)
+            {
+                memcpy(data + position, data + position - offset, matchSize);
+                position += matchSize;
+            }
+            else
+            {
+                // The match overlaps the bytes it writes, a repeated pattern.
+                for (; matchSize != 0; matchSize--)
+                {
+                    data[position] = data[position - offset];
+                    position++;
+                }
+            }
+        }
+    }
+}
+
+uint32_t EzPubSub::DataCodec::GetDecompressedSize(
+    _In_ const uint8_t* compressedData,
+    _In_ uint32_t compressedSize
+)
+{
+    uint32_t dataSize = 0;
+
+    if ((compressedData == nullptr) || (compressedSize <= kCodecHeaderSize))
+    {
+        return 0;
+    }
+
+    memcpy(&dataSize, compressedData, kCodecHeaderSize);
+    return dataSize;
+}
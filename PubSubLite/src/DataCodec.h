@@ -0,0 +1,49 @@
+/*!
+ * \author Ezbeat, Ji Hoon Park
+ */
+
+#pragma once
+
+#include "PubSubLiteSync.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace EzPubSub
+{
+
+const uint32_t kCodecHashBits = 12;
+const uint32_t kCodecHashTableSize = 1 << kCodecHashBits;
+const uint32_t kCodecMaxOffset = 65535; // Matches are at most this far back, Unit: Byte
+const uint32_t kCodecMaxDictionarySize = kCodecMaxOffset; // Only the end of a larger dictionary is used.
+
+/*
+    LZ77 codec of the LZ4 block format, fast enough to compress data at publish time.
+    A compressed block is the decompressed size(4 bytes, little endian) followed by sequences of a token,
+    literals and a match of 4 bytes or more at most kCodecMaxOffset bytes back. The last sequence has only literals.
+    With a dictionary, such as sample data of the channel, matches also refer to the end of the dictionary as if it preceded the data,
+    so small data of a known format are compressed too. The same dictionary must be used to decompress.
+    Compress and Decompress can be called by any thread at the same time.
+*/
+class DataCodec
+{
+public:
+    DataCodec();
+    explicit DataCodec(_In_ const std::vector<uint8_t>& dictionary);
+
+    DataCodec(const DataCodec&) = delete;
+    DataCodec& operator=(const DataCodec&) = delete;
+
+    // Returns the compressed size, or 0 if the compressed block would not be smaller than maxCompressedSize.
+    uint32_t Compress(_In_ const uint8_t* data, _In_ uint32_t dataSize, _Out_ uint8_t* compressedData, _In_ uint32_t maxCompressedSize) const;
+    // false if compressedData is not a block of dataSize bytes compressed by a codec of the same dictionary.
+    bool Decompress(_In_ const uint8_t* compressedData, _In_ uint32_t compressedSize, _Out_ uint8_t* data, _In_ uint32_t dataSize) const;
+    // 0 if compressedData is too short to be a block.
+    static uint32_t GetDecompressedSize(_In_ const uint8_t* compressedData, _In_ uint32_t compressedSize);
+
+private:
+    std::vector<uint8_t> dictionary_;
+    std::vector<uint32_t> dictionaryHashTable_; // Position + 1 in dictionary_ of the last 4 bytes of each hash, 0 if none.
+};
+
+}
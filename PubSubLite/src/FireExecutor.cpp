@@ -0,0 +1,160 @@
+/*!
+ * \author Ezbeat, Ji Hoon Park
+ */
+
+#include "FireExecutor.h"
+
+namespace
+{
+
+// Worker of the current thread, so that a worker submits to its own queue.
+thread_local EzPubSub::FireExecutor* tCurrentExecutor = nullptr;
+thread_local uint32_t tCurrentWorkerIndex = 0;
+
+}
+
+EzPubSub::FireExecutor::FireExecutor(
+    _In_ uint32_t threadCount
+) : workerQueueList_((threadCount != 0) ? threadCount : 1)
+{
+    nextQueueIndex_ = 0;
+    pendingTaskCount_ = 0;
+    idleThreadCount_ = 0;
+    isExit_ = false;
+
+    for (uint32_t workerIndex = 0; workerIndex < workerQueueList_.size(); workerIndex++)
+    {
+        workerThreadList_.emplace_back(&FireExecutor::WorkerThread_, this, workerIndex);
+    }
+}
+
+EzPubSub::FireExecutor::~FireExecutor()
+{
+    {
+        std::lock_guard<std::mutex> idleLock(idleSync_);
+        isExit_ = true;
+        idleEvent_.notify_all();
+    }
+
+    for (auto& workerThread : workerThreadList_)
+    {
+        workerThread.join();
+    }
+}
+
+void EzPubSub::FireExecutor::Submit(
+    _In_ TASK_CALLBACK taskCallback,
+    _In_opt_ void* taskContext
+)
+{
+    uint32_t queueIndex = 0;
+    Task task;
+
+    task.taskCallback = taskCallback;
+    task.taskContext = taskContext;
+
+    if (tCurrentExecutor == this)
+    {
+        queueIndex = tCurrentWorkerIndex;
+    }
+    else
+    {
+        queueIndex = nextQueueIndex_.fetch_add(1, std::memory_order_relaxed) % static_cast<uint32_t>(workerQueueList_.size());
+    }
+
+    workerQueueList_[queueIndex].queueSync.lock();
+    workerQueueList_[queueIndex].taskList.push_back(task);
+    workerQueueList_[queueIndex].queueSync.unlock();
+
+    // Pairs with WorkerThread_, either the worker sees the pending task or we see it idle.
+    pendingTaskCount_.fetch_add(1, std::memory_order_seq_cst);
+    if (idleThreadCount_.load(std::memory_order_seq_cst) != 0)
+    {
+        std::lock_guard<std::mutex> idleLock(idleSync_);
+        idleEvent_.notify_one();
+    }
+
+    return;
+}
+
+uint32_t EzPubSub::FireExecutor::GetThreadCount() const
+{
+    return static_cast<uint32_t>(workerThreadList_.size());
+}
+
+void EzPubSub::FireExecutor::WorkerThread_(
+    _In_ uint32_t workerIndex
+)
+{
+    Task task;
+
+    tCurrentExecutor = this;
+    tCurrentWorkerIndex = workerIndex;
+
+    while (true)
+    {
+        if (PopTask_(workerIndex, task) == true)
+        {
+            pendingTaskCount_.fetch_sub(1, std::memory_order_relaxed);
+            task.taskCallback(task.taskContext);
+            continue;
+        }
+
+        std::unique_lock<std::mutex> idleLock(idleSync_);
+        if (isExit_ == true)
+        {
+            break;
+        }
+
+        idleThreadCount_.fetch_add(1, std::memory_order_seq_cst);
+        if (pendingTaskCount_.load(std::memory_order_seq_cst) == 0)
+        {
+            idleEvent_.wait(idleLock);
+        }
+        idleThreadCount_.fetch_sub(1, std::memory_order_relaxed);
+    }
+
+    tCurrentExecutor = nullptr;
+    return;
+}
+
+bool EzPubSub::FireExecutor::PopTask_(
+    _In_ uint32_t workerIndex,
+    _Out_ Task& task
+)
+{
+    /*
+        The own queue is popped from the front, so a task submitting itself again does not starve the others.
+        The other queues are stolen from the back.
+    */
+
+    uint32_t queueCount = static_cast<uint32_t>(workerQueueList_.size());
+
+    for (uint32_t queueOffset = 0; queueOffset < queueCount; queueOffset++)
+    {
+        WorkerQueue& workerQueue = workerQueueList_[(workerIndex + queueOffset) % queueCount];
+
+        workerQueue.queueSync.lock();
+        if (workerQueue.taskList.size() == 0)
+        {
+            workerQueue.queueSync.unlock();
+            continue;
+        }
+
+        if (queueOffset == 0)
+        {
+            task = workerQueue.taskList.front();
+            workerQueue.taskList.pop_front();
+        }
+        else
+        {
+            task = workerQueue.taskList.back();
+            workerQueue.taskList.pop_back();
+        }
+        workerQueue.queueSync.unlock();
+
+        return true;
+    }
+
+    return false;
+}
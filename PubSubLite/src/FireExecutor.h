@@ -0,0 +1,75 @@
+/*!
+ * \author Ezbeat, Ji Hoon Park
+ */
+
+#pragma once
+
+#include "PubSubLiteSync.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace EzPubSub
+{
+
+typedef void(*TASK_CALLBACK)(_In_opt_ void* taskContext);
+
+/*
+    Work-stealing thread pool shared by channels.
+    Each worker has its own task queue. A task submitted by a worker goes to the queue of that worker,
+    other tasks are spread over the queues round robin, and an idle worker steals from the other queues.
+    Tasks are not ordered, the submitter must order its own tasks.
+*/
+class FireExecutor
+{
+public:
+    explicit FireExecutor(_In_ uint32_t threadCount);
+    ~FireExecutor();
+
+    FireExecutor(const FireExecutor&) = delete;
+    FireExecutor& operator=(const FireExecutor&) = delete;
+
+    void Submit(_In_ TASK_CALLBACK taskCallback, _In_opt_ void* taskContext);
+    uint32_t GetThreadCount() const;
+
+private:
+    struct Task
+    {
+        Task()
+        {
+            taskCallback = nullptr;
+            taskContext = nullptr;
+        }
+
+        TASK_CALLBACK taskCallback;
+        void* taskContext;
+    };
+
+    struct alignas(kCacheLineSize) WorkerQueue
+    {
+        SyncLock queueSync;
+        std::deque<Task> taskList;
+    };
+
+    void WorkerThread_(_In_ uint32_t workerIndex);
+    bool PopTask_(_In_ uint32_t workerIndex, _Out_ Task& task);
+
+private:
+    std::vector<WorkerQueue> workerQueueList_;
+    std::vector<std::thread> workerThreadList_;
+    std::atomic<uint32_t> nextQueueIndex_;
+    std::atomic<uint64_t> pendingTaskCount_;
+
+    // Idle workers sleep until a task is submitted.
+    std::mutex idleSync_;
+    std::condition_variable idleEvent_;
+    std::atomic<uint32_t> idleThreadCount_;
+    std::atomic<bool> isExit_;
+};
+
+}
@@ -0,0 +1,199 @@
+/*!
+ * \author Ezbeat, Ji Hoon Park
+ */
+
+#pragma once
+
+#include "PubSubLiteSync.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+namespace EzPubSub
+{
+
+/*
+    Bounded lock-free multi-producer/single-consumer ring.
+    Every cell has a sequence number that tells whether it is free for the producer of a position
+    or filled for the consumer of a position, so producers only compete on tailPosition_ and
+    the consumer never writes anything a producer spins on except the cell sequence.
+*/
+template <typename T>
+class MpscRing
+{
+public:
+    explicit MpscRing(_In_ size_t capacity)
+    {
+        size_t cellCount = 2;
+
+        while (cellCount < capacity)
+        {
+            cellCount <<= 1;
+        }
+
+        cellMask_ = cellCount - 1;
+        cellList_ = new Cell[cellCount];
+        for (size_t index = 0; index < cellCount; index++)
+        {
+            cellList_[index].sequence.store(index, std::memory_order_relaxed);
+        }
+
+        headPosition_.store(0, std::memory_order_relaxed);
+        tailPosition_.store(0, std::memory_order_relaxed);
+    }
+
+    ~MpscRing()
+    {
+        delete[] cellList_;
+    }
+
+    MpscRing(const MpscRing&) = delete;
+    MpscRing& operator=(const MpscRing&) = delete;
+
+    // Any thread. If it succeeds, value is moved into the ring.
+    bool TryPush(_Inout_ T& value)
+    {
+        uint64_t tailPosition = tailPosition_.load(std::memory_order_relaxed);
+        Cell* cell = nullptr;
+        int64_t sequenceDiff = 0;
+
+        while (true)
+        {
+            cell = &cellList_[tailPosition & cellMask_];
+            sequenceDiff = static_cast<int64_t>(cell->sequence.load(std::memory_order_acquire)) - static_cast<int64_t>(tailPosition);
+            if (sequenceDiff == 0)
+            {
+                if (tailPosition_.compare_exchange_weak(tailPosition, tailPosition + 1, std::memory_order_relaxed) == true)
+                {
+                    break;
+                }
+            }
+            else if (sequenceDiff < 0)
+            {
+                // The consumer has not released this cell yet, so the ring is full.
+                return false;
+            }
+            else
+            {
+                tailPosition = tailPosition_.load(std::memory_order_relaxed);
+            }
+        }
+
+        cell->value = std::move(value);
+        cell->sequence.store(tailPosition + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Any thread. valueList is pushed to consecutive positions claimed at once, so no value of another producer goes between them.
+    // If it succeeds, all of the values are moved into the ring, otherwise none of them.
+    bool TryPushList(_Inout_ T* valueList, _In_ size_t valueCount)
+    {
+        uint64_t tailPosition = tailPosition_.load(std::memory_order_relaxed);
+        uint64_t lastPosition = 0;
+        Cell* cell = nullptr;
+        int64_t sequenceDiff = 0;
+
+        if ((valueCount == 0) || (valueCount > GetCapacity()))
+        {
+            return false;
+        }
+
+        while (true)
+        {
+            cell = &cellList_[tailPosition & cellMask_];
+            sequenceDiff = static_cast<int64_t>(cell->sequence.load(std::memory_order_acquire)) - static_cast<int64_t>(tailPosition);
+            if (sequenceDiff == 0)
+            {
+                // The consumer releases cells in order, so the last cell is free only if all of them are.
+                lastPosition = tailPosition + valueCount - 1;
+                sequenceDiff = static_cast<int64_t>(cellList_[lastPosition & cellMask_].sequence.load(std::memory_order_acquire)) - static_cast<int64_t>(lastPosition);
+                if (sequenceDiff < 0)
+                {
+                    return false;
+                }
+                if ((sequenceDiff == 0) &&
+                    (tailPosition_.compare_exchange_weak(tailPosition, tailPosition + valueCount, std::memory_order_relaxed) == true))
+                {
+                    break;
+                }
+                tailPosition = tailPosition_.load(std::memory_order_relaxed);
+            }
+            else if (sequenceDiff < 0)
+            {
+                return false;
+            }
+            else
+            {
+                tailPosition = tailPosition_.load(std::memory_order_relaxed);
+            }
+        }
+
+        for (size_t index = 0; index < valueCount; index++)
+        {
+            cell = &cellList_[(tailPosition + index) & cellMask_];
+            cell->value = std::move(valueList[index]);
+            cell->sequence.store(tailPosition + index + 1, std::memory_order_release);
+        }
+        return true;
+    }
+
+    // Consumer thread only.
+    bool TryPop(_Out_ T& value)
+    {
+        uint64_t headPosition = headPosition_.load(std::memory_order_relaxed);
+        Cell* cell = &cellList_[headPosition & cellMask_];
+
+        if (cell->sequence.load(std::memory_order_acquire) != headPosition + 1)
+        {
+            // Empty, or the producer of this position has not finished writing yet.
+            return false;
+        }
+
+        value = std::move(cell->value);
+        cell->sequence.store(headPosition + cellMask_ + 1, std::memory_order_release);
+        headPosition_.store(headPosition + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Position of the next value to pop.
+    uint64_t GetHeadPosition() const
+    {
+        return headPosition_.load(std::memory_order_acquire);
+    }
+
+    // Position of the next value to push.
+    uint64_t GetTailPosition() const
+    {
+        return tailPosition_.load(std::memory_order_acquire);
+    }
+
+    size_t GetSize() const
+    {
+        uint64_t headPosition = GetHeadPosition();
+        uint64_t tailPosition = GetTailPosition();
+
+        return (tailPosition > headPosition) ? static_cast<size_t>(tailPosition - headPosition) : 0;
+    }
+
+    size_t GetCapacity() const
+    {
+        return cellMask_ + 1;
+    }
+
+private:
+    struct Cell
+    {
+        std::atomic<uint64_t> sequence;
+        T value;
+    };
+
+    // Producers and the consumer update different cache lines.
+    alignas(kCacheLineSize) std::atomic<uint64_t> tailPosition_;
+    alignas(kCacheLineSize) std::atomic<uint64_t> headPosition_;
+    alignas(kCacheLineSize) Cell* cellList_;
+    size_t cellMask_;
+};
+
+}
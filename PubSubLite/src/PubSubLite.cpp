@@ -4,8 +4,18 @@
 
 #include "PubSubLite.h"
 
-::CRITICAL_SECTION EzPubSub::PubSubLite::channelInfoListSync_;
-std::unordered_map<std::wstring, EzPubSub::ChannelInfo> EzPubSub::PubSubLite::channelInfoList_;
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+
+std::shared_mutex EzPubSub::PubSubLite::channelInfoListSync_;
+std::unordered_map<std::wstring, EzPubSub::ChannelInfo*> EzPubSub::PubSubLite::channelInfoList_;
+EzPubSub::TopicTrie<EzPubSub::SubscriberInfo> EzPubSub::PubSubLite::wildcardSubscriberTrie_;
+uint64_t EzPubSub::PubSubLite::lastWildcardSubscriberId_ = 0;
+std::unique_ptr<EzPubSub::FireExecutor> EzPubSub::PubSubLite::sharedFireExecutor_;
+uint32_t EzPubSub::PubSubLite::sharedFireThreadCount_ = EzPubSub::kDefaultSharedFireThreadCount;
+std::unique_ptr<EzPubSub::TimerWheel> EzPubSub::PubSubLite::coalescingTimerWheel_;
+uint32_t EzPubSub::PubSubLite::sharedChannelCount_ = 0;
 
 EzPubSub::Error EzPubSub::PubSubLite::CreateChannel(
     _In_ const std::wstring& channelName,
@@ -13,554 +23,5678 @@ EzPubSub::Error EzPubSub::PubSubLite::CreateChannel(
     _In_opt_ uint32_t maxBufferedDataSize /*= kDefaultMaxBufferedDataSize*/
 )
 {
-    Error retValue = Error::kUnsuccess;
-
-    ChannelInfo channelInfo;
-
-    if (channelName.length() == 0)
-    {
-        return retValue;
-    }
+    ChannelOption channelOption;
 
-    if (channelInfoListSync_.LockCount == 0)
-    {
-        ::InitializeCriticalSectionAndSpinCount(&channelInfoListSync_, kSyncSpinCount);
-    }
+    channelOption.flushTime = flushTime;
+    channelOption.maxBufferedDataSize = maxBufferedDataSize;
 
-    channelInfo.flushTime = flushTime;
-    channelInfo.maxBufferedDataSize = maxBufferedDataSize;
-
-    ::EnterCriticalSection(&channelInfoListSync_);
-    if (SearchChannelInfo_(channelName) != channelInfoList_.end())
-    {
-        ::LeaveCriticalSection(&channelInfoListSync_);
-        retValue = Error::kExistChannel;
-        return retValue;
-    }
+    return CreateChannel(channelName, channelOption);
+}
 
-    auto insertResult = channelInfoList_.insert({ channelName, channelInfo });
-    insertResult.first->second.fireThread = new std::thread(FireThread_, &(insertResult.first->second));
-    ::LeaveCriticalSection(&channelInfoListSync_);
+EzPubSub::Error EzPubSub::PubSubLite::CreateChannel(
+    _In_ const std::wstring& channelName,
+    _In_ const ChannelOption& channelOption
+)
+{
+    ChannelHandle channelHandle;
 
-    retValue = Error::kSuccess;
-    return retValue;
+    return CreateChannel(channelName, channelOption, channelHandle);
 }
 
-EzPubSub::Error EzPubSub::PubSubLite::UpdateChannel(
+EzPubSub::Error EzPubSub::PubSubLite::CreateChannel(
     _In_ const std::wstring& channelName,
-    _In_ uint32_t flushTime,
-    _In_ uint32_t maxBufferedDataSize
+    _In_ const ChannelOption& channelOption,
+    _Out_ ChannelHandle& channelHandle
 )
 {
     Error retValue = Error::kUnsuccess;
 
-    std::unordered_map<std::wstring, ChannelInfo>::iterator channelInfoListIter;
+    ChannelInfo* channelInfo = nullptr;
+    std::vector<SubscriberInfo*> matchedSubscriberInfoList;
 
-    if (channelName.length() == 0)
+    if ((channelName.length() == 0) ||
+        ((channelOption.queueType == QueueType::kSharedMemory) && (channelOption.fireThreadType == FireThreadType::kShared)) ||
+        (channelOption.priorityLaneCount == 0) ||
+        (channelOption.priorityLaneCount > kMaxPriorityLaneCount) ||
+        ((channelOption.queueType != QueueType::kList) && (channelOption.priorityLaneCount != 1)) ||
+        ((channelOption.conflationMode != ConflationMode::kNone) &&
+            ((channelOption.queueType != QueueType::kList) || (channelOption.fireThreadType != FireThreadType::kDedicated))) ||
+        ((channelOption.compressionThreshold != 0) &&
+            ((channelOption.queueType == QueueType::kSharedMemory) || (channelOption.fireThreadType != FireThreadType::kDedicated))))
     {
         return retValue;
     }
-
-    if (channelInfoListSync_.LockCount == 0)
+    for (uint32_t priority = 0; priority < channelOption.priorityLaneCount; priority++)
     {
-        ::InitializeCriticalSectionAndSpinCount(&channelInfoListSync_, kSyncSpinCount);
+        if ((channelOption.laneScheduling == LaneScheduling::kWeighted) && (channelOption.laneWeight[priority] == 0))
+        {
+            return retValue;
+        }
     }
 
-    ::EnterCriticalSection(&channelInfoListSync_);
-    channelInfoListIter = SearchChannelInfo_(channelName);
-    if ((channelInfoListIter == channelInfoList_.end()) ||
-        (channelInfoListIter->second.fireStatus == FireStatus::kExit))
+    channelInfoListSync_.lock();
+    if (SearchChannelInfo_(channelName) != channelInfoList_.end())
     {
-        ::LeaveCriticalSection(&channelInfoListSync_);
-        retValue = Error::kNotExistChannel;
+        channelInfoListSync_.unlock();
+        retValue = Error::kExistChannel;
         return retValue;
     }
 
-    channelInfoListIter->second.flushTime = flushTime;
-    channelInfoListIter->second.maxBufferedDataSize = maxBufferedDataSize;
-    ::LeaveCriticalSection(&channelInfoListSync_);
-
-    retValue = Error::kSuccess;
-    return retValue;
-}
-
-EzPubSub::Error EzPubSub::PubSubLite::DeleteChannel(
-    _In_ const std::wstring& channelName
-)
-{
-    Error retValue = Error::kUnsuccess;
-
-    std::unordered_map<std::wstring, ChannelInfo>::iterator channelInfoListIter;
-
-    if (channelName.length() == 0)
+    // No other thread can reach the new channel until it is inserted into the list.
+    channelInfo = new ChannelInfo;
+    channelInfo->channelName = channelName;
+    channelInfo->flushTime = channelOption.flushTime;
+    channelInfo->maxBufferedDataSize = channelOption.maxBufferedDataSize;
+    channelInfo->fireMode = channelOption.fireMode;
+    channelInfo->coalescedDataCount = channelOption.coalescedDataCount;
+    channelInfo->coalescedDataSize = channelOption.coalescedDataSize;
+    channelInfo->coalescedTime = channelOption.coalescedTime;
+    channelInfo->coalescingTimer.timerCallback = CoalescingTimerCallback_;
+    channelInfo->coalescingTimer.timerContext = channelInfo;
+    channelInfo->queueType = channelOption.queueType;
+    channelInfo->priorityLaneCount = channelOption.priorityLaneCount;
+    channelInfo->laneScheduling = channelOption.laneScheduling;
+    for (uint32_t priority = 0; priority < channelInfo->priorityLaneCount; priority++)
     {
-        return retValue;
+        channelInfo->priorityLaneList[priority].weight = channelOption.laneWeight[priority];
+        channelInfo->priorityLaneList[priority].maxBufferedDataSize = channelOption.laneMaxBufferedDataSize[priority];
     }
-
-    if (channelInfoListSync_.LockCount == 0)
+    channelInfo->conflationMode = channelOption.conflationMode;
+    channelInfo->fireThreadType = channelOption.fireThreadType;
+    channelInfo->overflowPolicy = channelOption.overflowPolicy;
+    channelInfo->blockTimeout = channelOption.blockTimeout;
+    channelInfo->dataPool = std::make_shared<DataPool>(GetDataPoolLimitSize_(channelInfo->maxBufferedDataSize));
+    if (channelInfo->queueType == QueueType::kRing)
     {
-        ::InitializeCriticalSectionAndSpinCount(&channelInfoListSync_, kSyncSpinCount);
+        channelInfo->publishedDataRing = new MpscRing<PublishedData>(channelOption.ringCapacity);
     }
-
-    ::EnterCriticalSection(&channelInfoListSync_);
-    channelInfoListIter = SearchChannelInfo_(channelName);
-    if (channelInfoListIter == channelInfoList_.end())
+    else if (channelInfo->queueType == QueueType::kSharedMemory)
     {
-        ::LeaveCriticalSection(&channelInfoListSync_);
-        retValue = Error::kNotExistChannel;
-        return retValue;
+        channelInfo->sharedMemoryRing = new SharedMemoryRing;
+        if (channelInfo->sharedMemoryRing->Open(channelName, channelOption.maxBufferedDataSize) == false)
+        {
+            channelInfoListSync_.unlock();
+            delete channelInfo->sharedMemoryRing;
+            delete channelInfo;
+            return retValue;
+        }
     }
-
-    // Exit and Delete FireThread of Channel
-    if (channelInfoListIter->second.fireThread != nullptr)
+    if (channelOption.compressionThreshold != 0)
     {
-        channelInfoListIter->second.fireStatus = FireStatus::kExit;
-        ::LeaveCriticalSection(&channelInfoListSync_);
-        channelInfoListIter->second.fireThread->join();
-        ::EnterCriticalSection(&channelInfoListSync_);
-        delete channelInfoListIter->second.fireThread;
-        channelInfoListIter->second.fireThread = nullptr;
+        channelInfo->dataCodec = new DataCodec(channelOption.compressionDictionary);
+        channelInfo->compressionThreshold = channelOption.compressionThreshold;
+    }
+    if (channelOption.logDirectory.length() != 0)
+    {
+        channelInfo->channelLog = new ChannelLog;
+        if (channelInfo->channelLog->Open(
+            channelOption.logDirectory,
+            channelName,
+            channelOption.logSegmentSize,
+            channelOption.logSyncDataCount,
+            channelOption.logSyncTime,
+            channelOption.logRetentionSegmentCount,
+            channelOption.logRetentionSize,
+            channelInfo->dataCodec) == false)
+        {
+            channelInfoListSync_.unlock();
+            delete channelInfo->channelLog;
+            delete channelInfo->dataCodec;
+            delete channelInfo->publishedDataRing;
+            delete channelInfo->sharedMemoryRing;
+            delete channelInfo;
+            return retValue;
+        }
     }
-    channelInfoList_.erase(channelInfoListIter);
-    ::LeaveCriticalSection(&channelInfoListSync_);
-
-    retValue = Error::kSuccess;
-    return retValue;
-}
-
-EzPubSub::Error EzPubSub::PubSubLite::PublishData(
-    _In_ const std::wstring& channelName,
-    _In_ const uint8_t* data,
-    _In_ uint32_t dataSize,
-    _In_opt_ void* userContext /*= nullptr*/,
-    _In_opt_ const std::vector<SUBSCRIBER_CALLBACK>* fireCallbackList /*= nullptr*/
-)
-{
-    Error retValue = Error::kUnsuccess;
-
-    std::unordered_map<std::wstring, ChannelInfo>::iterator channelInfoListIter;
-    const std::vector<SUBSCRIBER_CALLBACK> emptySubscriberList;
 
-    if ((channelName.length() == 0) || (data == nullptr) || (dataSize == 0))
+    // Wildcard subscribers matching the channel name are added before FireThread starts.
+    // All of them are added or the channel is not created, as RegisterWildcardSubscriber adds a subscriber to all channels or none.
+    wildcardSubscriberTrie_.Match(channelName, matchedSubscriberInfoList);
+    for (auto matchedSubscriberInfo : matchedSubscriberInfoList)
     {
-        return retValue;
+        retValue = AddSubscriberInfo_(channelInfo, *matchedSubscriberInfo, nullptr, nullptr);
+        if (retValue != Error::kSuccess)
+        {
+            channelInfoListSync_.unlock();
+            delete channelInfo->channelLog;
+            delete channelInfo->dataCodec;
+            delete channelInfo->publishedDataRing;
+            delete channelInfo->sharedMemoryRing;
+            delete channelInfo;
+            return retValue;
+        }
     }
 
-    if (channelInfoListSync_.LockCount == 0)
+    if (channelInfo->coalescedTime != 0)
     {
-        ::InitializeCriticalSectionAndSpinCount(&channelInfoListSync_, kSyncSpinCount);
+        if (coalescingTimerWheel_ == nullptr)
+        {
+            coalescingTimerWheel_.reset(new TimerWheel);
+        }
+        channelInfo->coalescingTimerWheel = coalescingTimerWheel_.get();
     }
 
-    ::EnterCriticalSection(&channelInfoListSync_);
-    channelInfoListIter = SearchChannelInfo_(channelName);
-    if ((channelInfoListIter == channelInfoList_.end()) ||
-        (channelInfoListIter->second.fireStatus == FireStatus::kExit))
+    if (channelInfo->fireThreadType == FireThreadType::kShared)
     {
-        ::LeaveCriticalSection(&channelInfoListSync_);
-        retValue = Error::kNotExistChannel;
-        return retValue;
+        if (sharedFireExecutor_ == nullptr)
+        {
+            sharedFireExecutor_.reset(new FireExecutor((sharedFireThreadCount_ != 0) ? sharedFireThreadCount_ : std::thread::hardware_concurrency()));
+        }
+        sharedChannelCount_++;
     }
-    else if (channelInfoListIter->second.fireStatus == FireStatus::kStop)
+    else if (channelInfo->queueType == QueueType::kRing)
     {
-        ::LeaveCriticalSection(&channelInfoListSync_);
-        retValue = Error::kBeStoppedFire;
-        return retValue;
+        channelInfo->fireThread = new std::thread(FireRingThread_, channelInfo);
     }
-
-    channelInfoListIter->second.currentBufferedDataSize += dataSize;
-    if (fireCallbackList != nullptr)
+    else if (channelInfo->queueType == QueueType::kSharedMemory)
     {
-        channelInfoListIter->second.publishedDataList.push_back({ userContext, *fireCallbackList, { data , data + dataSize } });
+        channelInfo->fireThread = new std::thread(FireSharedMemoryThread_, channelInfo);
     }
     else
     {
-        channelInfoListIter->second.publishedDataList.push_back({ userContext, emptySubscriberList, { data , data + dataSize } });
+        channelInfo->fireThread = new std::thread(FireThread_, channelInfo);
     }
-    ::LeaveCriticalSection(&channelInfoListSync_);
+    channelInfoList_.insert({ channelName, channelInfo });
+    channelHandle = ChannelHandle(channelInfo);
+    channelInfoListSync_.unlock();
 
     retValue = Error::kSuccess;
     return retValue;
 }
 
-EzPubSub::Error EzPubSub::PubSubLite::RegisterSubscriber(
+EzPubSub::Error EzPubSub::PubSubLite::OpenChannel(
     _In_ const std::wstring& channelName,
-    _In_ const SUBSCRIBER_CALLBACK subscriberCallback
+    _Out_ ChannelHandle& channelHandle
 )
 {
     Error retValue = Error::kUnsuccess;
 
-    std::unordered_map<std::wstring, ChannelInfo>::iterator channelInfoListIter;
+    std::unordered_map<std::wstring, ChannelInfo*>::iterator channelInfoListIter;
 
     if (channelName.length() == 0)
     {
         return retValue;
     }
 
-    if (channelInfoListSync_.LockCount == 0)
-    {
-        ::InitializeCriticalSectionAndSpinCount(&channelInfoListSync_, kSyncSpinCount);
-    }
-
-    ::EnterCriticalSection(&channelInfoListSync_);
+    // The reference is taken under the lock of the channel list, so DeleteChannel can not release the last one in the meantime.
+    channelInfoListSync_.lock_shared();
     channelInfoListIter = SearchChannelInfo_(channelName);
-    if ((channelInfoListIter == channelInfoList_.end()) ||
-        (channelInfoListIter->second.fireStatus == FireStatus::kExit))
+    if (channelInfoListIter == channelInfoList_.end())
     {
-        ::LeaveCriticalSection(&channelInfoListSync_);
+        channelInfoListSync_.unlock_shared();
         retValue = Error::kNotExistChannel;
         return retValue;
     }
+    channelHandle = ChannelHandle(channelInfoListIter->second);
+    channelInfoListSync_.unlock_shared();
+
+    retValue = Error::kSuccess;
+    return retValue;
+}
+
+EzPubSub::Error EzPubSub::PubSubLite::UpdateChannel(
+    _In_ const std::wstring& channelName,
+    _In_ uint32_t flushTime,
+    _In_ uint32_t maxBufferedDataSize
+)
+{
+    Error retValue = Error::kUnsuccess;
 
-    if (SearchSubscriberCallback_(channelInfoListIter->second, subscriberCallback) !=
-        channelInfoListIter->second.subscriberCallbackList.end())
+    if (channelName.length() == 0)
     {
-        ::LeaveCriticalSection(&channelInfoListSync_);
-        retValue = Error::kExistSubscriber;
         return retValue;
     }
 
-    channelInfoListIter->second.subscriberCallbackList.push_back(subscriberCallback);
-    ::LeaveCriticalSection(&channelInfoListSync_);
-
-    retValue = Error::kSuccess;
+    retValue = UpdateChannel_(channelName, flushTime, maxBufferedDataSize, nullptr);
     return retValue;
 }
 
-EzPubSub::Error EzPubSub::PubSubLite::UnregisterSubscriber(
+EzPubSub::Error EzPubSub::PubSubLite::UpdateChannel(
     _In_ const std::wstring& channelName,
-    _In_ const SUBSCRIBER_CALLBACK subscriberCallback
+    _In_ uint32_t flushTime,
+    _In_ uint32_t maxBufferedDataSize,
+    _In_ uint32_t coalescedDataCount,
+    _In_ uint32_t coalescedDataSize,
+    _In_ uint32_t coalescedTime
 )
 {
     Error retValue = Error::kUnsuccess;
 
-    std::unordered_map<std::wstring, ChannelInfo>::iterator channelInfoListIter;
-    std::list<SUBSCRIBER_CALLBACK>::iterator subscriberCallbackListIter;
+    ChannelOption coalescingOption;
 
     if (channelName.length() == 0)
     {
         return retValue;
     }
 
-    if (channelInfoListSync_.LockCount == 0)
+    coalescingOption.coalescedDataCount = coalescedDataCount;
+    coalescingOption.coalescedDataSize = coalescedDataSize;
+    coalescingOption.coalescedTime = coalescedTime;
+    retValue = UpdateChannel_(channelName, flushTime, maxBufferedDataSize, &coalescingOption);
+    return retValue;
+}
+
+EzPubSub::Error EzPubSub::PubSubLite::UpdateChannel_(
+    _In_ const std::wstring& channelName,
+    _In_ uint32_t flushTime,
+    _In_ uint32_t maxBufferedDataSize,
+    _In_opt_ const ChannelOption* coalescingOption
+)
+{
+    Error retValue = Error::kUnsuccess;
+
+    ChannelInfo* channelInfo = nullptr;
+    TimerWheel* timerWheel = nullptr;
+    std::vector<PendingData> completedDataList;
+
+    // The timer wheel is created under the exclusive lock of the channel list, before the channel is acquired by the shared one.
+    if ((coalescingOption != nullptr) && (coalescingOption->coalescedTime != 0))
     {
-        ::InitializeCriticalSectionAndSpinCount(&channelInfoListSync_, kSyncSpinCount);
+        channelInfoListSync_.lock();
+        if (coalescingTimerWheel_ == nullptr)
+        {
+            coalescingTimerWheel_.reset(new TimerWheel);
+        }
+        timerWheel = coalescingTimerWheel_.get();
+        channelInfoListSync_.unlock();
     }
 
-    ::EnterCriticalSection(&channelInfoListSync_);
-    channelInfoListIter = SearchChannelInfo_(channelName);
-    if ((channelInfoListIter == channelInfoList_.end()) ||
-        (channelInfoListIter->second.fireStatus == FireStatus::kExit))
+    channelInfo = AcquireChannelInfo_(channelName);
+    if (channelInfo == nullptr)
     {
-        ::LeaveCriticalSection(&channelInfoListSync_);
         retValue = Error::kNotExistChannel;
         return retValue;
     }
 
-    subscriberCallbackListIter = SearchSubscriberCallback_(channelInfoListIter->second, subscriberCallback);
-    if (subscriberCallbackListIter == channelInfoListIter->second.subscriberCallbackList.end())
+    channelInfo->flushTime = flushTime;
+    channelInfo->maxBufferedDataSize = maxBufferedDataSize;
+    channelInfo->dataPool->SetLimitSize(GetDataPoolLimitSize_(maxBufferedDataSize));
+    if (coalescingOption != nullptr)
     {
-        ::LeaveCriticalSection(&channelInfoListSync_);
-        retValue = Error::kNotExistSubscriber;
-        return retValue;
+        // The buffered data is coalesced again from now by the new settings.
+        ResetCoalescing_(channelInfo);
+        channelInfo->coalescedDataCount = coalescingOption->coalescedDataCount;
+        channelInfo->coalescedDataSize = coalescingOption->coalescedDataSize;
+        channelInfo->coalescedTime = coalescingOption->coalescedTime;
+        if (timerWheel != nullptr)
+        {
+            channelInfo->coalescingTimerWheel = timerWheel;
+        }
+    }
+    if ((channelInfo->overflowPolicy == OverflowPolicy::kDropOldest) && (channelInfo->blockingSubscriberCount == 0))
+    {
+        if (channelInfo->queueType == QueueType::kRing)
+        {
+            DropOldestRingData_(channelInfo);
+        }
+        else
+        {
+            AdjustDataBuffer_(channelInfo, channelInfo->priorityLaneCount - 1, 0);
+        }
     }
+    channelInfo->channelVersion++;
+    SignalFireThread_(channelInfo, true);
+    channelInfo->publishEvent.notify_all();
+    AdmitPendingData_(channelInfo, completedDataList);
+    channelInfo->channelSync.unlock();
 
-    channelInfoListIter->second.subscriberCallbackList.erase(subscriberCallbackListIter);
-    ::LeaveCriticalSection(&channelInfoListSync_);
+    CompletePendingData_(completedDataList);
 
     retValue = Error::kSuccess;
     return retValue;
 }
 
-EzPubSub::Error EzPubSub::PubSubLite::Pause(
+EzPubSub::Error EzPubSub::PubSubLite::DeleteChannel(
     _In_ const std::wstring& channelName
 )
 {
     Error retValue = Error::kUnsuccess;
 
-    std::unordered_map<std::wstring, ChannelInfo>::iterator channelInfoListIter;
-
     if (channelName.length() == 0)
     {
         return retValue;
     }
 
-    if (channelInfoListSync_.LockCount == 0)
-    {
-        ::InitializeCriticalSectionAndSpinCount(&channelInfoListSync_, kSyncSpinCount);
-    }
+    retValue = DeleteChannel_(channelName, nullptr);
+    return retValue;
+}
 
-    ::EnterCriticalSection(&channelInfoListSync_);
-    channelInfoListIter = SearchChannelInfo_(channelName);
-    if ((channelInfoListIter == channelInfoList_.end()) ||
-        (channelInfoListIter->second.fireStatus == FireStatus::kExit))
+EzPubSub::Error EzPubSub::PubSubLite::DeleteChannel(
+    _In_ const ChannelHandle& channelHandle
+)
+{
+    Error retValue = Error::kUnsuccess;
+
+    if (channelHandle.IsValid() == false)
     {
-        ::LeaveCriticalSection(&channelInfoListSync_);
-        retValue = Error::kNotExistChannel;
         return retValue;
     }
 
-    channelInfoListIter->second.fireStatus = FireStatus::kStop;
-    ::LeaveCriticalSection(&channelInfoListSync_);
-
-    retValue = Error::kSuccess;
+    retValue = DeleteChannel_(channelHandle.GetChannelName(), &channelHandle);
     return retValue;
 }
 
-EzPubSub::Error EzPubSub::PubSubLite::Resume(
+EzPubSub::Error EzPubSub::PubSubLite::DeleteChannel_(
     _In_ const std::wstring& channelName,
-    _In_opt_ bool clearBuffer /*= false*/
+    _In_opt_ const ChannelHandle* channelHandle
 )
 {
+    /*
+        With channelHandle, only the channel of the handle is deleted, not a channel created again with its name.
+    */
+
     Error retValue = Error::kUnsuccess;
 
-    std::unordered_map<std::wstring, ChannelInfo>::iterator channelInfoListIter;
+    std::unordered_map<std::wstring, ChannelInfo*>::iterator channelInfoListIter;
+    ChannelInfo* channelInfo = nullptr;
+    std::vector<PendingData> completedDataList;
 
-    if (channelName.length() == 0)
+    // After the channel is removed from the list, only threads that already acquired it can access it,
+    // and they are done with it once channelSync is acquired below. ChannelHandle sees isDeleted instead.
+    channelInfoListSync_.lock();
+    channelInfoListIter = SearchChannelInfo_(channelName);
+    if ((channelInfoListIter == channelInfoList_.end()) ||
+        ((channelHandle != nullptr) && (channelInfoListIter->second != channelHandle->channelInfo_)))
     {
+        channelInfoListSync_.unlock();
+        retValue = Error::kNotExistChannel;
         return retValue;
     }
+    channelInfo = channelInfoListIter->second;
+    channelInfo->isDeleted = true;
+    channelInfoList_.erase(channelInfoListIter);
+    channelInfoListSync_.unlock();
 
-    if (channelInfoListSync_.LockCount == 0)
+    // Publishers do not hold the lock of the channel list, those in the channel are done with it once they leave it.
+    // They do not wait in the channel, waiting publishers leave it after they acquire channelSync.
+    while (channelInfo->activePublisherCount.load(std::memory_order_acquire) != 0)
     {
-        ::InitializeCriticalSectionAndSpinCount(&channelInfoListSync_, kSyncSpinCount);
+        std::this_thread::yield();
     }
 
-    ::EnterCriticalSection(&channelInfoListSync_);
-    channelInfoListIter = SearchChannelInfo_(channelName);
-    if ((channelInfoListIter == channelInfoList_.end()) ||
-        (channelInfoListIter->second.fireStatus == FireStatus::kExit))
+    // Exit and Delete FireThread of Channel
+    // Fire tasks of a kShared channel see kExit and finish without firing, publishers waiting for room return,
+    // and queued data are completed with kNotExistChannel.
+    LockChannel_(channelInfo);
+    channelInfo->fireStatus = FireStatus::kExit;
+    SignalFireThread_(channelInfo, true);
+    channelInfo->publishEvent.notify_all();
+    while ((channelInfo->fireTaskCount != 0) || (channelInfo->waitingPublisherCount != 0))
     {
-        ::LeaveCriticalSection(&channelInfoListSync_);
-        retValue = Error::kNotExistChannel;
-        return retValue;
+        channelInfo->fireEvent.wait(channelInfo->channelSync);
     }
-
-    if ((clearBuffer == true) && (channelInfoListIter->second.publishedDataList.size() != 0))
+    AdmitPendingData_(channelInfo, completedDataList);
+    channelInfo->channelSync.unlock();
+    CompletePendingData_(completedDataList);
+    // Waits for the timer if it is being called, which sees kExit.
+    if (channelInfo->coalescingTimerWheel != nullptr)
+    {
+        channelInfo->coalescingTimerWheel->Cancel(&channelInfo->coalescingTimer);
+    }
+    if (channelInfo->fireThreadType == FireThreadType::kShared)
+    {
+        channelInfoListSync_.lock();
+        sharedChannelCount_--;
+        channelInfoListSync_.unlock();
+    }
+    if (channelInfo->fireThread != nullptr)
     {
-        channelInfoListIter->second.lostDataCount += static_cast<uint32_t>(channelInfoListIter->second.publishedDataList.size());
-        channelInfoListIter->second.currentBufferedDataSize = 0;
-        channelInfoListIter->second.publishedDataList.clear();
+        channelInfo->fireThread->join();
+        delete channelInfo->fireThread;
+        channelInfo->fireThread = nullptr;
     }
-    channelInfoListIter->second.fireStatus = FireStatus::kRunning;
-    ::LeaveCriticalSection(&channelInfoListSync_);
+    if (channelInfo->publishedDataRing != nullptr)
+    {
+        delete channelInfo->publishedDataRing;
+        channelInfo->publishedDataRing = nullptr;
+    }
+    if (channelInfo->sharedMemoryRing != nullptr)
+    {
+        // The segment is removed if no other process is attached to it.
+        delete channelInfo->sharedMemoryRing;
+        channelInfo->sharedMemoryRing = nullptr;
+    }
+    if (channelInfo->channelLog != nullptr)
+    {
+        // The log is written to the disk, and a channel of the same name can open it again.
+        channelInfo->channelLog->Close();
+    }
+    ReleaseChannelInfo_(channelInfo);
 
     retValue = Error::kSuccess;
     return retValue;
 }
 
-EzPubSub::Error EzPubSub::PubSubLite::GetFiredDataCount(
+EzPubSub::Error EzPubSub::PubSubLite::PublishData(
     _In_ const std::wstring& channelName,
-    _Out_ uint32_t& firedDataCount
+    _In_ const uint8_t* data,
+    _In_ uint32_t dataSize,
+    _In_opt_ void* userContext /*= nullptr*/,
+    _In_opt_ const std::vector<SUBSCRIBER_CALLBACK>* fireCallbackList /*= nullptr*/
 )
 {
     Error retValue = Error::kUnsuccess;
 
-    std::unordered_map<std::wstring, ChannelInfo>::iterator channelInfoListIter;
-
-    if (channelName.length() == 0)
+    if ((channelName.length() == 0) || (data == nullptr) || (dataSize == 0))
     {
         return retValue;
     }
 
-    if (channelInfoListSync_.LockCount == 0)
-    {
-        ::InitializeCriticalSectionAndSpinCount(&channelInfoListSync_, kSyncSpinCount);
-    }
+    retValue = PublishData_(channelName, nullptr, data, nullptr, dataSize, userContext, fireCallbackList, nullptr, 0, nullptr, PublishMode::kChannelPolicy, nullptr, nullptr, nullptr);
+    return retValue;
+}
 
-    ::EnterCriticalSection(&channelInfoListSync_);
-    channelInfoListIter = SearchChannelInfo_(channelName);
-    if ((channelInfoListIter == channelInfoList_.end()) ||
-        (channelInfoListIter->second.fireStatus == FireStatus::kExit))
+EzPubSub::Error EzPubSub::PubSubLite::PublishData(
+    _In_ const std::wstring& channelName,
+    _Inout_ DataBuffer&& dataBuffer,
+    _In_opt_ void* userContext /*= nullptr*/,
+    _In_opt_ const std::vector<SUBSCRIBER_CALLBACK>* fireCallbackList /*= nullptr*/
+)
+{
+    Error retValue = Error::kUnsuccess;
+
+    if ((channelName.length() == 0) || (dataBuffer.GetData() == nullptr) || (dataBuffer.GetDataSize() == 0))
     {
-        ::LeaveCriticalSection(&channelInfoListSync_);
-        retValue = Error::kNotExistChannel;
         return retValue;
     }
 
-    firedDataCount = channelInfoListIter->second.firedDataCount;
-    ::LeaveCriticalSection(&channelInfoListSync_);
-
-    retValue = Error::kSuccess;
+    retValue = PublishData_(channelName, nullptr, nullptr, &dataBuffer, dataBuffer.GetDataSize(), userContext, fireCallbackList, nullptr, 0, nullptr, PublishMode::kChannelPolicy, nullptr, nullptr, nullptr);
     return retValue;
 }
 
-EzPubSub::Error EzPubSub::PubSubLite::GetLostDataCount(
+EzPubSub::Error EzPubSub::PubSubLite::PublishData(
     _In_ const std::wstring& channelName,
-    _Out_ uint32_t& lostDataCount
+    _In_ const uint8_t* data,
+    _In_ uint32_t dataSize,
+    _In_opt_ void* userContext,
+    _In_ const SubscriberMask& fireSubscriberMask
 )
 {
     Error retValue = Error::kUnsuccess;
 
-    std::unordered_map<std::wstring, ChannelInfo>::iterator channelInfoListIter;
-
-    if (channelName.length() == 0)
+    if ((channelName.length() == 0) || (data == nullptr) || (dataSize == 0))
     {
         return retValue;
     }
 
-    if (channelInfoListSync_.LockCount == 0)
-    {
-        ::InitializeCriticalSectionAndSpinCount(&channelInfoListSync_, kSyncSpinCount);
-    }
+    retValue = PublishData_(channelName, nullptr, data, nullptr, dataSize, userContext, nullptr, &fireSubscriberMask, 0, nullptr, PublishMode::kChannelPolicy, nullptr, nullptr, nullptr);
+    return retValue;
+}
 
-    ::EnterCriticalSection(&channelInfoListSync_);
-    channelInfoListIter = SearchChannelInfo_(channelName);
-    if ((channelInfoListIter == channelInfoList_.end()) ||
-        (channelInfoListIter->second.fireStatus == FireStatus::kExit))
+EzPubSub::Error EzPubSub::PubSubLite::PublishData(
+    _In_ const std::wstring& channelName,
+    _Inout_ DataBuffer&& dataBuffer,
+    _In_opt_ void* userContext,
+    _In_ const SubscriberMask& fireSubscriberMask
+)
+{
+    Error retValue = Error::kUnsuccess;
+
+    if ((channelName.length() == 0) || (dataBuffer.GetData() == nullptr) || (dataBuffer.GetDataSize() == 0))
     {
-        ::LeaveCriticalSection(&channelInfoListSync_);
-        retValue = Error::kNotExistChannel;
         return retValue;
     }
 
-    lostDataCount = channelInfoListIter->second.lostDataCount;
-    ::LeaveCriticalSection(&channelInfoListSync_);
-
-    retValue = Error::kSuccess;
+    retValue = PublishData_(channelName, nullptr, nullptr, &dataBuffer, dataBuffer.GetDataSize(), userContext, nullptr, &fireSubscriberMask, 0, nullptr, PublishMode::kChannelPolicy, nullptr, nullptr, nullptr);
     return retValue;
 }
 
-std::unordered_map<std::wstring, EzPubSub::ChannelInfo>::iterator EzPubSub::PubSubLite::SearchChannelInfo_(
-    _In_ const std::wstring& channelName
+EzPubSub::Error EzPubSub::PubSubLite::PublishData(
+    _In_ const std::wstring& channelName,
+    _In_ const uint8_t* data,
+    _In_ uint32_t dataSize,
+    _In_opt_ void* userContext,
+    _In_ const std::chrono::steady_clock::time_point& deadline,
+    _In_opt_ const SubscriberMask* fireSubscriberMask /*= nullptr*/
 )
 {
-    /*
-        If a channel is searched, a global pointer is returned,
-        so the caller using this method must synchronize.
-    */
+    Error retValue = Error::kUnsuccess;
 
-    return channelInfoList_.find(channelName);
+    if ((channelName.length() == 0) || (data == nullptr) || (dataSize == 0))
+    {
+        return retValue;
+    }
+
+    retValue = PublishData_(channelName, nullptr, data, nullptr, dataSize, userContext, nullptr, fireSubscriberMask, 0, nullptr, PublishMode::kWait, &deadline, nullptr, nullptr);
+    return retValue;
 }
 
-std::list<EzPubSub::SUBSCRIBER_CALLBACK>::iterator EzPubSub::PubSubLite::SearchSubscriberCallback_(
-    _In_ ChannelInfo& channelInfo,
+EzPubSub::Error EzPubSub::PubSubLite::PublishData(
+    _In_ const std::wstring& channelName,
+    _Inout_ DataBuffer&& dataBuffer,
+    _In_opt_ void* userContext,
+    _In_ const std::chrono::steady_clock::time_point& deadline,
+    _In_opt_ const SubscriberMask* fireSubscriberMask /*= nullptr*/
+)
+{
+    Error retValue = Error::kUnsuccess;
+
+    if ((channelName.length() == 0) || (dataBuffer.GetData() == nullptr) || (dataBuffer.GetDataSize() == 0))
+    {
+        return retValue;
+    }
+
+    retValue = PublishData_(channelName, nullptr, nullptr, &dataBuffer, dataBuffer.GetDataSize(), userContext, nullptr, fireSubscriberMask, 0, nullptr, PublishMode::kWait, &deadline, nullptr, nullptr);
+    return retValue;
+}
+
+EzPubSub::Error EzPubSub::PubSubLite::TryPublishData(
+    _In_ const std::wstring& channelName,
+    _In_ const uint8_t* data,
+    _In_ uint32_t dataSize,
+    _In_opt_ void* userContext /*= nullptr*/,
+    _In_opt_ const SubscriberMask* fireSubscriberMask /*= nullptr*/
+)
+{
+    Error retValue = Error::kUnsuccess;
+
+    if ((channelName.length() == 0) || (data == nullptr) || (dataSize == 0))
+    {
+        return retValue;
+    }
+
+    retValue = PublishData_(channelName, nullptr, data, nullptr, dataSize, userContext, nullptr, fireSubscriberMask, 0, nullptr, PublishMode::kTry, nullptr, nullptr, nullptr);
+    return retValue;
+}
+
+EzPubSub::Error EzPubSub::PubSubLite::TryPublishData(
+    _In_ const std::wstring& channelName,
+    _Inout_ DataBuffer&& dataBuffer,
+    _In_opt_ void* userContext /*= nullptr*/,
+    _In_opt_ const SubscriberMask* fireSubscriberMask /*= nullptr*/
+)
+{
+    Error retValue = Error::kUnsuccess;
+
+    if ((channelName.length() == 0) || (dataBuffer.GetData() == nullptr) || (dataBuffer.GetDataSize() == 0))
+    {
+        return retValue;
+    }
+
+    retValue = PublishData_(channelName, nullptr, nullptr, &dataBuffer, dataBuffer.GetDataSize(), userContext, nullptr, fireSubscriberMask, 0, nullptr, PublishMode::kTry, nullptr, nullptr, nullptr);
+    return retValue;
+}
+
+EzPubSub::Error EzPubSub::PubSubLite::PublishDataAsync(
+    _In_ const std::wstring& channelName,
+    _In_ const uint8_t* data,
+    _In_ uint32_t dataSize,
+    _In_opt_ void* userContext,
+    _In_ PUBLISH_COMPLETION_CALLBACK completionCallback,
+    _In_opt_ void* completionContext /*= nullptr*/,
+    _In_opt_ const SubscriberMask* fireSubscriberMask /*= nullptr*/
+)
+{
+    Error retValue = Error::kUnsuccess;
+
+    if ((channelName.length() == 0) || (data == nullptr) || (dataSize == 0) || (completionCallback == nullptr))
+    {
+        return retValue;
+    }
+
+    retValue = PublishData_(channelName, nullptr, data, nullptr, dataSize, userContext, nullptr, fireSubscriberMask, 0, nullptr, PublishMode::kAsync, nullptr, completionCallback, completionContext);
+    return retValue;
+}
+
+EzPubSub::Error EzPubSub::PubSubLite::PublishDataAsync(
+    _In_ const std::wstring& channelName,
+    _Inout_ DataBuffer&& dataBuffer,
+    _In_opt_ void* userContext,
+    _In_ PUBLISH_COMPLETION_CALLBACK completionCallback,
+    _In_opt_ void* completionContext /*= nullptr*/,
+    _In_opt_ const SubscriberMask* fireSubscriberMask /*= nullptr*/
+)
+{
+    Error retValue = Error::kUnsuccess;
+
+    if ((channelName.length() == 0) || (dataBuffer.GetData() == nullptr) || (dataBuffer.GetDataSize() == 0) || (completionCallback == nullptr))
+    {
+        return retValue;
+    }
+
+    retValue = PublishData_(channelName, nullptr, nullptr, &dataBuffer, dataBuffer.GetDataSize(), userContext, nullptr, fireSubscriberMask, 0, nullptr, PublishMode::kAsync, nullptr, completionCallback, completionContext);
+    return retValue;
+}
+
+EzPubSub::Error EzPubSub::PubSubLite::PublishData(
+    _In_ const ChannelHandle& channelHandle,
+    _In_ const uint8_t* data,
+    _In_ uint32_t dataSize,
+    _In_opt_ void* userContext /*= nullptr*/,
+    _In_opt_ const std::vector<SUBSCRIBER_CALLBACK>* fireCallbackList /*= nullptr*/
+)
+{
+    Error retValue = Error::kUnsuccess;
+
+    if ((channelHandle.IsValid() == false) || (data == nullptr) || (dataSize == 0))
+    {
+        return retValue;
+    }
+
+    retValue = PublishData_(channelHandle.GetChannelName(), &channelHandle, data, nullptr, dataSize, userContext, fireCallbackList, nullptr, 0, nullptr, PublishMode::kChannelPolicy, nullptr, nullptr, nullptr);
+    return retValue;
+}
+
+EzPubSub::Error EzPubSub::PubSubLite::PublishData(
+    _In_ const ChannelHandle& channelHandle,
+    _Inout_ DataBuffer&& dataBuffer,
+    _In_opt_ void* userContext /*= nullptr*/,
+    _In_opt_ const std::vector<SUBSCRIBER_CALLBACK>* fireCallbackList /*= nullptr*/
+)
+{
+    Error retValue = Error::kUnsuccess;
+
+    if ((channelHandle.IsValid() == false) || (dataBuffer.GetData() == nullptr) || (dataBuffer.GetDataSize() == 0))
+    {
+        return retValue;
+    }
+
+    retValue = PublishData_(channelHandle.GetChannelName(), &channelHandle, nullptr, &dataBuffer, dataBuffer.GetDataSize(), userContext, fireCallbackList, nullptr, 0, nullptr, PublishMode::kChannelPolicy, nullptr, nullptr, nullptr);
+    return retValue;
+}
+
+EzPubSub::Error EzPubSub::PubSubLite::PublishData(
+    _In_ const ChannelHandle& channelHandle,
+    _In_ const uint8_t* data,
+    _In_ uint32_t dataSize,
+    _In_opt_ void* userContext,
+    _In_ const SubscriberMask& fireSubscriberMask
+)
+{
+    Error retValue = Error::kUnsuccess;
+
+    if ((channelHandle.IsValid() == false) || (data == nullptr) || (dataSize == 0))
+    {
+        return retValue;
+    }
+
+    retValue = PublishData_(channelHandle.GetChannelName(), &channelHandle, data, nullptr, dataSize, userContext, nullptr, &fireSubscriberMask, 0, nullptr, PublishMode::kChannelPolicy, nullptr, nullptr, nullptr);
+    return retValue;
+}
+
+EzPubSub::Error EzPubSub::PubSubLite::PublishData(
+    _In_ const ChannelHandle& channelHandle,
+    _Inout_ DataBuffer&& dataBuffer,
+    _In_opt_ void* userContext,
+    _In_ const SubscriberMask& fireSubscriberMask
+)
+{
+    Error retValue = Error::kUnsuccess;
+
+    if ((channelHandle.IsValid() == false) || (dataBuffer.GetData() == nullptr) || (dataBuffer.GetDataSize() == 0))
+    {
+        return retValue;
+    }
+
+    retValue = PublishData_(channelHandle.GetChannelName(), &channelHandle, nullptr, &dataBuffer, dataBuffer.GetDataSize(), userContext, nullptr, &fireSubscriberMask, 0, nullptr, PublishMode::kChannelPolicy, nullptr, nullptr, nullptr);
+    return retValue;
+}
+
+EzPubSub::Error EzPubSub::PubSubLite::PublishData(
+    _In_ const ChannelHandle& channelHandle,
+    _In_ const uint8_t* data,
+    _In_ uint32_t dataSize,
+    _In_opt_ void* userContext,
+    _In_ const std::chrono::steady_clock::time_point& deadline,
+    _In_opt_ const SubscriberMask* fireSubscriberMask /*= nullptr*/
+)
+{
+    Error retValue = Error::kUnsuccess;
+
+    if ((channelHandle.IsValid() == false) || (data == nullptr) || (dataSize == 0))
+    {
+        return retValue;
+    }
+
+    retValue = PublishData_(channelHandle.GetChannelName(), &channelHandle, data, nullptr, dataSize, userContext, nullptr, fireSubscriberMask, 0, nullptr, PublishMode::kWait, &deadline, nullptr, nullptr);
+    return retValue;
+}
+
+EzPubSub::Error EzPubSub::PubSubLite::PublishData(
+    _In_ const ChannelHandle& channelHandle,
+    _Inout_ DataBuffer&& dataBuffer,
+    _In_opt_ void* userContext,
+    _In_ const std::chrono::steady_clock::time_point& deadline,
+    _In_opt_ const SubscriberMask* fireSubscriberMask /*= nullptr*/
+)
+{
+    Error retValue = Error::kUnsuccess;
+
+    if ((channelHandle.IsValid() == false) || (dataBuffer.GetData() == nullptr) || (dataBuffer.GetDataSize() == 0))
+    {
+        return retValue;
+    }
+
+    retValue = PublishData_(channelHandle.GetChannelName(), &channelHandle, nullptr, &dataBuffer, dataBuffer.GetDataSize(), userContext, nullptr, fireSubscriberMask, 0, nullptr, PublishMode::kWait, &deadline, nullptr, nullptr);
+    return retValue;
+}
+
+EzPubSub::Error EzPubSub::PubSubLite::TryPublishData(
+    _In_ const ChannelHandle& channelHandle,
+    _In_ const uint8_t* data,
+    _In_ uint32_t dataSize,
+    _In_opt_ void* userContext /*= nullptr*/,
+    _In_opt_ const SubscriberMask* fireSubscriberMask /*= nullptr*/
+)
+{
+    Error retValue = Error::kUnsuccess;
+
+    if ((channelHandle.IsValid() == false) || (data == nullptr) || (dataSize == 0))
+    {
+        return retValue;
+    }
+
+    retValue = PublishData_(channelHandle.GetChannelName(), &channelHandle, data, nullptr, dataSize, userContext, nullptr, fireSubscriberMask, 0, nullptr, PublishMode::kTry, nullptr, nullptr, nullptr);
+    return retValue;
+}
+
+EzPubSub::Error EzPubSub::PubSubLite::TryPublishData(
+    _In_ const ChannelHandle& channelHandle,
+    _Inout_ DataBuffer&& dataBuffer,
+    _In_opt_ void* userContext /*= nullptr*/,
+    _In_opt_ const SubscriberMask* fireSubscriberMask /*= nullptr*/
+)
+{
+    Error retValue = Error::kUnsuccess;
+
+    if ((channelHandle.IsValid() == false) || (dataBuffer.GetData() == nullptr) || (dataBuffer.GetDataSize() == 0))
+    {
+        return retValue;
+    }
+
+    retValue = PublishData_(channelHandle.GetChannelName(), &channelHandle, nullptr, &dataBuffer, dataBuffer.GetDataSize(), userContext, nullptr, fireSubscriberMask, 0, nullptr, PublishMode::kTry, nullptr, nullptr, nullptr);
+    return retValue;
+}
+
+EzPubSub::Error EzPubSub::PubSubLite::PublishDataAsync(
+    _In_ const ChannelHandle& channelHandle,
+    _In_ const uint8_t* data,
+    _In_ uint32_t dataSize,
+    _In_opt_ void* userContext,
+    _In_ PUBLISH_COMPLETION_CALLBACK completionCallback,
+    _In_opt_ void* completionContext /*= nullptr*/,
+    _In_opt_ const SubscriberMask* fireSubscriberMask /*= nullptr*/
+)
+{
+    Error retValue = Error::kUnsuccess;
+
+    if ((channelHandle.IsValid() == false) || (data == nullptr) || (dataSize == 0) || (completionCallback == nullptr))
+    {
+        return retValue;
+    }
+
+    retValue = PublishData_(channelHandle.GetChannelName(), &channelHandle, data, nullptr, dataSize, userContext, nullptr, fireSubscriberMask, 0, nullptr, PublishMode::kAsync, nullptr, completionCallback, completionContext);
+    return retValue;
+}
+
+EzPubSub::Error EzPubSub::PubSubLite::PublishDataAsync(
+    _In_ const ChannelHandle& channelHandle,
+    _Inout_ DataBuffer&& dataBuffer,
+    _In_opt_ void* userContext,
+    _In_ PUBLISH_COMPLETION_CALLBACK completionCallback,
+    _In_opt_ void* completionContext /*= nullptr*/,
+    _In_opt_ const SubscriberMask* fireSubscriberMask /*= nullptr*/
+)
+{
+    Error retValue = Error::kUnsuccess;
+
+    if ((channelHandle.IsValid() == false) || (dataBuffer.GetData() == nullptr) || (dataBuffer.GetDataSize() == 0) || (completionCallback == nullptr))
+    {
+        return retValue;
+    }
+
+    retValue = PublishData_(channelHandle.GetChannelName(), &channelHandle, nullptr, &dataBuffer, dataBuffer.GetDataSize(), userContext, nullptr, fireSubscriberMask, 0, nullptr, PublishMode::kAsync, nullptr, completionCallback, completionContext);
+    return retValue;
+}
+
+EzPubSub::Error EzPubSub::PubSubLite::PublishPriorityData(
+    _In_ const std::wstring& channelName,
+    _In_ uint32_t priority,
+    _In_ const uint8_t* data,
+    _In_ uint32_t dataSize,
+    _In_opt_ void* userContext /*= nullptr*/,
+    _In_opt_ const SubscriberMask* fireSubscriberMask /*= nullptr*/
+)
+{
+    Error retValue = Error::kUnsuccess;
+
+    if ((channelName.length() == 0) || (data == nullptr) || (dataSize == 0))
+    {
+        return retValue;
+    }
+
+    retValue = PublishData_(channelName, nullptr, data, nullptr, dataSize, userContext, nullptr, fireSubscriberMask, priority, nullptr, PublishMode::kChannelPolicy, nullptr, nullptr, nullptr);
+    return retValue;
+}
+
+EzPubSub::Error EzPubSub::PubSubLite::PublishPriorityData(
+    _In_ const std::wstring& channelName,
+    _In_ uint32_t priority,
+    _Inout_ DataBuffer&& dataBuffer,
+    _In_opt_ void* userContext /*= nullptr*/,
+    _In_opt_ const SubscriberMask* fireSubscriberMask /*= nullptr*/
+)
+{
+    Error retValue = Error::kUnsuccess;
+
+    if ((channelName.length() == 0) || (dataBuffer.GetData() == nullptr) || (dataBuffer.GetDataSize() == 0))
+    {
+        return retValue;
+    }
+
+    retValue = PublishData_(channelName, nullptr, nullptr, &dataBuffer, dataBuffer.GetDataSize(), userContext, nullptr, fireSubscriberMask, priority, nullptr, PublishMode::kChannelPolicy, nullptr, nullptr, nullptr);
+    return retValue;
+}
+
+EzPubSub::Error EzPubSub::PubSubLite::PublishPriorityData(
+    _In_ const ChannelHandle& channelHandle,
+    _In_ uint32_t priority,
+    _In_ const uint8_t* data,
+    _In_ uint32_t dataSize,
+    _In_opt_ void* userContext /*= nullptr*/,
+    _In_opt_ const SubscriberMask* fireSubscriberMask /*= nullptr*/
+)
+{
+    Error retValue = Error::kUnsuccess;
+
+    if ((channelHandle.IsValid() == false) || (data == nullptr) || (dataSize == 0))
+    {
+        return retValue;
+    }
+
+    retValue = PublishData_(channelHandle.GetChannelName(), &channelHandle, data, nullptr, dataSize, userContext, nullptr, fireSubscriberMask, priority, nullptr, PublishMode::kChannelPolicy, nullptr, nullptr, nullptr);
+    return retValue;
+}
+
+EzPubSub::Error EzPubSub::PubSubLite::PublishPriorityData(
+    _In_ const ChannelHandle& channelHandle,
+    _In_ uint32_t priority,
+    _Inout_ DataBuffer&& dataBuffer,
+    _In_opt_ void* userContext /*= nullptr*/,
+    _In_opt_ const SubscriberMask* fireSubscriberMask /*= nullptr*/
+)
+{
+    Error retValue = Error::kUnsuccess;
+
+    if ((channelHandle.IsValid() == false) || (dataBuffer.GetData() == nullptr) || (dataBuffer.GetDataSize() == 0))
+    {
+        return retValue;
+    }
+
+    retValue = PublishData_(channelHandle.GetChannelName(), &channelHandle, nullptr, &dataBuffer, dataBuffer.GetDataSize(), userContext, nullptr, fireSubscriberMask, priority, nullptr, PublishMode::kChannelPolicy, nullptr, nullptr, nullptr);
+    return retValue;
+}
+
+EzPubSub::Error EzPubSub::PubSubLite::PublishKeyedData(
+    _In_ const std::wstring& channelName,
+    _In_ uint64_t dataKey,
+    _In_ const uint8_t* data,
+    _In_ uint32_t dataSize,
+    _In_opt_ void* userContext /*= nullptr*/,
+    _In_opt_ const SubscriberMask* fireSubscriberMask /*= nullptr*/
+)
+{
+    Error retValue = Error::kUnsuccess;
+
+    if ((channelName.length() == 0) || (data == nullptr) || (dataSize == 0))
+    {
+        return retValue;
+    }
+
+    retValue = PublishData_(channelName, nullptr, data, nullptr, dataSize, userContext, nullptr, fireSubscriberMask, 0, &dataKey, PublishMode::kChannelPolicy, nullptr, nullptr, nullptr);
+    return retValue;
+}
+
+EzPubSub::Error EzPubSub::PubSubLite::PublishKeyedData(
+    _In_ const std::wstring& channelName,
+    _In_ uint64_t dataKey,
+    _Inout_ DataBuffer&& dataBuffer,
+    _In_opt_ void* userContext /*= nullptr*/,
+    _In_opt_ const SubscriberMask* fireSubscriberMask /*= nullptr*/
+)
+{
+    Error retValue = Error::kUnsuccess;
+
+    if ((channelName.length() == 0) || (dataBuffer.GetData() == nullptr) || (dataBuffer.GetDataSize() == 0))
+    {
+        return retValue;
+    }
+
+    retValue = PublishData_(channelName, nullptr, nullptr, &dataBuffer, dataBuffer.GetDataSize(), userContext, nullptr, fireSubscriberMask, 0, &dataKey, PublishMode::kChannelPolicy, nullptr, nullptr, nullptr);
+    return retValue;
+}
+
+EzPubSub::Error EzPubSub::PubSubLite::PublishKeyedData(
+    _In_ const ChannelHandle& channelHandle,
+    _In_ uint64_t dataKey,
+    _In_ const uint8_t* data,
+    _In_ uint32_t dataSize,
+    _In_opt_ void* userContext /*= nullptr*/,
+    _In_opt_ const SubscriberMask* fireSubscriberMask /*= nullptr*/
+)
+{
+    Error retValue = Error::kUnsuccess;
+
+    if ((channelHandle.IsValid() == false) || (data == nullptr) || (dataSize == 0))
+    {
+        return retValue;
+    }
+
+    retValue = PublishData_(channelHandle.GetChannelName(), &channelHandle, data, nullptr, dataSize, userContext, nullptr, fireSubscriberMask, 0, &dataKey, PublishMode::kChannelPolicy, nullptr, nullptr, nullptr);
+    return retValue;
+}
+
+EzPubSub::Error EzPubSub::PubSubLite::PublishKeyedData(
+    _In_ const ChannelHandle& channelHandle,
+    _In_ uint64_t dataKey,
+    _Inout_ DataBuffer&& dataBuffer,
+    _In_opt_ void* userContext /*= nullptr*/,
+    _In_opt_ const SubscriberMask* fireSubscriberMask /*= nullptr*/
+)
+{
+    Error retValue = Error::kUnsuccess;
+
+    if ((channelHandle.IsValid() == false) || (dataBuffer.GetData() == nullptr) || (dataBuffer.GetDataSize() == 0))
+    {
+        return retValue;
+    }
+
+    retValue = PublishData_(channelHandle.GetChannelName(), &channelHandle, nullptr, &dataBuffer, dataBuffer.GetDataSize(), userContext, nullptr, fireSubscriberMask, 0, &dataKey, PublishMode::kChannelPolicy, nullptr, nullptr, nullptr);
+    return retValue;
+}
+
+EzPubSub::Error EzPubSub::PubSubLite::PublishBatch(
+    _In_ const std::wstring& channelName,
+    _In_ const PublishBatchData* batchDataList,
+    _In_ uint32_t batchDataCount
+)
+{
+    Error retValue = Error::kUnsuccess;
+
+    if ((channelName.length() == 0) || (batchDataList == nullptr) || (batchDataCount == 0))
+    {
+        return retValue;
+    }
+
+    retValue = PublishBatch_(channelName, nullptr, batchDataList, batchDataCount);
+    return retValue;
+}
+
+EzPubSub::Error EzPubSub::PubSubLite::PublishBatch(
+    _In_ const ChannelHandle& channelHandle,
+    _In_ const PublishBatchData* batchDataList,
+    _In_ uint32_t batchDataCount
+)
+{
+    Error retValue = Error::kUnsuccess;
+
+    if ((channelHandle.IsValid() == false) || (batchDataList == nullptr) || (batchDataCount == 0))
+    {
+        return retValue;
+    }
+
+    retValue = PublishBatch_(channelHandle.GetChannelName(), &channelHandle, batchDataList, batchDataCount);
+    return retValue;
+}
+
+EzPubSub::Error EzPubSub::PubSubLite::ReserveData(
+    _In_ const std::wstring& channelName,
+    _In_ uint32_t dataSize,
+    _Out_ DataBuffer& dataBuffer
+)
+{
+    Error retValue = Error::kUnsuccess;
+
+    ChannelInfo* channelInfo = nullptr;
+    std::shared_ptr<DataPool> dataPool;
+
+    if ((channelName.length() == 0) || (dataSize == 0))
+    {
+        return retValue;
+    }
+
+    // The data pool has its own lock, so the channel lock is not needed.
+    channelInfoListSync_.lock_shared();
+    channelInfo = FindChannelInfo_(channelName, nullptr);
+    if ((channelInfo == nullptr) || (channelInfo->fireStatus == FireStatus::kExit))
+    {
+        channelInfoListSync_.unlock_shared();
+        retValue = Error::kNotExistChannel;
+        return retValue;
+    }
+    dataPool = channelInfo->dataPool;
+    channelInfoListSync_.unlock_shared();
+
+    if (dataPool->Allocate(dataSize, dataBuffer) == false)
+    {
+        return retValue;
+    }
+
+    retValue = Error::kSuccess;
+    return retValue;
+}
+
+EzPubSub::Error EzPubSub::PubSubLite::ReserveData(
+    _In_ const ChannelHandle& channelHandle,
+    _In_ uint32_t dataSize,
+    _Out_ DataBuffer& dataBuffer
+)
+{
+    Error retValue = Error::kUnsuccess;
+
+    ChannelInfo* channelInfo = nullptr;
+    std::shared_ptr<DataPool> dataPool;
+
+    if ((channelHandle.IsValid() == false) || (dataSize == 0))
+    {
+        return retValue;
+    }
+
+    // The data pool has its own lock, so the channel lock is not needed.
+    channelInfoListSync_.lock_shared();
+    channelInfo = FindChannelInfo_(channelHandle.GetChannelName(), &channelHandle);
+    if ((channelInfo == nullptr) || (channelInfo->fireStatus == FireStatus::kExit))
+    {
+        channelInfoListSync_.unlock_shared();
+        retValue = Error::kNotExistChannel;
+        return retValue;
+    }
+    dataPool = channelInfo->dataPool;
+    channelInfoListSync_.unlock_shared();
+
+    if (dataPool->Allocate(dataSize, dataBuffer) == false)
+    {
+        return retValue;
+    }
+
+    retValue = Error::kSuccess;
+    return retValue;
+}
+
+EzPubSub::Error EzPubSub::PubSubLite::RegisterSubscriber(
+    _In_ const std::wstring& channelName,
+    _In_ const SUBSCRIBER_CALLBACK subscriberCallback,
+    _Out_opt_ uint32_t* subscriberId /*= nullptr*/
+)
+{
+    Error retValue = Error::kUnsuccess;
+
+    SubscriberInfo subscriberInfo;
+
+    if ((channelName.length() == 0) || (subscriberCallback == nullptr))
+    {
+        return retValue;
+    }
+
+    subscriberInfo.subscriberCallback = subscriberCallback;
+    retValue = RegisterSubscriber_(channelName, nullptr, subscriberInfo, nullptr, subscriberId);
+    return retValue;
+}
+
+EzPubSub::Error EzPubSub::PubSubLite::UnregisterSubscriber(
+    _In_ const std::wstring& channelName,
+    _In_ const SUBSCRIBER_CALLBACK subscriberCallback
+)
+{
+    Error retValue = Error::kUnsuccess;
+
+    SubscriberInfo subscriberInfo;
+
+    if ((channelName.length() == 0) || (subscriberCallback == nullptr))
+    {
+        return retValue;
+    }
+
+    subscriberInfo.subscriberCallback = subscriberCallback;
+    retValue = UnregisterSubscriber_(channelName, nullptr, subscriberInfo);
+    return retValue;
+}
+
+EzPubSub::Error EzPubSub::PubSubLite::RegisterSubscriber(
+    _In_ const std::wstring& channelName,
+    _In_ const BATCH_SUBSCRIBER_CALLBACK batchSubscriberCallback,
+    _Out_opt_ uint32_t* subscriberId /*= nullptr*/
+)
+{
+    Error retValue = Error::kUnsuccess;
+
+    SubscriberInfo subscriberInfo;
+
+    if ((channelName.length() == 0) || (batchSubscriberCallback == nullptr))
+    {
+        return retValue;
+    }
+
+    subscriberInfo.batchSubscriberCallback = batchSubscriberCallback;
+    retValue = RegisterSubscriber_(channelName, nullptr, subscriberInfo, nullptr, subscriberId);
+    return retValue;
+}
+
+EzPubSub::Error EzPubSub::PubSubLite::UnregisterSubscriber(
+    _In_ const std::wstring& channelName,
+    _In_ const BATCH_SUBSCRIBER_CALLBACK batchSubscriberCallback
+)
+{
+    Error retValue = Error::kUnsuccess;
+
+    SubscriberInfo subscriberInfo;
+
+    if ((channelName.length() == 0) || (batchSubscriberCallback == nullptr))
+    {
+        return retValue;
+    }
+
+    subscriberInfo.batchSubscriberCallback = batchSubscriberCallback;
+    retValue = UnregisterSubscriber_(channelName, nullptr, subscriberInfo);
+    return retValue;
+}
+
+EzPubSub::Error EzPubSub::PubSubLite::RegisterWildcardSubscriber(
+    _In_ const std::wstring& topicFilter,
+    _In_ const SUBSCRIBER_CALLBACK subscriberCallback
+)
+{
+    Error retValue = Error::kUnsuccess;
+
+    SubscriberInfo subscriberInfo;
+
+    if ((topicFilter.length() == 0) || (subscriberCallback == nullptr))
+    {
+        return retValue;
+    }
+
+    subscriberInfo.subscriberCallback = subscriberCallback;
+    retValue = RegisterWildcardSubscriber_(topicFilter, subscriberInfo);
+    return retValue;
+}
+
+EzPubSub::Error EzPubSub::PubSubLite::UnregisterWildcardSubscriber(
+    _In_ const std::wstring& topicFilter,
+    _In_ const SUBSCRIBER_CALLBACK subscriberCallback
+)
+{
+    Error retValue = Error::kUnsuccess;
+
+    SubscriberInfo subscriberInfo;
+
+    if ((topicFilter.length() == 0) || (subscriberCallback == nullptr))
+    {
+        return retValue;
+    }
+
+    subscriberInfo.subscriberCallback = subscriberCallback;
+    retValue = UnregisterWildcardSubscriber_(topicFilter, subscriberInfo);
+    return retValue;
+}
+
+EzPubSub::Error EzPubSub::PubSubLite::RegisterWildcardSubscriber(
+    _In_ const std::wstring& topicFilter,
+    _In_ const BATCH_SUBSCRIBER_CALLBACK batchSubscriberCallback
+)
+{
+    Error retValue = Error::kUnsuccess;
+
+    SubscriberInfo subscriberInfo;
+
+    if ((topicFilter.length() == 0) || (batchSubscriberCallback == nullptr))
+    {
+        return retValue;
+    }
+
+    subscriberInfo.batchSubscriberCallback = batchSubscriberCallback;
+    retValue = RegisterWildcardSubscriber_(topicFilter, subscriberInfo);
+    return retValue;
+}
+
+EzPubSub::Error EzPubSub::PubSubLite::UnregisterWildcardSubscriber(
+    _In_ const std::wstring& topicFilter,
+    _In_ const BATCH_SUBSCRIBER_CALLBACK batchSubscriberCallback
+)
+{
+    Error retValue = Error::kUnsuccess;
+
+    SubscriberInfo subscriberInfo;
+
+    if ((topicFilter.length() == 0) || (batchSubscriberCallback == nullptr))
+    {
+        return retValue;
+    }
+
+    subscriberInfo.batchSubscriberCallback = batchSubscriberCallback;
+    retValue = UnregisterWildcardSubscriber_(topicFilter, subscriberInfo);
+    return retValue;
+}
+
+EzPubSub::Error EzPubSub::PubSubLite::RegisterSubscriber(
+    _In_ const std::wstring& channelName,
+    _In_ const SUBSCRIBER_CALLBACK subscriberCallback,
+    _In_ const SubscriberOption& subscriberOption,
+    _Out_opt_ uint32_t* subscriberId /*= nullptr*/
+)
+{
+    Error retValue = Error::kUnsuccess;
+
+    SubscriberInfo subscriberInfo;
+
+    if ((channelName.length() == 0) || (subscriberCallback == nullptr))
+    {
+        return retValue;
+    }
+
+    subscriberInfo.subscriberCallback = subscriberCallback;
+    retValue = RegisterSubscriber_(channelName, nullptr, subscriberInfo, &subscriberOption, subscriberId);
+    return retValue;
+}
+
+EzPubSub::Error EzPubSub::PubSubLite::RegisterSubscriber(
+    _In_ const std::wstring& channelName,
+    _In_ const BATCH_SUBSCRIBER_CALLBACK batchSubscriberCallback,
+    _In_ const SubscriberOption& subscriberOption,
+    _Out_opt_ uint32_t* subscriberId /*= nullptr*/
+)
+{
+    Error retValue = Error::kUnsuccess;
+
+    SubscriberInfo subscriberInfo;
+
+    if ((channelName.length() == 0) || (batchSubscriberCallback == nullptr))
+    {
+        return retValue;
+    }
+
+    subscriberInfo.batchSubscriberCallback = batchSubscriberCallback;
+    retValue = RegisterSubscriber_(channelName, nullptr, subscriberInfo, &subscriberOption, subscriberId);
+    return retValue;
+}
+
+EzPubSub::Error EzPubSub::PubSubLite::RegisterSubscriber(
+    _In_ const ChannelHandle& channelHandle,
+    _In_ const SUBSCRIBER_CALLBACK subscriberCallback,
+    _Out_opt_ uint32_t* subscriberId /*= nullptr*/
+)
+{
+    Error retValue = Error::kUnsuccess;
+
+    SubscriberInfo subscriberInfo;
+
+    if ((channelHandle.IsValid() == false) || (subscriberCallback == nullptr))
+    {
+        return retValue;
+    }
+
+    subscriberInfo.subscriberCallback = subscriberCallback;
+    retValue = RegisterSubscriber_(channelHandle.GetChannelName(), &channelHandle, subscriberInfo, nullptr, subscriberId);
+    return retValue;
+}
+
+EzPubSub::Error EzPubSub::PubSubLite::UnregisterSubscriber(
+    _In_ const ChannelHandle& channelHandle,
     _In_ const SUBSCRIBER_CALLBACK subscriberCallback
 )
+{
+    Error retValue = Error::kUnsuccess;
+
+    SubscriberInfo subscriberInfo;
+
+    if ((channelHandle.IsValid() == false) || (subscriberCallback == nullptr))
+    {
+        return retValue;
+    }
+
+    subscriberInfo.subscriberCallback = subscriberCallback;
+    retValue = UnregisterSubscriber_(channelHandle.GetChannelName(), &channelHandle, subscriberInfo);
+    return retValue;
+}
+
+EzPubSub::Error EzPubSub::PubSubLite::RegisterSubscriber(
+    _In_ const ChannelHandle& channelHandle,
+    _In_ const BATCH_SUBSCRIBER_CALLBACK batchSubscriberCallback,
+    _Out_opt_ uint32_t* subscriberId /*= nullptr*/
+)
+{
+    Error retValue = Error::kUnsuccess;
+
+    SubscriberInfo subscriberInfo;
+
+    if ((channelHandle.IsValid() == false) || (batchSubscriberCallback == nullptr))
+    {
+        return retValue;
+    }
+
+    subscriberInfo.batchSubscriberCallback = batchSubscriberCallback;
+    retValue = RegisterSubscriber_(channelHandle.GetChannelName(), &channelHandle, subscriberInfo, nullptr, subscriberId);
+    return retValue;
+}
+
+EzPubSub::Error EzPubSub::PubSubLite::UnregisterSubscriber(
+    _In_ const ChannelHandle& channelHandle,
+    _In_ const BATCH_SUBSCRIBER_CALLBACK batchSubscriberCallback
+)
+{
+    Error retValue = Error::kUnsuccess;
+
+    SubscriberInfo subscriberInfo;
+
+    if ((channelHandle.IsValid() == false) || (batchSubscriberCallback == nullptr))
+    {
+        return retValue;
+    }
+
+    subscriberInfo.batchSubscriberCallback = batchSubscriberCallback;
+    retValue = UnregisterSubscriber_(channelHandle.GetChannelName(), &channelHandle, subscriberInfo);
+    return retValue;
+}
+
+EzPubSub::Error EzPubSub::PubSubLite::RegisterSubscriber(
+    _In_ const ChannelHandle& channelHandle,
+    _In_ const SUBSCRIBER_CALLBACK subscriberCallback,
+    _In_ const SubscriberOption& subscriberOption,
+    _Out_opt_ uint32_t* subscriberId /*= nullptr*/
+)
+{
+    Error retValue = Error::kUnsuccess;
+
+    SubscriberInfo subscriberInfo;
+
+    if ((channelHandle.IsValid() == false) || (subscriberCallback == nullptr))
+    {
+        return retValue;
+    }
+
+    subscriberInfo.subscriberCallback = subscriberCallback;
+    retValue = RegisterSubscriber_(channelHandle.GetChannelName(), &channelHandle, subscriberInfo, &subscriberOption, subscriberId);
+    return retValue;
+}
+
+EzPubSub::Error EzPubSub::PubSubLite::RegisterSubscriber(
+    _In_ const ChannelHandle& channelHandle,
+    _In_ const BATCH_SUBSCRIBER_CALLBACK batchSubscriberCallback,
+    _In_ const SubscriberOption& subscriberOption,
+    _Out_opt_ uint32_t* subscriberId /*= nullptr*/
+)
+{
+    Error retValue = Error::kUnsuccess;
+
+    SubscriberInfo subscriberInfo;
+
+    if ((channelHandle.IsValid() == false) || (batchSubscriberCallback == nullptr))
+    {
+        return retValue;
+    }
+
+    subscriberInfo.batchSubscriberCallback = batchSubscriberCallback;
+    retValue = RegisterSubscriber_(channelHandle.GetChannelName(), &channelHandle, subscriberInfo, &subscriberOption, subscriberId);
+    return retValue;
+}
+
+EzPubSub::Error EzPubSub::PubSubLite::Pause(
+    _In_ const std::wstring& channelName
+)
+{
+    Error retValue = Error::kUnsuccess;
+
+    ChannelInfo* channelInfo = nullptr;
+    std::vector<PendingData> completedDataList;
+
+    if (channelName.length() == 0)
+    {
+        return retValue;
+    }
+
+    channelInfo = AcquireChannelInfo_(channelName);
+    if (channelInfo == nullptr)
+    {
+        retValue = Error::kNotExistChannel;
+        return retValue;
+    }
+
+    // Queued data are not buffered while the fire is stopped, as PublishData is not.
+    channelInfo->fireStatus = FireStatus::kStop;
+    channelInfo->publishEvent.notify_all();
+    AdmitPendingData_(channelInfo, completedDataList);
+    channelInfo->channelSync.unlock();
+
+    CompletePendingData_(completedDataList);
+
+    retValue = Error::kSuccess;
+    return retValue;
+}
+
+EzPubSub::Error EzPubSub::PubSubLite::Resume(
+    _In_ const std::wstring& channelName,
+    _In_opt_ bool clearBuffer /*= false*/
+)
+{
+    Error retValue = Error::kUnsuccess;
+
+    ChannelInfo* channelInfo = nullptr;
+    std::vector<PendingData> completedDataList;
+
+    if (channelName.length() == 0)
+    {
+        return retValue;
+    }
+
+    channelInfo = AcquireChannelInfo_(channelName);
+    if (channelInfo == nullptr)
+    {
+        retValue = Error::kNotExistChannel;
+        return retValue;
+    }
+
+    if ((clearBuffer == true) && (channelInfo->queueType == QueueType::kRing))
+    {
+        // The ring is not popped here, the data before this position are dropped and counted as lost when they are popped.
+        channelInfo->clearedRingPosition = channelInfo->publishedDataRing->GetTailPosition();
+    }
+    else if ((clearBuffer == true) && (channelInfo->queueType == QueueType::kSharedMemory))
+    {
+        // Only the data not fired by this process are cleared, the other processes still fire them.
+        channelInfo->clearedRingPosition = channelInfo->sharedMemoryRing->GetTailPosition();
+    }
+    else if (clearBuffer == true)
+    {
+        if (GetBufferedDataCount_(channelInfo) != 0)
+        {
+            for (uint32_t priority = 0; priority < channelInfo->priorityLaneCount; priority++)
+            {
+                PriorityLane& priorityLane = channelInfo->priorityLaneList[priority];
+
+                channelInfo->lostDataCount += priorityLane.publishedDataList.size();
+                priorityLane.lostDataCount += priorityLane.publishedDataList.size();
+                priorityLane.bufferedDataSize = 0;
+                priorityLane.publishedDataList.clear();
+            }
+            channelInfo->currentBufferedDataSize = 0;
+            channelInfo->conflationIndex.clear();
+            ResetCoalescing_(channelInfo);
+        }
+
+        // kShared, the data moved to the log and not taken by a subscriber yet are lost to it too. Data being fired are still fired.
+        for (auto& subscriberCursor : channelInfo->subscriberCursorList)
+        {
+            if (subscriberCursor.isUnregistered == false)
+            {
+                ReleaseCursorData_(channelInfo, subscriberCursor, true);
+            }
+        }
+        if (channelInfo->subscriberCursorList.size() != 0)
+        {
+            TrimFiredDataLog_(channelInfo);
+        }
+    }
+    channelInfo->fireStatus = FireStatus::kRunning;
+    SignalFireThread_(channelInfo, true);
+    channelInfo->publishEvent.notify_all();
+    AdmitPendingData_(channelInfo, completedDataList);
+    channelInfo->channelSync.unlock();
+
+    CompletePendingData_(completedDataList);
+
+    retValue = Error::kSuccess;
+    return retValue;
+}
+
+EzPubSub::Error EzPubSub::PubSubLite::SetSharedFireThreadCount(
+    _In_ uint32_t threadCount
+)
+{
+    Error retValue = Error::kUnsuccess;
+
+    channelInfoListSync_.lock();
+    if (sharedChannelCount_ != 0)
+    {
+        channelInfoListSync_.unlock();
+        retValue = Error::kExistChannel;
+        return retValue;
+    }
+
+    // The FireExecutor is created again by the next kShared channel.
+    sharedFireThreadCount_ = threadCount;
+    sharedFireExecutor_.reset();
+    channelInfoListSync_.unlock();
+
+    retValue = Error::kSuccess;
+    return retValue;
+}
+
+EzPubSub::Error EzPubSub::PubSubLite::ReplayChannelLog(
+    _In_ const std::wstring& channelName,
+    _In_ uint64_t logOffset,
+    _In_ LOG_REPLAY_CALLBACK replayCallback,
+    _In_opt_ void* replayContext /*= nullptr*/,
+    _Out_opt_ uint64_t* nextLogOffset /*= nullptr*/
+)
+{
+    Error retValue = Error::kUnsuccess;
+
+    ChannelInfo* channelInfo = nullptr;
+
+    if ((channelName.length() == 0) || (replayCallback == nullptr))
+    {
+        return retValue;
+    }
+
+    // No lock is held while replayCallback is called, so it may publish the replayed data again.
+    channelInfo = ReferChannelInfo_(channelName);
+    if (channelInfo == nullptr)
+    {
+        retValue = Error::kNotExistChannel;
+        return retValue;
+    }
+
+    if (channelInfo->channelLog != nullptr)
+    {
+        logOffset = channelInfo->channelLog->Replay(logOffset, replayCallback, replayContext);
+        if (nextLogOffset != nullptr)
+        {
+            *nextLogOffset = logOffset;
+        }
+        retValue = Error::kSuccess;
+    }
+    ReleaseChannelInfo_(channelInfo);
+
+    return retValue;
+}
+
+EzPubSub::Error EzPubSub::PubSubLite::SyncChannelLog(
+    _In_ const std::wstring& channelName
+)
+{
+    Error retValue = Error::kUnsuccess;
+
+    ChannelInfo* channelInfo = nullptr;
+
+    if (channelName.length() == 0)
+    {
+        return retValue;
+    }
+
+    channelInfo = ReferChannelInfo_(channelName);
+    if (channelInfo == nullptr)
+    {
+        retValue = Error::kNotExistChannel;
+        return retValue;
+    }
+
+    if (channelInfo->channelLog != nullptr)
+    {
+        channelInfo->channelLog->Sync();
+        retValue = Error::kSuccess;
+    }
+    ReleaseChannelInfo_(channelInfo);
+
+    return retValue;
+}
+
+EzPubSub::Error EzPubSub::PubSubLite::GetFiredDataCount(
+    _In_ const std::wstring& channelName,
+    _Out_ uint64_t& firedDataCount
+)
+{
+    Error retValue = Error::kUnsuccess;
+
+    ChannelInfo* channelInfo = nullptr;
+
+    if (channelName.length() == 0)
+    {
+        return retValue;
+    }
+
+    channelInfo = AcquireChannelInfo_(channelName);
+    if (channelInfo == nullptr)
+    {
+        retValue = Error::kNotExistChannel;
+        return retValue;
+    }
+
+    firedDataCount = channelInfo->firedDataCount;
+    channelInfo->channelSync.unlock();
+
+    retValue = Error::kSuccess;
+    return retValue;
+}
+
+EzPubSub::Error EzPubSub::PubSubLite::GetLostDataCount(
+    _In_ const std::wstring& channelName,
+    _Out_ uint64_t& lostDataCount
+)
+{
+    Error retValue = Error::kUnsuccess;
+
+    ChannelInfo* channelInfo = nullptr;
+
+    if (channelName.length() == 0)
+    {
+        return retValue;
+    }
+
+    channelInfo = AcquireChannelInfo_(channelName);
+    if (channelInfo == nullptr)
+    {
+        retValue = Error::kNotExistChannel;
+        return retValue;
+    }
+
+    lostDataCount = channelInfo->lostDataCount;
+    channelInfo->channelSync.unlock();
+
+    retValue = Error::kSuccess;
+    return retValue;
+}
+
+EzPubSub::Error EzPubSub::PubSubLite::GetDataPoolStatistics(
+    _In_ const std::wstring& channelName,
+    _Out_ DataPoolStatistics& dataPoolStatistics
+)
+{
+    Error retValue = Error::kUnsuccess;
+
+    ChannelInfo* channelInfo = nullptr;
+
+    if (channelName.length() == 0)
+    {
+        return retValue;
+    }
+
+    channelInfo = AcquireChannelInfo_(channelName);
+    if (channelInfo == nullptr)
+    {
+        retValue = Error::kNotExistChannel;
+        return retValue;
+    }
+
+    channelInfo->dataPool->GetStatistics(dataPoolStatistics);
+    dataPoolStatistics.recycledDataCount = channelInfo->recycledDataList.size();
+    channelInfo->channelSync.unlock();
+
+    retValue = Error::kSuccess;
+    return retValue;
+}
+
+EzPubSub::Error EzPubSub::PubSubLite::GetSubscriberStatistics(
+    _In_ const std::wstring& channelName,
+    _In_ uint32_t subscriberId,
+    _Out_ SubscriberStatistics& subscriberStatistics
+)
+{
+    Error retValue = Error::kUnsuccess;
+
+    ChannelInfo* channelInfo = nullptr;
+
+    if (channelName.length() == 0)
+    {
+        return retValue;
+    }
+
+    channelInfo = AcquireChannelInfo_(channelName);
+    if (channelInfo == nullptr)
+    {
+        retValue = Error::kNotExistChannel;
+        return retValue;
+    }
+
+    if (channelInfo->fireThreadType != FireThreadType::kShared)
+    {
+        channelInfo->channelSync.unlock();
+        return retValue;
+    }
+
+    for (auto& subscriberCursor : channelInfo->subscriberCursorList)
+    {
+        if ((subscriberCursor.isUnregistered == false) &&
+            (subscriberCursor.subscriberInfo.subscriberId == subscriberId))
+        {
+            subscriberStatistics = subscriberCursor.subscriberStatistics;
+            channelInfo->channelSync.unlock();
+
+            retValue = Error::kSuccess;
+            return retValue;
+        }
+    }
+    channelInfo->channelSync.unlock();
+
+    retValue = Error::kNotExistSubscriber;
+    return retValue;
+}
+
+EzPubSub::Error EzPubSub::PubSubLite::GetChannelLogStatistics(
+    _In_ const std::wstring& channelName,
+    _Out_ ChannelLogStatistics& channelLogStatistics
+)
+{
+    Error retValue = Error::kUnsuccess;
+
+    ChannelInfo* channelInfo = nullptr;
+
+    if (channelName.length() == 0)
+    {
+        return retValue;
+    }
+
+    channelInfo = AcquireChannelInfo_(channelName);
+    if (channelInfo == nullptr)
+    {
+        retValue = Error::kNotExistChannel;
+        return retValue;
+    }
+
+    if (channelInfo->channelLog != nullptr)
+    {
+        channelInfo->channelLog->GetStatistics(channelLogStatistics);
+        retValue = Error::kSuccess;
+    }
+    channelInfo->channelSync.unlock();
+
+    return retValue;
+}
+
+EzPubSub::Error EzPubSub::PubSubLite::GetChannelStatistics(
+    _In_ const std::wstring& channelName,
+    _Out_ ChannelStatistics& channelStatistics
+)
+{
+    Error retValue = Error::kUnsuccess;
+
+    ChannelInfo* channelInfo = nullptr;
+
+    if (channelName.length() == 0)
+    {
+        return retValue;
+    }
+
+    channelInfo = AcquireChannelInfo_(channelName);
+    if (channelInfo == nullptr)
+    {
+        retValue = Error::kNotExistChannel;
+        return retValue;
+    }
+
+    GetChannelStatistics_(channelInfo, channelStatistics);
+    channelInfo->channelSync.unlock();
+
+    retValue = Error::kSuccess;
+    return retValue;
+}
+
+EzPubSub::Error EzPubSub::PubSubLite::GetAllChannelStatistics(
+    _Out_ std::vector<ChannelStatistics>& channelStatisticsList
+)
+{
+    /*
+        The channel list is locked shared while every channel is taken one at a time,
+        so channels can not be created or deleted in the meantime.
+    */
+
+    Error retValue = Error::kUnsuccess;
+
+    channelStatisticsList.clear();
+
+    channelInfoListSync_.lock_shared();
+    channelStatisticsList.reserve(channelInfoList_.size());
+    for (auto& channelInfoListEntry : channelInfoList_)
+    {
+        LockChannel_(channelInfoListEntry.second);
+        channelStatisticsList.emplace_back();
+        GetChannelStatistics_(channelInfoListEntry.second, channelStatisticsList.back());
+        channelInfoListEntry.second->channelSync.unlock();
+    }
+    channelInfoListSync_.unlock_shared();
+
+    retValue = Error::kSuccess;
+    return retValue;
+}
+
+EzPubSub::Error EzPubSub::PubSubLite::GetFiredDataCount(
+    _In_ const ChannelHandle& channelHandle,
+    _Out_ uint64_t& firedDataCount
+)
+{
+    Error retValue = Error::kUnsuccess;
+
+    ChannelInfo* channelInfo = nullptr;
+
+    if (channelHandle.IsValid() == false)
+    {
+        return retValue;
+    }
+
+    channelInfo = AcquireChannelInfo_(channelHandle.GetChannelName(), &channelHandle);
+    if (channelInfo == nullptr)
+    {
+        retValue = Error::kNotExistChannel;
+        return retValue;
+    }
+
+    firedDataCount = channelInfo->firedDataCount;
+    channelInfo->channelSync.unlock();
+
+    retValue = Error::kSuccess;
+    return retValue;
+}
+
+EzPubSub::Error EzPubSub::PubSubLite::GetLostDataCount(
+    _In_ const ChannelHandle& channelHandle,
+    _Out_ uint64_t& lostDataCount
+)
+{
+    Error retValue = Error::kUnsuccess;
+
+    ChannelInfo* channelInfo = nullptr;
+
+    if (channelHandle.IsValid() == false)
+    {
+        return retValue;
+    }
+
+    channelInfo = AcquireChannelInfo_(channelHandle.GetChannelName(), &channelHandle);
+    if (channelInfo == nullptr)
+    {
+        retValue = Error::kNotExistChannel;
+        return retValue;
+    }
+
+    lostDataCount = channelInfo->lostDataCount;
+    channelInfo->channelSync.unlock();
+
+    retValue = Error::kSuccess;
+    return retValue;
+}
+
+EzPubSub::Error EzPubSub::PubSubLite::GetDataPoolStatistics(
+    _In_ const ChannelHandle& channelHandle,
+    _Out_ DataPoolStatistics& dataPoolStatistics
+)
+{
+    Error retValue = Error::kUnsuccess;
+
+    ChannelInfo* channelInfo = nullptr;
+
+    if (channelHandle.IsValid() == false)
+    {
+        return retValue;
+    }
+
+    channelInfo = AcquireChannelInfo_(channelHandle.GetChannelName(), &channelHandle);
+    if (channelInfo == nullptr)
+    {
+        retValue = Error::kNotExistChannel;
+        return retValue;
+    }
+
+    channelInfo->dataPool->GetStatistics(dataPoolStatistics);
+    dataPoolStatistics.recycledDataCount = channelInfo->recycledDataList.size();
+    channelInfo->channelSync.unlock();
+
+    retValue = Error::kSuccess;
+    return retValue;
+}
+
+EzPubSub::Error EzPubSub::PubSubLite::GetSubscriberStatistics(
+    _In_ const ChannelHandle& channelHandle,
+    _In_ uint32_t subscriberId,
+    _Out_ SubscriberStatistics& subscriberStatistics
+)
+{
+    Error retValue = Error::kUnsuccess;
+
+    ChannelInfo* channelInfo = nullptr;
+
+    if (channelHandle.IsValid() == false)
+    {
+        return retValue;
+    }
+
+    channelInfo = AcquireChannelInfo_(channelHandle.GetChannelName(), &channelHandle);
+    if (channelInfo == nullptr)
+    {
+        retValue = Error::kNotExistChannel;
+        return retValue;
+    }
+
+    if (channelInfo->fireThreadType != FireThreadType::kShared)
+    {
+        channelInfo->channelSync.unlock();
+        return retValue;
+    }
+
+    for (auto& subscriberCursor : channelInfo->subscriberCursorList)
+    {
+        if ((subscriberCursor.isUnregistered == false) &&
+            (subscriberCursor.subscriberInfo.subscriberId == subscriberId))
+        {
+            subscriberStatistics = subscriberCursor.subscriberStatistics;
+            channelInfo->channelSync.unlock();
+
+            retValue = Error::kSuccess;
+            return retValue;
+        }
+    }
+    channelInfo->channelSync.unlock();
+
+    retValue = Error::kNotExistSubscriber;
+    return retValue;
+}
+
+EzPubSub::Error EzPubSub::PubSubLite::GetChannelLogStatistics(
+    _In_ const ChannelHandle& channelHandle,
+    _Out_ ChannelLogStatistics& channelLogStatistics
+)
+{
+    Error retValue = Error::kUnsuccess;
+
+    ChannelInfo* channelInfo = nullptr;
+
+    if (channelHandle.IsValid() == false)
+    {
+        return retValue;
+    }
+
+    channelInfo = AcquireChannelInfo_(channelHandle.GetChannelName(), &channelHandle);
+    if (channelInfo == nullptr)
+    {
+        retValue = Error::kNotExistChannel;
+        return retValue;
+    }
+
+    if (channelInfo->channelLog != nullptr)
+    {
+        channelInfo->channelLog->GetStatistics(channelLogStatistics);
+        retValue = Error::kSuccess;
+    }
+    channelInfo->channelSync.unlock();
+
+    return retValue;
+}
+
+EzPubSub::Error EzPubSub::PubSubLite::GetChannelStatistics(
+    _In_ const ChannelHandle& channelHandle,
+    _Out_ ChannelStatistics& channelStatistics
+)
+{
+    Error retValue = Error::kUnsuccess;
+
+    ChannelInfo* channelInfo = nullptr;
+
+    if (channelHandle.IsValid() == false)
+    {
+        return retValue;
+    }
+
+    channelInfo = AcquireChannelInfo_(channelHandle.GetChannelName(), &channelHandle);
+    if (channelInfo == nullptr)
+    {
+        retValue = Error::kNotExistChannel;
+        return retValue;
+    }
+
+    GetChannelStatistics_(channelInfo, channelStatistics);
+    channelInfo->channelSync.unlock();
+
+    retValue = Error::kSuccess;
+    return retValue;
+}
+
+std::unordered_map<std::wstring, EzPubSub::ChannelInfo*>::iterator EzPubSub::PubSubLite::SearchChannelInfo_(
+    _In_ const std::wstring& channelName
+)
+{
+    /*
+        If a channel is searched, a global pointer is returned,
+        so the caller using this method must synchronize.
+    */
+
+    return channelInfoList_.find(channelName);
+}
+
+EzPubSub::ChannelInfo* EzPubSub::PubSubLite::FindChannelInfo_(
+    _In_ const std::wstring& channelName,
+    _In_opt_ const ChannelHandle* channelHandle
+)
+{
+    /*
+        The caller using this method must synchronize.
+        Returns the channel of channelHandle if it is given, without searching channelName,
+        and nullptr if the channel is not in the channel list.
+    */
+
+    std::unordered_map<std::wstring, ChannelInfo*>::iterator channelInfoListIter;
+
+    if (channelHandle != nullptr)
+    {
+        return (channelHandle->channelInfo_->isDeleted == false) ? channelHandle->channelInfo_ : nullptr;
+    }
+
+    channelInfoListIter = SearchChannelInfo_(channelName);
+    if (channelInfoListIter == channelInfoList_.end())
+    {
+        return nullptr;
+    }
+
+    return channelInfoListIter->second;
+}
+
+EzPubSub::ChannelInfo* EzPubSub::PubSubLite::AcquireChannelInfo_(
+    _In_ const std::wstring& channelName,
+    _In_opt_ const ChannelHandle* channelHandle /*= nullptr*/
+)
+{
+    /*
+        Returns the channel with its channelSync acquired, the caller must release it.
+        The channel list is only locked shared while the channel is searched and acquired,
+        so DeleteChannel can not delete the channel in the meantime.
+    */
+
+    ChannelInfo* channelInfo = nullptr;
+
+    channelInfoListSync_.lock_shared();
+    channelInfo = FindChannelInfo_(channelName, channelHandle);
+    if (channelInfo == nullptr)
+    {
+        channelInfoListSync_.unlock_shared();
+        return nullptr;
+    }
+
+    LockChannel_(channelInfo);
+    channelInfoListSync_.unlock_shared();
+
+    if (channelInfo->fireStatus == FireStatus::kExit)
+    {
+        channelInfo->channelSync.unlock();
+        return nullptr;
+    }
+
+    return channelInfo;
+}
+
+void EzPubSub::PubSubLite::ReleaseChannelInfo_(
+    _Inout_ ChannelInfo* channelInfo
+)
+{
+    // The channel list and each ChannelHandle release their reference, the last one deletes the channel.
+    if (channelInfo->referenceCount.fetch_sub(1, std::memory_order_acq_rel) == 1)
+    {
+        delete channelInfo->channelLog;
+        delete channelInfo->dataCodec;
+        delete channelInfo;
+    }
+
+    return;
+}
+
+EzPubSub::ChannelInfo* EzPubSub::PubSubLite::ReferChannelInfo_(
+    _In_ const std::wstring& channelName
+)
+{
+    /*
+        Returns the channel with a reference, the caller must release it by ReleaseChannelInfo_.
+        For methods that take long without any lock, the channel may be deleted in the meantime but it is not freed.
+    */
+
+    ChannelInfo* channelInfo = nullptr;
+
+    channelInfoListSync_.lock_shared();
+    channelInfo = FindChannelInfo_(channelName, nullptr);
+    if ((channelInfo == nullptr) || (channelInfo->fireStatus == FireStatus::kExit))
+    {
+        channelInfoListSync_.unlock_shared();
+        return nullptr;
+    }
+    channelInfo->referenceCount++;
+    channelInfoListSync_.unlock_shared();
+
+    return channelInfo;
+}
+
+EzPubSub::ChannelInfo* EzPubSub::PubSubLite::EnterPublisher_(
+    _In_ const std::wstring& channelName,
+    _In_opt_ const ChannelHandle* channelHandle
+)
+{
+    /*
+        Returns the channel with the publisher counted in activePublisherCount, the caller must leave it by LeavePublisher_.
+        DeleteChannel waits for the publishers in the channel before it frees the ring and closes the log,
+        so a publisher does not hold the lock of the channel list while it publishes.
+        The channel of channelHandle is entered without the lock of the channel list at all, the handle keeps its memory alive.
+    */
+
+    ChannelInfo* channelInfo = nullptr;
+
+    if (channelHandle != nullptr)
+    {
+        channelInfo = channelHandle->channelInfo_;
+
+        // Pairs with DeleteChannel, either it sees the publisher or the publisher sees isDeleted.
+        channelInfo->activePublisherCount.fetch_add(1);
+        if (channelInfo->isDeleted == true)
+        {
+            LeavePublisher_(channelInfo);
+            return nullptr;
+        }
+        return channelInfo;
+    }
+
+    channelInfoListSync_.lock_shared();
+    channelInfo = FindChannelInfo_(channelName, nullptr);
+    if (channelInfo != nullptr)
+    {
+        channelInfo->activePublisherCount.fetch_add(1);
+    }
+    channelInfoListSync_.unlock_shared();
+
+    return channelInfo;
+}
+
+void EzPubSub::PubSubLite::LeavePublisher_(
+    _Inout_ ChannelInfo* channelInfo
+)
+{
+    // A channel found by its name may be freed by DeleteChannel right after, so the caller must not access it anymore.
+    channelInfo->activePublisherCount.fetch_sub(1, std::memory_order_release);
+
+    return;
+}
+
+void EzPubSub::PubSubLite::LockChannel_(
+    _Inout_ ChannelInfo* channelInfo
+)
+{
+    /*
+        Acquires channelSync of the channel, and records the time it waited only when another thread held it,
+        so an uncontended lock does not read the clock.
+    */
+
+    uint64_t waitStartTime = 0;
+
+    if (kIsStatisticsEnabled == false)
+    {
+        channelInfo->channelSync.lock();
+        return;
+    }
+
+    if (channelInfo->channelSync.try_lock() == true)
+    {
+        return;
+    }
+
+    waitStartTime = GetStatisticsTime();
+    channelInfo->channelSync.lock();
+    channelInfo->lockWaitTimeHistogram.Record(GetStatisticsTime() - waitStartTime);
+
+    return;
+}
+
+void EzPubSub::PubSubLite::GetChannelStatistics_(
+    _In_ ChannelInfo* channelInfo,
+    _Out_ ChannelStatistics& channelStatistics
+)
+{
+    /*
+        The caller using this method must synchronize.
+        The histograms are recorded without the channel lock, so they may miss the latest values.
+    */
+
+    channelStatistics.channelName = channelInfo->channelName;
+    channelStatistics.firedDataCount = channelInfo->firedDataCount;
+    channelStatistics.lostDataCount = channelInfo->lostDataCount;
+    channelStatistics.conflatedDataCount = channelInfo->conflatedDataCount;
+    channelStatistics.compressedDataCount = channelInfo->compressedDataCount;
+    channelStatistics.compressionSavedSize = channelInfo->compressionSavedSize;
+    channelStatistics.lastValueCount = channelInfo->lastValueCache.size();
+    channelStatistics.bufferedDataCount = GetBufferedDataCount_(channelInfo);
+    channelStatistics.bufferedDataSize = channelInfo->currentBufferedDataSize;
+    channelInfo->deliveryLatencyHistogram.GetSnapshot(channelStatistics.deliveryLatency);
+    channelInfo->lockWaitTimeHistogram.GetSnapshot(channelStatistics.lockWaitTime);
+    channelInfo->bufferedDataCountHistogram.GetSnapshot(channelStatistics.bufferedDataCountSample);
+    channelInfo->bufferedDataSizeHistogram.GetSnapshot(channelStatistics.bufferedDataSizeSample);
+
+    channelStatistics.subscriberStatisticsList.clear();
+    channelStatistics.subscriberStatisticsList.reserve(channelInfo->subscriberInfoList.size());
+    for (auto& subscriberInfo : channelInfo->subscriberInfoList)
+    {
+        channelStatistics.subscriberStatisticsList.emplace_back();
+        channelStatistics.subscriberStatisticsList.back().subscriberId = subscriberInfo.subscriberId;
+        subscriberInfo.callbackTimeHistogram->GetSnapshot(channelStatistics.subscriberStatisticsList.back().callbackTime);
+    }
+
+    channelStatistics.laneStatisticsList.clear();
+    if (channelInfo->queueType == QueueType::kList)
+    {
+        channelStatistics.laneStatisticsList.resize(channelInfo->priorityLaneCount);
+        for (uint32_t priority = 0; priority < channelInfo->priorityLaneCount; priority++)
+        {
+            PriorityLaneStatistics& laneStatistics = channelStatistics.laneStatisticsList[priority];
+
+            laneStatistics.priority = priority;
+            laneStatistics.firedDataCount = channelInfo->priorityLaneList[priority].firedDataCount;
+            laneStatistics.lostDataCount = channelInfo->priorityLaneList[priority].lostDataCount;
+            laneStatistics.bufferedDataCount = channelInfo->priorityLaneList[priority].publishedDataList.size();
+            laneStatistics.bufferedDataSize = channelInfo->priorityLaneList[priority].bufferedDataSize;
+        }
+    }
+
+    return;
+}
+
+EzPubSub::Error EzPubSub::PubSubLite::PublishData_(
+    _In_ const std::wstring& channelName,
+    _In_opt_ const ChannelHandle* channelHandle,
+    _In_opt_ const uint8_t* data,
+    _In_opt_ DataBuffer* dataBuffer,
+    _In_ uint32_t dataSize,
+    _In_opt_ void* userContext,
+    _In_opt_ const std::vector<SUBSCRIBER_CALLBACK>* fireCallbackList,
+    _In_opt_ const SubscriberMask* fireSubscriberMask,
+    _In_ uint32_t priority,
+    _In_opt_ const uint64_t* dataKey,
+    _In_ PublishMode publishMode,
+    _In_opt_ const std::chrono::steady_clock::time_point* deadline,
+    _In_opt_ PUBLISH_COMPLETION_CALLBACK completionCallback,
+    _In_opt_ void* completionContext
+)
+{
+    /*
+        Publishes to the channel of channelHandle if it is given, otherwise to the channel of channelName.
+        Publishes a copy of data if dataBuffer is nullptr, otherwise takes the ownership of dataBuffer.
+        If publishing fails, dataBuffer keeps the data.
+        The data is fired to fireSubscriberMask if it is given, otherwise to the subscribers of fireCallbackList.
+        The data is buffered in the lane of priority, which must be one of the channel.
+        Data of dataKey replaces the buffered data of the same key if the channel has conflationMode.
+        Data of compressionThreshold or larger is buffered compressed if it gets smaller,
+        then dataBuffer is released only if the data is published, and dataSize is the compressed size from there.
+        publishMode decides what is done when the data does not fit in maxBufferedDataSize, deadline is used by kWait,
+        and completionCallback by kAsync.
+    */
+
+    Error retValue = Error::kUnsuccess;
+
+    ChannelInfo* channelInfo = nullptr;
+    PublishedData publishedData;
+    uint32_t previousBufferedDataSize = 0;
+    bool isFull = false;
+    bool isPushed = false;
+    bool isQueued = false;
+    bool isReplaced = false;
+    bool isCompressed = false;
+    std::chrono::steady_clock::time_point channelDeadline;
+    std::vector<PendingData> completedDataList;
+
+    channelInfo = EnterPublisher_(channelName, channelHandle);
+    if (channelInfo == nullptr)
+    {
+        retValue = Error::kNotExistChannel;
+        return retValue;
+    }
+    else if (channelInfo->fireStatus == FireStatus::kExit)
+    {
+        LeavePublisher_(channelInfo);
+        retValue = Error::kNotExistChannel;
+        return retValue;
+    }
+    else if (channelInfo->fireStatus == FireStatus::kStop)
+    {
+        LeavePublisher_(channelInfo);
+        retValue = Error::kBeStoppedFire;
+        return retValue;
+    }
+    else if (priority >= channelInfo->priorityLaneCount)
+    {
+        LeavePublisher_(channelInfo);
+        return retValue;
+    }
+
+    if (channelInfo->queueType == QueueType::kSharedMemory)
+    {
+        // Subscriber IDs and completion callbacks only exist in this process, so such data cannot be published to the others.
+        if ((fireCallbackList != nullptr) || (fireSubscriberMask != nullptr) || (publishMode == PublishMode::kAsync))
+        {
+            LeavePublisher_(channelInfo);
+            return retValue;
+        }
+
+        // The data is copied into the segment, so dataBuffer is released only if it is published.
+        retValue = PublishSharedMemoryData_(channelInfo, (dataBuffer == nullptr) ? data : dataBuffer->GetData(), dataSize, publishMode, deadline);
+        if ((retValue == Error::kSuccess) && (dataBuffer != nullptr))
+        {
+            dataBuffer->Release();
+        }
+        return retValue;
+    }
+
+    // The data is copied or compressed into the data pool of the channel before the channel lock is taken.
+    if ((channelInfo->compressionThreshold != 0) &&
+        (dataSize >= channelInfo->compressionThreshold) &&
+        (CompressData_(channelInfo, (dataBuffer == nullptr) ? data : dataBuffer->GetData(), dataSize, publishedData.dataBuffer) == true))
+    {
+        isCompressed = true;
+        publishedData.isCompressed = true;
+        dataSize = publishedData.dataBuffer.GetDataSize();
+    }
+    else if (dataBuffer == nullptr)
+    {
+        channelInfo->dataPool->Allocate(dataSize, publishedData.dataBuffer);
+        memcpy(publishedData.dataBuffer.GetWritableData(), data, dataSize);
+    }
+    else
+    {
+        publishedData.dataBuffer = std::move(*dataBuffer);
+    }
+
+    publishedData.userContext = userContext;
+    publishedData.publishedTime = (IsStatisticsSample() == true) ? GetStatisticsTime() : 0;
+    publishedData.priority = priority;
+    if (fireSubscriberMask != nullptr)
+    {
+        publishedData.fireSubscriberMask = *fireSubscriberMask;
+    }
+    if (dataKey != nullptr)
+    {
+        publishedData.dataKey = *dataKey;
+        publishedData.isKeyed = true;
+    }
+
+    if (channelInfo->queueType == QueueType::kRing)
+    {
+        // Subscriber callbacks are mapped to their IDs under the channel lock.
+        if ((fireSubscriberMask == nullptr) && (fireCallbackList != nullptr))
+        {
+            LockChannel_(channelInfo);
+            GetFireSubscriberMask_(*channelInfo, *fireCallbackList, publishedData.fireSubscriberMask);
+            channelInfo->channelSync.unlock();
+        }
+
+        // The channel is alive until the publisher leaves it, the channel lock is not needed.
+        // The size is reserved before the push, FireThread may pop and subtract it right after the push.
+        // kDropOldest keeps the reservation and pops the oldest data until it fits.
+        // kAsync data goes behind the queued data, so that they are buffered in published order.
+        if ((publishMode != PublishMode::kAsync) || (channelInfo->pendingDataCount == 0))
+        {
+            previousBufferedDataSize = channelInfo->currentBufferedDataSize.fetch_add(dataSize);
+            isFull = ((previousBufferedDataSize != 0) && (previousBufferedDataSize + dataSize > channelInfo->maxBufferedDataSize));
+            if ((isFull == true) &&
+                (publishMode == PublishMode::kChannelPolicy) &&
+                (channelInfo->overflowPolicy == OverflowPolicy::kDropOldest) &&
+                (channelInfo->blockingSubscriberCount == 0))
+            {
+                DropOldestRingData_(channelInfo);
+                isFull = false;
+            }
+            if (isFull == false)
+            {
+                // The log is locked from before the push, so that data is logged in the order it is pushed.
+                if (channelInfo->channelLog != nullptr)
+                {
+                    channelInfo->channelLog->BeginAppend(publishedData.dataBuffer.GetData(), dataSize, isCompressed);
+                }
+                isPushed = channelInfo->publishedDataRing->TryPush(publishedData);
+                if (channelInfo->channelLog != nullptr)
+                {
+                    channelInfo->channelLog->EndAppend(isPushed);
+                }
+            }
+
+            if (isPushed == true)
+            {
+                // Pairs with the fence in WaitFireSignal_, either FireThread sees the data or we see it waiting.
+                // Likewise FireChannelTask_ clears isFireTaskScheduled before it pops the ring.
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+                if ((channelInfo->isFireThreadWaiting.load(std::memory_order_relaxed) == true) ||
+                    ((channelInfo->fireThreadType == FireThreadType::kShared) &&
+                     (channelInfo->isFireTaskScheduled.load(std::memory_order_relaxed) == false)))
+                {
+                    LockChannel_(channelInfo);
+                    SignalFireThread_(channelInfo, false);
+                    channelInfo->channelSync.unlock();
+                }
+                LeavePublisher_(channelInfo);
+
+                if ((dataBuffer != nullptr) && (isCompressed == true))
+                {
+                    dataBuffer->Release();
+                }
+                if (publishMode == PublishMode::kAsync)
+                {
+                    completionCallback(Error::kSuccess, completionContext);
+                }
+
+                retValue = Error::kSuccess;
+                return retValue;
+            }
+            channelInfo->currentBufferedDataSize -= dataSize;
+        }
+
+        if ((publishMode == PublishMode::kTry) ||
+            ((publishMode == PublishMode::kChannelPolicy) && (IsBlockingPublisher_(channelInfo) == false)))
+        {
+            LeavePublisher_(channelInfo);
+            if ((dataBuffer != nullptr) && (isCompressed == false))
+            {
+                *dataBuffer = std::move(publishedData.dataBuffer);
+            }
+            retValue = Error::kNotEnoughBufferSize;
+            return retValue;
+        }
+    }
+
+    // Waiting publishers hold the channel lock, which keeps the channel alive after they leave it.
+    LockChannel_(channelInfo);
+    LeavePublisher_(channelInfo);
+
+    // Room for the data is made by publishMode when it is published, so the buffer never exceeds maxBufferedDataSize.
+    // The data is buffered anyway if the buffer is empty, so data larger than maxBufferedDataSize is not rejected forever.
+    retValue = (channelInfo->fireStatus == FireStatus::kStop) ? Error::kBeStoppedFire : Error::kSuccess;
+    if ((retValue == Error::kSuccess) &&
+        (channelInfo->queueType == QueueType::kList) &&
+        (fireSubscriberMask == nullptr) &&
+        (fireCallbackList != nullptr))
+    {
+        GetFireSubscriberMask_(*channelInfo, *fireCallbackList, publishedData.fireSubscriberMask);
+    }
+
+    // Keyed data that fits in the place of the buffered data of its key needs no room.
+    if ((retValue == Error::kSuccess) &&
+        (channelInfo->conflationMode != ConflationMode::kNone) &&
+        (publishedData.isKeyed == true))
+    {
+        isReplaced = ReplaceConflatedData_(channelInfo, publishedData);
+    }
+
+    if ((retValue == Error::kSuccess) &&
+        (isReplaced == false) &&
+        (channelInfo->queueType == QueueType::kList) &&
+        (publishMode == PublishMode::kChannelPolicy) &&
+        (channelInfo->overflowPolicy == OverflowPolicy::kDropOldest) &&
+        (IsBlockingPublisher_(channelInfo) == false))
+    {
+        AdjustDataBuffer_(channelInfo, priority, dataSize);
+    }
+
+    if (publishMode == PublishMode::kChannelPolicy)
+    {
+        channelDeadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(channelInfo->blockTimeout);
+        deadline = (channelInfo->blockTimeout != 0) ? &channelDeadline : nullptr;
+    }
+
+    // kAsync data goes behind the queued data, so that they are buffered in published order.
+    // kRing publishers that do not wait reserve room without the channel lock, so the room may be taken again after waiting.
+    isQueued = ((retValue == Error::kSuccess) && (publishMode == PublishMode::kAsync) && (channelInfo->pendingDataList.size() != 0));
+    while ((retValue == Error::kSuccess) && (isQueued == false) && (isReplaced == false) && (PushPublishedData_(channelInfo, publishedData) == false))
+    {
+        if (publishMode == PublishMode::kAsync)
+        {
+            isQueued = true;
+        }
+        else if ((IsBufferFull_(channelInfo, priority, dataSize) == false) ||
+            (publishMode == PublishMode::kTry) ||
+            ((publishMode == PublishMode::kChannelPolicy) && (IsBlockingPublisher_(channelInfo) == false)))
+        {
+            // A full ring of data, not of bytes, is not waited for either.
+            retValue = Error::kNotEnoughBufferSize;
+        }
+        else
+        {
+            retValue = WaitBufferedDataSize_(channelInfo, priority, dataSize, deadline);
+        }
+    }
+
+    if ((retValue == Error::kSuccess) && (isQueued == true))
+    {
+        if ((channelInfo->pendingDataList.size() != 0) &&
+            (channelInfo->pendingDataSize + dataSize > channelInfo->maxBufferedDataSize))
+        {
+            retValue = Error::kNotEnoughBufferSize;
+        }
+        else
+        {
+            channelInfo->pendingDataList.emplace_back();
+            channelInfo->pendingDataList.back().publishedData.userContext = publishedData.userContext;
+            channelInfo->pendingDataList.back().publishedData.publishedTime = publishedData.publishedTime;
+            channelInfo->pendingDataList.back().publishedData.priority = publishedData.priority;
+            channelInfo->pendingDataList.back().publishedData.dataKey = publishedData.dataKey;
+            channelInfo->pendingDataList.back().publishedData.isKeyed = publishedData.isKeyed;
+            channelInfo->pendingDataList.back().publishedData.isCompressed = publishedData.isCompressed;
+            channelInfo->pendingDataList.back().publishedData.fireSubscriberMask = publishedData.fireSubscriberMask;
+            channelInfo->pendingDataList.back().publishedData.dataBuffer = std::move(publishedData.dataBuffer);
+            channelInfo->pendingDataList.back().completionCallback = completionCallback;
+            channelInfo->pendingDataList.back().completionContext = completionContext;
+            channelInfo->pendingDataSize += dataSize;
+            channelInfo->pendingDataCount++;
+
+            // A kRing FireThread may have made room before it saw the queued data.
+            AdmitPendingData_(channelInfo, completedDataList);
+        }
+    }
+    channelInfo->channelSync.unlock();
+
+    if (retValue != Error::kSuccess)
+    {
+        if ((dataBuffer != nullptr) && (isCompressed == false))
+        {
+            *dataBuffer = std::move(publishedData.dataBuffer);
+        }
+        return retValue;
+    }
+
+    if ((dataBuffer != nullptr) && (isCompressed == true))
+    {
+        dataBuffer->Release();
+    }
+    if ((publishMode == PublishMode::kAsync) && (isQueued == false))
+    {
+        completionCallback(Error::kSuccess, completionContext);
+    }
+    CompletePendingData_(completedDataList);
+
+    return retValue;
+}
+
+EzPubSub::Error EzPubSub::PubSubLite::PublishSharedMemoryData_(
+    _Inout_ ChannelInfo* channelInfo,
+    _In_ const uint8_t* data,
+    _In_ uint32_t dataSize,
+    _In_ PublishMode publishMode,
+    _In_opt_ const std::chrono::steady_clock::time_point* deadline
+)
+{
+    /*
+        The caller must have entered the channel by EnterPublisher_, and it leaves when this method returns.
+        Readers of other processes make room, so a waiting publisher does not stay in the channel.
+        It is counted in waitingPublisherCount instead, which DeleteChannel waits for,
+        and waits for room up to kSharedMemoryWaitTime at a time to see Pause and DeleteChannel.
+        Other processes publish to the ring too, so only the data published by this process are logged, after they are published.
+    */
+
+    Error retValue = Error::kUnsuccess;
+
+    bool isDropOldest = ((publishMode == PublishMode::kChannelPolicy) && (channelInfo->overflowPolicy == OverflowPolicy::kDropOldest));
+    std::chrono::steady_clock::time_point channelDeadline;
+    std::chrono::steady_clock::time_point currentTime;
+    uint32_t waitTime = 0;
+
+    // kDropOldest waits for the readers firing the oldest data under the lock of the segment, which holds up the publishers of every process,
+    // so the wait is bounded by blockTimeout, or kSharedMemoryWaitTime without it.
+    if (isDropOldest == true)
+    {
+        waitTime = (channelInfo->blockTimeout != 0) ? channelInfo->blockTimeout : kSharedMemoryWaitTime;
+    }
+    if (channelInfo->sharedMemoryRing->Push(data, dataSize, isDropOldest, waitTime) == true)
+    {
+        if (channelInfo->channelLog != nullptr)
+        {
+            channelInfo->channelLog->Append(data, dataSize);
+        }
+        LeavePublisher_(channelInfo);
+        retValue = Error::kSuccess;
+        return retValue;
+    }
+
+    if ((channelInfo->sharedMemoryRing->IsTooLarge(dataSize) == true) ||
+        ((publishMode != PublishMode::kWait) &&
+         ((publishMode != PublishMode::kChannelPolicy) || (channelInfo->overflowPolicy != OverflowPolicy::kBlock))))
+    {
+        LeavePublisher_(channelInfo);
+        retValue = Error::kNotEnoughBufferSize;
+        return retValue;
+    }
+
+    if (publishMode == PublishMode::kChannelPolicy)
+    {
+        channelDeadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(channelInfo->blockTimeout);
+        deadline = (channelInfo->blockTimeout != 0) ? &channelDeadline : nullptr;
+    }
+
+    LockChannel_(channelInfo);
+    channelInfo->waitingPublisherCount++;
+    channelInfo->channelSync.unlock();
+    LeavePublisher_(channelInfo);
+
+    while (true)
+    {
+        if (channelInfo->fireStatus == FireStatus::kExit)
+        {
+            retValue = Error::kNotExistChannel;
+            break;
+        }
+        else if (channelInfo->fireStatus == FireStatus::kStop)
+        {
+            retValue = Error::kBeStoppedFire;
+            break;
+        }
+
+        waitTime = kSharedMemoryWaitTime;
+        if (deadline != nullptr)
+        {
+            currentTime = std::chrono::steady_clock::now();
+            if (currentTime >= *deadline)
+            {
+                retValue = Error::kNotEnoughBufferSize;
+                break;
+            }
+            waitTime = std::min(waitTime, static_cast<uint32_t>(std::chrono::duration_cast<std::chrono::milliseconds>(*deadline - currentTime).count()) + 1);
+        }
+
+        if (channelInfo->sharedMemoryRing->Push(data, dataSize, false, waitTime) == true)
+        {
+            if (channelInfo->channelLog != nullptr)
+            {
+                channelInfo->channelLog->Append(data, dataSize);
+            }
+            retValue = Error::kSuccess;
+            break;
+        }
+    }
+
+    LockChannel_(channelInfo);
+    channelInfo->waitingPublisherCount--;
+    if (channelInfo->fireStatus == FireStatus::kExit)
+    {
+        channelInfo->fireEvent.notify_all();
+    }
+    channelInfo->channelSync.unlock();
+
+    return retValue;
+}
+
+bool EzPubSub::PubSubLite::PushPublishedData_(
+    _Inout_ ChannelInfo* channelInfo,
+    _Inout_ PublishedData& publishedData
+)
+{
+    /*
+        The caller using this method must synchronize.
+        Buffers publishedData if it fits in maxBufferedDataSize and signals FireThread.
+        If it does not fit, publishedData keeps the data.
+        Keyed data of conflationMode drops the buffered data of its key that it could not replace in its place.
+    */
+
+    uint32_t dataSize = publishedData.dataBuffer.GetDataSize();
+    uint32_t previousBufferedDataSize = 0;
+    bool isPushed = false;
+    PriorityLane& priorityLane = channelInfo->priorityLaneList[publishedData.priority];
+    std::list<PublishedData>::iterator conflatedDataIter;
+
+    if (channelInfo->queueType == QueueType::kRing)
+    {
+        // kRing publishers that do not wait reserve the size without the channel lock.
+        previousBufferedDataSize = channelInfo->currentBufferedDataSize.fetch_add(dataSize);
+        if ((previousBufferedDataSize != 0) && (previousBufferedDataSize + dataSize > channelInfo->maxBufferedDataSize))
+        {
+            channelInfo->currentBufferedDataSize -= dataSize;
+            return false;
+        }
+
+        if (channelInfo->channelLog != nullptr)
+        {
+            channelInfo->channelLog->BeginAppend(publishedData.dataBuffer.GetData(), dataSize, publishedData.isCompressed);
+        }
+        isPushed = channelInfo->publishedDataRing->TryPush(publishedData);
+        if (channelInfo->channelLog != nullptr)
+        {
+            channelInfo->channelLog->EndAppend(isPushed);
+        }
+        if (isPushed == false)
+        {
+            channelInfo->currentBufferedDataSize -= dataSize;
+            return false;
+        }
+    }
+    else
+    {
+        if (IsBufferFull_(channelInfo, publishedData.priority, dataSize) == true)
+        {
+            return false;
+        }
+
+        if (channelInfo->channelLog != nullptr)
+        {
+            channelInfo->channelLog->Append(publishedData.dataBuffer.GetData(), dataSize, publishedData.isCompressed);
+        }
+
+        if (channelInfo->recycledDataList.size() != 0)
+        {
+            priorityLane.publishedDataList.splice(priorityLane.publishedDataList.end(), channelInfo->recycledDataList, channelInfo->recycledDataList.begin());
+        }
+        else
+        {
+            priorityLane.publishedDataList.emplace_back();
+        }
+        priorityLane.publishedDataList.back().userContext = publishedData.userContext;
+        priorityLane.publishedDataList.back().publishedTime = publishedData.publishedTime;
+        priorityLane.publishedDataList.back().priority = publishedData.priority;
+        priorityLane.publishedDataList.back().dataKey = publishedData.dataKey;
+        priorityLane.publishedDataList.back().isKeyed = publishedData.isKeyed;
+        priorityLane.publishedDataList.back().isCompressed = publishedData.isCompressed;
+        priorityLane.publishedDataList.back().fireSubscriberMask = publishedData.fireSubscriberMask;
+        priorityLane.publishedDataList.back().dataBuffer = std::move(publishedData.dataBuffer);
+        priorityLane.bufferedDataSize += dataSize;
+        channelInfo->currentBufferedDataSize += dataSize;
+
+        if ((channelInfo->conflationMode != ConflationMode::kNone) && (publishedData.isKeyed == true))
+        {
+            auto conflationIndexIter = channelInfo->conflationIndex.find(publishedData.dataKey);
+            if (conflationIndexIter != channelInfo->conflationIndex.end())
+            {
+                conflatedDataIter = conflationIndexIter->second;
+                PriorityLane& conflatedLane = channelInfo->priorityLaneList[conflatedDataIter->priority];
+
+                channelInfo->currentBufferedDataSize -= conflatedDataIter->dataBuffer.GetDataSize();
+                conflatedLane.bufferedDataSize -= conflatedDataIter->dataBuffer.GetDataSize();
+                conflatedDataIter->dataBuffer.Release();
+                channelInfo->conflatedDataCount++;
+                if (channelInfo->recycledDataList.size() < kMaxRecycledDataCount)
+                {
+                    channelInfo->recycledDataList.splice(channelInfo->recycledDataList.end(), conflatedLane.publishedDataList, conflatedDataIter);
+                }
+                else
+                {
+                    conflatedLane.publishedDataList.erase(conflatedDataIter);
+                }
+            }
+            channelInfo->conflationIndex[publishedData.dataKey] = std::prev(priorityLane.publishedDataList.end());
+        }
+    }
+    SignalFireThread_(channelInfo, false);
+
+    return true;
+}
+
+EzPubSub::Error EzPubSub::PubSubLite::PublishBatch_(
+    _In_ const std::wstring& channelName,
+    _In_opt_ const ChannelHandle* channelHandle,
+    _In_ const PublishBatchData* batchDataList,
+    _In_ uint32_t batchDataCount
+)
+{
+    /*
+        Publishes to the channel of channelHandle if it is given, otherwise to the channel of channelName.
+        The data are copied into the data pool before the channel lock is taken, and buffered all at once:
+        a kList channel takes the channel lock once, and kRing publishers that do not wait reserve their total size at once
+        and claim consecutive positions of the ring.
+    */
+
+    Error retValue = Error::kUnsuccess;
+
+    ChannelInfo* channelInfo = nullptr;
+    std::vector<PublishedData> publishedDataList;
+    std::vector<ChannelLogData> logDataList;
+    uint32_t batchDataSize = 0;
+    uint32_t previousBufferedDataSize = 0;
+    bool isFull = false;
+    bool isPushed = false;
+    std::chrono::steady_clock::time_point channelDeadline;
+    const std::chrono::steady_clock::time_point* deadline = nullptr;
+
+    channelInfo = EnterPublisher_(channelName, channelHandle);
+    if (channelInfo == nullptr)
+    {
+        retValue = Error::kNotExistChannel;
+        return retValue;
+    }
+    else if (channelInfo->fireStatus == FireStatus::kExit)
+    {
+        LeavePublisher_(channelInfo);
+        retValue = Error::kNotExistChannel;
+        return retValue;
+    }
+    else if (channelInfo->fireStatus == FireStatus::kStop)
+    {
+        LeavePublisher_(channelInfo);
+        retValue = Error::kBeStoppedFire;
+        return retValue;
+    }
+
+    if ((channelInfo->queueType == QueueType::kSharedMemory) ||
+        (PackBatchData_(channelInfo, batchDataList, batchDataCount, publishedDataList, batchDataSize) == false))
+    {
+        LeavePublisher_(channelInfo);
+        return retValue;
+    }
+
+    // The copied data stays in its blocks until it is buffered, so the records are written from it.
+    if (channelInfo->channelLog != nullptr)
+    {
+        logDataList.resize(publishedDataList.size());
+        for (size_t index = 0; index < publishedDataList.size(); index++)
+        {
+            logDataList[index].data = publishedDataList[index].dataBuffer.GetData();
+            logDataList[index].dataSize = publishedDataList[index].dataBuffer.GetDataSize();
+            logDataList[index].isCompressed = publishedDataList[index].isCompressed;
+        }
+    }
+
+    if (channelInfo->queueType == QueueType::kRing)
+    {
+        // As PublishData does, the channel is alive until the publisher leaves it and the size is reserved before the push.
+        previousBufferedDataSize = channelInfo->currentBufferedDataSize.fetch_add(batchDataSize);
+        isFull = ((previousBufferedDataSize != 0) && (previousBufferedDataSize + batchDataSize > channelInfo->maxBufferedDataSize));
+        if ((isFull == true) && (channelInfo->overflowPolicy == OverflowPolicy::kDropOldest) && (channelInfo->blockingSubscriberCount == 0))
+        {
+            DropOldestRingData_(channelInfo);
+            isFull = false;
+        }
+        if (isFull == false)
+        {
+            if (channelInfo->channelLog != nullptr)
+            {
+                channelInfo->channelLog->BeginAppend(logDataList.data(), static_cast<uint32_t>(logDataList.size()));
+            }
+            isPushed = channelInfo->publishedDataRing->TryPushList(publishedDataList.data(), publishedDataList.size());
+            if (channelInfo->channelLog != nullptr)
+            {
+                channelInfo->channelLog->EndAppend(isPushed);
+            }
+        }
+
+        if (isPushed == true)
+        {
+            // Pairs with the fence in WaitFireSignal_, see PublishData_.
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if ((channelInfo->isFireThreadWaiting.load(std::memory_order_relaxed) == true) ||
+                ((channelInfo->fireThreadType == FireThreadType::kShared) &&
+                 (channelInfo->isFireTaskScheduled.load(std::memory_order_relaxed) == false)))
+            {
+                LockChannel_(channelInfo);
+                SignalFireThread_(channelInfo, false);
+                channelInfo->channelSync.unlock();
+            }
+            LeavePublisher_(channelInfo);
+
+            retValue = Error::kSuccess;
+            return retValue;
+        }
+        channelInfo->currentBufferedDataSize -= batchDataSize;
+
+        if (IsBlockingPublisher_(channelInfo) == false)
+        {
+            LeavePublisher_(channelInfo);
+            retValue = Error::kNotEnoughBufferSize;
+            return retValue;
+        }
+    }
+
+    // Waiting publishers hold the channel lock, which keeps the channel alive after they leave it.
+    LockChannel_(channelInfo);
+    LeavePublisher_(channelInfo);
+
+    retValue = (channelInfo->fireStatus == FireStatus::kStop) ? Error::kBeStoppedFire : Error::kSuccess;
+    if ((retValue == Error::kSuccess) &&
+        (channelInfo->queueType == QueueType::kList) &&
+        (channelInfo->overflowPolicy == OverflowPolicy::kDropOldest) &&
+        (IsBlockingPublisher_(channelInfo) == false))
+    {
+        AdjustDataBuffer_(channelInfo, 0, batchDataSize);
+    }
+
+    if (channelInfo->blockTimeout != 0)
+    {
+        channelDeadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(channelInfo->blockTimeout);
+        deadline = &channelDeadline;
+    }
+
+    while ((retValue == Error::kSuccess) && (PushBatchData_(channelInfo, publishedDataList, logDataList, batchDataSize) == false))
+    {
+        if ((IsBufferFull_(channelInfo, 0, batchDataSize) == false) || (IsBlockingPublisher_(channelInfo) == false))
+        {
+            // A ring without enough free positions for the data is not waited for either.
+            retValue = Error::kNotEnoughBufferSize;
+        }
+        else
+        {
+            retValue = WaitBufferedDataSize_(channelInfo, 0, batchDataSize, deadline);
+        }
+    }
+    channelInfo->channelSync.unlock();
+
+    return retValue;
+}
+
+bool EzPubSub::PubSubLite::PackBatchData_(
+    _Inout_ ChannelInfo* channelInfo,
+    _In_ const PublishBatchData* batchDataList,
+    _In_ uint32_t batchDataCount,
+    _Out_ std::vector<PublishedData>& publishedDataList,
+    _Out_ uint32_t& batchDataSize
+)
+{
+    /*
+        Copies each data of batchDataList into its own block of the data pool, and the blocks are allocated with one lock of the pool.
+        Each block is given back when its data is released, so the buffered data size is the size the buffered data holds.
+        Data of compressionThreshold or larger is compressed into a buffer of the thread first if it gets smaller,
+        so its block is allocated by the compressed size.
+    */
+
+    static thread_local std::vector<uint8_t> packingBuffer;
+    static thread_local std::vector<uint32_t> packedDataSizeList;
+    static thread_local std::vector<DataBuffer> packedDataBufferList;
+    const uint8_t* packedData = nullptr;
+    uint64_t totalDataSize = 0;
+    uint32_t packedPosition = 0;
+    uint32_t compressedSize = 0;
+    uint64_t publishedTime = 0;
+
+    for (uint32_t index = 0; index < batchDataCount; index++)
+    {
+        if ((batchDataList[index].data == nullptr) || (batchDataList[index].dataSize == 0))
+        {
+            return false;
+        }
+        totalDataSize += batchDataList[index].dataSize;
+    }
+    if (totalDataSize > UINT32_MAX)
+    {
+        return false;
+    }
+
+    publishedDataList.resize(batchDataCount);
+    packedDataSizeList.resize(batchDataCount);
+    packedDataBufferList.resize(batchDataCount);
+    if (channelInfo->compressionThreshold != 0)
+    {
+        if (packingBuffer.size() < totalDataSize)
+        {
+            packingBuffer.resize(static_cast<size_t>(totalDataSize));
+        }
+
+        for (uint32_t index = 0; index < batchDataCount; index++)
+        {
+            const PublishBatchData& batchData = batchDataList[index];
+
+            compressedSize = 0;
+            if (batchData.dataSize >= channelInfo->compressionThreshold)
+            {
+                compressedSize = channelInfo->dataCodec->Compress(batchData.data, batchData.dataSize, packingBuffer.data() + packedPosition, batchData.dataSize);
+            }
+            if (compressedSize != 0)
+            {
+                publishedDataList[index].isCompressed = true;
+                channelInfo->compressedDataCount.fetch_add(1, std::memory_order_relaxed);
+                channelInfo->compressionSavedSize.fetch_add(batchData.dataSize - compressedSize, std::memory_order_relaxed);
+                packedDataSizeList[index] = compressedSize;
+            }
+            else
+            {
+                memcpy(packingBuffer.data() + packedPosition, batchData.data, batchData.dataSize);
+                packedDataSizeList[index] = batchData.dataSize;
+            }
+            packedPosition += packedDataSizeList[index];
+        }
+        batchDataSize = packedPosition;
+    }
+    else
+    {
+        for (uint32_t index = 0; index < batchDataCount; index++)
+        {
+            packedDataSizeList[index] = batchDataList[index].dataSize;
+        }
+        batchDataSize = static_cast<uint32_t>(totalDataSize);
+    }
+
+    if (channelInfo->dataPool->AllocateList(packedDataSizeList.data(), batchDataCount, packedDataBufferList.data()) == false)
+    {
+        return false;
+    }
+
+    // Data are sampled as PublishData does, and the clock is read once for the batch.
+    packedPosition = 0;
+    for (uint32_t index = 0; index < batchDataCount; index++)
+    {
+        PublishedData& publishedData = publishedDataList[index];
+
+        packedData = (channelInfo->compressionThreshold != 0) ? packingBuffer.data() + packedPosition : batchDataList[index].data;
+        memcpy(packedDataBufferList[index].GetWritableData(), packedData, packedDataSizeList[index]);
+        publishedData.dataBuffer = std::move(packedDataBufferList[index]);
+        publishedData.userContext = batchDataList[index].userContext;
+        if (IsStatisticsSample() == true)
+        {
+            if (publishedTime == 0)
+            {
+                publishedTime = GetStatisticsTime();
+            }
+            publishedData.publishedTime = publishedTime;
+        }
+        packedPosition += packedDataSizeList[index];
+    }
+
+    return true;
+}
+
+bool EzPubSub::PubSubLite::PushBatchData_(
+    _Inout_ ChannelInfo* channelInfo,
+    _Inout_ std::vector<PublishedData>& publishedDataList,
+    _In_ const std::vector<ChannelLogData>& logDataList,
+    _In_ uint32_t batchDataSize
+)
+{
+    /*
+        The caller using this method must synchronize.
+        Buffers all of publishedDataList in priority 0 if their total size fits in maxBufferedDataSize, and signals FireThread once.
+        If it does not fit, publishedDataList keeps the data.
+    */
+
+    uint32_t previousBufferedDataSize = 0;
+    bool isPushed = false;
+    PriorityLane& priorityLane = channelInfo->priorityLaneList[0];
+
+    if (channelInfo->queueType == QueueType::kRing)
+    {
+        // kRing publishers that do not wait reserve the size without the channel lock.
+        previousBufferedDataSize = channelInfo->currentBufferedDataSize.fetch_add(batchDataSize);
+        if ((previousBufferedDataSize != 0) && (previousBufferedDataSize + batchDataSize > channelInfo->maxBufferedDataSize))
+        {
+            channelInfo->currentBufferedDataSize -= batchDataSize;
+            return false;
+        }
+
+        if (channelInfo->channelLog != nullptr)
+        {
+            channelInfo->channelLog->BeginAppend(logDataList.data(), static_cast<uint32_t>(logDataList.size()));
+        }
+        isPushed = channelInfo->publishedDataRing->TryPushList(publishedDataList.data(), publishedDataList.size());
+        if (channelInfo->channelLog != nullptr)
+        {
+            channelInfo->channelLog->EndAppend(isPushed);
+        }
+        if (isPushed == false)
+        {
+            channelInfo->currentBufferedDataSize -= batchDataSize;
+            return false;
+        }
+    }
+    else
+    {
+        if (IsBufferFull_(channelInfo, 0, batchDataSize) == true)
+        {
+            return false;
+        }
+
+        if (channelInfo->channelLog != nullptr)
+        {
+            channelInfo->channelLog->BeginAppend(logDataList.data(), static_cast<uint32_t>(logDataList.size()));
+            channelInfo->channelLog->EndAppend(true);
+        }
+
+        for (auto& publishedData : publishedDataList)
+        {
+            if (channelInfo->recycledDataList.size() != 0)
+            {
+                priorityLane.publishedDataList.splice(priorityLane.publishedDataList.end(), channelInfo->recycledDataList, channelInfo->recycledDataList.begin());
+            }
+            else
+            {
+                priorityLane.publishedDataList.emplace_back();
+            }
+            priorityLane.publishedDataList.back().userContext = publishedData.userContext;
+            priorityLane.publishedDataList.back().publishedTime = publishedData.publishedTime;
+            priorityLane.publishedDataList.back().priority = 0;
+            priorityLane.publishedDataList.back().dataKey = 0;
+            priorityLane.publishedDataList.back().isKeyed = false;
+            priorityLane.publishedDataList.back().isCompressed = publishedData.isCompressed;
+            priorityLane.publishedDataList.back().fireSubscriberMask.SetAll();
+            priorityLane.publishedDataList.back().dataBuffer = std::move(publishedData.dataBuffer);
+        }
+        priorityLane.bufferedDataSize += batchDataSize;
+        channelInfo->currentBufferedDataSize += batchDataSize;
+    }
+    SignalFireThread_(channelInfo, false);
+
+    return true;
+}
+
+bool EzPubSub::PubSubLite::CompressData_(
+    _Inout_ ChannelInfo* channelInfo,
+    _In_ const uint8_t* data,
+    _In_ uint32_t dataSize,
+    _Out_ DataBuffer& compressedDataBuffer
+)
+{
+    /*
+        Compresses data into a block of the data pool, only if it gets smaller.
+        Data is compressed into a buffer of the thread first, so the block is allocated by the compressed size.
+    */
+
+    static thread_local std::vector<uint8_t> compressionBuffer;
+    uint32_t compressedSize = 0;
+
+    if (compressionBuffer.size() < dataSize)
+    {
+        compressionBuffer.resize(dataSize);
+    }
+
+    compressedSize = channelInfo->dataCodec->Compress(data, dataSize, compressionBuffer.data(), dataSize);
+    if ((compressedSize == 0) || (channelInfo->dataPool->Allocate(compressedSize, compressedDataBuffer) == false))
+    {
+        return false;
+    }
+    memcpy(compressedDataBuffer.GetWritableData(), compressionBuffer.data(), compressedSize);
+
+    channelInfo->compressedDataCount.fetch_add(1, std::memory_order_relaxed);
+    channelInfo->compressionSavedSize.fetch_add(dataSize - compressedSize, std::memory_order_relaxed);
+
+    return true;
+}
+
+void EzPubSub::PubSubLite::DecompressDataList_(
+    _Inout_ ChannelInfo* channelInfo,
+    _Inout_ std::list<PublishedData>& publishedDataList
+)
+{
+    /*
+        Called by FireThread without the channel lock, before the data are filtered and fired,
+        so each compressed data is decompressed once whatever the number of its subscribers.
+        The channel compressed the data itself, so decompressing fails only if the data pool cannot allocate the data or the memory is broken.
+        Such data is removed from publishedDataList and counted as lost, subscribers never receive empty data.
+    */
+
+    DataBuffer decompressedDataBuffer;
+    uint32_t decompressedSize = 0;
+    uint64_t laneLostDataCount[kMaxPriorityLaneCount] = { 0, };
+    uint64_t lostDataCount = 0;
+
+    for (auto publishedData = publishedDataList.begin(); publishedData != publishedDataList.end();)
+    {
+        if (publishedData->isCompressed == false)
+        {
+            ++publishedData;
+            continue;
+        }
+
+        decompressedSize = DataCodec::GetDecompressedSize(publishedData->dataBuffer.GetData(), publishedData->dataBuffer.GetDataSize());
+        if ((channelInfo->dataPool->Allocate(decompressedSize, decompressedDataBuffer) == false) ||
+            (channelInfo->dataCodec->Decompress(
+                publishedData->dataBuffer.GetData(),
+                publishedData->dataBuffer.GetDataSize(),
+                decompressedDataBuffer.GetWritableData(),
+                decompressedSize) == false))
+        {
+            decompressedDataBuffer.Release();
+            publishedData->dataBuffer.Release();
+            laneLostDataCount[publishedData->priority]++;
+            lostDataCount++;
+            publishedData = publishedDataList.erase(publishedData);
+            continue;
+        }
+        publishedData->dataBuffer = std::move(decompressedDataBuffer);
+        publishedData->isCompressed = false;
+        ++publishedData;
+    }
+
+    if (lostDataCount != 0)
+    {
+        channelInfo->lostDataCount += lostDataCount;
+        LockChannel_(channelInfo);
+        for (uint32_t priority = 0; priority < kMaxPriorityLaneCount; priority++)
+        {
+            channelInfo->priorityLaneList[priority].lostDataCount += laneLostDataCount[priority];
+        }
+        channelInfo->channelSync.unlock();
+    }
+
+    return;
+}
+
+void EzPubSub::PubSubLite::AdmitPendingData_(
+    _Inout_ ChannelInfo* channelInfo,
+    _Inout_ std::vector<PendingData>& completedDataList
+)
+{
+    /*
+        The caller using this method must synchronize.
+        Buffers the data queued by PublishDataAsync in published order while they fit.
+        If the fire is not running, the queued data fail as PublishData does.
+        The admitted data are moved to completedDataList, and the caller completes them after it releases the channel lock.
+    */
+
+    uint32_t dataSize = 0;
+
+    while (channelInfo->pendingDataList.size() != 0)
+    {
+        PendingData& pendingData = channelInfo->pendingDataList.front();
+
+        dataSize = pendingData.publishedData.dataBuffer.GetDataSize();
+        if (channelInfo->fireStatus == FireStatus::kExit)
+        {
+            pendingData.publishResult = Error::kNotExistChannel;
+        }
+        else if (channelInfo->fireStatus == FireStatus::kStop)
+        {
+            pendingData.publishResult = Error::kBeStoppedFire;
+        }
+        else if (PushPublishedData_(channelInfo, pendingData.publishedData) == true)
+        {
+            pendingData.publishResult = Error::kSuccess;
+        }
+        else
+        {
+            break;
+        }
+
+        channelInfo->pendingDataSize -= dataSize;
+        channelInfo->pendingDataCount--;
+        completedDataList.push_back(std::move(pendingData));
+        channelInfo->pendingDataList.pop_front();
+    }
+
+    return;
+}
+
+void EzPubSub::PubSubLite::CompletePendingData_(
+    _Inout_ std::vector<PendingData>& completedDataList
+)
+{
+    /*
+        Calls the completion callbacks without the channel lock, so that they may publish again.
+        Data that failed are released before their callbacks are called.
+    */
+
+    for (auto& completedData : completedDataList)
+    {
+        completedData.publishedData.dataBuffer.Release();
+        completedData.completionCallback(completedData.publishResult, completedData.completionContext);
+    }
+    completedDataList.clear();
+
+    return;
+}
+
+EzPubSub::Error EzPubSub::PubSubLite::RegisterSubscriber_(
+    _In_ const std::wstring& channelName,
+    _In_opt_ const ChannelHandle* channelHandle,
+    _In_ const SubscriberInfo& subscriberInfo,
+    _In_opt_ const SubscriberOption* subscriberOption,
+    _Out_opt_ uint32_t* subscriberId
+)
+{
+    Error retValue = Error::kUnsuccess;
+
+    ChannelInfo* channelInfo = nullptr;
+
+    channelInfo = AcquireChannelInfo_(channelName, channelHandle);
+    if (channelInfo == nullptr)
+    {
+        retValue = Error::kNotExistChannel;
+        return retValue;
+    }
+
+    retValue = AddSubscriberInfo_(channelInfo, subscriberInfo, subscriberOption, subscriberId);
+    channelInfo->channelSync.unlock();
+
+    return retValue;
+}
+
+EzPubSub::Error EzPubSub::PubSubLite::UnregisterSubscriber_(
+    _In_ const std::wstring& channelName,
+    _In_opt_ const ChannelHandle* channelHandle,
+    _In_ const SubscriberInfo& subscriberInfo
+)
+{
+    Error retValue = Error::kUnsuccess;
+
+    ChannelInfo* channelInfo = nullptr;
+    std::list<SubscriberInfo>::iterator subscriberInfoListIter;
+
+    channelInfo = AcquireChannelInfo_(channelName, channelHandle);
+    if (channelInfo == nullptr)
+    {
+        retValue = Error::kNotExistChannel;
+        return retValue;
+    }
+
+    subscriberInfoListIter = SearchSubscriberInfo_(*channelInfo, subscriberInfo);
+    if (subscriberInfoListIter == channelInfo->subscriberInfoList.end())
+    {
+        channelInfo->channelSync.unlock();
+        retValue = Error::kNotExistSubscriber;
+        return retValue;
+    }
+
+    RemoveSubscriberInfo_(channelInfo, subscriberInfoListIter);
+    channelInfo->channelSync.unlock();
+
+    retValue = Error::kSuccess;
+    return retValue;
+}
+
+EzPubSub::Error EzPubSub::PubSubLite::AddSubscriberInfo_(
+    _Inout_ ChannelInfo* channelInfo,
+    _In_ const SubscriberInfo& subscriberInfo,
+    _In_opt_ const SubscriberOption* subscriberOption,
+    _Out_opt_ uint32_t* subscriberId
+)
+{
+    /*
+        The caller using this method must synchronize.
+        Without subscriberOption, the subscriber uses the overflow policy of the channel.
+    */
+
+    Error retValue = Error::kUnsuccess;
+
+    uint32_t newSubscriberId = 0;
+    SubscriberOption copiedSubscriberOption;
+
+    if ((subscriberOption != nullptr) && (subscriberOption->subscriberFilter.IsValid() == false))
+    {
+        return retValue;
+    }
+    if (SearchSubscriberInfo_(*channelInfo, subscriberInfo) !=
+        channelInfo->subscriberInfoList.end())
+    {
+        retValue = Error::kExistSubscriber;
+        return retValue;
+    }
+
+    // The smallest unused ID is given.
+    while ((newSubscriberId < kMaxSubscriberCount) && (channelInfo->usedSubscriberMask.IsSet(newSubscriberId) == true))
+    {
+        newSubscriberId++;
+    }
+    if (newSubscriberId == kMaxSubscriberCount)
+    {
+        retValue = Error::kExceedSubscriberCount;
+        return retValue;
+    }
+
+    channelInfo->subscriberInfoList.push_back(subscriberInfo);
+    channelInfo->subscriberInfoList.back().subscriberId = newSubscriberId;
+    channelInfo->subscriberInfoList.back().callbackTimeHistogram = std::make_shared<Histogram>();
+    if (subscriberOption != nullptr)
+    {
+        channelInfo->subscriberInfoList.back().subscriberFilter = subscriberOption->subscriberFilter;
+    }
+    if (channelInfo->conflationMode == ConflationMode::kLastValueCache)
+    {
+        channelInfo->subscriberInfoList.back().isSnapshotPending = true;
+        channelInfo->snapshotSubscriberCount++;
+    }
+    channelInfo->usedSubscriberMask.Set(newSubscriberId);
+    if (channelInfo->fireThreadType == FireThreadType::kShared)
+    {
+        // The subscriber receives data moved to firedDataLog after now.
+        channelInfo->subscriberCursorList.emplace_back();
+        channelInfo->subscriberCursorList.back().channelInfo = channelInfo;
+        channelInfo->subscriberCursorList.back().subscriberInfo = channelInfo->subscriberInfoList.back();
+        if (subscriberOption != nullptr)
+        {
+            copiedSubscriberOption = *subscriberOption;
+        }
+        else
+        {
+            copiedSubscriberOption.overflowPolicy = channelInfo->overflowPolicy;
+        }
+        channelInfo->subscriberCursorList.back().subscriberOption = copiedSubscriberOption;
+        channelInfo->subscriberCursorList.back().nextSequence = channelInfo->firedDataLogSequence + channelInfo->firedDataLog.size();
+        if (copiedSubscriberOption.overflowPolicy == OverflowPolicy::kBlock)
+        {
+            channelInfo->blockingSubscriberCount++;
+        }
+    }
+    channelInfo->channelVersion++;
+    if (channelInfo->conflationMode == ConflationMode::kLastValueCache)
+    {
+        SignalFireThread_(channelInfo, true);
+    }
+
+    if (subscriberId != nullptr)
+    {
+        *subscriberId = newSubscriberId;
+    }
+
+    retValue = Error::kSuccess;
+    return retValue;
+}
+
+void EzPubSub::PubSubLite::RemoveSubscriberInfo_(
+    _Inout_ ChannelInfo* channelInfo,
+    _In_ std::list<SubscriberInfo>::iterator subscriberInfoListIter
+)
+{
+    /*
+        The caller using this method must synchronize.
+    */
+
+    if (channelInfo->fireThreadType == FireThreadType::kShared)
+    {
+        for (auto subscriberCursorListIter = channelInfo->subscriberCursorList.begin();
+            subscriberCursorListIter != channelInfo->subscriberCursorList.end();
+            subscriberCursorListIter++)
+        {
+            if ((subscriberCursorListIter->isUnregistered == true) ||
+                (subscriberCursorListIter->subscriberInfo.subscriberId != subscriberInfoListIter->subscriberId))
+            {
+                continue;
+            }
+
+            DetachSubscriberCursor_(channelInfo, *subscriberCursorListIter);
+            if (subscriberCursorListIter->isScheduled == true)
+            {
+                subscriberCursorListIter->isUnregistered = true;
+            }
+            else
+            {
+                channelInfo->subscriberCursorList.erase(subscriberCursorListIter);
+            }
+            TrimFiredDataLog_(channelInfo);
+            break;
+        }
+    }
+    if (subscriberInfoListIter->isSnapshotPending == true)
+    {
+        channelInfo->snapshotSubscriberCount--;
+    }
+    channelInfo->usedSubscriberMask.Reset(subscriberInfoListIter->subscriberId);
+    channelInfo->subscriberInfoList.erase(subscriberInfoListIter);
+    channelInfo->channelVersion++;
+
+    return;
+}
+
+EzPubSub::Error EzPubSub::PubSubLite::RegisterWildcardSubscriber_(
+    _In_ const std::wstring& topicFilter,
+    _In_ const SubscriberInfo& subscriberInfo
+)
+{
+    /*
+        The channel list is locked exclusively, so no channel is created or deleted while the matching channels are updated.
+        If a matching channel has no room for the subscriber, the subscriber is removed from the channels it was added to.
+    */
+
+    Error retValue = Error::kUnsuccess;
+
+    std::list<SubscriberInfo>* wildcardSubscriberList = nullptr;
+    SubscriberInfo wildcardSubscriberInfo = subscriberInfo;
+    std::vector<ChannelInfo*> addedChannelInfoList;
+
+    if (TopicTrie<SubscriberInfo>::IsValidFilter(topicFilter) == false)
+    {
+        return retValue;
+    }
+
+    channelInfoListSync_.lock();
+    wildcardSubscriberList = wildcardSubscriberTrie_.FindValueList(topicFilter);
+    if (wildcardSubscriberList != nullptr)
+    {
+        for (auto& wildcardSubscriber : *wildcardSubscriberList)
+        {
+            if ((wildcardSubscriber.subscriberCallback == subscriberInfo.subscriberCallback) &&
+                (wildcardSubscriber.batchSubscriberCallback == subscriberInfo.batchSubscriberCallback))
+            {
+                channelInfoListSync_.unlock();
+                retValue = Error::kExistSubscriber;
+                return retValue;
+            }
+        }
+    }
+
+    wildcardSubscriberInfo.wildcardSubscriberId = ++lastWildcardSubscriberId_;
+    retValue = Error::kSuccess;
+    for (auto& channelInfoListEntry : channelInfoList_)
+    {
+        if (TopicTrie<SubscriberInfo>::IsMatched(topicFilter, channelInfoListEntry.first) == false)
+        {
+            continue;
+        }
+
+        LockChannel_(channelInfoListEntry.second);
+        retValue = AddSubscriberInfo_(channelInfoListEntry.second, wildcardSubscriberInfo, nullptr, nullptr);
+        channelInfoListEntry.second->channelSync.unlock();
+        if (retValue != Error::kSuccess)
+        {
+            break;
+        }
+        addedChannelInfoList.push_back(channelInfoListEntry.second);
+    }
+
+    if (retValue != Error::kSuccess)
+    {
+        for (auto addedChannelInfo : addedChannelInfoList)
+        {
+            LockChannel_(addedChannelInfo);
+            RemoveSubscriberInfo_(addedChannelInfo, SearchSubscriberInfo_(*addedChannelInfo, wildcardSubscriberInfo));
+            addedChannelInfo->channelSync.unlock();
+        }
+        channelInfoListSync_.unlock();
+        return retValue;
+    }
+
+    wildcardSubscriberTrie_.GetValueList(topicFilter).push_back(wildcardSubscriberInfo);
+    channelInfoListSync_.unlock();
+
+    retValue = Error::kSuccess;
+    return retValue;
+}
+
+EzPubSub::Error EzPubSub::PubSubLite::UnregisterWildcardSubscriber_(
+    _In_ const std::wstring& topicFilter,
+    _In_ const SubscriberInfo& subscriberInfo
+)
+{
+    Error retValue = Error::kUnsuccess;
+
+    std::list<SubscriberInfo>* wildcardSubscriberList = nullptr;
+    SubscriberInfo wildcardSubscriberInfo;
+    std::list<SubscriberInfo>::iterator subscriberInfoListIter;
+
+    channelInfoListSync_.lock();
+    wildcardSubscriberList = wildcardSubscriberTrie_.FindValueList(topicFilter);
+    if (wildcardSubscriberList != nullptr)
+    {
+        for (auto wildcardSubscriberListIter = wildcardSubscriberList->begin();
+            wildcardSubscriberListIter != wildcardSubscriberList->end();
+            wildcardSubscriberListIter++)
+        {
+            if ((wildcardSubscriberListIter->subscriberCallback == subscriberInfo.subscriberCallback) &&
+                (wildcardSubscriberListIter->batchSubscriberCallback == subscriberInfo.batchSubscriberCallback))
+            {
+                wildcardSubscriberInfo = *wildcardSubscriberListIter;
+                wildcardSubscriberList->erase(wildcardSubscriberListIter);
+                wildcardSubscriberTrie_.Prune(topicFilter);
+                retValue = Error::kSuccess;
+                break;
+            }
+        }
+    }
+
+    if (retValue != Error::kSuccess)
+    {
+        channelInfoListSync_.unlock();
+        retValue = Error::kNotExistSubscriber;
+        return retValue;
+    }
+
+    for (auto& channelInfoListEntry : channelInfoList_)
+    {
+        if (TopicTrie<SubscriberInfo>::IsMatched(topicFilter, channelInfoListEntry.first) == false)
+        {
+            continue;
+        }
+
+        LockChannel_(channelInfoListEntry.second);
+        subscriberInfoListIter = SearchSubscriberInfo_(*channelInfoListEntry.second, wildcardSubscriberInfo);
+        if (subscriberInfoListIter != channelInfoListEntry.second->subscriberInfoList.end())
+        {
+            RemoveSubscriberInfo_(channelInfoListEntry.second, subscriberInfoListIter);
+        }
+        channelInfoListEntry.second->channelSync.unlock();
+    }
+    channelInfoListSync_.unlock();
+
+    return retValue;
+}
+
+std::list<EzPubSub::SubscriberInfo>::iterator EzPubSub::PubSubLite::SearchSubscriberInfo_(
+    _In_ ChannelInfo& channelInfo,
+    _In_ const SubscriberInfo& subscriberInfo
+)
+{
+    /*
+        If a subscriber is searched by its callback, a global pointer is returned,
+        so the caller using this method must synchronize.
+        A callback registered by name and by wildcard subscriptions is a different subscriber for each of them.
+    */
+
+    auto subscriberInfoListIter = channelInfo.subscriberInfoList.begin();
+
+    for (; subscriberInfoListIter != channelInfo.subscriberInfoList.end(); subscriberInfoListIter++)
+    {
+        if ((subscriberInfoListIter->subscriberCallback == subscriberInfo.subscriberCallback) &&
+            (subscriberInfoListIter->batchSubscriberCallback == subscriberInfo.batchSubscriberCallback) &&
+            (subscriberInfoListIter->wildcardSubscriberId == subscriberInfo.wildcardSubscriberId))
+        {
+            return subscriberInfoListIter;
+        }
+    }
+
+    return subscriberInfoListIter;
+}
+
+void EzPubSub::PubSubLite::GetFireSubscriberMask_(
+    _In_ ChannelInfo& channelInfo,
+    _In_ const std::vector<SUBSCRIBER_CALLBACK>& fireCallbackList,
+    _Out_ SubscriberMask& fireSubscriberMask
+)
+{
+    /*
+        The caller using this method must synchronize.
+        An empty fireCallbackList fires the data to all subscribers.
+    */
+
+    if (fireCallbackList.size() == 0)
+    {
+        fireSubscriberMask.SetAll();
+        return;
+    }
+
+    fireSubscriberMask.Clear();
+    for (auto& subscriberInfo : channelInfo.subscriberInfoList)
+    {
+        if (subscriberInfo.subscriberCallback == nullptr)
+        {
+            continue;
+        }
+
+        for (auto fireCallbackListEntry : fireCallbackList)
+        {
+            if (fireCallbackListEntry == subscriberInfo.subscriberCallback)
+            {
+                fireSubscriberMask.Set(subscriberInfo.subscriberId);
+                break;
+            }
+        }
+    }
+
+    return;
+}
+
+void EzPubSub::PubSubLite::FireThread_(
+    ChannelInfo* channelInfo
+)
+{
+    /*
+        All published data are spliced out of the buffer under one lock and fired without it,
+        then the fired nodes are spliced back to recycledDataList under one more lock.
+        A channel with priority lanes takes out up to kMaxLaneFiredDataCount data at a time, see TakeLaneData_.
+        kLastValueCache fires the cached data to new subscribers before it fires data with them.
+    */
+
+    std::vector<SubscriberInfo> copiedSubscriberInfoList;
+    std::vector<SubscriberInfo> snapshotSubscriberInfoList;
+    uint32_t copiedChannelVersion = 0;
+    bool isLastValueCache = (channelInfo->conflationMode == ConflationMode::kLastValueCache);
+    std::list<PublishedData> firingDataList;
+    FireBuffer fireBuffer;
+    std::vector<PendingData> completedDataList;
+    size_t firingDataCount = 0;
+    uint64_t laneFiredDataCount[kMaxPriorityLaneCount] = { 0, };
+
+    LockChannel_(channelInfo);
+    copiedSubscriberInfoList.assign(channelInfo->subscriberInfoList.begin(), channelInfo->subscriberInfoList.end());
+    copiedChannelVersion = channelInfo->channelVersion;
+    channelInfo->channelSync.unlock();
+
+    while (true)
+    {
+        LockChannel_(channelInfo);
+        // Terminate thread if fire is exit.
+        if (channelInfo->fireStatus == FireStatus::kExit)
+        {
+            channelInfo->channelSync.unlock();
+            break;
+        }
+
+        if ((channelInfo->snapshotSubscriberCount != 0) && (channelInfo->fireStatus == FireStatus::kRunning))
+        {
+            snapshotSubscriberInfoList.clear();
+            for (auto& subscriberInfo : channelInfo->subscriberInfoList)
+            {
+                if (subscriberInfo.isSnapshotPending == true)
+                {
+                    subscriberInfo.isSnapshotPending = false;
+                    snapshotSubscriberInfoList.push_back(subscriberInfo);
+                }
+            }
+            channelInfo->snapshotSubscriberCount = 0;
+            channelInfo->channelSync.unlock();
+
+            FireLastValueSnapshot_(channelInfo, snapshotSubscriberInfoList, fireBuffer);
+            continue;
+        }
+
+        // If no published data or fire status is stop, wait for the fire signal or sleep by flush time.
+        if ((GetBufferedDataCount_(channelInfo) == 0) || (channelInfo->fireStatus == FireStatus::kStop))
+        {
+            WaitFireSignal_(channelInfo);
+            continue;
+        }
+        // Coalesced data waits for the thresholds or the timer.
+        if (IsCoalescingDone_(channelInfo) == false)
+        {
+            ArmCoalescingTimer_(channelInfo);
+            WaitFireSignal_(channelInfo);
+            continue;
+        }
+
+        if (channelInfo->channelVersion != copiedChannelVersion)
+        {
+            copiedSubscriberInfoList.assign(channelInfo->subscriberInfoList.begin(), channelInfo->subscriberInfoList.end());
+            copiedChannelVersion = channelInfo->channelVersion;
+        }
+
+        channelInfo->bufferedDataCountHistogram.Record(GetBufferedDataCount_(channelInfo));
+        channelInfo->bufferedDataSizeHistogram.Record(channelInfo->currentBufferedDataSize);
+
+        // The data being fired are no longer buffered, so Resume and AdjustDataBuffer_ only see data published after them.
+        TakeLaneData_(channelInfo, firingDataList);
+        ResetCoalescing_(channelInfo);
+        // Data left in the lanes were due as well, so they do not wait for the coalescing again.
+        if (GetBufferedDataCount_(channelInfo) != 0)
+        {
+            channelInfo->isCoalescingTimeExpired = true;
+        }
+        if (channelInfo->waitingPublisherCount != 0)
+        {
+            channelInfo->publishEvent.notify_all();
+        }
+        AdmitPendingData_(channelInfo, completedDataList);
+        channelInfo->channelSync.unlock();
+
+        CompletePendingData_(completedDataList);
+        if (channelInfo->dataCodec != nullptr)
+        {
+            DecompressDataList_(channelInfo, firingDataList);
+        }
+        FireDataList_(channelInfo, copiedSubscriberInfoList, firingDataList, fireBuffer);
+
+        firingDataCount = firingDataList.size();
+        for (auto& firingData : firingDataList)
+        {
+            // Keyed data of kLastValueCache is moved to the cache instead.
+            if ((isLastValueCache == false) || (firingData.isKeyed == false))
+            {
+                firingData.dataBuffer.Release();
+            }
+            laneFiredDataCount[firingData.priority]++;
+        }
+
+        LockChannel_(channelInfo);
+        if (isLastValueCache == true)
+        {
+            UpdateLastValueCache_(channelInfo, firingDataList);
+        }
+        channelInfo->firedDataCount += firingDataCount;
+        for (uint32_t priority = 0; priority < channelInfo->priorityLaneCount; priority++)
+        {
+            channelInfo->priorityLaneList[priority].firedDataCount += laneFiredDataCount[priority];
+            laneFiredDataCount[priority] = 0;
+        }
+        if (channelInfo->recycledDataList.size() < kMaxRecycledDataCount)
+        {
+            channelInfo->recycledDataList.splice(channelInfo->recycledDataList.end(), firingDataList);
+        }
+        channelInfo->channelSync.unlock();
+
+        // Nodes that were not recycled are freed without the lock.
+        firingDataList.clear();
+    }
+}
+
+void EzPubSub::PubSubLite::FireRingThread_(
+    ChannelInfo* channelInfo
+)
+{
+    /*
+        The ring has a single consumer, so this thread pops and fires without the channel lock.
+        The channel lock is only taken to refresh the subscriber list and settings when channelVersion is changed,
+        and to wait for the fire signal.
+        Up to kMaxRingFiredDataCount data are popped into firingDataList and fired as a batch.
+    */
+
+    std::vector<SubscriberInfo> copiedSubscriberInfoList;
+    uint32_t copiedChannelVersion = 0;
+    uint32_t copiedCoalescedTime = 0;
+    bool isPopped = false;
+    size_t bufferedDataCount = 0;
+    uint64_t headPosition = 0;
+    uint32_t dataSize = 0;
+    std::list<PublishedData> firingDataList;
+    std::list<PublishedData> recycledDataList;
+    FireBuffer fireBuffer;
+    std::vector<PendingData> completedDataList;
+    size_t firingDataCount = 0;
+
+    LockChannel_(channelInfo);
+    copiedSubscriberInfoList.assign(channelInfo->subscriberInfoList.begin(), channelInfo->subscriberInfoList.end());
+    copiedCoalescedTime = channelInfo->coalescedTime;
+    copiedChannelVersion = channelInfo->channelVersion;
+    channelInfo->channelSync.unlock();
+
+    while (true)
+    {
+        // Terminate thread if fire is exit.
+        if (channelInfo->fireStatus == FireStatus::kExit)
+        {
+            break;
+        }
+
+        if (channelInfo->channelVersion.load(std::memory_order_acquire) != copiedChannelVersion)
+        {
+            LockChannel_(channelInfo);
+            copiedSubscriberInfoList.assign(channelInfo->subscriberInfoList.begin(), channelInfo->subscriberInfoList.end());
+            copiedCoalescedTime = channelInfo->coalescedTime;
+            copiedChannelVersion = channelInfo->channelVersion;
+            channelInfo->channelSync.unlock();
+        }
+
+        /*
+            Coalesced data waits for the thresholds or the timer, checked under the channel lock once per batch.
+            Publishers arm the timer only while this thread waits, so data published while it fires is timed from when it finds them.
+        */
+        if ((copiedCoalescedTime != 0) &&
+            (channelInfo->fireStatus == FireStatus::kRunning) &&
+            (channelInfo->publishedDataRing->GetSize() != 0))
+        {
+            LockChannel_(channelInfo);
+            if (IsCoalescingDone_(channelInfo) == false)
+            {
+                ArmCoalescingTimer_(channelInfo);
+                WaitFireSignal_(channelInfo);
+                continue;
+            }
+            ResetCoalescing_(channelInfo);
+            channelInfo->channelSync.unlock();
+        }
+
+        // Sampled before popping, the publishers may push more while this thread pops.
+        bufferedDataCount = channelInfo->publishedDataRing->GetSize();
+        if (bufferedDataCount != 0)
+        {
+            channelInfo->bufferedDataCountHistogram.Record(bufferedDataCount);
+            channelInfo->bufferedDataSizeHistogram.Record(channelInfo->currentBufferedDataSize);
+        }
+
+        // kDropOldest publishers pop the ring too, so it is popped under ringPopSync, which they rarely contend for.
+        isPopped = false;
+        channelInfo->ringPopSync.lock();
+        while ((channelInfo->fireStatus == FireStatus::kRunning) && (firingDataList.size() < kMaxRingFiredDataCount))
+        {
+            if (recycledDataList.size() == 0)
+            {
+                recycledDataList.emplace_back();
+            }
+
+            headPosition = channelInfo->publishedDataRing->GetHeadPosition();
+            if (channelInfo->publishedDataRing->TryPop(recycledDataList.front()) == false)
+            {
+                break;
+            }
+            dataSize = recycledDataList.front().dataBuffer.GetDataSize();
+            channelInfo->currentBufferedDataSize -= dataSize;
+            isPopped = true;
+
+            // Data cleared by Resume are lost.
+            if (headPosition < channelInfo->clearedRingPosition)
+            {
+                recycledDataList.front().dataBuffer.Release();
+                channelInfo->lostDataCount++;
+                continue;
+            }
+
+            firingDataList.splice(firingDataList.end(), recycledDataList, recycledDataList.begin());
+        }
+        channelInfo->ringPopSync.unlock();
+
+        // Publishers waiting for room and queued data check the buffered data size under the channel lock after they count themselves,
+        // so the lock is taken to signal and admit them.
+        if ((isPopped == true) &&
+            ((channelInfo->waitingPublisherCount != 0) || (channelInfo->pendingDataCount != 0)))
+        {
+            LockChannel_(channelInfo);
+            channelInfo->publishEvent.notify_all();
+            AdmitPendingData_(channelInfo, completedDataList);
+            channelInfo->channelSync.unlock();
+
+            CompletePendingData_(completedDataList);
+        }
+
+        // If no published data or fire status is stop, wait for the fire signal or sleep by flush time.
+        if (firingDataList.size() == 0)
+        {
+            LockChannel_(channelInfo);
+            WaitFireSignal_(channelInfo);
+            continue;
+        }
+
+        if (channelInfo->dataCodec != nullptr)
+        {
+            DecompressDataList_(channelInfo, firingDataList);
+        }
+        FireDataList_(channelInfo, copiedSubscriberInfoList, firingDataList, fireBuffer);
+
+        firingDataCount = firingDataList.size();
+        for (auto& firingData : firingDataList)
+        {
+            firingData.dataBuffer.Release();
+        }
+        recycledDataList.splice(recycledDataList.end(), firingDataList);
+        channelInfo->firedDataCount += firingDataCount;
+    }
+}
+
+void EzPubSub::PubSubLite::FireSharedMemoryThread_(
+    ChannelInfo* channelInfo
+)
+{
+    /*
+        Data are fired straight from the segment, and they stay claimed until every subscriber received them.
+        Like FireRingThread_, the channel lock is only taken to refresh the subscriber list and settings when channelVersion is changed,
+        and to wait while the fire is stopped.
+        Publishers of any process wake this thread through the futex of the segment in kEvent mode.
+    */
+
+    std::vector<SubscriberInfo> copiedSubscriberInfoList;
+    uint32_t copiedChannelVersion = 0;
+    uint32_t copiedFlushTime = 0;
+    FireMode copiedFireMode = FireMode::kPolling;
+    SharedMemoryRing* sharedMemoryRing = channelInfo->sharedMemoryRing;
+    uint32_t publishSequence = 0;
+    uint64_t lostDataCount = 0;
+    std::vector<FiredData> firedDataList;
+    FireBuffer fireBuffer;
+    bool hasSubscriberFilter = false;
+    size_t firedDataCount = 0;
+    bool isSampled = false;
+    uint64_t firedTime = 0;
+    uint64_t calledTime = 0;
+
+    LockChannel_(channelInfo);
+    copiedSubscriberInfoList.assign(channelInfo->subscriberInfoList.begin(), channelInfo->subscriberInfoList.end());
+    copiedFlushTime = channelInfo->flushTime;
+    copiedFireMode = channelInfo->fireMode;
+    copiedChannelVersion = channelInfo->channelVersion;
+    channelInfo->channelSync.unlock();
+    hasSubscriberFilter = HasSubscriberFilter_(copiedSubscriberInfoList);
+
+    while (true)
+    {
+        // Terminate thread if fire is exit.
+        if (channelInfo->fireStatus == FireStatus::kExit)
+        {
+            break;
+        }
+
+        if (channelInfo->channelVersion.load(std::memory_order_acquire) != copiedChannelVersion)
+        {
+            LockChannel_(channelInfo);
+            copiedSubscriberInfoList.assign(channelInfo->subscriberInfoList.begin(), channelInfo->subscriberInfoList.end());
+            copiedFlushTime = channelInfo->flushTime;
+            copiedFireMode = channelInfo->fireMode;
+            copiedChannelVersion = channelInfo->channelVersion;
+            channelInfo->channelSync.unlock();
+            hasSubscriberFilter = HasSubscriberFilter_(copiedSubscriberInfoList);
+        }
+
+        // Data published while the fire is stopped stay in the segment, unless Resume clears them.
+        if (channelInfo->fireStatus == FireStatus::kStop)
+        {
+            LockChannel_(channelInfo);
+            WaitFireSignal_(channelInfo);
+            continue;
+        }
+
+        publishSequence = sharedMemoryRing->GetPublishSequence();
+        firedDataList.clear();
+        sharedMemoryRing->ReadDataList(channelInfo->clearedRingPosition, kMaxRingFiredDataCount, firedDataList, lostDataCount);
+        if (firedDataList.size() != 0)
+        {
+            channelInfo->bufferedDataCountHistogram.Record(firedDataList.size());
+            channelInfo->bufferedDataSizeHistogram.Record(sharedMemoryRing->GetBufferedDataSize());
+        }
+        if ((hasSubscriberFilter == true) && (firedDataList.size() != 0))
+        {
+            FilterFiredDataList_(copiedSubscriberInfoList, firedDataList, fireBuffer);
+        }
+
+        // Records do not keep the time they were published, so data are sampled here and only the callbacks are timed.
+        for (size_t dataIndex = 0; dataIndex < firedDataList.size(); dataIndex++)
+        {
+            FiredData& firedData = firedDataList[dataIndex];
+
+            isSampled = IsStatisticsSample();
+            firedTime = (isSampled == true) ? GetStatisticsTime() : 0;
+            for (auto& subscriberInfo : copiedSubscriberInfoList)
+            {
+                if ((subscriberInfo.subscriberCallback != nullptr) &&
+                    ((hasSubscriberFilter == false) || (fireBuffer.fireSubscriberMaskList[dataIndex].IsSet(subscriberInfo.subscriberId) == true)))
+                {
+                    subscriberInfo.subscriberCallback(firedData.data, firedData.dataSize, firedData.userContext);
+                    if (isSampled == true)
+                    {
+                        calledTime = GetStatisticsTime();
+                        subscriberInfo.callbackTimeHistogram->Record(calledTime - firedTime);
+                        firedTime = calledTime;
+                    }
+                }
+            }
+        }
+        for (auto& subscriberInfo : copiedSubscriberInfoList)
+        {
+            if ((subscriberInfo.batchSubscriberCallback == nullptr) || (firedDataList.size() == 0))
+            {
+                continue;
+            }
+
+            if (subscriberInfo.subscriberFilter.filterType == FilterType::kNone)
+            {
+                firedTime = GetStatisticsTime();
+                subscriberInfo.batchSubscriberCallback(firedDataList.data(), static_cast<uint32_t>(firedDataList.size()));
+                subscriberInfo.callbackTimeHistogram->Record(GetStatisticsTime() - firedTime);
+                continue;
+            }
+
+            fireBuffer.firedDataList.clear();
+            for (size_t dataIndex = 0; dataIndex < firedDataList.size(); dataIndex++)
+            {
+                if (fireBuffer.fireSubscriberMaskList[dataIndex].IsSet(subscriberInfo.subscriberId) == true)
+                {
+                    fireBuffer.firedDataList.push_back(firedDataList[dataIndex]);
+                }
+            }
+            if (fireBuffer.firedDataList.size() != 0)
+            {
+                firedTime = GetStatisticsTime();
+                subscriberInfo.batchSubscriberCallback(fireBuffer.firedDataList.data(), static_cast<uint32_t>(fireBuffer.firedDataList.size()));
+                subscriberInfo.callbackTimeHistogram->Record(GetStatisticsTime() - firedTime);
+            }
+        }
+        sharedMemoryRing->ReleaseDataList();
+
+        firedDataCount = firedDataList.size();
+        channelInfo->firedDataCount += firedDataCount;
+        channelInfo->lostDataCount += lostDataCount;
+        channelInfo->currentBufferedDataSize = sharedMemoryRing->GetBufferedDataSize();
+
+        // If no published data, wait for a publisher of any process or sleep by flush time.
+        if ((firedDataCount == 0) && (lostDataCount == 0))
+        {
+            if (copiedFireMode == FireMode::kEvent)
+            {
+                sharedMemoryRing->WaitPublish(publishSequence, copiedFlushTime);
+            }
+            else
+            {
+                std::this_thread::sleep_for(std::chrono::milliseconds(copiedFlushTime));
+            }
+        }
+    }
+}
+
+void EzPubSub::PubSubLite::FireData_(
+    _Inout_ ChannelInfo* channelInfo,
+    _In_ const std::vector<SubscriberInfo>& subscriberInfoList,
+    _In_ const PublishedData& publishedData,
+    _In_ const SubscriberMask& fireSubscriberMask
+)
+{
+    /*
+        Calls of sampled data are timed, one clock read for each call since a call ends when the next one starts.
+        fireSubscriberMask is fireSubscriberMask of publishedData, without the subscribers whose filter does not match it.
+    */
+
+    uint64_t firedTime = 0;
+    uint64_t calledTime = 0;
+
+    if (publishedData.publishedTime != 0)
+    {
+        firedTime = GetStatisticsTime();
+    }
+
+    for (auto& subscriberInfo : subscriberInfoList)
+    {
+        if ((subscriberInfo.subscriberCallback != nullptr) &&
+            (fireSubscriberMask.IsSet(subscriberInfo.subscriberId) == true))
+        {
+            subscriberInfo.subscriberCallback(
+                publishedData.dataBuffer.GetData(),
+                publishedData.dataBuffer.GetDataSize(),
+                publishedData.userContext
+            );
+
+            if (publishedData.publishedTime != 0)
+            {
+                channelInfo->deliveryLatencyHistogram.Record(GetElapsedTime(publishedData.publishedTime, firedTime));
+                calledTime = GetStatisticsTime();
+                subscriberInfo.callbackTimeHistogram->Record(calledTime - firedTime);
+                firedTime = calledTime;
+            }
+        }
+    }
+
+    return;
+}
+
+void EzPubSub::PubSubLite::FireDataList_(
+    _Inout_ ChannelInfo* channelInfo,
+    _In_ const std::vector<SubscriberInfo>& subscriberInfoList,
+    _In_ const std::list<PublishedData>& firingDataList,
+    _Inout_ FireBuffer& fireBuffer
+)
+{
+    /*
+        Subscribers receive the data one by one in published order,
+        and then batch subscribers receive their data at once.
+        If every data is fired to all subscribers, batch subscribers share one firedDataList,
+        otherwise firedDataList is built for each batch subscriber.
+        If a subscriber has a filter, the filters are evaluated over the whole firingDataList first,
+        and the data is fired by fireSubscriberMaskList instead of its own fireSubscriberMask.
+    */
+
+    bool hasBatchSubscriber = false;
+    bool hasSubscriberFilter = HasSubscriberFilter_(subscriberInfoList);
+    bool isFiredToAll = (hasSubscriberFilter == false);
+    uint64_t firedTime = 0;
+    size_t dataIndex = 0;
+    const uint8_t* matchList = nullptr;
+
+    for (auto& subscriberInfo : subscriberInfoList)
+    {
+        if (subscriberInfo.batchSubscriberCallback != nullptr)
+        {
+            hasBatchSubscriber = true;
+            break;
+        }
+    }
+
+    if (hasSubscriberFilter == true)
+    {
+        fireBuffer.filterColumn.Clear();
+        fireBuffer.fireSubscriberMaskList.clear();
+        for (auto& firingData : firingDataList)
+        {
+            fireBuffer.filterColumn.Append(firingData.dataBuffer.GetData(), firingData.dataBuffer.GetDataSize());
+            fireBuffer.fireSubscriberMaskList.push_back(firingData.fireSubscriberMask);
+        }
+
+        for (auto& subscriberInfo : subscriberInfoList)
+        {
+            if (subscriberInfo.subscriberFilter.filterType == FilterType::kNone)
+            {
+                continue;
+            }
+
+            matchList = fireBuffer.filterColumn.Evaluate(subscriberInfo.subscriberFilter);
+            for (dataIndex = 0; dataIndex < fireBuffer.fireSubscriberMaskList.size(); dataIndex++)
+            {
+                if (matchList[dataIndex] == 0)
+                {
+                    fireBuffer.fireSubscriberMaskList[dataIndex].Reset(subscriberInfo.subscriberId);
+                }
+            }
+        }
+    }
+
+    dataIndex = 0;
+    for (auto& firingData : firingDataList)
+    {
+        const SubscriberMask& fireSubscriberMask = (hasSubscriberFilter == true) ? fireBuffer.fireSubscriberMaskList[dataIndex] : firingData.fireSubscriberMask;
+
+        FireData_(channelInfo, subscriberInfoList, firingData, fireSubscriberMask);
+        dataIndex++;
+
+        if (firingData.fireSubscriberMask.IsAll() == false)
+        {
+            isFiredToAll = false;
+        }
+    }
+
+    if (hasBatchSubscriber == false)
+    {
+        return;
+    }
+
+    fireBuffer.firedDataList.clear();
+    for (auto& subscriberInfo : subscriberInfoList)
+    {
+        if (subscriberInfo.batchSubscriberCallback == nullptr)
+        {
+            continue;
+        }
+
+        if ((isFiredToAll == false) || (fireBuffer.firedDataList.size() == 0))
+        {
+            fireBuffer.firedDataList.clear();
+            dataIndex = 0;
+            for (auto& firingData : firingDataList)
+            {
+                const SubscriberMask& fireSubscriberMask = (hasSubscriberFilter == true) ? fireBuffer.fireSubscriberMaskList[dataIndex] : firingData.fireSubscriberMask;
+
+                if (fireSubscriberMask.IsSet(subscriberInfo.subscriberId) == true)
+                {
+                    fireBuffer.firedDataList.emplace_back();
+                    fireBuffer.firedDataList.back().data = firingData.dataBuffer.GetData();
+                    fireBuffer.firedDataList.back().dataSize = firingData.dataBuffer.GetDataSize();
+                    fireBuffer.firedDataList.back().userContext = firingData.userContext;
+                }
+                dataIndex++;
+            }
+        }
+
+        if (fireBuffer.firedDataList.size() == 0)
+        {
+            continue;
+        }
+
+        // Every batch is timed, the latency only for the sampled data in it.
+        firedTime = GetStatisticsTime();
+        if (kIsStatisticsEnabled == true)
+        {
+            dataIndex = 0;
+            for (auto& firingData : firingDataList)
+            {
+                const SubscriberMask& fireSubscriberMask = (hasSubscriberFilter == true) ? fireBuffer.fireSubscriberMaskList[dataIndex] : firingData.fireSubscriberMask;
+
+                if ((firingData.publishedTime != 0) && (fireSubscriberMask.IsSet(subscriberInfo.subscriberId) == true))
+                {
+                    channelInfo->deliveryLatencyHistogram.Record(GetElapsedTime(firingData.publishedTime, firedTime));
+                }
+                dataIndex++;
+            }
+        }
+        subscriberInfo.batchSubscriberCallback(fireBuffer.firedDataList.data(), static_cast<uint32_t>(fireBuffer.firedDataList.size()));
+        subscriberInfo.callbackTimeHistogram->Record(GetStatisticsTime() - firedTime);
+    }
+
+    return;
+}
+
+bool EzPubSub::PubSubLite::HasSubscriberFilter_(
+    _In_ const std::vector<SubscriberInfo>& subscriberInfoList
+)
+{
+    for (auto& subscriberInfo : subscriberInfoList)
+    {
+        if (subscriberInfo.subscriberFilter.filterType != FilterType::kNone)
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void EzPubSub::PubSubLite::FilterFiredDataList_(
+    _In_ const std::vector<SubscriberInfo>& subscriberInfoList,
+    _In_ const std::vector<FiredData>& firedDataList,
+    _Inout_ FireBuffer& fireBuffer
+)
+{
+    /*
+        kSharedMemory, whose data is fired to every subscriber.
+        fireSubscriberMaskList of fireBuffer receives the subscribers each data of firedDataList is fired to after the filters.
+    */
+
+    const uint8_t* matchList = nullptr;
+
+    fireBuffer.filterColumn.Clear();
+    fireBuffer.fireSubscriberMaskList.resize(firedDataList.size());
+    for (size_t dataIndex = 0; dataIndex < firedDataList.size(); dataIndex++)
+    {
+        fireBuffer.filterColumn.Append(firedDataList[dataIndex].data, firedDataList[dataIndex].dataSize);
+        fireBuffer.fireSubscriberMaskList[dataIndex].SetAll();
+    }
+
+    for (auto& subscriberInfo : subscriberInfoList)
+    {
+        if (subscriberInfo.subscriberFilter.filterType == FilterType::kNone)
+        {
+            continue;
+        }
+
+        matchList = fireBuffer.filterColumn.Evaluate(subscriberInfo.subscriberFilter);
+        for (size_t dataIndex = 0; dataIndex < firedDataList.size(); dataIndex++)
+        {
+            if (matchList[dataIndex] == 0)
+            {
+                fireBuffer.fireSubscriberMaskList[dataIndex].Reset(subscriberInfo.subscriberId);
+            }
+        }
+    }
+
+    return;
+}
+
+void EzPubSub::PubSubLite::AdjustDataBuffer_(
+    _Inout_ ChannelInfo* channelInfo,
+    _In_ uint32_t priority,
+    _In_ uint32_t dataSize
+)
+{
+    /*
+        The caller using this method must synchronize.
+        Drops the oldest data of the lane of priority until dataSize more fits in its budget,
+        then the oldest data from the lowest lane up to the lane of priority until it fits in maxBufferedDataSize, and counts them as lost.
+        Each data is dropped at most once, so the cost is amortized over PublishData.
+    */
+
+    PriorityLane& priorityLane = channelInfo->priorityLaneList[priority];
+
+    while ((priorityLane.maxBufferedDataSize != 0) &&
+        (priorityLane.publishedDataList.size() != 0) &&
+        (priorityLane.bufferedDataSize + dataSize > priorityLane.maxBufferedDataSize))
+    {
+        DropOldestLaneData_(channelInfo, priorityLane);
+    }
+
+    for (uint32_t lowerPriority = 0; lowerPriority <= priority; lowerPriority++)
+    {
+        while ((channelInfo->priorityLaneList[lowerPriority].publishedDataList.size() != 0) &&
+            (channelInfo->currentBufferedDataSize + dataSize > channelInfo->maxBufferedDataSize))
+        {
+            DropOldestLaneData_(channelInfo, channelInfo->priorityLaneList[lowerPriority]);
+        }
+    }
+
+    return;
+}
+
+void EzPubSub::PubSubLite::DropOldestLaneData_(
+    _Inout_ ChannelInfo* channelInfo,
+    _Inout_ PriorityLane& priorityLane
+)
+{
+    /*
+        The caller using this method must synchronize.
+    */
+
+    uint32_t dataSize = priorityLane.publishedDataList.front().dataBuffer.GetDataSize();
+
+    UnindexConflatedData_(channelInfo, priorityLane.publishedDataList.begin());
+    channelInfo->currentBufferedDataSize -= dataSize;
+    priorityLane.bufferedDataSize -= dataSize;
+    priorityLane.publishedDataList.front().dataBuffer.Release();
+    channelInfo->lostDataCount++;
+    priorityLane.lostDataCount++;
+
+    if (channelInfo->recycledDataList.size() < kMaxRecycledDataCount)
+    {
+        channelInfo->recycledDataList.splice(channelInfo->recycledDataList.end(), priorityLane.publishedDataList, priorityLane.publishedDataList.begin());
+    }
+    else
+    {
+        priorityLane.publishedDataList.pop_front();
+    }
+
+    return;
+}
+
+void EzPubSub::PubSubLite::DropOldestRingData_(
+    _Inout_ ChannelInfo* channelInfo
+)
+{
+    /*
+        kDropOldest of a kRing channel, called by a publisher after it reserved the size of its data.
+        Pops the oldest data and counts them as lost until currentBufferedDataSize fits in maxBufferedDataSize,
+        or the ring is empty, and the rest is the reservations of publishers that did not push yet, or only the data of the caller.
+        Popping is serialized with FireThread by ringPopSync, the channel lock is not needed.
+    */
+
+    PublishedData droppedData;
+
+    channelInfo->ringPopSync.lock();
+    while (channelInfo->currentBufferedDataSize > channelInfo->maxBufferedDataSize)
+    {
+        if (channelInfo->publishedDataRing->TryPop(droppedData) == true)
+        {
+            channelInfo->currentBufferedDataSize -= droppedData.dataBuffer.GetDataSize();
+            droppedData.dataBuffer.Release();
+            channelInfo->lostDataCount++;
+        }
+        else if (channelInfo->publishedDataRing->GetSize() == 0)
+        {
+            break;
+        }
+        else
+        {
+            // The publisher of the oldest position claimed it and is moving its data in, which does not take any lock.
+            std::this_thread::yield();
+        }
+    }
+    channelInfo->ringPopSync.unlock();
+
+    return;
+}
+
+bool EzPubSub::PubSubLite::IsBlockingPublisher_(
+    _In_ ChannelInfo* channelInfo
+)
+{
+    // A kBlock subscriber can not lose data, so the publisher waits whatever the channel policy is.
+    return ((channelInfo->overflowPolicy == OverflowPolicy::kBlock) || (channelInfo->blockingSubscriberCount != 0));
+}
+
+bool EzPubSub::PubSubLite::IsBufferFull_(
+    _In_ ChannelInfo* channelInfo,
+    _In_ uint32_t priority,
+    _In_ uint32_t dataSize
+)
+{
+    // The data is buffered anyway if the buffer is empty, so data larger than maxBufferedDataSize is not rejected forever.
+    // Likewise an empty lane takes data larger than its budget.
+    const PriorityLane& priorityLane = channelInfo->priorityLaneList[priority];
+
+    return (((channelInfo->currentBufferedDataSize != 0) &&
+             (channelInfo->currentBufferedDataSize + dataSize > channelInfo->maxBufferedDataSize)) ||
+            ((priorityLane.maxBufferedDataSize != 0) &&
+             (priorityLane.bufferedDataSize != 0) &&
+             (priorityLane.bufferedDataSize + dataSize > priorityLane.maxBufferedDataSize)));
+}
+
+EzPubSub::Error EzPubSub::PubSubLite::WaitBufferedDataSize_(
+    _Inout_ ChannelInfo* channelInfo,
+    _In_ uint32_t priority,
+    _In_ uint32_t dataSize,
+    _In_opt_ const std::chrono::steady_clock::time_point* deadline
+)
+{
+    /*
+        The caller must hold channelSync of the channel.
+        Waits until dataSize fits in maxBufferedDataSize and the budget of the lane of priority, until deadline unless it is nullptr.
+        A kRing FireThread pops without the channel lock, so the publisher counts itself before it checks the buffered data size,
+        and FireThread takes the channel lock to signal once it sees a waiting publisher.
+    */
+
+    Error retValue = Error::kUnsuccess;
+
+    bool isTimeout = false;
+
+    channelInfo->waitingPublisherCount++;
+    while ((channelInfo->fireStatus == FireStatus::kRunning) && (IsBufferFull_(channelInfo, priority, dataSize) == true))
+    {
+        if (isTimeout == true)
+        {
+            break;
+        }
+
+        if (deadline == nullptr)
+        {
+            channelInfo->publishEvent.wait(channelInfo->channelSync);
+        }
+        else
+        {
+            isTimeout = (channelInfo->publishEvent.wait_until(channelInfo->channelSync, *deadline) == std::cv_status::timeout);
+        }
+    }
+    channelInfo->waitingPublisherCount--;
+
+    // Room may be made right after the timeout.
+    if ((isTimeout == true) && (IsBufferFull_(channelInfo, priority, dataSize) == false))
+    {
+        isTimeout = false;
+    }
+
+    if (channelInfo->fireStatus == FireStatus::kExit)
+    {
+        // DeleteChannel waits for the publishers that waited for room.
+        channelInfo->fireEvent.notify_all();
+        retValue = Error::kNotExistChannel;
+    }
+    else if (channelInfo->fireStatus == FireStatus::kStop)
+    {
+        retValue = Error::kBeStoppedFire;
+    }
+    else if (isTimeout == true)
+    {
+        retValue = Error::kNotEnoughBufferSize;
+    }
+    else
+    {
+        retValue = Error::kSuccess;
+    }
+
+    return retValue;
+}
+
+void EzPubSub::PubSubLite::SignalFireThread_(
+    _Inout_ ChannelInfo* channelInfo,
+    _In_ bool isForced
+)
+{
+    /*
+        The caller using this method must synchronize.
+        Only a waiting FireThread of kEvent mode is signaled, and it is signaled once per wait.
+    */
+
+    bool isSignaled = false;
+
+    if (channelInfo->fireThreadType == FireThreadType::kShared)
+    {
+        if ((isForced == false) && (IsCoalescingDone_(channelInfo) == false))
+        {
+            ArmCoalescingTimer_(channelInfo);
+            return;
+        }
+        ScheduleFireTask_(channelInfo);
+        return;
+    }
+
+    // FireThread of kSharedMemory waits for data on the futex of the segment, so it is woken there too.
+    if ((channelInfo->sharedMemoryRing != nullptr) && (isForced == true))
+    {
+        channelInfo->sharedMemoryRing->Wake();
+    }
+
+    if (channelInfo->fireMode != FireMode::kEvent)
+    {
+        return;
+    }
+
+    // The timer is armed even if FireThread does not wait, by the first data buffered since the last fire.
+    if ((isForced == false) && (IsCoalescingDone_(channelInfo) == false))
+    {
+        ArmCoalescingTimer_(channelInfo);
+        return;
+    }
+
+    if (channelInfo->isFireThreadWaiting == false)
+    {
+        return;
+    }
+
+    if ((isForced == true) ||
+        (channelInfo->coalescedTime != 0) ||
+        ((channelInfo->coalescedDataCount == 0) && (channelInfo->coalescedDataSize == 0)))
+    {
+        isSignaled = true;
+    }
+    else if ((channelInfo->coalescedDataCount != 0) && (GetBufferedDataCount_(channelInfo) >= channelInfo->coalescedDataCount))
+    {
+        isSignaled = true;
+    }
+    else if ((channelInfo->coalescedDataSize != 0) && (channelInfo->currentBufferedDataSize >= channelInfo->coalescedDataSize))
+    {
+        isSignaled = true;
+    }
+
+    if (isSignaled == true)
+    {
+        channelInfo->isFireThreadWaiting = false;
+        channelInfo->fireEvent.notify_one();
+    }
+
+    return;
+}
+
+void EzPubSub::PubSubLite::WaitFireSignal_(
+    _Inout_ ChannelInfo* channelInfo
+)
+{
+    /*
+        The caller must hold channelSync of the channel, and it is released when this method returns.
+        Data that did not reach the coalescing threshold is fired at the latest after flush time.
+    */
+
+    uint32_t copiedFlushTime = channelInfo->flushTime;
+
+    if (channelInfo->fireMode == FireMode::kEvent)
+    {
+        // A kRing publisher does not take the channel lock, so fireable data is checked again after marking waiting.
+        channelInfo->isFireThreadWaiting = true;
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (HasFireableData_(channelInfo) == false)
+        {
+            channelInfo->fireEvent.wait_for(channelInfo->channelSync, std::chrono::milliseconds(copiedFlushTime));
+        }
+        channelInfo->isFireThreadWaiting = false;
+        channelInfo->channelSync.unlock();
+    }
+    else
+    {
+        channelInfo->channelSync.unlock();
+        std::this_thread::sleep_for(std::chrono::milliseconds(copiedFlushTime));
+    }
+
+    return;
+}
+
+bool EzPubSub::PubSubLite::IsCoalescingDone_(
+    _In_ ChannelInfo* channelInfo
+)
+{
+    /*
+        The caller using this method must synchronize.
+        Without coalescedTime, coalescing only decides when a waiting FireThread is signaled, see SignalFireThread_.
+    */
+
+    if ((channelInfo->coalescedTime == 0) ||
+        (channelInfo->queueType == QueueType::kSharedMemory) ||
+        ((channelInfo->fireThreadType == FireThreadType::kDedicated) && (channelInfo->fireMode != FireMode::kEvent)))
+    {
+        return true;
+    }
+
+    if (channelInfo->isCoalescingTimeExpired == true)
+    {
+        return true;
+    }
+    if ((channelInfo->coalescedDataCount != 0) && (GetBufferedDataCount_(channelInfo) >= channelInfo->coalescedDataCount))
+    {
+        return true;
+    }
+    if ((channelInfo->coalescedDataSize != 0) && (channelInfo->currentBufferedDataSize >= channelInfo->coalescedDataSize))
+    {
+        return true;
+    }
+
+    return false;
+}
+
+void EzPubSub::PubSubLite::ArmCoalescingTimer_(
+    _Inout_ ChannelInfo* channelInfo
+)
+{
+    /*
+        The caller using this method must synchronize.
+        Only the first data buffered since the last fire arms the timer, the later ones are fired with it.
+    */
+
+    if (channelInfo->coalescingDeadline != 0)
+    {
+        return;
+    }
+
+    channelInfo->coalescingDeadline = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count()) + static_cast<uint64_t>(channelInfo->coalescedTime) * 1000;
+    channelInfo->coalescingTimerWheel->Schedule(&channelInfo->coalescingTimer, channelInfo->coalescingDeadline);
+
+    return;
+}
+
+void EzPubSub::PubSubLite::ResetCoalescing_(
+    _Inout_ ChannelInfo* channelInfo
+)
+{
+    /*
+        The caller using this method must synchronize.
+        Called when the buffered data is taken out to be fired. A call of the timer in progress sees coalescingDeadline is 0.
+    */
+
+    if (channelInfo->coalescingDeadline != 0)
+    {
+        channelInfo->coalescingTimerWheel->Unschedule(&channelInfo->coalescingTimer);
+        channelInfo->coalescingDeadline = 0;
+    }
+    channelInfo->isCoalescingTimeExpired = false;
+
+    return;
+}
+
+void EzPubSub::PubSubLite::CoalescingTimerCallback_(
+    _In_opt_ void* timerContext
+)
+{
+    /*
+        Called by the thread of the timer wheel. DeleteChannel cancels the timer after kExit, and waits for this call.
+    */
+
+    ChannelInfo* channelInfo = static_cast<ChannelInfo*>(timerContext);
+    uint64_t currentTime = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count());
+
+    LockChannel_(channelInfo);
+    // The timer of data fired before, or rearmed since, is ignored.
+    if ((channelInfo->coalescingDeadline != 0) && (currentTime >= channelInfo->coalescingDeadline))
+    {
+        channelInfo->isCoalescingTimeExpired = true;
+        SignalFireThread_(channelInfo, true);
+    }
+    channelInfo->channelSync.unlock();
+
+    return;
+}
+
+size_t EzPubSub::PubSubLite::GetBufferedDataCount_(
+    _In_ ChannelInfo* channelInfo
+)
+{
+    size_t bufferedDataCount = 0;
+
+    if (channelInfo->queueType == QueueType::kRing)
+    {
+        return channelInfo->publishedDataRing->GetSize();
+    }
+
+    for (uint32_t priority = 0; priority < channelInfo->priorityLaneCount; priority++)
+    {
+        bufferedDataCount += channelInfo->priorityLaneList[priority].publishedDataList.size();
+    }
+
+    return bufferedDataCount;
+}
+
+uint32_t EzPubSub::PubSubLite::SelectPriorityLane_(
+    _Inout_ ChannelInfo* channelInfo
+)
+{
+    /*
+        The caller using this method must synchronize.
+        Returns the priority of the lane whose oldest data is fired next, or kMaxPriorityLaneCount if every lane is empty.
+        kWeighted gives the turn to the next lower lane, from the lowest back to the highest, once the lane of the turn
+        fired its weight or is empty, so the turn comes back to a lane at most after every other lane.
+    */
+
+    uint32_t priority = channelInfo->priorityLaneCount - 1;
+
+    if (channelInfo->laneScheduling == LaneScheduling::kStrict)
+    {
+        while (channelInfo->priorityLaneList[priority].publishedDataList.size() == 0)
+        {
+            if (priority == 0)
+            {
+                return kMaxPriorityLaneCount;
+            }
+            priority--;
+        }
+
+        return priority;
+    }
+
+    for (uint32_t turnCount = 0; turnCount <= channelInfo->priorityLaneCount; turnCount++)
+    {
+        priority = channelInfo->scheduledLaneIndex;
+        if ((channelInfo->remainingLaneWeight != 0) && (channelInfo->priorityLaneList[priority].publishedDataList.size() != 0))
+        {
+            channelInfo->remainingLaneWeight--;
+            return priority;
+        }
+
+        channelInfo->scheduledLaneIndex = (priority == 0) ? channelInfo->priorityLaneCount - 1 : priority - 1;
+        channelInfo->remainingLaneWeight = channelInfo->priorityLaneList[channelInfo->scheduledLaneIndex].weight;
+    }
+
+    return kMaxPriorityLaneCount;
+}
+
+void EzPubSub::PubSubLite::TakeLaneData_(
+    _Inout_ ChannelInfo* channelInfo,
+    _Inout_ std::list<PublishedData>& firingDataList
+)
+{
+    /*
+        The caller using this method must synchronize.
+        Splices the buffered data to be fired next to firingDataList.
+        With one lane, every buffered data is spliced at once.
+        With priority lanes, up to kMaxLaneFiredDataCount data are spliced one by one in the order of SelectPriorityLane_.
+    */
+
+    uint32_t priority = 0;
+    uint32_t dataSize = 0;
+
+    if (channelInfo->priorityLaneCount == 1)
+    {
+        firingDataList.splice(firingDataList.end(), channelInfo->priorityLaneList[0].publishedDataList);
+        channelInfo->priorityLaneList[0].bufferedDataSize = 0;
+        channelInfo->currentBufferedDataSize = 0;
+        channelInfo->conflationIndex.clear();
+        return;
+    }
+
+    for (uint32_t takenDataCount = 0; takenDataCount < kMaxLaneFiredDataCount; takenDataCount++)
+    {
+        priority = SelectPriorityLane_(channelInfo);
+        if (priority == kMaxPriorityLaneCount)
+        {
+            break;
+        }
+
+        PriorityLane& priorityLane = channelInfo->priorityLaneList[priority];
+
+        dataSize = priorityLane.publishedDataList.front().dataBuffer.GetDataSize();
+        priorityLane.bufferedDataSize -= dataSize;
+        channelInfo->currentBufferedDataSize -= dataSize;
+        UnindexConflatedData_(channelInfo, priorityLane.publishedDataList.begin());
+        firingDataList.splice(firingDataList.end(), priorityLane.publishedDataList, priorityLane.publishedDataList.begin());
+    }
+
+    return;
+}
+
+bool EzPubSub::PubSubLite::ReplaceConflatedData_(
+    _Inout_ ChannelInfo* channelInfo,
+    _Inout_ PublishedData& publishedData
+)
+{
+    /*
+        The caller using this method must synchronize.
+        Replaces the buffered data of the key of publishedData in its place, if the difference of their sizes fits in the buffer.
+        If it is not replaced, publishedData keeps the data.
+    */
+
+    uint32_t dataSize = publishedData.dataBuffer.GetDataSize();
+    uint32_t conflatedDataSize = 0;
+    auto conflationIndexIter = channelInfo->conflationIndex.find(publishedData.dataKey);
+
+    if (conflationIndexIter == channelInfo->conflationIndex.end())
+    {
+        return false;
+    }
+
+    PublishedData& conflatedData = *conflationIndexIter->second;
+    PriorityLane& priorityLane = channelInfo->priorityLaneList[conflatedData.priority];
+
+    conflatedDataSize = conflatedData.dataBuffer.GetDataSize();
+    if ((dataSize > conflatedDataSize) && (IsBufferFull_(channelInfo, conflatedData.priority, dataSize - conflatedDataSize) == true))
+    {
+        return false;
+    }
+
+    if (channelInfo->channelLog != nullptr)
+    {
+        channelInfo->channelLog->Append(publishedData.dataBuffer.GetData(), dataSize, publishedData.isCompressed);
+    }
+
+    // Assigning the data buffer gives the replaced data back to the data pool.
+    conflatedData.userContext = publishedData.userContext;
+    conflatedData.publishedTime = publishedData.publishedTime;
+    conflatedData.isCompressed = publishedData.isCompressed;
+    conflatedData.fireSubscriberMask = publishedData.fireSubscriberMask;
+    conflatedData.dataBuffer = std::move(publishedData.dataBuffer);
+    priorityLane.bufferedDataSize = priorityLane.bufferedDataSize - conflatedDataSize + dataSize;
+    channelInfo->currentBufferedDataSize -= conflatedDataSize;
+    channelInfo->currentBufferedDataSize += dataSize;
+    channelInfo->conflatedDataCount++;
+
+    return true;
+}
+
+void EzPubSub::PubSubLite::UnindexConflatedData_(
+    _Inout_ ChannelInfo* channelInfo,
+    _In_ std::list<PublishedData>::iterator publishedDataListIter
+)
+{
+    /*
+        The caller using this method must synchronize.
+        Called before buffered data leaves its lane.
+    */
+
+    if ((channelInfo->conflationMode == ConflationMode::kNone) || (publishedDataListIter->isKeyed == false))
+    {
+        return;
+    }
+
+    auto conflationIndexIter = channelInfo->conflationIndex.find(publishedDataListIter->dataKey);
+    if ((conflationIndexIter != channelInfo->conflationIndex.end()) && (conflationIndexIter->second == publishedDataListIter))
+    {
+        channelInfo->conflationIndex.erase(conflationIndexIter);
+    }
+
+    return;
+}
+
+void EzPubSub::PubSubLite::UpdateLastValueCache_(
+    _Inout_ ChannelInfo* channelInfo,
+    _Inout_ std::list<PublishedData>& firedDataList
+)
+{
+    /*
+        The caller using this method must synchronize.
+        Moves the fired keyed data to lastValueCache, which gives the data they replace back to the data pool.
+    */
+
+    for (auto& firedData : firedDataList)
+    {
+        if (firedData.isKeyed == false)
+        {
+            continue;
+        }
+
+        PublishedData& lastValue = channelInfo->lastValueCache[firedData.dataKey];
+        lastValue.userContext = firedData.userContext;
+        lastValue.dataKey = firedData.dataKey;
+        lastValue.isKeyed = true;
+        lastValue.dataBuffer = std::move(firedData.dataBuffer);
+    }
+
+    return;
+}
+
+void EzPubSub::PubSubLite::FireLastValueSnapshot_(
+    _Inout_ ChannelInfo* channelInfo,
+    _In_ const std::vector<SubscriberInfo>& snapshotSubscriberInfoList,
+    _Inout_ FireBuffer& fireBuffer
+)
+{
+    /*
+        Called by FireThread without the channel lock, lastValueCache is only changed by FireThread.
+        Fires the last data of each key to each subscriber of snapshotSubscriberInfoList that matches its filter.
+    */
+
+    for (const auto& subscriberInfo : snapshotSubscriberInfoList)
+    {
+        if (subscriberInfo.subscriberCallback != nullptr)
+        {
+            for (const auto& lastValue : channelInfo->lastValueCache)
+            {
+                if (subscriberInfo.subscriberFilter.IsMatched(lastValue.second.dataBuffer.GetData(), lastValue.second.dataBuffer.GetDataSize()) == true)
+                {
+                    subscriberInfo.subscriberCallback(lastValue.second.dataBuffer.GetData(), lastValue.second.dataBuffer.GetDataSize(), lastValue.second.userContext);
+                }
+            }
+            continue;
+        }
+
+        fireBuffer.firedDataList.clear();
+        for (const auto& lastValue : channelInfo->lastValueCache)
+        {
+            if (subscriberInfo.subscriberFilter.IsMatched(lastValue.second.dataBuffer.GetData(), lastValue.second.dataBuffer.GetDataSize()) == true)
+            {
+                fireBuffer.firedDataList.emplace_back();
+                fireBuffer.firedDataList.back().data = lastValue.second.dataBuffer.GetData();
+                fireBuffer.firedDataList.back().dataSize = lastValue.second.dataBuffer.GetDataSize();
+                fireBuffer.firedDataList.back().userContext = lastValue.second.userContext;
+            }
+        }
+        if (fireBuffer.firedDataList.size() != 0)
+        {
+            subscriberInfo.batchSubscriberCallback(fireBuffer.firedDataList.data(), static_cast<uint32_t>(fireBuffer.firedDataList.size()));
+        }
+    }
+
+    return;
+}
+
+bool EzPubSub::PubSubLite::HasFireableData_(
+    _In_ ChannelInfo* channelInfo
+)
+{
+    /*
+        The caller using this method must synchronize.
+    */
+
+    if (channelInfo->fireStatus != FireStatus::kRunning)
+    {
+        return (channelInfo->fireStatus == FireStatus::kExit);
+    }
+
+    return ((GetBufferedDataCount_(channelInfo) != 0) && (IsCoalescingDone_(channelInfo) == true));
+}
+
+void EzPubSub::PubSubLite::ScheduleFireTask_(
+    _Inout_ ChannelInfo* channelInfo
+)
+{
+    /*
+        The caller using this method must synchronize.
+        The channel fire task is submitted once until it runs.
+    */
+
+    if (channelInfo->fireStatus != FireStatus::kRunning)
+    {
+        return;
+    }
+
+    if (channelInfo->isFireTaskScheduled.exchange(true) == false)
+    {
+        channelInfo->fireTaskCount++;
+        sharedFireExecutor_->Submit(FireChannelTask_, channelInfo);
+    }
+
+    return;
+}
+
+void EzPubSub::PubSubLite::FinishFireTask_(
+    _Inout_ ChannelInfo* channelInfo
+)
+{
+    /*
+        The caller using this method must synchronize.
+        The task must not touch the channel after it releases channelSync, DeleteChannel may delete it.
+    */
+
+    channelInfo->fireTaskCount--;
+    if ((channelInfo->fireTaskCount == 0) && (channelInfo->fireStatus == FireStatus::kExit))
+    {
+        channelInfo->fireEvent.notify_all();
+    }
+
+    return;
+}
+
+void EzPubSub::PubSubLite::FireChannelTask_(
+    _In_opt_ void* taskContext
+)
+{
+    /*
+        Moves buffered data to firedDataLog and submits the fire task of each subscriber that has data to fire.
+    */
+
+    ChannelInfo* channelInfo = static_cast<ChannelInfo*>(taskContext);
+    std::vector<PendingData> completedDataList;
+
+    LockChannel_(channelInfo);
+    // Pairs with the fence of a kRing publisher, either this task pops the data or the publisher schedules a new task.
+    channelInfo->isFireTaskScheduled.store(false, std::memory_order_seq_cst);
+    if (channelInfo->fireStatus == FireStatus::kRunning)
+    {
+        // A task scheduled before the coalescing is done, such as by UpdateChannel, leaves the data to the timer like FireThread_.
+        if (IsCoalescingDone_(channelInfo) == true)
+        {
+            MoveToFiredDataLog_(channelInfo);
+            ResetCoalescing_(channelInfo);
+        }
+        else if (GetBufferedDataCount_(channelInfo) != 0)
+        {
+            ArmCoalescingTimer_(channelInfo);
+        }
+        AdmitPendingData_(channelInfo, completedDataList);
+
+        for (auto& subscriberCursor : channelInfo->subscriberCursorList)
+        {
+            if ((subscriberCursor.isScheduled == true) ||
+                (subscriberCursor.nextSequence >= channelInfo->firedDataLogSequence + channelInfo->firedDataLog.size()))
+            {
+                continue;
+            }
+
+            subscriberCursor.isScheduled = true;
+            channelInfo->fireTaskCount++;
+            sharedFireExecutor_->Submit(FireSubscriberTask_, &subscriberCursor);
+        }
+
+        // Data released while moving, without subscribers or dropped by every subscriber, is removed.
+        TrimFiredDataLog_(channelInfo);
+    }
+    FinishFireTask_(channelInfo);
+    channelInfo->channelSync.unlock();
+
+    // The channel may be deleted once the task is finished, completedDataList does not refer to it.
+    CompletePendingData_(completedDataList);
+
+    return;
+}
+
+void EzPubSub::PubSubLite::FireSubscriberTask_(
+    _In_opt_ void* taskContext
+)
+{
+    /*
+        Fires up to kMaxSharedFiredDataCount data from the cursor without the channel lock, and submits itself again if more data remain.
+        firedDataLog is a deque that only grows at the back and is trimmed up to the firing data, so the data stays in place while firing.
+    */
+
+    SubscriberCursor* subscriberCursor = static_cast<SubscriberCursor*>(taskContext);
+    ChannelInfo* channelInfo = subscriberCursor->channelInfo;
+    uint32_t subscriberId = subscriberCursor->subscriberInfo.subscriberId;
+    uint64_t logEndSequence = 0;
+    LoggedData* firingData = nullptr;
+    uint64_t firedTime = 0;
+
+    LockChannel_(channelInfo);
+    logEndSequence = channelInfo->firedDataLogSequence + channelInfo->firedDataLog.size();
+    if ((channelInfo->fireStatus == FireStatus::kRunning) &&
+        (subscriberCursor->isUnregistered == false) &&
+        (subscriberCursor->nextSequence < logEndSequence))
+    {
+        subscriberCursor->firingDataList.clear();
+        for (uint64_t sequence = subscriberCursor->nextSequence;
+            (sequence < logEndSequence) && (subscriberCursor->firingDataList.size() < kMaxSharedFiredDataCount);
+            sequence++)
+        {
+            subscriberCursor->firingDataList.push_back(&channelInfo->firedDataLog[static_cast<size_t>(sequence - channelInfo->firedDataLogSequence)]);
+        }
+        subscriberCursor->firingSequence = subscriberCursor->nextSequence;
+        subscriberCursor->nextSequence += subscriberCursor->firingDataList.size();
+        subscriberCursor->isFiring = true;
+        channelInfo->channelSync.unlock();
+
+        // As FireData_ does, calls of sampled data are timed, and every batch.
+        if (subscriberCursor->subscriberInfo.subscriberCallback != nullptr)
+        {
+            for (size_t index = 0; index < subscriberCursor->firingDataList.size(); index++)
+            {
+                firingData = subscriberCursor->firingDataList[index];
+                if (firingData->publishedData.fireSubscriberMask.IsSet(subscriberId) == true)
+                {
+                    if (firingData->publishedData.publishedTime != 0)
+                    {
+                        firedTime = GetStatisticsTime();
+                        channelInfo->deliveryLatencyHistogram.Record(GetElapsedTime(firingData->publishedData.publishedTime, firedTime));
+                    }
+                    subscriberCursor->subscriberInfo.subscriberCallback(
+                        firingData->publishedData.dataBuffer.GetData(),
+                        firingData->publishedData.dataBuffer.GetDataSize(),
+                        firingData->publishedData.userContext
+                    );
+                    if (firingData->publishedData.publishedTime != 0)
+                    {
+                        subscriberCursor->subscriberInfo.callbackTimeHistogram->Record(GetStatisticsTime() - firedTime);
+                    }
+                }
+            }
+        }
+        else
+        {
+            firedTime = GetStatisticsTime();
+            subscriberCursor->firedDataList.clear();
+            for (size_t index = 0; index < subscriberCursor->firingDataList.size(); index++)
+            {
+                firingData = subscriberCursor->firingDataList[index];
+                if (firingData->publishedData.fireSubscriberMask.IsSet(subscriberId) == true)
+                {
+                    subscriberCursor->firedDataList.emplace_back();
+                    subscriberCursor->firedDataList.back().data = firingData->publishedData.dataBuffer.GetData();
+                    subscriberCursor->firedDataList.back().dataSize = firingData->publishedData.dataBuffer.GetDataSize();
+                    subscriberCursor->firedDataList.back().userContext = firingData->publishedData.userContext;
+                    if (firingData->publishedData.publishedTime != 0)
+                    {
+                        channelInfo->deliveryLatencyHistogram.Record(GetElapsedTime(firingData->publishedData.publishedTime, firedTime));
+                    }
+                }
+            }
+            if (subscriberCursor->firedDataList.size() != 0)
+            {
+                subscriberCursor->subscriberInfo.batchSubscriberCallback(
+                    subscriberCursor->firedDataList.data(),
+                    static_cast<uint32_t>(subscriberCursor->firedDataList.size())
+                );
+                subscriberCursor->subscriberInfo.callbackTimeHistogram->Record(GetStatisticsTime() - firedTime);
+            }
+        }
+
+        LockChannel_(channelInfo);
+        for (size_t index = 0; index < subscriberCursor->firingDataList.size(); index++)
+        {
+            firingData = subscriberCursor->firingDataList[index];
+            if (firingData->publishedData.fireSubscriberMask.IsSet(subscriberId) == true)
+            {
+                subscriberCursor->subscriberStatistics.firedDataCount++;
+                subscriberCursor->subscriberStatistics.lagDataCount--;
+                subscriberCursor->subscriberStatistics.lagDataSize -= firingData->publishedData.dataBuffer.GetDataSize();
+                ReleaseLoggedData_(channelInfo, *firingData);
+            }
+        }
+        subscriberCursor->isFiring = false;
+        logEndSequence = channelInfo->firedDataLogSequence + channelInfo->firedDataLog.size();
+
+        // The lag of the subscriber went down, so buffered data held back by kBlock may be moved now.
+        if (GetBufferedDataCount_(channelInfo) != 0)
+        {
+            ScheduleFireTask_(channelInfo);
+        }
+    }
+
+    if (subscriberCursor->isUnregistered == true)
+    {
+        for (auto subscriberCursorListIter = channelInfo->subscriberCursorList.begin();
+            subscriberCursorListIter != channelInfo->subscriberCursorList.end();
+            subscriberCursorListIter++)
+        {
+            if (&(*subscriberCursorListIter) == subscriberCursor)
+            {
+                channelInfo->subscriberCursorList.erase(subscriberCursorListIter);
+                break;
+            }
+        }
+    }
+    else if ((channelInfo->fireStatus == FireStatus::kRunning) && (subscriberCursor->nextSequence < logEndSequence))
+    {
+        // Submitted again instead of looping, so that the other tasks of the worker are not starved.
+        TrimFiredDataLog_(channelInfo);
+        sharedFireExecutor_->Submit(FireSubscriberTask_, subscriberCursor);
+        channelInfo->channelSync.unlock();
+        return;
+    }
+    else
+    {
+        subscriberCursor->isScheduled = false;
+    }
+
+    TrimFiredDataLog_(channelInfo);
+    FinishFireTask_(channelInfo);
+    channelInfo->channelSync.unlock();
+
+    return;
+}
+
+void EzPubSub::PubSubLite::MoveToFiredDataLog_(
+    _Inout_ ChannelInfo* channelInfo
+)
 {
     /*
-        If a subscriberCallback is searched, a global pointer is returned,
-        so the caller using this method must synchronize.
+        The caller using this method must synchronize.
+        Buffered data is moved until firedDataLog is full, the rest stays buffered.
     */
 
-    auto subscriberCallbackListIter = channelInfo.subscriberCallbackList.begin();
+    uint64_t headPosition = 0;
+    uint32_t dataSize = 0;
+    uint32_t priority = 0;
+    bool isMoved = false;
+    size_t bufferedDataCount = GetBufferedDataCount_(channelInfo);
+    PublishedData publishedData;
+
+    if (bufferedDataCount != 0)
+    {
+        channelInfo->bufferedDataCountHistogram.Record(bufferedDataCount);
+        channelInfo->bufferedDataSizeHistogram.Record(channelInfo->currentBufferedDataSize);
+    }
+
+    if (channelInfo->queueType == QueueType::kRing)
+    {
+        // The size of the next data is not known before it is popped.
+        channelInfo->ringPopSync.lock();
+        while (IsFiredDataLogFull_(channelInfo, 1) == false)
+        {
+            headPosition = channelInfo->publishedDataRing->GetHeadPosition();
+            if (channelInfo->publishedDataRing->TryPop(publishedData) == false)
+            {
+                break;
+            }
+            dataSize = publishedData.dataBuffer.GetDataSize();
+            channelInfo->currentBufferedDataSize -= dataSize;
+            isMoved = true;
+
+            // Data cleared by Resume are lost, kDropOldest publishers keep the ring within the max buffered data size.
+            if (headPosition < channelInfo->clearedRingPosition)
+            {
+                publishedData.dataBuffer.Release();
+                channelInfo->lostDataCount++;
+                continue;
+            }
+
+            AppendFiredDataLog_(channelInfo, publishedData);
+        }
+        channelInfo->ringPopSync.unlock();
+    }
 
-    for (; subscriberCallbackListIter != channelInfo.subscriberCallbackList.end(); subscriberCallbackListIter++)
+    // Priority lanes are moved in the order of SelectPriorityLane_, a turn of kWeighted is not taken back if the log is full.
+    while (channelInfo->queueType == QueueType::kList)
     {
-        if (*subscriberCallbackListIter == subscriberCallback)
+        priority = (channelInfo->priorityLaneCount == 1) ? 0 : SelectPriorityLane_(channelInfo);
+        if ((priority == kMaxPriorityLaneCount) || (channelInfo->priorityLaneList[priority].publishedDataList.size() == 0))
+        {
+            break;
+        }
+
+        PriorityLane& priorityLane = channelInfo->priorityLaneList[priority];
+
+        dataSize = priorityLane.publishedDataList.front().dataBuffer.GetDataSize();
+        if (IsFiredDataLogFull_(channelInfo, dataSize) == true)
+        {
+            break;
+        }
+        channelInfo->currentBufferedDataSize -= dataSize;
+        priorityLane.bufferedDataSize -= dataSize;
+        AppendFiredDataLog_(channelInfo, priorityLane.publishedDataList.front());
+        isMoved = true;
+
+        if (channelInfo->recycledDataList.size() < kMaxRecycledDataCount)
+        {
+            channelInfo->recycledDataList.splice(channelInfo->recycledDataList.end(), priorityLane.publishedDataList, priorityLane.publishedDataList.begin());
+        }
+        else
         {
-            return subscriberCallbackListIter;
+            priorityLane.publishedDataList.pop_front();
         }
     }
 
-    return subscriberCallbackListIter;
+    if ((isMoved == true) && (channelInfo->waitingPublisherCount != 0))
+    {
+        channelInfo->publishEvent.notify_all();
+    }
+
+    return;
 }
 
-void EzPubSub::PubSubLite::FireThread_(
-    ChannelInfo* channelInfo
+bool EzPubSub::PubSubLite::IsFiredDataLogFull_(
+    _In_ ChannelInfo* channelInfo,
+    _In_ uint32_t dataSize
 )
 {
-    uint32_t copiedFlushTime = 0;
-    std::list<SUBSCRIBER_CALLBACK> copiedCallbackList;
+    /*
+        The caller using this method must synchronize.
+        firedDataLog is full at kMaxFiredDataLogCount data, or when the next data of dataSize exceeds the max lag of a kBlock subscriber.
+        A subscriber without lag takes any data, so data larger than the max lag is not held back forever.
+    */
 
-    while (true)
+    if (channelInfo->firedDataLog.size() >= kMaxFiredDataLogCount)
     {
-        ::EnterCriticalSection(&channelInfoListSync_);
-        // Terminate thread if fire is exit.
-        if (channelInfo->fireStatus == FireStatus::kExit)
+        return true;
+    }
+
+    if (channelInfo->blockingSubscriberCount == 0)
+    {
+        return false;
+    }
+
+    for (auto& subscriberCursor : channelInfo->subscriberCursorList)
+    {
+        if ((subscriberCursor.isUnregistered == false) &&
+            (subscriberCursor.subscriberOption.overflowPolicy == OverflowPolicy::kBlock) &&
+            (subscriberCursor.subscriberStatistics.lagDataCount != 0) &&
+            (subscriberCursor.subscriberStatistics.lagDataSize + dataSize > GetMaxLagDataSize_(channelInfo, subscriberCursor)))
         {
-            ::LeaveCriticalSection(&channelInfoListSync_);
-            break;
+            return true;
         }
+    }
+
+    return false;
+}
+
+void EzPubSub::PubSubLite::AppendFiredDataLog_(
+    _Inout_ ChannelInfo* channelInfo,
+    _Inout_ PublishedData& publishedData
+)
+{
+    /*
+        The caller using this method must synchronize.
+        Moves publishedData to the back of firedDataLog, applying the overflow policy of each subscriber it is fired to.
+        - kDropOldest: the oldest data not firing yet are dropped from the cursor until the new data fits.
+        - kDropNewest: the subscriber is removed from fireSubscriberMask of the new data.
+        - kBlock: MoveToFiredDataLog_ stops before the max lag is exceeded.
+        A subscriber whose filter does not match the data is removed from fireSubscriberMask of the data as well.
+    */
+
+    uint32_t dataSize = publishedData.dataBuffer.GetDataSize();
+    uint64_t logEndSequence = channelInfo->firedDataLogSequence + channelInfo->firedDataLog.size();
+    uint32_t maxLagDataSize = 0;
+    uint32_t remainingSubscriberCount = 0;
+    bool isLost = false;
+    LoggedData* droppedData = nullptr;
 
-        // If no published data or fire status is stop, sleep by flush time.
-        if ((channelInfo->publishedDataList.size() == 0) || (channelInfo->fireStatus == FireStatus::kStop))
+    for (auto& subscriberCursor : channelInfo->subscriberCursorList)
+    {
+        if ((subscriberCursor.isUnregistered == true) ||
+            (publishedData.fireSubscriberMask.IsSet(subscriberCursor.subscriberInfo.subscriberId) == false))
         {
-            copiedFlushTime = channelInfo->flushTime;
-            ::LeaveCriticalSection(&channelInfoListSync_);
-            Sleep(copiedFlushTime);
             continue;
         }
-        else
+        if (subscriberCursor.subscriberInfo.subscriberFilter.IsMatched(publishedData.dataBuffer.GetData(), dataSize) == false)
         {
-            AdjustDataBuffer_(channelInfo);
-            if (channelInfo->publishedDataList.size() == 0)
-            {
-                copiedFlushTime = channelInfo->flushTime;
-                ::LeaveCriticalSection(&channelInfoListSync_);
-                Sleep(copiedFlushTime);
-                continue;
-            }
+            publishedData.fireSubscriberMask.Reset(subscriberCursor.subscriberInfo.subscriberId);
+            continue;
         }
 
-        copiedCallbackList = channelInfo->subscriberCallbackList;
-        ::LeaveCriticalSection(&channelInfoListSync_);
-
-        // While the subscriber is processing published data, it does not synchronize to store the data sent by the publisher in the buffer.
-        // Therefore, it never modifies the front of other methods published data buffer list.
-        for (auto copiedCallbackListEntry : copiedCallbackList)
+        // kBlock may exceed the max lag by one kRing data, whose size is not known before it is popped.
+        maxLagDataSize = GetMaxLagDataSize_(channelInfo, subscriberCursor);
+        if ((subscriberCursor.subscriberOption.overflowPolicy != OverflowPolicy::kBlock) &&
+            (subscriberCursor.subscriberStatistics.lagDataCount != 0) &&
+            (subscriberCursor.subscriberStatistics.lagDataSize + dataSize > maxLagDataSize))
         {
-            if (std::get<1>(*(channelInfo->publishedDataList.begin())).size() == 0)
+            if (subscriberCursor.subscriberOption.overflowPolicy == OverflowPolicy::kDropNewest)
             {
-                copiedCallbackListEntry(
-                    std::get<2>(*(channelInfo->publishedDataList.begin())).data(),
-                    static_cast<uint32_t>(std::get<2>(*(channelInfo->publishedDataList.begin())).size()),
-                    reinterpret_cast<void*>(std::get<0>(*(channelInfo->publishedDataList.begin())))
-                );
+                publishedData.fireSubscriberMask.Reset(subscriberCursor.subscriberInfo.subscriberId);
+                subscriberCursor.subscriberStatistics.lostDataCount++;
+                isLost = true;
+                continue;
             }
-            else
+
+            // Data being fired can not be dropped, so the lag may stay above the max lag until the firing finishes.
+            while ((subscriberCursor.nextSequence < logEndSequence) &&
+                (subscriberCursor.subscriberStatistics.lagDataSize + dataSize > maxLagDataSize))
             {
-                // Not all callbacks fired published data
-                for (auto fireCallbackListEntry : std::get<1>(*(channelInfo->publishedDataList.begin())))
+                droppedData = &channelInfo->firedDataLog[static_cast<size_t>(subscriberCursor.nextSequence - channelInfo->firedDataLogSequence)];
+                subscriberCursor.nextSequence++;
+                if (droppedData->publishedData.fireSubscriberMask.IsSet(subscriberCursor.subscriberInfo.subscriberId) == false)
                 {
-                    if (fireCallbackListEntry == copiedCallbackListEntry)
-                    {
-                        copiedCallbackListEntry(
-                            std::get<2>(*(channelInfo->publishedDataList.begin())).data(),
-                            static_cast<uint32_t>(std::get<2>(*(channelInfo->publishedDataList.begin())).size()),
-                            reinterpret_cast<void*>(std::get<0>(*(channelInfo->publishedDataList.begin())))
-                        );
-                    }
+                    continue;
                 }
+
+                subscriberCursor.subscriberStatistics.lostDataCount++;
+                subscriberCursor.subscriberStatistics.lagDataCount--;
+                subscriberCursor.subscriberStatistics.lagDataSize -= droppedData->publishedData.dataBuffer.GetDataSize();
+                droppedData->isLost = true;
+                ReleaseLoggedData_(channelInfo, *droppedData);
             }
         }
 
-        ::EnterCriticalSection(&channelInfoListSync_);
-        channelInfo->currentBufferedDataSize -= static_cast<uint32_t>(std::get<2>(*(channelInfo->publishedDataList.begin())).size());
-        channelInfo->publishedDataList.pop_front();
+        subscriberCursor.subscriberStatistics.lagDataCount++;
+        subscriberCursor.subscriberStatistics.lagDataSize += dataSize;
+        remainingSubscriberCount++;
+    }
+
+    // Without subscribers to fire, the data is done right away.
+    if (remainingSubscriberCount == 0)
+    {
+        publishedData.dataBuffer.Release();
+        if (isLost == true)
+        {
+            channelInfo->lostDataCount++;
+            channelInfo->priorityLaneList[publishedData.priority].lostDataCount++;
+        }
+        else
+        {
+            channelInfo->firedDataCount++;
+            channelInfo->priorityLaneList[publishedData.priority].firedDataCount++;
+        }
+        return;
+    }
+
+    channelInfo->firedDataLog.emplace_back();
+    channelInfo->firedDataLog.back().publishedData.userContext = publishedData.userContext;
+    channelInfo->firedDataLog.back().publishedData.publishedTime = publishedData.publishedTime;
+    channelInfo->firedDataLog.back().publishedData.priority = publishedData.priority;
+    channelInfo->firedDataLog.back().publishedData.fireSubscriberMask = publishedData.fireSubscriberMask;
+    channelInfo->firedDataLog.back().publishedData.dataBuffer = std::move(publishedData.dataBuffer);
+    channelInfo->firedDataLog.back().remainingSubscriberCount = remainingSubscriberCount;
+    channelInfo->firedDataLog.back().isLost = isLost;
+    channelInfo->firedDataLogSize += dataSize;
+
+    return;
+}
+
+void EzPubSub::PubSubLite::ReleaseLoggedData_(
+    _Inout_ ChannelInfo* channelInfo,
+    _Inout_ LoggedData& loggedData
+)
+{
+    /*
+        The caller using this method must synchronize.
+        A subscriber fired or dropped the data, and the data is released when it was the last one.
+        Data dropped by any subscriber is counted as lost, otherwise as fired.
+    */
+
+    loggedData.remainingSubscriberCount--;
+    if (loggedData.remainingSubscriberCount != 0)
+    {
+        return;
+    }
+
+    channelInfo->firedDataLogSize -= loggedData.publishedData.dataBuffer.GetDataSize();
+    loggedData.publishedData.dataBuffer.Release();
+    if (loggedData.isLost == true)
+    {
+        channelInfo->lostDataCount++;
+        channelInfo->priorityLaneList[loggedData.publishedData.priority].lostDataCount++;
+    }
+    else
+    {
         channelInfo->firedDataCount++;
-        ::LeaveCriticalSection(&channelInfoListSync_);
+        channelInfo->priorityLaneList[loggedData.publishedData.priority].firedDataCount++;
     }
+
+    return;
 }
 
-void EzPubSub::PubSubLite::AdjustDataBuffer_(
-    _Inout_ ChannelInfo* channelInfo
+void EzPubSub::PubSubLite::ReleaseCursorData_(
+    _Inout_ ChannelInfo* channelInfo,
+    _Inout_ SubscriberCursor& subscriberCursor,
+    _In_ bool isLost
 )
 {
     /*
         The caller using this method must synchronize.
+        Releases the data of firedDataLog the subscriber did not take yet, and moves the cursor to the end of the log.
+        If isLost, they are counted as lost by the subscriber, and by the channel once every subscriber released them.
     */
 
-    size_t beforeDeletionDataListSize = 0;
-    uint32_t beDeletedDataSize = 0;
+    uint64_t logEndSequence = channelInfo->firedDataLogSequence + channelInfo->firedDataLog.size();
+    LoggedData* loggedData = nullptr;
 
-    if (channelInfo->currentBufferedDataSize > channelInfo->maxBufferedDataSize)
+    for (uint64_t sequence = subscriberCursor.nextSequence; sequence < logEndSequence; sequence++)
     {
-        beforeDeletionDataListSize = channelInfo->publishedDataList.size();
-        beDeletedDataSize = 0;
-        for (auto publishedDataListIter = channelInfo->publishedDataList.begin();
-            publishedDataListIter != channelInfo->publishedDataList.end();
-            publishedDataListIter++)
+        loggedData = &channelInfo->firedDataLog[static_cast<size_t>(sequence - channelInfo->firedDataLogSequence)];
+        if (loggedData->publishedData.fireSubscriberMask.IsSet(subscriberCursor.subscriberInfo.subscriberId) == true)
         {
-            beDeletedDataSize += static_cast<uint32_t>(std::get<2>(*(channelInfo->publishedDataList.begin())).size());
-            if ((channelInfo->currentBufferedDataSize - beDeletedDataSize) <= channelInfo->maxBufferedDataSize)
+            subscriberCursor.subscriberStatistics.lagDataCount--;
+            subscriberCursor.subscriberStatistics.lagDataSize -= loggedData->publishedData.dataBuffer.GetDataSize();
+            if (isLost == true)
             {
-                channelInfo->currentBufferedDataSize -= beDeletedDataSize;
-                channelInfo->publishedDataList.erase(channelInfo->publishedDataList.begin(), ++publishedDataListIter);
-                channelInfo->lostDataCount += static_cast<uint32_t>(beforeDeletionDataListSize - channelInfo->publishedDataList.size());
-                return;
+                subscriberCursor.subscriberStatistics.lostDataCount++;
+                loggedData->isLost = true;
             }
+            ReleaseLoggedData_(channelInfo, *loggedData);
+        }
+    }
+    subscriberCursor.nextSequence = logEndSequence;
+
+    return;
+}
+
+void EzPubSub::PubSubLite::DetachSubscriberCursor_(
+    _Inout_ ChannelInfo* channelInfo,
+    _Inout_ SubscriberCursor& subscriberCursor
+)
+{
+    /*
+        The caller using this method must synchronize.
+        The unregistered subscriber gives up the data it did not take yet. Data it is firing is given up by its fire task.
+    */
+
+    ReleaseCursorData_(channelInfo, subscriberCursor, false);
+
+    if (subscriberCursor.subscriberOption.overflowPolicy == OverflowPolicy::kBlock)
+    {
+        channelInfo->blockingSubscriberCount--;
+    }
+    if (GetBufferedDataCount_(channelInfo) != 0)
+    {
+        ScheduleFireTask_(channelInfo);
+    }
+
+    return;
+}
+
+void EzPubSub::PubSubLite::TrimFiredDataLog_(
+    _Inout_ ChannelInfo* channelInfo
+)
+{
+    /*
+        The caller using this method must synchronize.
+        Removes the released data from the front of firedDataLog, up to the data being fired by a subscriber.
+    */
+
+    uint64_t trimSequence = channelInfo->firedDataLogSequence + channelInfo->firedDataLog.size();
+
+    for (auto& subscriberCursor : channelInfo->subscriberCursorList)
+    {
+        if (subscriberCursor.isFiring == true)
+        {
+            trimSequence = std::min(trimSequence, subscriberCursor.firingSequence);
+        }
+    }
+
+    while ((channelInfo->firedDataLogSequence < trimSequence) &&
+        (channelInfo->firedDataLog.front().remainingSubscriberCount == 0))
+    {
+        channelInfo->firedDataLog.pop_front();
+        channelInfo->firedDataLogSequence++;
+    }
+
+    // The removed data were released, so a cursor behind them did not want them.
+    for (auto& subscriberCursor : channelInfo->subscriberCursorList)
+    {
+        if (subscriberCursor.nextSequence < channelInfo->firedDataLogSequence)
+        {
+            subscriberCursor.nextSequence = channelInfo->firedDataLogSequence;
+        }
+    }
+
+    return;
+}
+
+uint32_t EzPubSub::PubSubLite::GetMaxLagDataSize_(
+    _In_ ChannelInfo* channelInfo,
+    _In_ const SubscriberCursor& subscriberCursor
+)
+{
+    /*
+        The caller using this method must synchronize.
+    */
+
+    if (subscriberCursor.subscriberOption.maxLagDataSize == 0)
+    {
+        return channelInfo->maxBufferedDataSize;
+    }
+
+    return subscriberCursor.subscriberOption.maxLagDataSize;
+}
+
+uint64_t EzPubSub::PubSubLite::GetDataPoolLimitSize_(
+    _In_ uint32_t maxBufferedDataSize
+)
+{
+    // A block wastes at most 25% of its size, so a full channel fits in the pool.
+    return static_cast<uint64_t>(maxBufferedDataSize) + (maxBufferedDataSize / 4);
+}
+
+EzPubSub::ChannelHandle::ChannelHandle()
+{
+    channelInfo_ = nullptr;
+}
+
+EzPubSub::ChannelHandle::ChannelHandle(
+    _In_ ChannelInfo* channelInfo
+)
+{
+    // The caller keeps the channel alive while the reference is taken.
+    channelInfo_ = channelInfo;
+    channelInfo_->referenceCount.fetch_add(1, std::memory_order_relaxed);
+}
+
+EzPubSub::ChannelHandle::ChannelHandle(
+    _In_ const ChannelHandle& channelHandle
+) : ChannelHandle()
+{
+    *this = channelHandle;
+}
+
+EzPubSub::ChannelHandle::ChannelHandle(
+    _Inout_ ChannelHandle&& channelHandle
+) noexcept : ChannelHandle()
+{
+    *this = std::move(channelHandle);
+}
+
+EzPubSub::ChannelHandle::~ChannelHandle()
+{
+    Reset();
+}
+
+EzPubSub::ChannelHandle& EzPubSub::ChannelHandle::operator=(
+    _In_ const ChannelHandle& channelHandle
+)
+{
+    if (this != &channelHandle)
+    {
+        Reset();
+        channelInfo_ = channelHandle.channelInfo_;
+        if (channelInfo_ != nullptr)
+        {
+            channelInfo_->referenceCount.fetch_add(1, std::memory_order_relaxed);
         }
     }
 
+    return *this;
+}
+
+EzPubSub::ChannelHandle& EzPubSub::ChannelHandle::operator=(
+    _Inout_ ChannelHandle&& channelHandle
+) noexcept
+{
+    if (this != &channelHandle)
+    {
+        Reset();
+        channelInfo_ = channelHandle.channelInfo_;
+        channelHandle.channelInfo_ = nullptr;
+    }
+
+    return *this;
+}
+
+bool EzPubSub::ChannelHandle::IsValid() const
+{
+    return (channelInfo_ != nullptr);
+}
+
+const std::wstring& EzPubSub::ChannelHandle::GetChannelName() const
+{
+    static const std::wstring emptyChannelName;
+
+    return (channelInfo_ != nullptr) ? channelInfo_->channelName : emptyChannelName;
+}
+
+void EzPubSub::ChannelHandle::Reset()
+{
+    if (channelInfo_ != nullptr)
+    {
+        PubSubLite::ReleaseChannelInfo_(channelInfo_);
+        channelInfo_ = nullptr;
+    }
+
     return;
 }
@@ -4,22 +4,46 @@
 
 #pragma once
 
-#include <windows.h>
+#include "PubSubLiteSync.h"
+#include "MpscRing.h"
+#include "DataBuffer.h"
+#include "DataCodec.h"
+#include "FireExecutor.h"
+#include "TopicTrie.h"
+#include "SharedMemoryRing.h"
+#include "ChannelLog.h"
+#include "ChannelStatistics.h"
+#include "TimerWheel.h"
+#include "SubscriberFilter.h"
 
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
 #include <cstdint>
 #include <string>
 #include <tuple>
 #include <unordered_map>
+#include <deque>
 #include <list>
+#include <memory>
+#include <vector>
 #include <thread>
+#include <shared_mutex>
 
 namespace EzPubSub
 {
 
-const uint32_t kSyncSpinCount = 2000;
-
 const uint32_t kDefaultFlushTime = 1000; // 1 Second, Unit: Millisecond
 const uint32_t kDefaultMaxBufferedDataSize = 10485760; // 10 MB, Unit: Byte
+const uint32_t kDefaultRingCapacity = 65536; // Unit: Published data count
+const uint32_t kMaxRecycledDataCount = 1024; // Unit: Published data count
+const uint32_t kMaxRingFiredDataCount = 1024; // kRing, most data popped and fired as a batch. Unit: Published data count
+const uint32_t kMaxSubscriberCount = 128; // Per channel, subscriber IDs are 0 ~ kMaxSubscriberCount - 1.
+const uint32_t kMaxSharedFiredDataCount = 1024; // kShared, most data fired to a subscriber by one fire task. Unit: Published data count
+const uint32_t kMaxFiredDataLogCount = 65536; // kShared, most data kept in the log of a channel. Unit: Published data count
+const uint32_t kDefaultSharedFireThreadCount = 0; // 0: std::thread::hardware_concurrency()
+const uint32_t kMaxPriorityLaneCount = 4; // kList, priority lanes of a channel.
+const uint32_t kMaxLaneFiredDataCount = 64; // kList with priority lanes, most data taken out to be fired at a time. Unit: Published data count
 
 enum class Error : uint32_t
 {
@@ -31,7 +55,8 @@ enum class Error : uint32_t
     kNotExistChannel,
     kNotExistSubscriber,
     kNotEnoughBufferSize,
-    kBeStoppedFire
+    kBeStoppedFire,
+    kExceedSubscriberCount
 };
 
 enum class FireStatus
@@ -41,35 +66,588 @@ enum class FireStatus
     kExit
 };
 
+enum class FireMode
+{
+    kPolling, // FireThread sleeps by flush time whenever there is nothing to fire.
+    kEvent    // FireThread waits for PublishData to signal it, flush time is the longest wait.
+};
+
+enum class QueueType
+{
+    kList, // std::list synchronized by the channel lock, never full.
+    kRing,        // Bounded lock-free MPSC ring, PublishData and FireThread do not take the channel lock.
+    kSharedMemory // Byte ring in a POSIX shared memory segment named by the channel, shared with the channels of the same name in other processes.
+};
+
+enum class FireThreadType
+{
+    kDedicated, // The channel has its own FireThread that fires data to the subscribers one by one.
+    kShared     // Fire tasks of the channel run on the FireExecutor shared by channels, subscribers are fired concurrently.
+};
+
+enum class OverflowPolicy
+{
+    kDropOldest, // The oldest data are lost to make room.
+    kDropNewest, // The new data is lost.
+    kBlock       // The publisher waits for room.
+};
+
+enum class LaneScheduling
+{
+    kStrict,  // A lane is fired only while every higher lane is empty.
+    kWeighted // Lanes are fired in turn from the highest, laneWeight data of a lane per turn.
+};
+
+enum class ConflationMode
+{
+    kNone,
+    kConflate,      // Keyed data replaces the buffered data of its key.
+    kLastValueCache // kConflate, and the last fired data of each key is kept and fired to each new subscriber.
+};
+
+struct ChannelOption
+{
+    ChannelOption()
+    {
+        flushTime = kDefaultFlushTime;
+        maxBufferedDataSize = kDefaultMaxBufferedDataSize;
+        fireMode = FireMode::kPolling;
+        coalescedDataCount = 0;
+        coalescedDataSize = 0;
+        coalescedTime = 0;
+        queueType = QueueType::kList;
+        ringCapacity = kDefaultRingCapacity;
+        fireThreadType = FireThreadType::kDedicated;
+        overflowPolicy = OverflowPolicy::kDropOldest;
+        blockTimeout = 0;
+        logSegmentSize = kDefaultLogSegmentSize;
+        logSyncDataCount = 0;
+        logSyncTime = 0;
+        logRetentionSegmentCount = 0;
+        logRetentionSize = 0;
+        priorityLaneCount = 1;
+        laneScheduling = LaneScheduling::kStrict;
+        for (uint32_t priority = 0; priority < kMaxPriorityLaneCount; priority++)
+        {
+            laneWeight[priority] = 1u << (2 * priority);
+            laneMaxBufferedDataSize[priority] = 0;
+        }
+        conflationMode = ConflationMode::kNone;
+        compressionThreshold = 0;
+    }
+
+    uint32_t flushTime;
+    uint32_t maxBufferedDataSize;
+    FireMode fireMode;
+
+    // kEvent only. FireThread is signaled when this many data or bytes are buffered. (0: not used)
+    // If neither is used, every PublishData signals FireThread.
+    uint32_t coalescedDataCount;
+    uint32_t coalescedDataSize;
+    // kEvent and kShared. Buffered data is fired when coalescedDataCount or coalescedDataSize is reached,
+    // or at the latest this long after the first data buffered since the last fire, by a timer shared by all channels.
+    // Unlike without it, data buffered while the previous data are fired is also coalesced, and flushTime does not fire it earlier.
+    // (0: not used, Unit: Microsecond)
+    uint32_t coalescedTime;
+
+    QueueType queueType;
+    // kRing only. Number of published data the ring can hold, rounded up to a power of two.
+    // PublishData returns kNotEnoughBufferSize while the ring is full.
+    uint32_t ringCapacity;
+
+    // kSharedMemory only. The ring is maxBufferedDataSize bytes, set by the process that creates the segment, and UpdateChannel does not resize it.
+    // Every process attached to the channel fires all data published by any of them to its own subscribers, straight from the segment.
+    // Only a dedicated FireThread is supported, coalescing is not used, and subscribers receive nullptr as userContext.
+    // PublishData with fireCallbackList or SubscriberMask and PublishDataAsync return kUnsuccess.
+    // kDropOldest waits for a process firing the oldest data up to blockTimeout (kSharedMemoryWaitTime if 0), then returns kNotEnoughBufferSize.
+
+    // kShared fires data as soon as it is published unless coalescedTime is used, and fireMode and flushTime are not used.
+    FireThreadType fireThreadType;
+
+    // Applied by PublishData when the data does not fit in maxBufferedDataSize. An empty buffer takes any data.
+    // kDropOldest: the oldest buffered data are lost. (kRing: popped by PublishData to make room, data reserved by other publishers
+    //             and not pushed yet are not dropped, so they may exceed maxBufferedDataSize until FireThread pops them)
+    // kDropNewest: PublishData returns kNotEnoughBufferSize.
+    // kBlock: PublishData waits for room up to blockTimeout, and returns kNotEnoughBufferSize on timeout.
+    OverflowPolicy overflowPolicy;
+    uint32_t blockTimeout; // Unit: Millisecond (0: no timeout), also used while a kBlock subscriber holds the buffer.
+
+    // Log of the published data in segment files of logSegmentSize bytes in logDirectory, see ChannelLog. (Empty: not logged)
+    // Data is logged when it is buffered, in buffered order, and the log of the channel continues after the data logged before.
+    // The log is written to the disk when logSyncDataCount data are logged since the last write,
+    // and logSyncTime after data are logged. (0: not used, Unit: Millisecond)
+    std::wstring logDirectory;
+    uint32_t logSegmentSize;
+    uint32_t logSyncDataCount;
+    uint32_t logSyncTime;
+    // The oldest segment files are deleted whole when the log has more than logRetentionSegmentCount segments
+    // or logRetentionSize bytes of them, keeping at least the current segment. (0: not used, Unit: Byte)
+    uint32_t logRetentionSegmentCount;
+    uint64_t logRetentionSize;
+
+    // kList only. PublishPriorityData publishes to a lane by its priority(0 ~ priorityLaneCount - 1, higher is fired first),
+    // and the other methods to priority 0. Each lane is taken out to be fired by laneScheduling, up to kMaxLaneFiredDataCount data at a time,
+    // so data of a higher lane waits for at most that many data of lower lanes. Data of a lane is fired in published order.
+    // laneMaxBufferedDataSize is the overflow budget of a lane within maxBufferedDataSize, to which overflowPolicy is applied too. (0: not used)
+    // kDropOldest makes room from the lowest lane up to the lane of the data, never from a higher lane.
+    // kShared schedules the lanes when data is moved to the log of the subscribers, where the overflow policy of a subscriber ignores the priority.
+    uint32_t priorityLaneCount;
+    LaneScheduling laneScheduling;
+    uint32_t laneWeight[kMaxPriorityLaneCount]; // kWeighted, 1 or more. (Default: 1, 4, 16, 64)
+    uint32_t laneMaxBufferedDataSize[kMaxPriorityLaneCount]; // Unit: Byte
+
+    // kList and kDedicated only. Data published by PublishKeyedData replaces the data of the same key that is still buffered,
+    // in its place in the buffer, so the buffer holds at most one data per key however fast the data of a key is published.
+    // kLastValueCache keeps the last fired data of each key until the channel is deleted,
+    // and a new subscriber receives them from FireThread before any data published after it is registered.
+    ConflationMode conflationMode;
+
+    // kList and kRing of kDedicated only. Data of compressionThreshold bytes or larger is compressed by DataCodec when it is published,
+    // and buffered and logged compressed if it gets smaller, so maxBufferedDataSize counts the compressed size.
+    // FireThread decompresses each data once before it is fired, and subscribers receive the published data. (0: not used, Unit: Byte)
+    // compressionDictionary, such as typical data of the channel, lets small data be compressed, the last 64 KB of it are used.
+    uint32_t compressionThreshold;
+    std::vector<uint8_t> compressionDictionary;
+};
+
 typedef void(*SUBSCRIBER_CALLBACK)(_In_ const uint8_t* data, _In_ uint32_t dataSize, _In_opt_ void* userContext);
 
-// External Data Process Pointer(optional), Fired subscriber callback list(optional), Published data
-using PublishedData = std::tuple<void*, const std::vector<SUBSCRIBER_CALLBACK>, const std::vector<uint8_t>>;
+// Set of subscriber IDs of a channel that published data is fired to.
+struct SubscriberMask
+{
+    SubscriberMask()
+    {
+        Clear();
+    }
+
+    void Clear()
+    {
+        for (auto& bit : bitList)
+        {
+            bit = 0;
+        }
+    }
+
+    void SetAll()
+    {
+        for (auto& bit : bitList)
+        {
+            bit = ~0ull;
+        }
+    }
+
+    void Set(_In_ uint32_t subscriberId)
+    {
+        bitList[subscriberId / 64] |= (1ull << (subscriberId % 64));
+    }
+
+    void Reset(_In_ uint32_t subscriberId)
+    {
+        bitList[subscriberId / 64] &= ~(1ull << (subscriberId % 64));
+    }
+
+    bool IsSet(_In_ uint32_t subscriberId) const
+    {
+        return ((bitList[subscriberId / 64] & (1ull << (subscriberId % 64))) != 0);
+    }
+
+    bool IsAll() const
+    {
+        for (auto bit : bitList)
+        {
+            if (bit != ~0ull)
+            {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    uint64_t bitList[(kMaxSubscriberCount + 63) / 64];
+};
+
+struct FiredData
+{
+    FiredData()
+    {
+        data = nullptr;
+        dataSize = 0;
+        userContext = nullptr;
+    }
+
+    const uint8_t* data;
+    uint32_t dataSize;
+    void* userContext;
+};
+
+// Receives every data fired at once by FireThread, in published order. The list is only valid during the call.
+typedef void(*BATCH_SUBSCRIBER_CALLBACK)(_In_ const FiredData* firedDataList, _In_ uint32_t firedDataCount);
+
+// Data of PubSubLite::PublishBatch.
+struct PublishBatchData
+{
+    PublishBatchData()
+    {
+        data = nullptr;
+        dataSize = 0;
+        userContext = nullptr;
+    }
+
+    const uint8_t* data;
+    uint32_t dataSize;
+    void* userContext;
+};
+
+// overflowPolicy and maxLagDataSize are kShared only, a kDedicated channel fires every subscriber from one buffer.
+// A subscriber registered without SubscriberOption uses the overflow policy of the channel.
+struct SubscriberOption
+{
+    SubscriberOption()
+    {
+        overflowPolicy = OverflowPolicy::kDropOldest;
+        maxLagDataSize = 0;
+    }
+
+    // Applied when the data not fired to the subscriber yet exceed maxLagDataSize.
+    // kBlock stops moving buffered data to the log, so PublishData waits while the buffer is full, up to blockTimeout of the channel.
+    OverflowPolicy overflowPolicy;
+    uint32_t maxLagDataSize; // Unit: Byte (0: maxBufferedDataSize of the channel)
+
+    // The subscriber is only called for the data subscriberFilter matches.
+    // FireThread evaluates the filters of all subscribers over the header keys of the data it takes out at once,
+    // and kShared when the data is moved to the log, so data filtered out is not counted in the lag of the subscriber.
+    SubscriberFilter subscriberFilter;
+};
+
+struct SubscriberStatistics
+{
+    SubscriberStatistics()
+    {
+        firedDataCount = 0;
+        lostDataCount = 0;
+        lagDataCount = 0;
+        lagDataSize = 0;
+    }
+
+    uint64_t firedDataCount;
+    uint64_t lostDataCount; // Dropped by the overflow policy of the subscriber.
+    uint64_t lagDataCount; // Data in the log not fired to the subscriber yet.
+    uint64_t lagDataSize;
+};
+
+struct SubscriberInfo
+{
+    SubscriberInfo()
+    {
+        subscriberId = 0;
+        subscriberCallback = nullptr;
+        batchSubscriberCallback = nullptr;
+        wildcardSubscriberId = 0;
+        isSnapshotPending = false;
+    }
+
+    uint32_t subscriberId;
+    uint64_t wildcardSubscriberId; // Registered by RegisterWildcardSubscriber, 0 if registered to the channel by its name.
+    // Only one of them is set.
+    SUBSCRIBER_CALLBACK subscriberCallback;
+    BATCH_SUBSCRIBER_CALLBACK batchSubscriberCallback;
+    SubscriberFilter subscriberFilter; // From SubscriberOption.
+    bool isSnapshotPending; // kLastValueCache, the cached data were not fired to the new subscriber yet.
+    // Created when the subscriber is added to a channel, and shared by the copies of the subscriber list FireThread fires.
+    std::shared_ptr<Histogram> callbackTimeHistogram;
+};
+
+struct PublishedData
+{
+    PublishedData()
+    {
+        userContext = nullptr;
+        publishedTime = 0;
+        priority = 0;
+        dataKey = 0;
+        isKeyed = false;
+        isCompressed = false;
+        fireSubscriberMask.SetAll();
+    }
+
+    void* userContext; // External Data Process Pointer(optional)
+    uint64_t publishedTime; // GetStatisticsTime when it was published if it is sampled, otherwise 0.
+    uint32_t priority; // Priority lane
+    uint64_t dataKey; // PublishKeyedData, used by conflationMode.
+    bool isKeyed;
+    bool isCompressed; // dataBuffer is a block of DataCodec until FireThread decompresses it.
+    SubscriberMask fireSubscriberMask; // Fired subscriber IDs, all subscribers by default.
+    DataBuffer dataBuffer; // Published data
+};
+
+// Called once for each data accepted by PublishDataAsync, with kSuccess when it is buffered,
+// or with the error when it is given up because the channel is paused or deleted.
+typedef void(*PUBLISH_COMPLETION_CALLBACK)(_In_ Error publishResult, _In_opt_ void* completionContext);
+
+// How PublishData makes room for data that does not fit in maxBufferedDataSize.
+enum class PublishMode
+{
+    kChannelPolicy, // overflowPolicy and blockTimeout of the channel
+    kTry,           // Returns kNotEnoughBufferSize.
+    kWait,          // Waits until the deadline.
+    kAsync          // Queues the data, it is buffered in published order as room is made.
+};
+
+// PublishDataAsync, data waiting for room.
+struct PendingData
+{
+    PendingData()
+    {
+        completionCallback = nullptr;
+        completionContext = nullptr;
+        publishResult = Error::kUnsuccess;
+    }
+
+    PublishedData publishedData;
+    PUBLISH_COMPLETION_CALLBACK completionCallback;
+    void* completionContext;
+    Error publishResult;
+};
+
+// kList, the buffer of data published by a priority.
+struct PriorityLane
+{
+    PriorityLane()
+    {
+        weight = 1;
+        maxBufferedDataSize = 0;
+        bufferedDataSize = 0;
+        firedDataCount = 0;
+        lostDataCount = 0;
+    }
+
+    std::list<PublishedData> publishedDataList;
+    uint32_t weight;
+    uint32_t maxBufferedDataSize; // 0: only maxBufferedDataSize of the channel
+    uint64_t bufferedDataSize; // Unit: Byte
+    uint64_t firedDataCount;
+    uint64_t lostDataCount;
+};
+
+struct ChannelInfo;
+
+// kShared, published data in the log of the channel.
+struct LoggedData
+{
+    LoggedData()
+    {
+        remainingSubscriberCount = 0;
+        isLost = false;
+    }
+
+    // fireSubscriberMask is final once the data is in the log, the subscribers dropping it by kDropNewest are removed.
+    PublishedData publishedData;
+    uint32_t remainingSubscriberCount; // Subscribers that did not fire or drop the data yet, the data is released at 0.
+    bool isLost; // Dropped by a subscriber, it is counted as lost instead of fired.
+};
+
+// Kept by a FireThread to reuse the capacity of its buffers.
+struct FireBuffer
+{
+    std::vector<FiredData> firedDataList; // Data fired to a batch subscriber.
+    // While a subscriber has a filter, the subscribers each data is fired to after the filters.
+    SubscriberFilterColumn filterColumn;
+    std::vector<SubscriberMask> fireSubscriberMaskList;
+};
+
+// kShared, the position of a subscriber in firedDataLog of the channel.
+struct SubscriberCursor
+{
+    SubscriberCursor()
+    {
+        channelInfo = nullptr;
+        nextSequence = 0;
+        firingSequence = 0;
+        isScheduled = false;
+        isFiring = false;
+        isUnregistered = false;
+    }
+
+    ChannelInfo* channelInfo;
+    SubscriberInfo subscriberInfo;
+    SubscriberOption subscriberOption;
+    SubscriberStatistics subscriberStatistics;
+    uint64_t nextSequence; // Sequence of the next data to fire.
+    uint64_t firingSequence; // Sequence of the first data being fired, while isFiring.
+    bool isScheduled; // The fire task of the subscriber is submitted, only one runs at a time so the data is fired in order.
+    bool isFiring;
+    bool isUnregistered; // Unregistered while isScheduled, the fire task removes the cursor.
+
+    // Only used by the fire task, kept to reuse their capacity.
+    std::vector<LoggedData*> firingDataList;
+    std::vector<FiredData> firedDataList;
+};
+
 struct ChannelInfo
 {
     ChannelInfo()
     {
         flushTime = 0;
         maxBufferedDataSize = 0;
+        fireMode = FireMode::kPolling;
+        coalescedDataCount = 0;
+        coalescedDataSize = 0;
+        coalescedTime = 0;
+        coalescingTimerWheel = nullptr;
+        coalescingDeadline = 0;
+        isCoalescingTimeExpired = false;
+        overflowPolicy = OverflowPolicy::kDropOldest;
+        blockTimeout = 0;
+        waitingPublisherCount = 0;
+        pendingDataCount = 0;
+        pendingDataSize = 0;
+        isFireThreadWaiting = false;
         fireStatus = FireStatus::kRunning;
         fireThread = nullptr;
         firedDataCount = 0;
         lostDataCount = 0;
+        channelVersion = 0;
         currentBufferedDataSize = 0;
+        queueType = QueueType::kList;
+        priorityLaneCount = 1;
+        laneScheduling = LaneScheduling::kStrict;
+        scheduledLaneIndex = 0;
+        remainingLaneWeight = 0;
+        conflationMode = ConflationMode::kNone;
+        conflatedDataCount = 0;
+        snapshotSubscriberCount = 0;
+        publishedDataRing = nullptr;
+        sharedMemoryRing = nullptr;
+        clearedRingPosition = 0;
+        channelLog = nullptr;
+        dataPool = nullptr;
+        dataCodec = nullptr;
+        compressionThreshold = 0;
+        compressedDataCount = 0;
+        compressionSavedSize = 0;
+        fireThreadType = FireThreadType::kDedicated;
+        isFireTaskScheduled = false;
+        fireTaskCount = 0;
+        blockingSubscriberCount = 0;
+        firedDataLogSequence = 0;
+        firedDataLogSize = 0;
+        referenceCount = 1;
+        isDeleted = false;
+        activePublisherCount = 0;
     }
 
-    //std::wstring name; // key of list
+    std::wstring channelName; // Key of the channel list
+    // Synchronizes all of the members below.
+    // Atomic members are also accessed without it by PublishData and FireThread of a kRing channel.
+    SyncLock channelSync;
     uint32_t flushTime;
-    uint32_t maxBufferedDataSize;
-    FireStatus fireStatus;
+    std::atomic<uint32_t> maxBufferedDataSize;
+    FireMode fireMode;
+    uint32_t coalescedDataCount;
+    uint32_t coalescedDataSize;
+    uint32_t coalescedTime; // Unit: Microsecond
+    TimerWheel* coalescingTimerWheel; // Set once coalescedTime is used, DeleteChannel cancels coalescingTimer on it.
+    TimerWheelEntry coalescingTimer;
+    uint64_t coalescingDeadline; // Nanoseconds of the steady clock while coalescingTimer is armed, otherwise 0.
+    bool isCoalescingTimeExpired; // Until the next fire.
+    OverflowPolicy overflowPolicy;
+    uint32_t blockTimeout;
+    std::condition_variable_any publishEvent; // Signaled when buffered data is taken out, for publishers waiting for room.
+    std::atomic<uint32_t> waitingPublisherCount; // DeleteChannel waits for them.
+    std::deque<PendingData> pendingDataList; // PublishDataAsync
+    std::atomic<uint32_t> pendingDataCount; // Read by a kRing FireThread without the channel lock.
+    uint64_t pendingDataSize; // At most maxBufferedDataSize, unless it holds one data. Unit: Byte
+    std::atomic<bool> isFireThreadWaiting;
+    std::condition_variable_any fireEvent;
+    std::atomic<FireStatus> fireStatus;
     std::thread* fireThread;
-    uint32_t firedDataCount;
-    uint32_t lostDataCount;
+    std::atomic<uint64_t> firedDataCount;
+    std::atomic<uint64_t> lostDataCount;
+    std::atomic<uint32_t> channelVersion; // Increased whenever the settings or the subscriber list are changed.
 
-    uint32_t currentBufferedDataSize;
-    std::list<PublishedData> publishedDataList;
+    std::atomic<uint32_t> currentBufferedDataSize;
+    QueueType queueType;
+    // kList, buffered data by priority. currentBufferedDataSize is the total of the lanes.
+    uint32_t priorityLaneCount;
+    LaneScheduling laneScheduling;
+    PriorityLane priorityLaneList[kMaxPriorityLaneCount];
+    uint32_t scheduledLaneIndex; // kWeighted, the lane of the turn.
+    uint32_t remainingLaneWeight; // kWeighted, data the lane of the turn can still fire.
+    std::list<PublishedData> recycledDataList; // kList, fired nodes of the lanes are spliced back here for reuse.
+    ConflationMode conflationMode;
+    std::unordered_map<uint64_t, std::list<PublishedData>::iterator> conflationIndex; // Buffered keyed data in the lanes by their key.
+    std::atomic<uint64_t> conflatedDataCount; // Buffered data replaced by data of the same key.
+    // kLastValueCache, only changed by FireThread under the channel lock, so FireThread reads it without the lock.
+    std::unordered_map<uint64_t, PublishedData> lastValueCache;
+    uint32_t snapshotSubscriberCount; // Subscribers of isSnapshotPending.
+    MpscRing<PublishedData>* publishedDataRing; // kRing
+    SyncLock ringPopSync; // kRing, held to pop publishedDataRing, so kDropOldest publishers can pop the oldest data as FireThread does.
+    SharedMemoryRing* sharedMemoryRing; // kSharedMemory
+    std::atomic<uint64_t> clearedRingPosition; // kRing and kSharedMemory, data before this position were cleared by Resume.
+    ChannelLog* channelLog; // Closed by DeleteChannel, and deleted with the channel for ReplayChannelLog in progress.
+    std::shared_ptr<DataPool> dataPool; // Storage of copied and reserved data, it outlives the channel while such data remains.
+    DataCodec* dataCodec; // compressionThreshold, used by PublishData, FireThread and channelLog without the channel lock.
+    uint32_t compressionThreshold;
+    std::atomic<uint64_t> compressedDataCount;
+    std::atomic<uint64_t> compressionSavedSize; // Unit: Byte
+
+    std::list<SubscriberInfo> subscriberInfoList; // In registration order.
+    SubscriberMask usedSubscriberMask; // IDs of subscriberInfoList, an ID is reused after its subscriber is unregistered.
+
+    // kShared
+    // The channel fire task moves buffered data to firedDataLog, applying the overflow policy of each subscriber,
+    // and submits the fire task of each subscriber.
+    // Data is released when every subscriber fired or dropped it, and removed from the front of firedDataLog when no fire task reads it.
+    FireThreadType fireThreadType;
+    std::atomic<bool> isFireTaskScheduled;
+    uint32_t fireTaskCount; // Submitted fire tasks that did not finish, DeleteChannel waits for them.
+    std::atomic<uint32_t> blockingSubscriberCount; // Subscribers of kBlock, read by kRing publishers without the channel lock.
+    std::deque<LoggedData> firedDataLog; // A deque keeps the data in place while the log grows and shrinks at the ends.
+    uint64_t firedDataLogSequence; // Sequence of firedDataLog.front()
+    uint64_t firedDataLogSize; // Data not released yet, Unit: Byte
+    std::list<SubscriberCursor> subscriberCursorList;
+
+    // Recorded without the channel lock, see ChannelStatistics.
+    Histogram deliveryLatencyHistogram;
+    Histogram lockWaitTimeHistogram;
+    Histogram bufferedDataCountHistogram;
+    Histogram bufferedDataSizeHistogram;
 
-    std::list<SUBSCRIBER_CALLBACK> subscriberCallbackList;
+    // The channel list and each ChannelHandle hold a reference, the last one deletes the channel.
+    std::atomic<uint32_t> referenceCount;
+    std::atomic<bool> isDeleted; // Set by DeleteChannel when the channel is removed from the list.
+    std::atomic<uint32_t> activePublisherCount; // Publishers between EnterPublisher_ and LeavePublisher_, DeleteChannel waits for them.
+};
+
+/*
+    Refers to a channel without searching its name, returned by PubSubLite::CreateChannel and PubSubLite::OpenChannel.
+    A handle keeps the memory of the channel alive, so it can be used after DeleteChannel,
+    but methods called with it return kNotExistChannel, even if a channel of the same name is created again.
+*/
+class ChannelHandle
+{
+public:
+    ChannelHandle();
+    ChannelHandle(_In_ const ChannelHandle& channelHandle);
+    ChannelHandle(_Inout_ ChannelHandle&& channelHandle) noexcept;
+    ~ChannelHandle();
+
+    ChannelHandle& operator=(_In_ const ChannelHandle& channelHandle);
+    ChannelHandle& operator=(_Inout_ ChannelHandle&& channelHandle) noexcept;
+
+    // false if the handle does not refer to a channel, not if the channel is deleted.
+    bool IsValid() const;
+    const std::wstring& GetChannelName() const;
+
+    void Reset();
+
+private:
+    friend class PubSubLite;
+
+    explicit ChannelHandle(_In_ ChannelInfo* channelInfo);
+
+    ChannelInfo* channelInfo_;
 };
 
 class PubSubLite
@@ -77,8 +655,24 @@ class PubSubLite
 public:
     // Channel Method
     static Error CreateChannel(_In_ const std::wstring& channelName, _In_opt_ uint32_t flushTime = kDefaultFlushTime, _In_opt_ uint32_t maxBufferedDataSize = kDefaultMaxBufferedDataSize);
+    // Wildcard subscribers matching channelName are registered to it, and kExceedSubscriberCount is returned without creating it if they do not fit.
+    static Error CreateChannel(_In_ const std::wstring& channelName, _In_ const ChannelOption& channelOption);
+    // channelHandle refers to the created channel.
+    static Error CreateChannel(_In_ const std::wstring& channelName, _In_ const ChannelOption& channelOption, _Out_ ChannelHandle& channelHandle);
+    static Error OpenChannel(_In_ const std::wstring& channelName, _Out_ ChannelHandle& channelHandle);
     static Error UpdateChannel(_In_ const std::wstring& channelName, _In_ uint32_t flushTime, _In_ uint32_t maxDataSize);
+    // Also changes the coalescing of the channel, see ChannelOption.
+    static Error UpdateChannel(
+        _In_ const std::wstring& channelName,
+        _In_ uint32_t flushTime,
+        _In_ uint32_t maxDataSize,
+        _In_ uint32_t coalescedDataCount,
+        _In_ uint32_t coalescedDataSize,
+        _In_ uint32_t coalescedTime
+    );
     static Error DeleteChannel(_In_ const std::wstring& channelName);
+    // Deletes the channel of channelHandle, and returns kNotExistChannel if it is already deleted, even if a channel of the same name exists.
+    static Error DeleteChannel(_In_ const ChannelHandle& channelHandle);
 
     // Publisher Method
     static Error PublishData(
@@ -88,28 +682,473 @@ public:
         _In_opt_ void* userContext = nullptr,
         _In_opt_ const std::vector<SUBSCRIBER_CALLBACK>* fireCallbackList = nullptr
     );
+    // Takes the ownership of dataBuffer instead of copying the data.
+    static Error PublishData(
+        _In_ const std::wstring& channelName,
+        _Inout_ DataBuffer&& dataBuffer,
+        _In_opt_ void* userContext = nullptr,
+        _In_opt_ const std::vector<SUBSCRIBER_CALLBACK>* fireCallbackList = nullptr
+    );
+    // Fires the data only to the subscriber IDs in fireSubscriberMask.
+    static Error PublishData(
+        _In_ const std::wstring& channelName,
+        _In_ const uint8_t* data,
+        _In_ uint32_t dataSize,
+        _In_opt_ void* userContext,
+        _In_ const SubscriberMask& fireSubscriberMask
+    );
+    static Error PublishData(
+        _In_ const std::wstring& channelName,
+        _Inout_ DataBuffer&& dataBuffer,
+        _In_opt_ void* userContext,
+        _In_ const SubscriberMask& fireSubscriberMask
+    );
+    // Waits for room until deadline whatever overflowPolicy of the channel is, and returns kNotEnoughBufferSize on timeout.
+    static Error PublishData(
+        _In_ const std::wstring& channelName,
+        _In_ const uint8_t* data,
+        _In_ uint32_t dataSize,
+        _In_opt_ void* userContext,
+        _In_ const std::chrono::steady_clock::time_point& deadline,
+        _In_opt_ const SubscriberMask* fireSubscriberMask = nullptr
+    );
+    static Error PublishData(
+        _In_ const std::wstring& channelName,
+        _Inout_ DataBuffer&& dataBuffer,
+        _In_opt_ void* userContext,
+        _In_ const std::chrono::steady_clock::time_point& deadline,
+        _In_opt_ const SubscriberMask* fireSubscriberMask = nullptr
+    );
+    // Returns kNotEnoughBufferSize right away if the data does not fit, whatever overflowPolicy of the channel is.
+    static Error TryPublishData(
+        _In_ const std::wstring& channelName,
+        _In_ const uint8_t* data,
+        _In_ uint32_t dataSize,
+        _In_opt_ void* userContext = nullptr,
+        _In_opt_ const SubscriberMask* fireSubscriberMask = nullptr
+    );
+    static Error TryPublishData(
+        _In_ const std::wstring& channelName,
+        _Inout_ DataBuffer&& dataBuffer,
+        _In_opt_ void* userContext = nullptr,
+        _In_opt_ const SubscriberMask* fireSubscriberMask = nullptr
+    );
+    // Returns without waiting, and completionCallback is called once the data is buffered, in published order.
+    // completionCallback is only called if kSuccess is returned. kNotEnoughBufferSize is returned while maxBufferedDataSize of data is queued.
+    static Error PublishDataAsync(
+        _In_ const std::wstring& channelName,
+        _In_ const uint8_t* data,
+        _In_ uint32_t dataSize,
+        _In_opt_ void* userContext,
+        _In_ PUBLISH_COMPLETION_CALLBACK completionCallback,
+        _In_opt_ void* completionContext = nullptr,
+        _In_opt_ const SubscriberMask* fireSubscriberMask = nullptr
+    );
+    static Error PublishDataAsync(
+        _In_ const std::wstring& channelName,
+        _Inout_ DataBuffer&& dataBuffer,
+        _In_opt_ void* userContext,
+        _In_ PUBLISH_COMPLETION_CALLBACK completionCallback,
+        _In_opt_ void* completionContext = nullptr,
+        _In_opt_ const SubscriberMask* fireSubscriberMask = nullptr
+    );
+    // The same methods by ChannelHandle, which do not search the channel name.
+    static Error PublishData(
+        _In_ const ChannelHandle& channelHandle,
+        _In_ const uint8_t* data,
+        _In_ uint32_t dataSize,
+        _In_opt_ void* userContext = nullptr,
+        _In_opt_ const std::vector<SUBSCRIBER_CALLBACK>* fireCallbackList = nullptr
+    );
+    static Error PublishData(
+        _In_ const ChannelHandle& channelHandle,
+        _Inout_ DataBuffer&& dataBuffer,
+        _In_opt_ void* userContext = nullptr,
+        _In_opt_ const std::vector<SUBSCRIBER_CALLBACK>* fireCallbackList = nullptr
+    );
+    static Error PublishData(
+        _In_ const ChannelHandle& channelHandle,
+        _In_ const uint8_t* data,
+        _In_ uint32_t dataSize,
+        _In_opt_ void* userContext,
+        _In_ const SubscriberMask& fireSubscriberMask
+    );
+    static Error PublishData(
+        _In_ const ChannelHandle& channelHandle,
+        _Inout_ DataBuffer&& dataBuffer,
+        _In_opt_ void* userContext,
+        _In_ const SubscriberMask& fireSubscriberMask
+    );
+    static Error PublishData(
+        _In_ const ChannelHandle& channelHandle,
+        _In_ const uint8_t* data,
+        _In_ uint32_t dataSize,
+        _In_opt_ void* userContext,
+        _In_ const std::chrono::steady_clock::time_point& deadline,
+        _In_opt_ const SubscriberMask* fireSubscriberMask = nullptr
+    );
+    static Error PublishData(
+        _In_ const ChannelHandle& channelHandle,
+        _Inout_ DataBuffer&& dataBuffer,
+        _In_opt_ void* userContext,
+        _In_ const std::chrono::steady_clock::time_point& deadline,
+        _In_opt_ const SubscriberMask* fireSubscriberMask = nullptr
+    );
+    static Error TryPublishData(
+        _In_ const ChannelHandle& channelHandle,
+        _In_ const uint8_t* data,
+        _In_ uint32_t dataSize,
+        _In_opt_ void* userContext = nullptr,
+        _In_opt_ const SubscriberMask* fireSubscriberMask = nullptr
+    );
+    static Error TryPublishData(
+        _In_ const ChannelHandle& channelHandle,
+        _Inout_ DataBuffer&& dataBuffer,
+        _In_opt_ void* userContext = nullptr,
+        _In_opt_ const SubscriberMask* fireSubscriberMask = nullptr
+    );
+    static Error PublishDataAsync(
+        _In_ const ChannelHandle& channelHandle,
+        _In_ const uint8_t* data,
+        _In_ uint32_t dataSize,
+        _In_opt_ void* userContext,
+        _In_ PUBLISH_COMPLETION_CALLBACK completionCallback,
+        _In_opt_ void* completionContext = nullptr,
+        _In_opt_ const SubscriberMask* fireSubscriberMask = nullptr
+    );
+    static Error PublishDataAsync(
+        _In_ const ChannelHandle& channelHandle,
+        _Inout_ DataBuffer&& dataBuffer,
+        _In_opt_ void* userContext,
+        _In_ PUBLISH_COMPLETION_CALLBACK completionCallback,
+        _In_opt_ void* completionContext = nullptr,
+        _In_opt_ const SubscriberMask* fireSubscriberMask = nullptr
+    );
+    // Publishes to the priority lane of a kList channel, see ChannelOption::priorityLaneCount.
+    // kUnsuccess is returned if the channel has no lane of the priority.
+    static Error PublishPriorityData(
+        _In_ const std::wstring& channelName,
+        _In_ uint32_t priority,
+        _In_ const uint8_t* data,
+        _In_ uint32_t dataSize,
+        _In_opt_ void* userContext = nullptr,
+        _In_opt_ const SubscriberMask* fireSubscriberMask = nullptr
+    );
+    static Error PublishPriorityData(
+        _In_ const std::wstring& channelName,
+        _In_ uint32_t priority,
+        _Inout_ DataBuffer&& dataBuffer,
+        _In_opt_ void* userContext = nullptr,
+        _In_opt_ const SubscriberMask* fireSubscriberMask = nullptr
+    );
+    static Error PublishPriorityData(
+        _In_ const ChannelHandle& channelHandle,
+        _In_ uint32_t priority,
+        _In_ const uint8_t* data,
+        _In_ uint32_t dataSize,
+        _In_opt_ void* userContext = nullptr,
+        _In_opt_ const SubscriberMask* fireSubscriberMask = nullptr
+    );
+    static Error PublishPriorityData(
+        _In_ const ChannelHandle& channelHandle,
+        _In_ uint32_t priority,
+        _Inout_ DataBuffer&& dataBuffer,
+        _In_opt_ void* userContext = nullptr,
+        _In_opt_ const SubscriberMask* fireSubscriberMask = nullptr
+    );
+    // Publishes data of dataKey to a channel of conflationMode, see ChannelOption::conflationMode.
+    // The data is buffered in priority 0. Other channels take it as PublishData does.
+    static Error PublishKeyedData(
+        _In_ const std::wstring& channelName,
+        _In_ uint64_t dataKey,
+        _In_ const uint8_t* data,
+        _In_ uint32_t dataSize,
+        _In_opt_ void* userContext = nullptr,
+        _In_opt_ const SubscriberMask* fireSubscriberMask = nullptr
+    );
+    static Error PublishKeyedData(
+        _In_ const std::wstring& channelName,
+        _In_ uint64_t dataKey,
+        _Inout_ DataBuffer&& dataBuffer,
+        _In_opt_ void* userContext = nullptr,
+        _In_opt_ const SubscriberMask* fireSubscriberMask = nullptr
+    );
+    static Error PublishKeyedData(
+        _In_ const ChannelHandle& channelHandle,
+        _In_ uint64_t dataKey,
+        _In_ const uint8_t* data,
+        _In_ uint32_t dataSize,
+        _In_opt_ void* userContext = nullptr,
+        _In_opt_ const SubscriberMask* fireSubscriberMask = nullptr
+    );
+    static Error PublishKeyedData(
+        _In_ const ChannelHandle& channelHandle,
+        _In_ uint64_t dataKey,
+        _Inout_ DataBuffer&& dataBuffer,
+        _In_opt_ void* userContext = nullptr,
+        _In_opt_ const SubscriberMask* fireSubscriberMask = nullptr
+    );
+    // Publishes each data of batchDataList to every subscriber as PublishData does, with one search of the channel, one channel lock and one lock of the data pool.
+    // Each data is copied into its own block of the data pool, given back when it is released, and they are buffered together in priority 0 in list order.
+    // All of them are buffered or none, by overflowPolicy of the channel for their total size. kList and kRing only, otherwise kUnsuccess is returned.
+    static Error PublishBatch(_In_ const std::wstring& channelName, _In_ const PublishBatchData* batchDataList, _In_ uint32_t batchDataCount);
+    static Error PublishBatch(_In_ const ChannelHandle& channelHandle, _In_ const PublishBatchData* batchDataList, _In_ uint32_t batchDataCount);
+    // Reserves dataSize bytes of channel-owned storage to write the data in place.
+    // The reserved data is committed by PublishData(channelName, std::move(dataBuffer)), or given back when dataBuffer is destroyed.
+    static Error ReserveData(_In_ const std::wstring& channelName, _In_ uint32_t dataSize, _Out_ DataBuffer& dataBuffer);
+    static Error ReserveData(_In_ const ChannelHandle& channelHandle, _In_ uint32_t dataSize, _Out_ DataBuffer& dataBuffer);
 
     // Subscriber Method
-    static Error RegisterSubscriber(_In_ const std::wstring& channelName, _In_ const SUBSCRIBER_CALLBACK subscriberCallback);
+    // subscriberId receives the ID of the subscriber in the channel, which is used by SubscriberMask.
+    static Error RegisterSubscriber(_In_ const std::wstring& channelName, _In_ const SUBSCRIBER_CALLBACK subscriberCallback, _Out_opt_ uint32_t* subscriberId = nullptr);
     static Error UnregisterSubscriber(_In_ const std::wstring& channelName, _In_ const SUBSCRIBER_CALLBACK subscriberCallback);
+    static Error RegisterSubscriber(_In_ const std::wstring& channelName, _In_ const BATCH_SUBSCRIBER_CALLBACK batchSubscriberCallback, _Out_opt_ uint32_t* subscriberId = nullptr);
+    static Error UnregisterSubscriber(_In_ const std::wstring& channelName, _In_ const BATCH_SUBSCRIBER_CALLBACK batchSubscriberCallback);
+    static Error RegisterSubscriber(
+        _In_ const std::wstring& channelName,
+        _In_ const SUBSCRIBER_CALLBACK subscriberCallback,
+        _In_ const SubscriberOption& subscriberOption,
+        _Out_opt_ uint32_t* subscriberId = nullptr
+    );
+    static Error RegisterSubscriber(
+        _In_ const std::wstring& channelName,
+        _In_ const BATCH_SUBSCRIBER_CALLBACK batchSubscriberCallback,
+        _In_ const SubscriberOption& subscriberOption,
+        _Out_opt_ uint32_t* subscriberId = nullptr
+    );
+    // Registers the subscriber to every channel whose name matches topicFilter, including the channels created later.
+    // Channel names are topics of levels separated by '/'. In topicFilter, a '*' level matches one level,
+    // and a '#' level, only as the last level, matches the remaining levels.
+    static Error RegisterWildcardSubscriber(_In_ const std::wstring& topicFilter, _In_ const SUBSCRIBER_CALLBACK subscriberCallback);
+    static Error UnregisterWildcardSubscriber(_In_ const std::wstring& topicFilter, _In_ const SUBSCRIBER_CALLBACK subscriberCallback);
+    static Error RegisterWildcardSubscriber(_In_ const std::wstring& topicFilter, _In_ const BATCH_SUBSCRIBER_CALLBACK batchSubscriberCallback);
+    static Error UnregisterWildcardSubscriber(_In_ const std::wstring& topicFilter, _In_ const BATCH_SUBSCRIBER_CALLBACK batchSubscriberCallback);
+    static Error RegisterSubscriber(_In_ const ChannelHandle& channelHandle, _In_ const SUBSCRIBER_CALLBACK subscriberCallback, _Out_opt_ uint32_t* subscriberId = nullptr);
+    static Error UnregisterSubscriber(_In_ const ChannelHandle& channelHandle, _In_ const SUBSCRIBER_CALLBACK subscriberCallback);
+    static Error RegisterSubscriber(_In_ const ChannelHandle& channelHandle, _In_ const BATCH_SUBSCRIBER_CALLBACK batchSubscriberCallback, _Out_opt_ uint32_t* subscriberId = nullptr);
+    static Error UnregisterSubscriber(_In_ const ChannelHandle& channelHandle, _In_ const BATCH_SUBSCRIBER_CALLBACK batchSubscriberCallback);
+    static Error RegisterSubscriber(
+        _In_ const ChannelHandle& channelHandle,
+        _In_ const SUBSCRIBER_CALLBACK subscriberCallback,
+        _In_ const SubscriberOption& subscriberOption,
+        _Out_opt_ uint32_t* subscriberId = nullptr
+    );
+    static Error RegisterSubscriber(
+        _In_ const ChannelHandle& channelHandle,
+        _In_ const BATCH_SUBSCRIBER_CALLBACK batchSubscriberCallback,
+        _In_ const SubscriberOption& subscriberOption,
+        _Out_opt_ uint32_t* subscriberId = nullptr
+    );
 
     // Etc Method
     static Error Pause(_In_ const std::wstring& channelName);
+    // clearBuffer drops the buffered data as lost, and kShared the data the subscribers did not take from the log yet.
     static Error Resume(_In_ const std::wstring& channelName, _In_opt_ bool clearBuffer = false);
+    // Thread count of the FireExecutor shared by kShared channels. It can only be changed while no kShared channel exists.
+    static Error SetSharedFireThreadCount(_In_ uint32_t threadCount);
+    // Channels with logDirectory only, otherwise kUnsuccess is returned.
+    // Calls replayCallback for the logged data from logOffset in the calling thread, and nextLogOffset receives the offset after the last one.
+    // Data deleted by the log retention are skipped, so the first replayed data may be after logOffset.
+    static Error ReplayChannelLog(
+        _In_ const std::wstring& channelName,
+        _In_ uint64_t logOffset,
+        _In_ LOG_REPLAY_CALLBACK replayCallback,
+        _In_opt_ void* replayContext = nullptr,
+        _Out_opt_ uint64_t* nextLogOffset = nullptr
+    );
+    // Returns after the data logged so far are written to the disk.
+    static Error SyncChannelLog(_In_ const std::wstring& channelName);
 
     // Getter
-    static Error GetFiredDataCount(_In_ const std::wstring& channelName, _Out_ uint32_t& firedDataCount);
-    static Error GetLostDataCount(_In_ const std::wstring& channelName, _Out_ uint32_t& lostDataCount);
+    static Error GetFiredDataCount(_In_ const std::wstring& channelName, _Out_ uint64_t& firedDataCount);
+    static Error GetLostDataCount(_In_ const std::wstring& channelName, _Out_ uint64_t& lostDataCount);
+    static Error GetDataPoolStatistics(_In_ const std::wstring& channelName, _Out_ DataPoolStatistics& dataPoolStatistics);
+    // kShared only.
+    static Error GetSubscriberStatistics(_In_ const std::wstring& channelName, _In_ uint32_t subscriberId, _Out_ SubscriberStatistics& subscriberStatistics);
+    // Channels with logDirectory only.
+    static Error GetChannelLogStatistics(_In_ const std::wstring& channelName, _Out_ ChannelLogStatistics& channelLogStatistics);
+    // Counters, latency and callback time histograms and buffered data samples of the channel, see ChannelStatistics.
+    static Error GetChannelStatistics(_In_ const std::wstring& channelName, _Out_ ChannelStatistics& channelStatistics);
+    // ChannelStatistics of every channel, taken one channel at a time.
+    static Error GetAllChannelStatistics(_Out_ std::vector<ChannelStatistics>& channelStatisticsList);
+    static Error GetFiredDataCount(_In_ const ChannelHandle& channelHandle, _Out_ uint64_t& firedDataCount);
+    static Error GetLostDataCount(_In_ const ChannelHandle& channelHandle, _Out_ uint64_t& lostDataCount);
+    static Error GetDataPoolStatistics(_In_ const ChannelHandle& channelHandle, _Out_ DataPoolStatistics& dataPoolStatistics);
+    static Error GetSubscriberStatistics(_In_ const ChannelHandle& channelHandle, _In_ uint32_t subscriberId, _Out_ SubscriberStatistics& subscriberStatistics);
+    static Error GetChannelLogStatistics(_In_ const ChannelHandle& channelHandle, _Out_ ChannelLogStatistics& channelLogStatistics);
+    static Error GetChannelStatistics(_In_ const ChannelHandle& channelHandle, _Out_ ChannelStatistics& channelStatistics);
 
 private:
-    static std::unordered_map<std::wstring, ChannelInfo>::iterator SearchChannelInfo_(_In_ const std::wstring& channelName);
-    static std::list<SUBSCRIBER_CALLBACK>::iterator SearchSubscriberCallback_(_In_ ChannelInfo& channelInfo, _In_ const SUBSCRIBER_CALLBACK subscriberCallback);
+    friend class ChannelHandle;
+
+    static std::unordered_map<std::wstring, ChannelInfo*>::iterator SearchChannelInfo_(_In_ const std::wstring& channelName);
+    static ChannelInfo* FindChannelInfo_(_In_ const std::wstring& channelName, _In_opt_ const ChannelHandle* channelHandle);
+    static ChannelInfo* AcquireChannelInfo_(_In_ const std::wstring& channelName, _In_opt_ const ChannelHandle* channelHandle = nullptr);
+    static void ReleaseChannelInfo_(_Inout_ ChannelInfo* channelInfo);
+    static ChannelInfo* ReferChannelInfo_(_In_ const std::wstring& channelName);
+    static ChannelInfo* EnterPublisher_(_In_ const std::wstring& channelName, _In_opt_ const ChannelHandle* channelHandle);
+    static void LeavePublisher_(_Inout_ ChannelInfo* channelInfo);
+    static void LockChannel_(_Inout_ ChannelInfo* channelInfo);
+    static Error DeleteChannel_(_In_ const std::wstring& channelName, _In_opt_ const ChannelHandle* channelHandle);
+    static void GetChannelStatistics_(_In_ ChannelInfo* channelInfo, _Out_ ChannelStatistics& channelStatistics);
+    static Error PublishData_(
+        _In_ const std::wstring& channelName,
+        _In_opt_ const ChannelHandle* channelHandle,
+        _In_opt_ const uint8_t* data,
+        _In_opt_ DataBuffer* dataBuffer,
+        _In_ uint32_t dataSize,
+        _In_opt_ void* userContext,
+        _In_opt_ const std::vector<SUBSCRIBER_CALLBACK>* fireCallbackList,
+        _In_opt_ const SubscriberMask* fireSubscriberMask,
+        _In_ uint32_t priority,
+        _In_opt_ const uint64_t* dataKey,
+        _In_ PublishMode publishMode,
+        _In_opt_ const std::chrono::steady_clock::time_point* deadline,
+        _In_opt_ PUBLISH_COMPLETION_CALLBACK completionCallback,
+        _In_opt_ void* completionContext
+    );
+    static Error PublishSharedMemoryData_(
+        _Inout_ ChannelInfo* channelInfo,
+        _In_ const uint8_t* data,
+        _In_ uint32_t dataSize,
+        _In_ PublishMode publishMode,
+        _In_opt_ const std::chrono::steady_clock::time_point* deadline
+    );
+    static bool PushPublishedData_(_Inout_ ChannelInfo* channelInfo, _Inout_ PublishedData& publishedData);
+    static Error PublishBatch_(
+        _In_ const std::wstring& channelName,
+        _In_opt_ const ChannelHandle* channelHandle,
+        _In_ const PublishBatchData* batchDataList,
+        _In_ uint32_t batchDataCount
+    );
+    static bool PackBatchData_(
+        _Inout_ ChannelInfo* channelInfo,
+        _In_ const PublishBatchData* batchDataList,
+        _In_ uint32_t batchDataCount,
+        _Out_ std::vector<PublishedData>& publishedDataList,
+        _Out_ uint32_t& batchDataSize
+    );
+    static bool PushBatchData_(
+        _Inout_ ChannelInfo* channelInfo,
+        _Inout_ std::vector<PublishedData>& publishedDataList,
+        _In_ const std::vector<ChannelLogData>& logDataList,
+        _In_ uint32_t batchDataSize
+    );
+    static bool CompressData_(_Inout_ ChannelInfo* channelInfo, _In_ const uint8_t* data, _In_ uint32_t dataSize, _Out_ DataBuffer& compressedDataBuffer);
+    static void DecompressDataList_(_Inout_ ChannelInfo* channelInfo, _Inout_ std::list<PublishedData>& publishedDataList);
+    static void AdmitPendingData_(_Inout_ ChannelInfo* channelInfo, _Inout_ std::vector<PendingData>& completedDataList);
+    static void CompletePendingData_(_Inout_ std::vector<PendingData>& completedDataList);
+    static uint64_t GetDataPoolLimitSize_(_In_ uint32_t maxBufferedDataSize);
+    static Error RegisterSubscriber_(
+        _In_ const std::wstring& channelName,
+        _In_opt_ const ChannelHandle* channelHandle,
+        _In_ const SubscriberInfo& subscriberInfo,
+        _In_opt_ const SubscriberOption* subscriberOption,
+        _Out_opt_ uint32_t* subscriberId
+    );
+    static Error UnregisterSubscriber_(
+        _In_ const std::wstring& channelName,
+        _In_opt_ const ChannelHandle* channelHandle,
+        _In_ const SubscriberInfo& subscriberInfo
+    );
+    static Error AddSubscriberInfo_(
+        _Inout_ ChannelInfo* channelInfo,
+        _In_ const SubscriberInfo& subscriberInfo,
+        _In_opt_ const SubscriberOption* subscriberOption,
+        _Out_opt_ uint32_t* subscriberId
+    );
+    static void RemoveSubscriberInfo_(_Inout_ ChannelInfo* channelInfo, _In_ std::list<SubscriberInfo>::iterator subscriberInfoListIter);
+    static Error RegisterWildcardSubscriber_(_In_ const std::wstring& topicFilter, _In_ const SubscriberInfo& subscriberInfo);
+    static Error UnregisterWildcardSubscriber_(_In_ const std::wstring& topicFilter, _In_ const SubscriberInfo& subscriberInfo);
+    static std::list<SubscriberInfo>::iterator SearchSubscriberInfo_(_In_ ChannelInfo& channelInfo, _In_ const SubscriberInfo& subscriberInfo);
+    static void GetFireSubscriberMask_(_In_ ChannelInfo& channelInfo, _In_ const std::vector<SUBSCRIBER_CALLBACK>& fireCallbackList, _Out_ SubscriberMask& fireSubscriberMask);
     static void FireThread_(ChannelInfo* channelInfo);
-    static void AdjustDataBuffer_(_Inout_ ChannelInfo* channelInfo);
+    static void FireRingThread_(ChannelInfo* channelInfo);
+    static void FireSharedMemoryThread_(ChannelInfo* channelInfo);
+    static void FireData_(
+        _Inout_ ChannelInfo* channelInfo,
+        _In_ const std::vector<SubscriberInfo>& subscriberInfoList,
+        _In_ const PublishedData& publishedData,
+        _In_ const SubscriberMask& fireSubscriberMask
+    );
+    static void FireDataList_(
+        _Inout_ ChannelInfo* channelInfo,
+        _In_ const std::vector<SubscriberInfo>& subscriberInfoList,
+        _In_ const std::list<PublishedData>& firingDataList,
+        _Inout_ FireBuffer& fireBuffer
+    );
+    static bool HasSubscriberFilter_(_In_ const std::vector<SubscriberInfo>& subscriberInfoList);
+    static void FilterFiredDataList_(
+        _In_ const std::vector<SubscriberInfo>& subscriberInfoList,
+        _In_ const std::vector<FiredData>& firedDataList,
+        _Inout_ FireBuffer& fireBuffer
+    );
+    static void AdjustDataBuffer_(_Inout_ ChannelInfo* channelInfo, _In_ uint32_t priority, _In_ uint32_t dataSize);
+    static void DropOldestLaneData_(_Inout_ ChannelInfo* channelInfo, _Inout_ PriorityLane& priorityLane);
+    static void DropOldestRingData_(_Inout_ ChannelInfo* channelInfo);
+    static bool IsBlockingPublisher_(_In_ ChannelInfo* channelInfo);
+    static bool IsBufferFull_(_In_ ChannelInfo* channelInfo, _In_ uint32_t priority, _In_ uint32_t dataSize);
+    static Error WaitBufferedDataSize_(
+        _Inout_ ChannelInfo* channelInfo,
+        _In_ uint32_t priority,
+        _In_ uint32_t dataSize,
+        _In_opt_ const std::chrono::steady_clock::time_point* deadline
+    );
+    static size_t GetBufferedDataCount_(_In_ ChannelInfo* channelInfo);
+    static uint32_t SelectPriorityLane_(_Inout_ ChannelInfo* channelInfo);
+    static void TakeLaneData_(_Inout_ ChannelInfo* channelInfo, _Inout_ std::list<PublishedData>& firingDataList);
+    static bool ReplaceConflatedData_(_Inout_ ChannelInfo* channelInfo, _Inout_ PublishedData& publishedData);
+    static void UnindexConflatedData_(_Inout_ ChannelInfo* channelInfo, _In_ std::list<PublishedData>::iterator publishedDataListIter);
+    static void UpdateLastValueCache_(_Inout_ ChannelInfo* channelInfo, _Inout_ std::list<PublishedData>& firedDataList);
+    static void FireLastValueSnapshot_(
+        _Inout_ ChannelInfo* channelInfo,
+        _In_ const std::vector<SubscriberInfo>& snapshotSubscriberInfoList,
+        _Inout_ FireBuffer& fireBuffer
+    );
+    static bool HasFireableData_(_In_ ChannelInfo* channelInfo);
+    static void SignalFireThread_(_Inout_ ChannelInfo* channelInfo, _In_ bool isForced);
+    static void WaitFireSignal_(_Inout_ ChannelInfo* channelInfo);
+    static Error UpdateChannel_(
+        _In_ const std::wstring& channelName,
+        _In_ uint32_t flushTime,
+        _In_ uint32_t maxDataSize,
+        _In_opt_ const ChannelOption* coalescingOption
+    );
+    static bool IsCoalescingDone_(_In_ ChannelInfo* channelInfo);
+    static void ArmCoalescingTimer_(_Inout_ ChannelInfo* channelInfo);
+    static void ResetCoalescing_(_Inout_ ChannelInfo* channelInfo);
+    static void CoalescingTimerCallback_(_In_opt_ void* timerContext);
+
+    // kShared
+    static void ScheduleFireTask_(_Inout_ ChannelInfo* channelInfo);
+    static void FinishFireTask_(_Inout_ ChannelInfo* channelInfo);
+    static void FireChannelTask_(_In_opt_ void* taskContext);
+    static void FireSubscriberTask_(_In_opt_ void* taskContext);
+    static void MoveToFiredDataLog_(_Inout_ ChannelInfo* channelInfo);
+    static bool IsFiredDataLogFull_(_In_ ChannelInfo* channelInfo, _In_ uint32_t dataSize);
+    static void AppendFiredDataLog_(_Inout_ ChannelInfo* channelInfo, _Inout_ PublishedData& publishedData);
+    static void ReleaseLoggedData_(_Inout_ ChannelInfo* channelInfo, _Inout_ LoggedData& loggedData);
+    static void ReleaseCursorData_(_Inout_ ChannelInfo* channelInfo, _Inout_ SubscriberCursor& subscriberCursor, _In_ bool isLost);
+    static void DetachSubscriberCursor_(_Inout_ ChannelInfo* channelInfo, _Inout_ SubscriberCursor& subscriberCursor);
+    static void TrimFiredDataLog_(_Inout_ ChannelInfo* channelInfo);
+    static uint32_t GetMaxLagDataSize_(_In_ ChannelInfo* channelInfo, _In_ const SubscriberCursor& subscriberCursor);
 
 private:
-    static ::CRITICAL_SECTION channelInfoListSync_;
-    static std::unordered_map<std::wstring, ChannelInfo> channelInfoList_;
+    // Synchronizes only the channel list, and each ChannelInfo is synchronized by its own channelSync.
+    // Lock order: channelInfoListSync_ -> ChannelInfo::channelSync
+    static std::shared_mutex channelInfoListSync_;
+    static std::unordered_map<std::wstring, ChannelInfo*> channelInfoList_;
+    // Synchronized by channelInfoListSync_.
+    static TopicTrie<SubscriberInfo> wildcardSubscriberTrie_;
+    static uint64_t lastWildcardSubscriberId_;
+
+    // Synchronized by channelInfoListSync_, it is created when the first kShared channel is created.
+    static std::unique_ptr<FireExecutor> sharedFireExecutor_;
+    static uint32_t sharedFireThreadCount_;
+    static uint32_t sharedChannelCount_;
+    // Synchronized by channelInfoListSync_, it is created when coalescedTime is first used and is never deleted,
+    // so a channel keeps a pointer to it.
+    static std::unique_ptr<TimerWheel> coalescingTimerWheel_;
 };
 
 }
\ No newline at end of file
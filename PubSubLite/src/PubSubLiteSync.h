@@ -0,0 +1,173 @@
+/*!
+ * \author Ezbeat, Ji Hoon Park
+ */
+
+#pragma once
+
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#elif defined(__linux__)
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#else
+#include <thread>
+#endif
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#endif
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+// SAL annotations are only provided by the Microsoft toolchain.
+#ifndef _MSC_VER
+#ifndef _In_
+#define _In_
+#endif
+#ifndef _In_opt_
+#define _In_opt_
+#endif
+#ifndef _Out_
+#define _Out_
+#endif
+#ifndef _Out_opt_
+#define _Out_opt_
+#endif
+#ifndef _Inout_
+#define _Inout_
+#endif
+#endif
+
+namespace EzPubSub
+{
+
+const uint32_t kSyncSpinCount = 2000;
+const size_t kCacheLineSize = 64;
+
+inline void CpuRelax()
+{
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+    _mm_pause();
+#elif defined(__aarch64__) || defined(__arm__)
+    __asm__ __volatile__("yield");
+#endif
+}
+
+/*
+    Spin-then-block lock.
+    Windows uses a CRITICAL_SECTION with spin count, Linux spins and then waits on a futex,
+    other platforms spin and then yield the processor.
+    It satisfies Lockable, so it can be used with std::lock_guard and std::condition_variable_any.
+*/
+class SyncLock
+{
+public:
+    explicit SyncLock(_In_opt_ uint32_t spinCount = kSyncSpinCount)
+    {
+        spinCount_ = spinCount;
+#if defined(_WIN32)
+        ::InitializeCriticalSectionAndSpinCount(&criticalSection_, spinCount_);
+#else
+        lockState_.store(kUnlocked, std::memory_order_relaxed);
+#endif
+    }
+
+    ~SyncLock()
+    {
+#if defined(_WIN32)
+        ::DeleteCriticalSection(&criticalSection_);
+#endif
+    }
+
+    SyncLock(const SyncLock&) = delete;
+    SyncLock& operator=(const SyncLock&) = delete;
+
+    void lock()
+    {
+#if defined(_WIN32)
+        ::EnterCriticalSection(&criticalSection_);
+#else
+        uint32_t lockState = kUnlocked;
+
+        for (uint32_t spinIndex = 0; spinIndex < spinCount_; spinIndex++)
+        {
+            lockState = lockState_.load(std::memory_order_relaxed);
+            if ((lockState == kUnlocked) &&
+                (lockState_.compare_exchange_weak(lockState, kLocked, std::memory_order_acquire, std::memory_order_relaxed) == true))
+            {
+                return;
+            }
+            CpuRelax();
+        }
+
+        // Mark the lock as contended so that the owner wakes us up on unlock.
+        lockState = lockState_.exchange(kContended, std::memory_order_acquire);
+        while (lockState != kUnlocked)
+        {
+            Wait_();
+            lockState = lockState_.exchange(kContended, std::memory_order_acquire);
+        }
+#endif
+    }
+
+    bool try_lock()
+    {
+#if defined(_WIN32)
+        return (::TryEnterCriticalSection(&criticalSection_) != FALSE);
+#else
+        uint32_t lockState = kUnlocked;
+        return lockState_.compare_exchange_strong(lockState, kLocked, std::memory_order_acquire, std::memory_order_relaxed);
+#endif
+    }
+
+    void unlock()
+    {
+#if defined(_WIN32)
+        ::LeaveCriticalSection(&criticalSection_);
+#else
+        if (lockState_.exchange(kUnlocked, std::memory_order_release) == kContended)
+        {
+            Wake_();
+        }
+#endif
+    }
+
+private:
+#if !defined(_WIN32)
+    void Wait_()
+    {
+#if defined(__linux__)
+        ::syscall(SYS_futex, reinterpret_cast<uint32_t*>(&lockState_), FUTEX_WAIT_PRIVATE, kContended, nullptr, nullptr, 0);
+#else
+        std::this_thread::yield();
+#endif
+    }
+
+    void Wake_()
+    {
+#if defined(__linux__)
+        ::syscall(SYS_futex, reinterpret_cast<uint32_t*>(&lockState_), FUTEX_WAKE_PRIVATE, 1, nullptr, nullptr, 0);
+#endif
+    }
+#endif
+
+private:
+    uint32_t spinCount_;
+#if defined(_WIN32)
+    ::CRITICAL_SECTION criticalSection_;
+#else
+    static const uint32_t kUnlocked = 0;
+    static const uint32_t kLocked = 1;
+    static const uint32_t kContended = 2;
+
+    std::atomic<uint32_t> lockState_;
+#endif
+};
+
+}
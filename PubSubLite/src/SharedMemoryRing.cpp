@@ -0,0 +1,781 @@
+/*!
+ * \author Ezbeat, Ji Hoon Park
+ */
+
+#include "SharedMemoryRing.h"
+#include "PubSubLite.h"
+#include "ChannelName.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <new>
+#include <thread>
+
+#if defined(__linux__)
+#include <cerrno>
+#include <climits>
+#include <csignal>
+#include <ctime>
+#include <fcntl.h>
+#include <pthread.h>
+#include <linux/futex.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+namespace EzPubSub
+{
+
+const uint32_t kSharedMemoryMagic = 0x4C535045; // "EPSL"
+const uint32_t kSharedMemoryVersion = 1;
+const uint32_t kSharedMemoryMinDataCapacity = 4096; // Unit: Byte
+const uint32_t kSharedMemoryOpenRetryCount = 1000; // Retried every millisecond while another process creates or removes the segment.
+const uint32_t kSharedMemoryPaddingDataSize = 0xFFFFFFFF;
+const uint64_t kSharedMemoryNotFiringPosition = ~0ull;
+
+enum class SharedMemoryState : uint32_t
+{
+    kInitializing, // Zero-filled by ftruncate until the creator initializes it.
+    kReady,
+    kClosed        // Removed by the last process, openers retry with a new segment.
+};
+
+// Followed by the data, the next record starts at recordSize aligned to kSharedMemoryRecordAlignment.
+struct SharedMemoryRecord
+{
+    uint32_t recordSize;
+    uint32_t dataSize; // kSharedMemoryPaddingDataSize: the rest of the ring is skipped.
+    uint64_t sequence; // Sequence of the data in the ring, a reader seeing a gap lost the data in between.
+};
+
+struct alignas(kCacheLineSize) SharedMemoryReader
+{
+    std::atomic<uint32_t> isUsed;
+    int32_t processId; // A reader whose process is gone is freed when a process attaches or detaches, or by the publisher it blocks.
+    std::atomic<uint64_t> cursorPosition; // Data before it were fired.
+    std::atomic<uint64_t> firingPosition; // Data from it are being fired, kSharedMemoryNotFiringPosition if not.
+};
+
+struct SharedMemoryHeader
+{
+    uint32_t magic;
+    uint32_t version;
+    std::atomic<uint32_t> segmentState;
+    uint32_t dataCapacity; // Unit: Byte
+
+    // Synchronizes the members up to headPosition and the ring data, the positions are also read by readers without it.
+    alignas(kCacheLineSize) pthread_mutex_t writerSync;
+    uint32_t attachCount;
+    uint64_t nextSequence;
+    alignas(kCacheLineSize) std::atomic<uint64_t> headPosition; // Oldest data not overwritten yet.
+    std::atomic<uint64_t> tailPosition; // End of the published data.
+
+    // Futexes, increased whenever data is published or released.
+    alignas(kCacheLineSize) std::atomic<uint32_t> publishSequence;
+    std::atomic<uint32_t> waitingReaderCount;
+    alignas(kCacheLineSize) std::atomic<uint32_t> releaseSequence;
+    std::atomic<uint32_t> waitingWriterCount;
+
+    SharedMemoryReader readerList[kMaxSharedMemoryReaderCount];
+};
+
+}
+
+namespace
+{
+
+const size_t kSharedMemoryHeaderSize = (sizeof(EzPubSub::SharedMemoryHeader) + EzPubSub::kCacheLineSize - 1) & ~(EzPubSub::kCacheLineSize - 1);
+
+uint64_t AlignRecordSize(_In_ uint64_t recordSize)
+{
+    return (recordSize + EzPubSub::kSharedMemoryRecordAlignment - 1) & ~static_cast<uint64_t>(EzPubSub::kSharedMemoryRecordAlignment - 1);
+}
+
+void WaitFutex(_In_ std::atomic<uint32_t>* futexValue, _In_ uint32_t expectedValue, _In_ uint32_t waitTime)
+{
+    struct timespec timeout;
+
+    timeout.tv_sec = waitTime / 1000;
+    timeout.tv_nsec = static_cast<long>(waitTime % 1000) * 1000000;
+    ::syscall(SYS_futex, reinterpret_cast<uint32_t*>(futexValue), FUTEX_WAIT, expectedValue, &timeout, nullptr, 0);
+
+    return;
+}
+
+void WakeFutex(_In_ std::atomic<uint32_t>* futexValue)
+{
+    ::syscall(SYS_futex, reinterpret_cast<uint32_t*>(futexValue), FUTEX_WAKE, INT_MAX, nullptr, nullptr, 0);
+
+    return;
+}
+
+}
+#endif
+
+EzPubSub::SharedMemoryRing::SharedMemoryRing()
+{
+    segmentHandle_ = -1;
+    segment_ = nullptr;
+    segmentSize_ = 0;
+    header_ = nullptr;
+    ringData_ = nullptr;
+    readerIndex_ = 0;
+    readingEndPosition_ = 0;
+    nextSequence_ = 0;
+}
+
+EzPubSub::SharedMemoryRing::~SharedMemoryRing()
+{
+    Close();
+}
+
+bool EzPubSub::SharedMemoryRing::Open(
+    _In_ const std::wstring& channelName,
+    _In_ uint32_t dataCapacity
+)
+{
+#if defined(__linux__)
+    /*
+        The creator of the segment sets its size and initializes the header, the others wait for it.
+        A segment removed by the last process between shm_open and the lock is retried.
+    */
+
+    bool isCreated = false;
+    bool isOpened = false;
+    uint64_t alignedDataCapacity = AlignRecordSize(std::max(dataCapacity, kSharedMemoryMinDataCapacity));
+    pthread_mutexattr_t writerSyncAttribute;
+    struct stat segmentStat;
+
+    if (segment_ != nullptr)
+    {
+        return false;
+    }
+
+    segmentName_ = "/PubSubLite." + EncodeChannelName(channelName);
+    for (uint32_t retryCount = 0; (retryCount < kSharedMemoryOpenRetryCount) && (isOpened == false); retryCount++)
+    {
+        segmentHandle_ = ::shm_open(segmentName_.c_str(), O_RDWR | O_CREAT | O_EXCL, 0600);
+        isCreated = (segmentHandle_ != -1);
+        if ((isCreated == false) && (errno == EEXIST))
+        {
+            segmentHandle_ = ::shm_open(segmentName_.c_str(), O_RDWR, 0600);
+        }
+        if (segmentHandle_ == -1)
+        {
+            if (errno != ENOENT)
+            {
+                return false;
+            }
+            continue;
+        }
+
+        if (isCreated == true)
+        {
+            segmentSize_ = kSharedMemoryHeaderSize + static_cast<size_t>(alignedDataCapacity);
+            if (::ftruncate(segmentHandle_, static_cast<off_t>(segmentSize_)) != 0)
+            {
+                ::shm_unlink(segmentName_.c_str());
+                ::close(segmentHandle_);
+                segmentHandle_ = -1;
+                return false;
+            }
+        }
+        else
+        {
+            segmentSize_ = 0;
+            if ((::fstat(segmentHandle_, &segmentStat) == 0) && (segmentStat.st_size > static_cast<off_t>(kSharedMemoryHeaderSize)))
+            {
+                segmentSize_ = static_cast<size_t>(segmentStat.st_size);
+            }
+        }
+
+        if (segmentSize_ != 0)
+        {
+            segment_ = static_cast<uint8_t*>(::mmap(nullptr, segmentSize_, PROT_READ | PROT_WRITE, MAP_SHARED, segmentHandle_, 0));
+            if (segment_ == MAP_FAILED)
+            {
+                segment_ = nullptr;
+            }
+        }
+        if (segment_ == nullptr)
+        {
+            // The creator did not set the size yet.
+            ::close(segmentHandle_);
+            segmentHandle_ = -1;
+            if (isCreated == true)
+            {
+                ::shm_unlink(segmentName_.c_str());
+                return false;
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            continue;
+        }
+        header_ = reinterpret_cast<SharedMemoryHeader*>(segment_);
+        ringData_ = segment_ + kSharedMemoryHeaderSize;
+
+        if (isCreated == true)
+        {
+            new (header_) SharedMemoryHeader;
+            header_->magic = kSharedMemoryMagic;
+            header_->version = kSharedMemoryVersion;
+            header_->dataCapacity = static_cast<uint32_t>(alignedDataCapacity);
+            pthread_mutexattr_init(&writerSyncAttribute);
+            pthread_mutexattr_setpshared(&writerSyncAttribute, PTHREAD_PROCESS_SHARED);
+            pthread_mutexattr_setrobust(&writerSyncAttribute, PTHREAD_MUTEX_ROBUST);
+            pthread_mutex_init(&header_->writerSync, &writerSyncAttribute);
+            pthread_mutexattr_destroy(&writerSyncAttribute);
+            header_->attachCount = 0;
+            header_->nextSequence = 0;
+            header_->headPosition.store(0, std::memory_order_relaxed);
+            header_->tailPosition.store(0, std::memory_order_relaxed);
+            header_->publishSequence.store(0, std::memory_order_relaxed);
+            header_->waitingReaderCount.store(0, std::memory_order_relaxed);
+            header_->releaseSequence.store(0, std::memory_order_relaxed);
+            header_->waitingWriterCount.store(0, std::memory_order_relaxed);
+            for (auto& sharedMemoryReader : header_->readerList)
+            {
+                sharedMemoryReader.isUsed.store(0, std::memory_order_relaxed);
+                sharedMemoryReader.processId = 0;
+                sharedMemoryReader.cursorPosition.store(0, std::memory_order_relaxed);
+                sharedMemoryReader.firingPosition.store(kSharedMemoryNotFiringPosition, std::memory_order_relaxed);
+            }
+            header_->segmentState.store(static_cast<uint32_t>(SharedMemoryState::kReady), std::memory_order_release);
+        }
+        else
+        {
+            for (uint32_t waitCount = 0;
+                (waitCount < kSharedMemoryOpenRetryCount) &&
+                (header_->segmentState.load(std::memory_order_acquire) == static_cast<uint32_t>(SharedMemoryState::kInitializing));
+                waitCount++)
+            {
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+
+            if ((header_->segmentState.load(std::memory_order_acquire) == static_cast<uint32_t>(SharedMemoryState::kInitializing)) ||
+                (header_->magic != kSharedMemoryMagic) ||
+                (header_->version != kSharedMemoryVersion) ||
+                (kSharedMemoryHeaderSize + header_->dataCapacity > segmentSize_))
+            {
+                ::munmap(segment_, segmentSize_);
+                ::close(segmentHandle_);
+                segment_ = nullptr;
+                segmentHandle_ = -1;
+                return false;
+            }
+        }
+
+        LockWriter_();
+        if (header_->segmentState.load(std::memory_order_acquire) == static_cast<uint32_t>(SharedMemoryState::kClosed))
+        {
+            UnlockWriter_();
+            ::munmap(segment_, segmentSize_);
+            ::close(segmentHandle_);
+            segment_ = nullptr;
+            segmentHandle_ = -1;
+            continue;
+        }
+
+        ReclaimDeadReaders_();
+        for (readerIndex_ = 0; readerIndex_ < kMaxSharedMemoryReaderCount; readerIndex_++)
+        {
+            SharedMemoryReader& sharedMemoryReader = header_->readerList[readerIndex_];
+
+            if (sharedMemoryReader.isUsed.load(std::memory_order_relaxed) == 0)
+            {
+                // The reader starts after the data published so far.
+                sharedMemoryReader.processId = static_cast<int32_t>(::getpid());
+                sharedMemoryReader.cursorPosition.store(header_->tailPosition.load(std::memory_order_relaxed), std::memory_order_relaxed);
+                sharedMemoryReader.firingPosition.store(kSharedMemoryNotFiringPosition, std::memory_order_relaxed);
+                sharedMemoryReader.isUsed.store(1, std::memory_order_seq_cst);
+                nextSequence_ = header_->nextSequence;
+                header_->attachCount++;
+                isOpened = true;
+                break;
+            }
+        }
+        UnlockWriter_();
+
+        if (isOpened == false)
+        {
+            ::munmap(segment_, segmentSize_);
+            ::close(segmentHandle_);
+            segment_ = nullptr;
+            segmentHandle_ = -1;
+            return false;
+        }
+    }
+
+    return isOpened;
+#else
+    (void)channelName;
+    (void)dataCapacity;
+
+    return false;
+#endif
+}
+
+void EzPubSub::SharedMemoryRing::Close()
+{
+#if defined(__linux__)
+    if (segment_ == nullptr)
+    {
+        return;
+    }
+
+    LockWriter_();
+    header_->readerList[readerIndex_].firingPosition.store(kSharedMemoryNotFiringPosition, std::memory_order_seq_cst);
+    header_->readerList[readerIndex_].isUsed.store(0, std::memory_order_seq_cst);
+    header_->attachCount--;
+    // The segment is also removed if the other processes attached to it are gone.
+    ReclaimDeadReaders_();
+    if (header_->attachCount == 0)
+    {
+        header_->segmentState.store(static_cast<uint32_t>(SharedMemoryState::kClosed), std::memory_order_release);
+        ::shm_unlink(segmentName_.c_str());
+    }
+    UnlockWriter_();
+
+    // Publishers waiting for this reader check the readers again.
+    Wake();
+
+    ::munmap(segment_, segmentSize_);
+    ::close(segmentHandle_);
+    segment_ = nullptr;
+    segmentHandle_ = -1;
+    header_ = nullptr;
+    ringData_ = nullptr;
+#endif
+
+    return;
+}
+
+bool EzPubSub::SharedMemoryRing::Push(
+    _In_ const uint8_t* data,
+    _In_ uint32_t dataSize,
+    _In_ bool isDropOldest,
+    _In_ uint32_t waitTime
+)
+{
+#if defined(__linux__)
+    /*
+        The record is written after the padding record if it does not fit before the end of the ring,
+        and the tail is moved past it once it is written, so readers never see a record being written.
+    */
+
+    uint64_t recordSize = AlignRecordSize(sizeof(SharedMemoryRecord) + static_cast<uint64_t>(dataSize));
+    uint64_t dataCapacity = 0;
+    uint64_t tailPosition = 0;
+    uint64_t paddingSize = 0;
+    uint64_t requiredHeadPosition = 0;
+    uint32_t releaseSequence = 0;
+    SharedMemoryRecord* sharedMemoryRecord = nullptr;
+    std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(waitTime);
+    std::chrono::steady_clock::time_point currentTime;
+
+    if ((segment_ == nullptr) || (IsTooLarge(dataSize) == true))
+    {
+        return false;
+    }
+
+    dataCapacity = header_->dataCapacity;
+    LockWriter_();
+    while (true)
+    {
+        tailPosition = header_->tailPosition.load(std::memory_order_relaxed);
+        paddingSize = ((dataCapacity - (tailPosition % dataCapacity)) < recordSize) ? (dataCapacity - (tailPosition % dataCapacity)) : 0;
+        requiredHeadPosition = (tailPosition + paddingSize + recordSize > dataCapacity) ? (tailPosition + paddingSize + recordSize - dataCapacity) : 0;
+        if (MakeRoom_(requiredHeadPosition, isDropOldest, deadline) == true)
+        {
+            break;
+        }
+
+        // MakeRoom_ of isDropOldest already waited for the readers up to the deadline.
+        currentTime = std::chrono::steady_clock::now();
+        if ((isDropOldest == true) || (waitTime == 0) || (currentTime >= deadline))
+        {
+            UnlockWriter_();
+            return false;
+        }
+
+        // Readers increase releaseSequence after they move their cursor, so it is read before the cursors are checked again.
+        header_->waitingWriterCount.fetch_add(1, std::memory_order_seq_cst);
+        releaseSequence = header_->releaseSequence.load(std::memory_order_seq_cst);
+        if (MakeRoom_(requiredHeadPosition, isDropOldest, deadline) == true)
+        {
+            header_->waitingWriterCount.fetch_sub(1, std::memory_order_relaxed);
+            break;
+        }
+        UnlockWriter_();
+
+        WaitFutex(&header_->releaseSequence, releaseSequence,
+            static_cast<uint32_t>(std::chrono::duration_cast<std::chrono::milliseconds>(deadline - currentTime).count()) + 1);
+        header_->waitingWriterCount.fetch_sub(1, std::memory_order_relaxed);
+        LockWriter_();
+    }
+
+    if (paddingSize != 0)
+    {
+        sharedMemoryRecord = reinterpret_cast<SharedMemoryRecord*>(ringData_ + (tailPosition % dataCapacity));
+        sharedMemoryRecord->recordSize = static_cast<uint32_t>(paddingSize);
+        sharedMemoryRecord->dataSize = kSharedMemoryPaddingDataSize;
+        sharedMemoryRecord->sequence = 0;
+    }
+
+    sharedMemoryRecord = reinterpret_cast<SharedMemoryRecord*>(ringData_ + ((tailPosition + paddingSize) % dataCapacity));
+    sharedMemoryRecord->recordSize = static_cast<uint32_t>(recordSize);
+    sharedMemoryRecord->dataSize = dataSize;
+    sharedMemoryRecord->sequence = header_->nextSequence++;
+    memcpy(sharedMemoryRecord + 1, data, dataSize);
+    header_->tailPosition.store(tailPosition + paddingSize + recordSize, std::memory_order_seq_cst);
+    UnlockWriter_();
+
+    // Pairs with WaitPublish, either the reader sees the data or we see it waiting.
+    header_->publishSequence.fetch_add(1, std::memory_order_seq_cst);
+    if (header_->waitingReaderCount.load(std::memory_order_seq_cst) != 0)
+    {
+        WakeFutex(&header_->publishSequence);
+    }
+
+    return true;
+#else
+    (void)data;
+    (void)dataSize;
+    (void)isDropOldest;
+    (void)waitTime;
+
+    return false;
+#endif
+}
+
+bool EzPubSub::SharedMemoryRing::IsTooLarge(
+    _In_ uint32_t dataSize
+) const
+{
+#if defined(__linux__)
+    // A record never wraps around, so it must fit in the ring by itself.
+    return ((segment_ == nullptr) || (AlignRecordSize(sizeof(SharedMemoryRecord) + static_cast<uint64_t>(dataSize)) > header_->dataCapacity));
+#else
+    (void)dataSize;
+
+    return true;
+#endif
+}
+
+void EzPubSub::SharedMemoryRing::ReadDataList(
+    _In_ uint64_t clearedPosition,
+    _In_ uint32_t maxDataCount,
+    _Inout_ std::vector<FiredData>& firedDataList,
+    _Out_ uint64_t& lostDataCount
+)
+{
+    /*
+        Every ReadDataList is followed by ReleaseDataList.
+        The firing position is set before the head is read, and a kDropOldest publisher moves the head before it reads the firing positions,
+        so either the publisher waits for the data being fired or this reader starts after the head.
+    */
+
+    lostDataCount = 0;
+
+#if defined(__linux__)
+    SharedMemoryReader& sharedMemoryReader = header_->readerList[readerIndex_];
+    uint64_t dataCapacity = header_->dataCapacity;
+    uint64_t cursorPosition = sharedMemoryReader.cursorPosition.load(std::memory_order_relaxed);
+    uint64_t headPosition = 0;
+    uint64_t tailPosition = 0;
+    uint64_t recordPosition = 0;
+    SharedMemoryRecord* sharedMemoryRecord = nullptr;
+
+    sharedMemoryReader.firingPosition.store(cursorPosition, std::memory_order_seq_cst);
+    headPosition = header_->headPosition.load(std::memory_order_seq_cst);
+    while (headPosition > cursorPosition)
+    {
+        cursorPosition = headPosition;
+        sharedMemoryReader.firingPosition.store(cursorPosition, std::memory_order_seq_cst);
+        headPosition = header_->headPosition.load(std::memory_order_seq_cst);
+    }
+
+    tailPosition = header_->tailPosition.load(std::memory_order_acquire);
+    readingEndPosition_ = cursorPosition;
+    while ((readingEndPosition_ < tailPosition) && (firedDataList.size() < maxDataCount))
+    {
+        recordPosition = readingEndPosition_;
+        sharedMemoryRecord = reinterpret_cast<SharedMemoryRecord*>(ringData_ + (recordPosition % dataCapacity));
+        readingEndPosition_ += sharedMemoryRecord->recordSize;
+        if (sharedMemoryRecord->dataSize == kSharedMemoryPaddingDataSize)
+        {
+            continue;
+        }
+
+        // Data dropped by kDropOldest before the head was reached.
+        lostDataCount += sharedMemoryRecord->sequence - nextSequence_;
+        nextSequence_ = sharedMemoryRecord->sequence + 1;
+        if (recordPosition < clearedPosition)
+        {
+            lostDataCount++;
+            continue;
+        }
+
+        firedDataList.emplace_back();
+        firedDataList.back().data = reinterpret_cast<const uint8_t*>(sharedMemoryRecord + 1);
+        firedDataList.back().dataSize = sharedMemoryRecord->dataSize;
+        firedDataList.back().userContext = nullptr;
+    }
+#else
+    (void)clearedPosition;
+    (void)maxDataCount;
+    (void)firedDataList;
+#endif
+
+    return;
+}
+
+void EzPubSub::SharedMemoryRing::ReleaseDataList()
+{
+#if defined(__linux__)
+    SharedMemoryReader& sharedMemoryReader = header_->readerList[readerIndex_];
+
+    sharedMemoryReader.cursorPosition.store(readingEndPosition_, std::memory_order_seq_cst);
+    sharedMemoryReader.firingPosition.store(kSharedMemoryNotFiringPosition, std::memory_order_seq_cst);
+
+    // Pairs with Push, either the publisher sees the cursor or we see it waiting.
+    header_->releaseSequence.fetch_add(1, std::memory_order_seq_cst);
+    if (header_->waitingWriterCount.load(std::memory_order_seq_cst) != 0)
+    {
+        WakeFutex(&header_->releaseSequence);
+    }
+#endif
+
+    return;
+}
+
+uint32_t EzPubSub::SharedMemoryRing::GetPublishSequence() const
+{
+#if defined(__linux__)
+    return header_->publishSequence.load(std::memory_order_seq_cst);
+#else
+    return 0;
+#endif
+}
+
+void EzPubSub::SharedMemoryRing::WaitPublish(
+    _In_ uint32_t publishSequence,
+    _In_ uint32_t waitTime
+)
+{
+#if defined(__linux__)
+    // publishSequence was read before the data were read, so data published after that changed it and the wait returns at once.
+    header_->waitingReaderCount.fetch_add(1, std::memory_order_seq_cst);
+    if (header_->tailPosition.load(std::memory_order_seq_cst) == header_->readerList[readerIndex_].cursorPosition.load(std::memory_order_relaxed))
+    {
+        WaitFutex(&header_->publishSequence, publishSequence, waitTime);
+    }
+    header_->waitingReaderCount.fetch_sub(1, std::memory_order_relaxed);
+#else
+    (void)publishSequence;
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(waitTime));
+#endif
+
+    return;
+}
+
+void EzPubSub::SharedMemoryRing::Wake()
+{
+#if defined(__linux__)
+    if (header_ == nullptr)
+    {
+        return;
+    }
+
+    header_->publishSequence.fetch_add(1, std::memory_order_seq_cst);
+    header_->releaseSequence.fetch_add(1, std::memory_order_seq_cst);
+    WakeFutex(&header_->publishSequence);
+    WakeFutex(&header_->releaseSequence);
+#endif
+
+    return;
+}
+
+uint64_t EzPubSub::SharedMemoryRing::GetTailPosition() const
+{
+#if defined(__linux__)
+    return header_->tailPosition.load(std::memory_order_acquire);
+#else
+    return 0;
+#endif
+}
+
+uint32_t EzPubSub::SharedMemoryRing::GetBufferedDataSize() const
+{
+#if defined(__linux__)
+    return static_cast<uint32_t>(header_->tailPosition.load(std::memory_order_acquire) -
+        std::max(header_->readerList[readerIndex_].cursorPosition.load(std::memory_order_relaxed), header_->headPosition.load(std::memory_order_acquire)));
+#else
+    return 0;
+#endif
+}
+
+bool EzPubSub::SharedMemoryRing::MakeRoom_(
+    _In_ uint64_t requiredHeadPosition,
+    _In_ bool isDropOldest,
+    _In_ const std::chrono::steady_clock::time_point& deadline
+)
+{
+#if defined(__linux__)
+    /*
+        The caller must hold writerSync.
+        Moves the head to the first record at or after requiredHeadPosition.
+        Without isDropOldest, it fails while a reader did not fire the data before requiredHeadPosition.
+        With isDropOldest, the head is moved first and only the readers firing the data before the new head are waited for, up to deadline.
+        The other publishers wait for writerSync meanwhile, so on timeout the head is moved back,
+        and the next publisher waits for the reader again instead of overwriting the data it is firing.
+    */
+
+    uint64_t previousHeadPosition = header_->headPosition.load(std::memory_order_relaxed);
+    uint64_t headPosition = previousHeadPosition;
+    uint32_t releaseSequence = 0;
+    std::chrono::steady_clock::time_point currentTime;
+
+    if (requiredHeadPosition <= headPosition)
+    {
+        return true;
+    }
+
+    headPosition = GetRecordEndPosition_(headPosition, requiredHeadPosition);
+    if (isDropOldest == false)
+    {
+        for (auto& sharedMemoryReader : header_->readerList)
+        {
+            if ((sharedMemoryReader.isUsed.load(std::memory_order_seq_cst) == 0) ||
+                (sharedMemoryReader.cursorPosition.load(std::memory_order_seq_cst) >= requiredHeadPosition))
+            {
+                continue;
+            }
+
+            if (IsReaderAlive_(sharedMemoryReader) == false)
+            {
+                sharedMemoryReader.isUsed.store(0, std::memory_order_seq_cst);
+                header_->attachCount--;
+                continue;
+            }
+            return false;
+        }
+
+        header_->headPosition.store(headPosition, std::memory_order_seq_cst);
+        return true;
+    }
+
+    header_->headPosition.store(headPosition, std::memory_order_seq_cst);
+    for (auto& sharedMemoryReader : header_->readerList)
+    {
+        while ((sharedMemoryReader.isUsed.load(std::memory_order_seq_cst) != 0) &&
+            (sharedMemoryReader.firingPosition.load(std::memory_order_seq_cst) < headPosition))
+        {
+            if (IsReaderAlive_(sharedMemoryReader) == false)
+            {
+                sharedMemoryReader.isUsed.store(0, std::memory_order_seq_cst);
+                header_->attachCount--;
+                break;
+            }
+
+            // The reader is calling its subscribers with the data, writerSync is kept so that no other publisher overwrites them.
+            // Readers that saw the moved head and skipped the data count them as lost even if the head is moved back.
+            currentTime = std::chrono::steady_clock::now();
+            if (currentTime >= deadline)
+            {
+                header_->headPosition.store(previousHeadPosition, std::memory_order_seq_cst);
+                return false;
+            }
+            header_->waitingWriterCount.fetch_add(1, std::memory_order_seq_cst);
+            releaseSequence = header_->releaseSequence.load(std::memory_order_seq_cst);
+            if (sharedMemoryReader.firingPosition.load(std::memory_order_seq_cst) < headPosition)
+            {
+                WaitFutex(&header_->releaseSequence, releaseSequence,
+                    std::min(kSharedMemoryWaitTime, static_cast<uint32_t>(std::chrono::duration_cast<std::chrono::milliseconds>(deadline - currentTime).count()) + 1));
+            }
+            header_->waitingWriterCount.fetch_sub(1, std::memory_order_relaxed);
+        }
+    }
+
+    return true;
+#else
+    (void)requiredHeadPosition;
+    (void)isDropOldest;
+    (void)deadline;
+
+    return false;
+#endif
+}
+
+void EzPubSub::SharedMemoryRing::ReclaimDeadReaders_()
+{
+#if defined(__linux__)
+    // The caller must hold writerSync. Readers of crashed processes never detach by themselves.
+    for (auto& sharedMemoryReader : header_->readerList)
+    {
+        if ((sharedMemoryReader.isUsed.load(std::memory_order_relaxed) != 0) && (IsReaderAlive_(sharedMemoryReader) == false))
+        {
+            sharedMemoryReader.firingPosition.store(kSharedMemoryNotFiringPosition, std::memory_order_seq_cst);
+            sharedMemoryReader.isUsed.store(0, std::memory_order_seq_cst);
+            header_->attachCount--;
+        }
+    }
+#endif
+
+    return;
+}
+
+uint64_t EzPubSub::SharedMemoryRing::GetRecordEndPosition_(
+    _In_ uint64_t position,
+    _In_ uint64_t requiredPosition
+) const
+{
+#if defined(__linux__)
+    // The records from the head are not overwritten, so they are walked to find the first record at or after requiredPosition.
+    while (position < requiredPosition)
+    {
+        position += reinterpret_cast<SharedMemoryRecord*>(ringData_ + (position % header_->dataCapacity))->recordSize;
+    }
+#else
+    (void)requiredPosition;
+#endif
+
+    return position;
+}
+
+bool EzPubSub::SharedMemoryRing::IsReaderAlive_(
+    _In_ SharedMemoryReader& sharedMemoryReader
+) const
+{
+#if defined(__linux__)
+    return ((::kill(sharedMemoryReader.processId, 0) == 0) || (errno != ESRCH));
+#else
+    (void)sharedMemoryReader;
+
+    return true;
+#endif
+}
+
+void EzPubSub::SharedMemoryRing::LockWriter_()
+{
+#if defined(__linux__)
+    // A publisher died holding the lock, the ring is still consistent because the tail is only moved after a record is written.
+    if (pthread_mutex_lock(&header_->writerSync) == EOWNERDEAD)
+    {
+        pthread_mutex_consistent(&header_->writerSync);
+    }
+#endif
+
+    return;
+}
+
+void EzPubSub::SharedMemoryRing::UnlockWriter_()
+{
+#if defined(__linux__)
+    pthread_mutex_unlock(&header_->writerSync);
+#endif
+
+    return;
+}
@@ -0,0 +1,94 @@
+/*!
+ * \author Ezbeat, Ji Hoon Park
+ */
+
+#pragma once
+
+#include "PubSubLiteSync.h"
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace EzPubSub
+{
+
+const uint32_t kMaxSharedMemoryReaderCount = 64; // Processes attached to a kSharedMemory channel at the same time.
+const uint32_t kSharedMemoryRecordAlignment = 16; // Unit: Byte
+const uint32_t kSharedMemoryWaitTime = 10; // Longest wait of a publisher before it checks the channel again. Unit: Millisecond
+
+struct FiredData;
+struct SharedMemoryHeader;
+struct SharedMemoryReader;
+
+/*
+    Byte ring of published data in a POSIX shared memory segment, shared by every process that opens the same channel name.
+    Each data is a record aligned to 16 bytes, and a record never wraps around, the end of the ring is skipped by a padding record instead.
+    Publishers of all processes append records under a robust process-shared mutex, so a publisher dying in the middle does not stop the others.
+    Each process is a reader with its own cursor in the segment, and fires the records to its subscribers from the segment without copying them.
+    - kDropOldest: the publisher moves the head of the ring past the oldest records, readers that did not start them lose them,
+      and the publisher only waits for the records a reader is firing right now, up to the wait time of Push.
+    - Otherwise: the publisher waits until every reader moved past the records it overwrites.
+    Readers wait for publishers and publishers wait for readers on futexes in the segment, they are woken only if someone waits.
+    Only supported on Linux, Open fails on the other platforms.
+*/
+class SharedMemoryRing
+{
+public:
+    SharedMemoryRing();
+    ~SharedMemoryRing();
+
+    SharedMemoryRing(const SharedMemoryRing&) = delete;
+    SharedMemoryRing& operator=(const SharedMemoryRing&) = delete;
+
+    // Creates the segment of channelName with dataCapacity bytes of ring, or opens it with the capacity it was created with.
+    // The reader of this process starts after the data published so far.
+    bool Open(_In_ const std::wstring& channelName, _In_ uint32_t dataCapacity);
+    // The segment is removed when the last process closes it.
+    void Close();
+
+    // Publisher. Waits up to waitTime for readers to make room, only for the readers firing the dropped data if isDropOldest. (0: no wait)
+    bool Push(_In_ const uint8_t* data, _In_ uint32_t dataSize, _In_ bool isDropOldest, _In_ uint32_t waitTime);
+    bool IsTooLarge(_In_ uint32_t dataSize) const;
+
+    // Reader of this process, only one thread reads.
+    // Claims up to maxDataCount data from the cursor, they stay in the segment until ReleaseDataList.
+    // Data published before clearedPosition and data dropped by kDropOldest are counted in lostDataCount.
+    void ReadDataList(
+        _In_ uint64_t clearedPosition,
+        _In_ uint32_t maxDataCount,
+        _Inout_ std::vector<FiredData>& firedDataList,
+        _Out_ uint64_t& lostDataCount
+    );
+    void ReleaseDataList();
+    uint32_t GetPublishSequence() const;
+    // Waits up to waitTime for data published after publishSequence was read.
+    void WaitPublish(_In_ uint32_t publishSequence, _In_ uint32_t waitTime);
+
+    // Wakes the waiting readers and publishers of every process, they check their state again.
+    void Wake();
+    uint64_t GetTailPosition() const;
+    uint32_t GetBufferedDataSize() const;
+
+private:
+    bool MakeRoom_(_In_ uint64_t requiredHeadPosition, _In_ bool isDropOldest, _In_ const std::chrono::steady_clock::time_point& deadline);
+    void ReclaimDeadReaders_();
+    uint64_t GetRecordEndPosition_(_In_ uint64_t position, _In_ uint64_t requiredPosition) const;
+    bool IsReaderAlive_(_In_ SharedMemoryReader& sharedMemoryReader) const;
+    void LockWriter_();
+    void UnlockWriter_();
+
+private:
+    std::string segmentName_;
+    int segmentHandle_;
+    uint8_t* segment_;
+    size_t segmentSize_;
+    SharedMemoryHeader* header_;
+    uint8_t* ringData_;
+    uint32_t readerIndex_;
+    uint64_t readingEndPosition_; // End of the data claimed by ReadDataList.
+    uint64_t nextSequence_; // Sequence of the next data of this reader, a gap is lost data.
+};
+
+}
@@ -0,0 +1,261 @@
+/*!
+ * \author Ezbeat, Ji Hoon Park
+ */
+
+#pragma once
+
+#include "PubSubLiteSync.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+namespace EzPubSub
+{
+
+const uint32_t kMaxFilterKeySize = 8; // Unit: Byte
+
+enum class FilterType
+{
+    kNone,      // Every data matches.
+    kRange,     // minKey <= key <= maxKey
+    kMaskValue  // (key & keyMask) == keyValue
+};
+
+/*
+    Rule on a header key of the published data, the keySize bytes at keyOffset read as an unsigned integer.
+    Data shorter than keyOffset + keySize does not match, unless the type is kNone.
+*/
+struct SubscriberFilter
+{
+    SubscriberFilter()
+    {
+        filterType = FilterType::kNone;
+        keyOffset = 0;
+        keySize = 0;
+        isBigEndianKey = false;
+        minKey = 0;
+        maxKey = 0;
+        keyMask = 0;
+        keyValue = 0;
+    }
+
+    static SubscriberFilter MakeRange(_In_ uint32_t keyOffset, _In_ uint32_t keySize, _In_ uint64_t minKey, _In_ uint64_t maxKey, _In_opt_ bool isBigEndianKey = false)
+    {
+        SubscriberFilter subscriberFilter;
+
+        subscriberFilter.filterType = FilterType::kRange;
+        subscriberFilter.keyOffset = keyOffset;
+        subscriberFilter.keySize = keySize;
+        subscriberFilter.isBigEndianKey = isBigEndianKey;
+        subscriberFilter.minKey = minKey;
+        subscriberFilter.maxKey = maxKey;
+        return subscriberFilter;
+    }
+
+    static SubscriberFilter MakeMaskValue(_In_ uint32_t keyOffset, _In_ uint32_t keySize, _In_ uint64_t keyMask, _In_ uint64_t keyValue, _In_opt_ bool isBigEndianKey = false)
+    {
+        SubscriberFilter subscriberFilter;
+
+        subscriberFilter.filterType = FilterType::kMaskValue;
+        subscriberFilter.keyOffset = keyOffset;
+        subscriberFilter.keySize = keySize;
+        subscriberFilter.isBigEndianKey = isBigEndianKey;
+        subscriberFilter.keyMask = keyMask;
+        subscriberFilter.keyValue = keyValue;
+        return subscriberFilter;
+    }
+
+    bool IsValid() const
+    {
+        if (filterType == FilterType::kNone)
+        {
+            return true;
+        }
+
+        return ((keySize != 0) && (keySize <= kMaxFilterKeySize) && ((filterType != FilterType::kRange) || (minKey <= maxKey)));
+    }
+
+    bool IsSameKey(_In_ const SubscriberFilter& subscriberFilter) const
+    {
+        return ((keyOffset == subscriberFilter.keyOffset) && (keySize == subscriberFilter.keySize) && (isBigEndianKey == subscriberFilter.isBigEndianKey));
+    }
+
+    // false if the data is too short to hold the key.
+    bool ReadKey(_In_ const uint8_t* data, _In_ uint32_t dataSize, _Out_ uint64_t& key) const
+    {
+        uint8_t keyBytes[kMaxFilterKeySize] = { 0, };
+
+        key = 0;
+        if ((data == nullptr) || (keyOffset > dataSize) || (keySize > dataSize - keyOffset))
+        {
+            return false;
+        }
+
+        memcpy(keyBytes, data + keyOffset, keySize);
+        for (uint32_t index = 0; index < keySize; index++)
+        {
+            if (isBigEndianKey == true)
+            {
+                key = (key << 8) | keyBytes[index];
+            }
+            else
+            {
+                key |= static_cast<uint64_t>(keyBytes[index]) << (8 * index);
+            }
+        }
+
+        return true;
+    }
+
+    bool IsMatchedKey(_In_ uint64_t key) const
+    {
+        if (filterType == FilterType::kRange)
+        {
+            return (key - minKey <= maxKey - minKey);
+        }
+
+        return ((key & keyMask) == keyValue);
+    }
+
+    bool IsMatched(_In_ const uint8_t* data, _In_ uint32_t dataSize) const
+    {
+        uint64_t key = 0;
+
+        if (filterType == FilterType::kNone)
+        {
+            return true;
+        }
+        if (ReadKey(data, dataSize, key) == false)
+        {
+            return false;
+        }
+
+        return IsMatchedKey(key);
+    }
+
+    FilterType filterType;
+    uint32_t keyOffset; // Unit: Byte
+    uint32_t keySize; // 1 ~ kMaxFilterKeySize, Unit: Byte
+    bool isBigEndianKey; // The key is in network byte order, otherwise in little endian.
+    // kRange
+    uint64_t minKey;
+    uint64_t maxKey;
+    // kMaskValue
+    uint64_t keyMask;
+    uint64_t keyValue;
+};
+
+/*
+    Evaluates filters over a batch of data at once.
+    The header keys of the batch are read into a column once for each key layout, and each filter is a branchless loop over the column,
+    so the cost of a filter is a few instructions per data, and the compiler vectorizes the loop.
+*/
+class SubscriberFilterColumn
+{
+public:
+    SubscriberFilterColumn()
+    {
+        isKeyRead_ = false;
+    }
+
+    void Clear()
+    {
+        dataList_.clear();
+        dataSizeList_.clear();
+        isKeyRead_ = false;
+
+        return;
+    }
+
+    void Append(_In_ const uint8_t* data, _In_ uint32_t dataSize)
+    {
+        dataList_.push_back(data);
+        dataSizeList_.push_back(dataSize);
+        isKeyRead_ = false;
+
+        return;
+    }
+
+    size_t GetDataCount() const
+    {
+        return dataList_.size();
+    }
+
+    // Returns 1 for each appended data subscriberFilter matches, otherwise 0, valid until the next call.
+    const uint8_t* Evaluate(_In_ const SubscriberFilter& subscriberFilter)
+    {
+        size_t dataCount = dataList_.size();
+        const uint64_t* keyList = nullptr;
+        const uint8_t* keyValidList = nullptr;
+        uint8_t* matchList = nullptr;
+        uint64_t minKey = subscriberFilter.minKey;
+        uint64_t keyRange = subscriberFilter.maxKey - subscriberFilter.minKey;
+        uint64_t keyMask = subscriberFilter.keyMask;
+        uint64_t keyValue = subscriberFilter.keyValue;
+
+        matchList_.resize(dataCount);
+        if (subscriberFilter.filterType == FilterType::kNone)
+        {
+            std::fill(matchList_.begin(), matchList_.end(), static_cast<uint8_t>(1));
+            return matchList_.data();
+        }
+
+        ReadKeyColumn_(subscriberFilter);
+        keyList = keyList_.data();
+        keyValidList = keyValidList_.data();
+        matchList = matchList_.data();
+        if (subscriberFilter.filterType == FilterType::kRange)
+        {
+            for (size_t index = 0; index < dataCount; index++)
+            {
+                matchList[index] = keyValidList[index] & static_cast<uint8_t>(keyList[index] - minKey <= keyRange);
+            }
+        }
+        else
+        {
+            for (size_t index = 0; index < dataCount; index++)
+            {
+                matchList[index] = keyValidList[index] & static_cast<uint8_t>((keyList[index] & keyMask) == keyValue);
+            }
+        }
+
+        return matchList_.data();
+    }
+
+private:
+    void ReadKeyColumn_(_In_ const SubscriberFilter& subscriberFilter)
+    {
+        size_t dataCount = dataList_.size();
+
+        // Subscribers of a channel usually filter on the same header field, so the column is read once for the batch.
+        if ((isKeyRead_ == true) && (keyFilter_.IsSameKey(subscriberFilter) == true))
+        {
+            return;
+        }
+
+        keyList_.resize(dataCount);
+        keyValidList_.resize(dataCount);
+        for (size_t index = 0; index < dataCount; index++)
+        {
+            keyValidList_[index] = (subscriberFilter.ReadKey(dataList_[index], dataSizeList_[index], keyList_[index]) == true) ? 1 : 0;
+        }
+        keyFilter_ = subscriberFilter;
+        isKeyRead_ = true;
+
+        return;
+    }
+
+private:
+    std::vector<const uint8_t*> dataList_;
+    std::vector<uint32_t> dataSizeList_;
+    // Header key column of the layout of keyFilter_.
+    SubscriberFilter keyFilter_;
+    bool isKeyRead_;
+    std::vector<uint64_t> keyList_;
+    std::vector<uint8_t> keyValidList_;
+    std::vector<uint8_t> matchList_;
+};
+
+}
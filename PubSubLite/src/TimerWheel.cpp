@@ -0,0 +1,276 @@
+/*!
+ * \author Ezbeat, Ji Hoon Park
+ */
+
+#include "TimerWheel.h"
+
+#include <algorithm>
+#include <chrono>
+
+#if defined(__linux__)
+#include <sys/prctl.h>
+#endif
+
+namespace
+{
+
+const uint64_t kTickNanoseconds = static_cast<uint64_t>(EzPubSub::kTimerWheelTickTime) * 1000;
+
+uint64_t GetSteadyTime()
+{
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+}
+
+EzPubSub::TimerWheel::TimerWheel() : slotList_(kTimerWheelSlotCount, nullptr)
+{
+    startTime_ = GetSteadyTime();
+    processedTick_ = 0;
+    wakeTick_ = 0;
+    scheduledEntryCount_ = 0;
+    callingEntry_ = nullptr;
+    isExit_ = false;
+
+    timerThread_ = std::thread(&TimerWheel::TimerThread_, this);
+}
+
+EzPubSub::TimerWheel::~TimerWheel()
+{
+    wheelSync_.lock();
+    isExit_ = true;
+    timerEvent_.notify_all();
+    wheelSync_.unlock();
+
+    timerThread_.join();
+}
+
+void EzPubSub::TimerWheel::Schedule(
+    _Inout_ TimerWheelEntry* timerWheelEntry,
+    _In_ uint64_t expiryTime
+)
+{
+    uint64_t expiryTick = 0;
+
+    // Rounded up, so that the timer is not called before expiryTime.
+    if (expiryTime > startTime_)
+    {
+        expiryTick = (expiryTime - startTime_ + kTickNanoseconds - 1) / kTickNanoseconds;
+    }
+
+    wheelSync_.lock();
+    if (timerWheelEntry->isScheduled == true)
+    {
+        UnlinkEntry_(timerWheelEntry);
+    }
+
+    // The thread did not move processedTick_ while it had no timer, so it is moved here instead of walking the ticks it slept.
+    if (scheduledEntryCount_ == 0)
+    {
+        processedTick_ = std::max(processedTick_, GetCurrentTick_());
+    }
+    if (expiryTick <= processedTick_)
+    {
+        expiryTick = processedTick_ + 1;
+    }
+
+    timerWheelEntry->expiryTick = expiryTick;
+    LinkEntry_(timerWheelEntry);
+    if (expiryTick < wakeTick_)
+    {
+        timerEvent_.notify_one();
+    }
+    wheelSync_.unlock();
+
+    return;
+}
+
+void EzPubSub::TimerWheel::Unschedule(
+    _Inout_ TimerWheelEntry* timerWheelEntry
+)
+{
+    wheelSync_.lock();
+    if (timerWheelEntry->isScheduled == true)
+    {
+        UnlinkEntry_(timerWheelEntry);
+    }
+    wheelSync_.unlock();
+
+    return;
+}
+
+void EzPubSub::TimerWheel::Cancel(
+    _Inout_ TimerWheelEntry* timerWheelEntry
+)
+{
+    wheelSync_.lock();
+    if (timerWheelEntry->isScheduled == true)
+    {
+        UnlinkEntry_(timerWheelEntry);
+    }
+    while (callingEntry_ == timerWheelEntry)
+    {
+        callEvent_.wait(wheelSync_);
+    }
+    wheelSync_.unlock();
+
+    return;
+}
+
+uint64_t EzPubSub::TimerWheel::GetCurrentTick_() const
+{
+    return (GetSteadyTime() - startTime_) / kTickNanoseconds;
+}
+
+void EzPubSub::TimerWheel::LinkEntry_(
+    _Inout_ TimerWheelEntry* timerWheelEntry
+)
+{
+    /*
+        The caller using this method must synchronize.
+    */
+
+    TimerWheelEntry*& slotEntry = slotList_[timerWheelEntry->expiryTick % kTimerWheelSlotCount];
+
+    timerWheelEntry->previousEntry = nullptr;
+    timerWheelEntry->nextEntry = slotEntry;
+    if (slotEntry != nullptr)
+    {
+        slotEntry->previousEntry = timerWheelEntry;
+    }
+    slotEntry = timerWheelEntry;
+    timerWheelEntry->isScheduled = true;
+    scheduledEntryCount_++;
+
+    return;
+}
+
+void EzPubSub::TimerWheel::UnlinkEntry_(
+    _Inout_ TimerWheelEntry* timerWheelEntry
+)
+{
+    /*
+        The caller using this method must synchronize.
+    */
+
+    if (timerWheelEntry->previousEntry != nullptr)
+    {
+        timerWheelEntry->previousEntry->nextEntry = timerWheelEntry->nextEntry;
+    }
+    else
+    {
+        slotList_[timerWheelEntry->expiryTick % kTimerWheelSlotCount] = timerWheelEntry->nextEntry;
+    }
+    if (timerWheelEntry->nextEntry != nullptr)
+    {
+        timerWheelEntry->nextEntry->previousEntry = timerWheelEntry->previousEntry;
+    }
+    timerWheelEntry->previousEntry = nullptr;
+    timerWheelEntry->nextEntry = nullptr;
+    timerWheelEntry->isScheduled = false;
+    scheduledEntryCount_--;
+
+    return;
+}
+
+uint64_t EzPubSub::TimerWheel::GetNextExpiryTick_() const
+{
+    /*
+        The caller using this method must synchronize.
+        The slots of the next turn are searched in order, so the first timer expiring in its slot is the earliest.
+        If every timer waits for a later turn, the earliest of them is returned.
+    */
+
+    uint64_t nextExpiryTick = UINT64_MAX;
+    uint64_t tick = 0;
+
+    if (scheduledEntryCount_ == 0)
+    {
+        return nextExpiryTick;
+    }
+
+    for (uint32_t slotOffset = 1; slotOffset <= kTimerWheelSlotCount; slotOffset++)
+    {
+        tick = processedTick_ + slotOffset;
+        for (TimerWheelEntry* timerWheelEntry = slotList_[tick % kTimerWheelSlotCount]; timerWheelEntry != nullptr; timerWheelEntry = timerWheelEntry->nextEntry)
+        {
+            if (timerWheelEntry->expiryTick <= tick)
+            {
+                return tick;
+            }
+            nextExpiryTick = std::min(nextExpiryTick, timerWheelEntry->expiryTick);
+        }
+    }
+
+    return nextExpiryTick;
+}
+
+void EzPubSub::TimerWheel::TimerThread_()
+{
+    /*
+        Ticks are processed in order, and processedTick_ is moved past a tick only after its slot has no expired timer,
+        so a timer scheduled while a callback is called lands in the slot being processed or in a later one.
+    */
+
+    uint64_t currentTick = 0;
+    uint64_t tick = 0;
+    TimerWheelEntry* expiredEntry = nullptr;
+    TIMER_CALLBACK timerCallback = nullptr;
+    void* timerContext = nullptr;
+
+#if defined(__linux__)
+    // The default timer slack of 50 microseconds is several ticks.
+    prctl(PR_SET_TIMERSLACK, 1UL, 0UL, 0UL, 0UL);
+#endif
+
+    wheelSync_.lock();
+    while (isExit_ == false)
+    {
+        wakeTick_ = 0;
+        currentTick = GetCurrentTick_();
+        while ((processedTick_ < currentTick) && (scheduledEntryCount_ != 0) && (isExit_ == false))
+        {
+            tick = processedTick_ + 1;
+            expiredEntry = slotList_[tick % kTimerWheelSlotCount];
+            while ((expiredEntry != nullptr) && (expiredEntry->expiryTick > tick))
+            {
+                expiredEntry = expiredEntry->nextEntry;
+            }
+            if (expiredEntry == nullptr)
+            {
+                processedTick_ = tick;
+                continue;
+            }
+
+            UnlinkEntry_(expiredEntry);
+            timerCallback = expiredEntry->timerCallback;
+            timerContext = expiredEntry->timerContext;
+            callingEntry_ = expiredEntry;
+            wheelSync_.unlock();
+
+            timerCallback(timerContext);
+
+            wheelSync_.lock();
+            callingEntry_ = nullptr;
+            callEvent_.notify_all();
+        }
+        if (isExit_ == true)
+        {
+            break;
+        }
+
+        wakeTick_ = GetNextExpiryTick_();
+        if (wakeTick_ == UINT64_MAX)
+        {
+            timerEvent_.wait(wheelSync_);
+        }
+        else
+        {
+            timerEvent_.wait_until(wheelSync_, std::chrono::steady_clock::time_point(
+                std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::nanoseconds(startTime_ + wakeTick_ * kTickNanoseconds))));
+        }
+    }
+    wheelSync_.unlock();
+
+    return;
+}
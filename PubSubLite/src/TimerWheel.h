@@ -0,0 +1,90 @@
+/*!
+ * \author Ezbeat, Ji Hoon Park
+ */
+
+#pragma once
+
+#include "PubSubLiteSync.h"
+
+#include <condition_variable>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+namespace EzPubSub
+{
+
+const uint32_t kTimerWheelTickTime = 16; // Unit: Microsecond
+const uint32_t kTimerWheelSlotCount = 4096; // A turn of the wheel is about 65 milliseconds, later timers wait for more turns.
+
+typedef void(*TIMER_CALLBACK)(_In_opt_ void* timerContext);
+
+// Timer owned by its user and linked into a slot of TimerWheel while it is scheduled.
+struct TimerWheelEntry
+{
+    TimerWheelEntry()
+    {
+        timerCallback = nullptr;
+        timerContext = nullptr;
+        expiryTick = 0;
+        previousEntry = nullptr;
+        nextEntry = nullptr;
+        isScheduled = false;
+    }
+
+    TIMER_CALLBACK timerCallback;
+    void* timerContext;
+
+    // Synchronized by TimerWheel.
+    uint64_t expiryTick;
+    TimerWheelEntry* previousEntry;
+    TimerWheelEntry* nextEntry;
+    bool isScheduled;
+};
+
+/*
+    Hashed timer wheel of kTimerWheelSlotCount slots of kTimerWheelTickTime, run by one thread for any number of timers.
+    Scheduling and unscheduling a timer is O(1), and the thread sleeps until the earliest slot holding a timer, or while there is none.
+    A timer is called at its expiry rounded up to the next tick, never before, from the thread of the wheel and without the lock of the wheel.
+*/
+class TimerWheel
+{
+public:
+    TimerWheel();
+    ~TimerWheel();
+
+    TimerWheel(const TimerWheel&) = delete;
+    TimerWheel& operator=(const TimerWheel&) = delete;
+
+    // expiryTime: nanoseconds of the steady clock. A scheduled timer is moved to the new expiry time.
+    void Schedule(_Inout_ TimerWheelEntry* timerWheelEntry, _In_ uint64_t expiryTime);
+    // Does not wait for a call of the timer in progress, so it can be called by a lock the callback takes.
+    void Unschedule(_Inout_ TimerWheelEntry* timerWheelEntry);
+    // Also waits for a call of the timer in progress, after which timerWheelEntry can be freed. Must not be called from the callback.
+    void Cancel(_Inout_ TimerWheelEntry* timerWheelEntry);
+
+private:
+    uint64_t GetCurrentTick_() const;
+    void LinkEntry_(_Inout_ TimerWheelEntry* timerWheelEntry);
+    void UnlinkEntry_(_Inout_ TimerWheelEntry* timerWheelEntry);
+    uint64_t GetNextExpiryTick_() const;
+    void TimerThread_();
+
+private:
+    uint64_t startTime_;
+
+    // Synchronizes the members below.
+    SyncLock wheelSync_;
+    std::vector<TimerWheelEntry*> slotList_;
+    uint64_t processedTick_; // Every timer expiring up to this tick was called.
+    uint64_t wakeTick_; // Tick the thread sleeps until, UINT64_MAX while it sleeps without a timer.
+    uint32_t scheduledEntryCount_;
+    TimerWheelEntry* callingEntry_;
+    bool isExit_;
+    std::condition_variable_any timerEvent_;
+    std::condition_variable_any callEvent_;
+
+    std::thread timerThread_;
+};
+
+}
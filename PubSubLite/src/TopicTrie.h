@@ -0,0 +1,278 @@
+/*!
+ * \author Ezbeat, Ji Hoon Park
+ */
+
+#pragma once
+
+#include "PubSubLiteSync.h"
+
+#include <cstddef>
+#include <list>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace EzPubSub
+{
+
+const wchar_t kTopicLevelSeparator = L'/';
+const wchar_t kTopicSingleLevelWildcard[] = L"*"; // Matches exactly one level.
+const wchar_t kTopicMultiLevelWildcard[] = L"#"; // Only as the last level, matches the remaining levels, even none.
+
+/*
+    Prefix trie of topic filters, a topic is a name of levels separated by '/'.
+    Each node is a level of the filters inserted so far, and holds the values of the filters ending at it.
+    A topic is matched level by level, following the literal child, the '*' child and the '#' child of each node,
+    so the cost depends on the depth of the topic, not on the number of filters.
+    Not synchronized, the caller must synchronize.
+*/
+template <typename T>
+class TopicTrie
+{
+public:
+    TopicTrie()
+    {
+        rootNode_.reset(new Node);
+    }
+
+    TopicTrie(const TopicTrie&) = delete;
+    TopicTrie& operator=(const TopicTrie&) = delete;
+
+    static bool IsWildcardFilter(_In_ const std::wstring& topicFilter)
+    {
+        std::vector<std::wstring> levelList;
+
+        SplitLevel_(topicFilter, levelList);
+        for (auto& level : levelList)
+        {
+            if ((level == kTopicSingleLevelWildcard) || (level == kTopicMultiLevelWildcard))
+            {
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    // Wildcards are whole levels, and '#' is only the last level.
+    static bool IsValidFilter(_In_ const std::wstring& topicFilter)
+    {
+        std::vector<std::wstring> levelList;
+
+        if (topicFilter.length() == 0)
+        {
+            return false;
+        }
+
+        SplitLevel_(topicFilter, levelList);
+        for (size_t levelIndex = 0; levelIndex < levelList.size(); levelIndex++)
+        {
+            if ((levelList[levelIndex] == kTopicMultiLevelWildcard) && (levelIndex + 1 != levelList.size()))
+            {
+                return false;
+            }
+
+            if ((levelList[levelIndex].length() > 1) &&
+                ((levelList[levelIndex].find(kTopicSingleLevelWildcard[0]) != std::wstring::npos) ||
+                 (levelList[levelIndex].find(kTopicMultiLevelWildcard[0]) != std::wstring::npos)))
+            {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    static bool IsMatched(_In_ const std::wstring& topicFilter, _In_ const std::wstring& topicName)
+    {
+        std::vector<std::wstring> filterLevelList;
+        std::vector<std::wstring> nameLevelList;
+        size_t levelIndex = 0;
+
+        if (IsWildcardFilter(topicName) == true)
+        {
+            return false;
+        }
+
+        SplitLevel_(topicFilter, filterLevelList);
+        SplitLevel_(topicName, nameLevelList);
+        for (; levelIndex < filterLevelList.size(); levelIndex++)
+        {
+            if (filterLevelList[levelIndex] == kTopicMultiLevelWildcard)
+            {
+                return true;
+            }
+
+            if ((levelIndex == nameLevelList.size()) ||
+                ((filterLevelList[levelIndex] != kTopicSingleLevelWildcard) && (filterLevelList[levelIndex] != nameLevelList[levelIndex])))
+            {
+                return false;
+            }
+        }
+
+        return (levelIndex == nameLevelList.size());
+    }
+
+    // Values of topicFilter, the node is created if it does not exist.
+    std::list<T>& GetValueList(_In_ const std::wstring& topicFilter)
+    {
+        std::vector<std::wstring> levelList;
+        Node* node = rootNode_.get();
+
+        SplitLevel_(topicFilter, levelList);
+        for (auto& level : levelList)
+        {
+            std::unique_ptr<Node>& childNode = node->childNodeList[level];
+
+            if (childNode == nullptr)
+            {
+                childNode.reset(new Node);
+            }
+            node = childNode.get();
+        }
+
+        return node->valueList;
+    }
+
+    // Values of topicFilter, nullptr if it was never inserted.
+    std::list<T>* FindValueList(_In_ const std::wstring& topicFilter)
+    {
+        std::vector<std::wstring> levelList;
+        Node* node = rootNode_.get();
+
+        SplitLevel_(topicFilter, levelList);
+        for (auto& level : levelList)
+        {
+            auto childNodeListIter = node->childNodeList.find(level);
+
+            if (childNodeListIter == node->childNodeList.end())
+            {
+                return nullptr;
+            }
+            node = childNodeListIter->second.get();
+        }
+
+        return &node->valueList;
+    }
+
+    // Deletes the nodes of topicFilter that no longer lead to a value.
+    void Prune(_In_ const std::wstring& topicFilter)
+    {
+        std::vector<std::wstring> levelList;
+
+        SplitLevel_(topicFilter, levelList);
+        PruneNode_(rootNode_.get(), levelList, 0);
+
+        return;
+    }
+
+    // Appends the values of every filter matching topicName. A topic name with a wildcard level is not matched.
+    void Match(_In_ const std::wstring& topicName, _Inout_ std::vector<T*>& matchedValueList)
+    {
+        std::vector<std::wstring> levelList;
+
+        if (IsWildcardFilter(topicName) == true)
+        {
+            return;
+        }
+
+        SplitLevel_(topicName, levelList);
+        MatchNode_(rootNode_.get(), levelList, 0, matchedValueList);
+
+        return;
+    }
+
+private:
+    struct Node
+    {
+        std::unordered_map<std::wstring, std::unique_ptr<Node>> childNodeList; // Key: level, a wildcard is a level too.
+        std::list<T> valueList;
+    };
+
+    static void SplitLevel_(_In_ const std::wstring& topic, _Out_ std::vector<std::wstring>& levelList)
+    {
+        size_t levelPosition = 0;
+        size_t separatorPosition = 0;
+
+        levelList.clear();
+        while (true)
+        {
+            separatorPosition = topic.find(kTopicLevelSeparator, levelPosition);
+            if (separatorPosition == std::wstring::npos)
+            {
+                levelList.push_back(topic.substr(levelPosition));
+                break;
+            }
+
+            levelList.push_back(topic.substr(levelPosition, separatorPosition - levelPosition));
+            levelPosition = separatorPosition + 1;
+        }
+
+        return;
+    }
+
+    static bool PruneNode_(_Inout_ Node* node, _In_ const std::vector<std::wstring>& levelList, _In_ size_t levelIndex)
+    {
+        // Returns true if node can be deleted.
+        if (levelIndex < levelList.size())
+        {
+            auto childNodeListIter = node->childNodeList.find(levelList[levelIndex]);
+
+            if ((childNodeListIter != node->childNodeList.end()) &&
+                (PruneNode_(childNodeListIter->second.get(), levelList, levelIndex + 1) == true))
+            {
+                node->childNodeList.erase(childNodeListIter);
+            }
+        }
+
+        return ((node->childNodeList.size() == 0) && (node->valueList.size() == 0));
+    }
+
+    static void MatchNode_(
+        _In_ Node* node,
+        _In_ const std::vector<std::wstring>& levelList,
+        _In_ size_t levelIndex,
+        _Inout_ std::vector<T*>& matchedValueList
+    )
+    {
+        typename std::unordered_map<std::wstring, std::unique_ptr<Node>>::iterator childNodeListIter;
+
+        childNodeListIter = node->childNodeList.find(kTopicMultiLevelWildcard);
+        if (childNodeListIter != node->childNodeList.end())
+        {
+            for (auto& value : childNodeListIter->second->valueList)
+            {
+                matchedValueList.push_back(&value);
+            }
+        }
+
+        if (levelIndex == levelList.size())
+        {
+            for (auto& value : node->valueList)
+            {
+                matchedValueList.push_back(&value);
+            }
+            return;
+        }
+
+        childNodeListIter = node->childNodeList.find(levelList[levelIndex]);
+        if (childNodeListIter != node->childNodeList.end())
+        {
+            MatchNode_(childNodeListIter->second.get(), levelList, levelIndex + 1, matchedValueList);
+        }
+
+        childNodeListIter = node->childNodeList.find(kTopicSingleLevelWildcard);
+        if (childNodeListIter != node->childNodeList.end())
+        {
+            MatchNode_(childNodeListIter->second.get(), levelList, levelIndex + 1, matchedValueList);
+        }
+
+        return;
+    }
+
+private:
+    std::unique_ptr<Node> rootNode_;
+};
+
+}
@@ -0,0 +1,236 @@
+/*!
+ * \author Ezbeat, Ji Hoon Park
+ */
+
+#pragma once
+
+#include "PubSubLite.h"
+
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace EzPubSub
+{
+
+/*
+    Channel of values of T, layered over a PubSubLite channel it creates and deletes.
+    A value is published as sizeof(T) bytes copied into a block of the data pool of the channel, and subscribers receive it as const T&.
+    The value is not stored inline in the DataBuffer, even when T is small, because the channel moves, filters, logs and
+    releases every buffered data as a DataBuffer of bytes, and a data pool block costs no global allocation in steady state.
+    One batch subscriber is registered to the channel, and it calls every Subscriber for all data fired at once,
+    so Subscriber is called directly. With a functor or lambda type as Subscriber, the call can be inlined,
+    and std::function, the default, accepts any callable with captured state.
+    The userContext of the published data is the TypedChannel, so publish to the channel only through it.
+    Subscribe and Unsubscribe replace the subscriber list, and the batch subscriber calls the list it took when the data were fired
+    without the lock of the list, so they never wait for a Subscriber, and a Subscriber may call them too.
+*/
+template <typename T, typename Subscriber = std::function<void(const T& value)>>
+class TypedChannel
+{
+    static_assert(std::is_trivially_copyable<T>::value == true, "T of TypedChannel must be trivially copyable.");
+
+public:
+    TypedChannel()
+    {
+        subscriberList_ = std::make_shared<std::vector<SubscriberEntry>>();
+        lastSubscriberId_ = 0;
+    }
+
+    ~TypedChannel()
+    {
+        Delete();
+    }
+
+    TypedChannel(const TypedChannel&) = delete;
+    TypedChannel& operator=(const TypedChannel&) = delete;
+
+    Error Create(_In_ const std::wstring& channelName, _In_ const ChannelOption& channelOption = ChannelOption())
+    {
+        Error retValue = Error::kUnsuccess;
+
+        if (channelHandle_.IsValid() == true)
+        {
+            retValue = Error::kExistChannel;
+            return retValue;
+        }
+
+        // The TypedChannel of the data is delivered as userContext, which does not cross processes.
+        if (channelOption.queueType == QueueType::kSharedMemory)
+        {
+            return retValue;
+        }
+
+        retValue = PubSubLite::CreateChannel(channelName, channelOption, channelHandle_);
+        if (retValue != Error::kSuccess)
+        {
+            return retValue;
+        }
+
+        retValue = PubSubLite::RegisterSubscriber(channelHandle_, FireTypedData_);
+        if (retValue != Error::kSuccess)
+        {
+            PubSubLite::DeleteChannel(channelHandle_);
+            channelHandle_.Reset();
+        }
+
+        return retValue;
+    }
+
+    // Data not fired yet are discarded as DeleteChannel does, and no Subscriber is called after it returns.
+    // A channel deleted by its name elsewhere is not deleted again, nor a channel created again with its name.
+    Error Delete()
+    {
+        Error retValue = Error::kUnsuccess;
+
+        if (channelHandle_.IsValid() == false)
+        {
+            retValue = Error::kNotExistChannel;
+            return retValue;
+        }
+
+        retValue = PubSubLite::DeleteChannel(channelHandle_);
+        channelHandle_.Reset();
+
+        return retValue;
+    }
+
+    Error Subscribe(_In_ const Subscriber& subscriber, _Out_opt_ uint32_t* subscriberId = nullptr)
+    {
+        std::lock_guard<SyncLock> subscriberListGuard(subscriberListSync_);
+        std::shared_ptr<std::vector<SubscriberEntry>> subscriberList = std::make_shared<std::vector<SubscriberEntry>>(*subscriberList_);
+
+        subscriberList->emplace_back(++lastSubscriberId_, subscriber);
+        subscriberList_ = std::move(subscriberList);
+        if (subscriberId != nullptr)
+        {
+            *subscriberId = lastSubscriberId_;
+        }
+
+        return Error::kSuccess;
+    }
+
+    // Data being fired when it returns may still be delivered to the Subscriber.
+    Error Unsubscribe(_In_ uint32_t subscriberId)
+    {
+        std::lock_guard<SyncLock> subscriberListGuard(subscriberListSync_);
+        std::shared_ptr<std::vector<SubscriberEntry>> subscriberList;
+
+        for (size_t subscriberIndex = 0; subscriberIndex < subscriberList_->size(); subscriberIndex++)
+        {
+            if ((*subscriberList_)[subscriberIndex].subscriberId == subscriberId)
+            {
+                subscriberList = std::make_shared<std::vector<SubscriberEntry>>(*subscriberList_);
+                subscriberList->erase(subscriberList->begin() + static_cast<std::ptrdiff_t>(subscriberIndex));
+                subscriberList_ = std::move(subscriberList);
+                return Error::kSuccess;
+            }
+        }
+
+        return Error::kNotExistSubscriber;
+    }
+
+    Error Publish(_In_ const T& value)
+    {
+        return PubSubLite::PublishData(channelHandle_, reinterpret_cast<const uint8_t*>(&value), sizeof(T), this);
+    }
+
+    Error Publish(_In_ const T& value, _In_ const std::chrono::steady_clock::time_point& deadline)
+    {
+        return PubSubLite::PublishData(channelHandle_, reinterpret_cast<const uint8_t*>(&value), sizeof(T), this, deadline);
+    }
+
+    Error TryPublish(_In_ const T& value)
+    {
+        return PubSubLite::TryPublishData(channelHandle_, reinterpret_cast<const uint8_t*>(&value), sizeof(T), this);
+    }
+
+    // For the other methods of PubSubLite, such as the getters and PauseChannel.
+    const ChannelHandle& GetChannelHandle() const
+    {
+        return channelHandle_;
+    }
+
+private:
+    struct SubscriberEntry
+    {
+        SubscriberEntry(_In_ uint32_t subscriberId, _In_ const Subscriber& subscriber) : subscriber(subscriber)
+        {
+            this->subscriberId = subscriberId;
+        }
+
+        uint32_t subscriberId;
+        Subscriber subscriber;
+    };
+
+    static void FireTypedData_(_In_ const FiredData* firedDataList, _In_ uint32_t firedDataCount)
+    {
+        TypedChannel* typedChannel = nullptr;
+        std::shared_ptr<std::vector<SubscriberEntry>> subscriberList;
+
+        if (firedDataCount == 0)
+        {
+            return;
+        }
+
+        // All data fired at once are published by the same TypedChannel.
+        typedChannel = static_cast<TypedChannel*>(firedDataList[0].userContext);
+        typedChannel->subscriberListSync_.lock();
+        subscriberList = typedChannel->subscriberList_;
+        typedChannel->subscriberListSync_.unlock();
+
+        if (subscriberList->size() == 1)
+        {
+            Subscriber& subscriber = (*subscriberList)[0].subscriber;
+
+            for (uint32_t firedDataIndex = 0; firedDataIndex < firedDataCount; firedDataIndex++)
+            {
+                FireValue_(subscriber, firedDataList[firedDataIndex]);
+            }
+            return;
+        }
+
+        for (uint32_t firedDataIndex = 0; firedDataIndex < firedDataCount; firedDataIndex++)
+        {
+            for (auto& subscriberEntry : *subscriberList)
+            {
+                FireValue_(subscriberEntry.subscriber, firedDataList[firedDataIndex]);
+            }
+        }
+
+        return;
+    }
+
+    static void FireValue_(_In_ Subscriber& subscriber, _In_ const FiredData& firedData)
+    {
+        // Blocks of the data pool are aligned to 16 bytes, so the value is copied only for a wider alignment.
+        if ((reinterpret_cast<uintptr_t>(firedData.data) % alignof(T)) == 0)
+        {
+            subscriber(*reinterpret_cast<const T*>(firedData.data));
+        }
+        else
+        {
+            typename std::aligned_storage<sizeof(T), alignof(T)>::type alignedValue;
+
+            memcpy(&alignedValue, firedData.data, sizeof(T));
+            subscriber(*reinterpret_cast<const T*>(&alignedValue));
+        }
+
+        return;
+    }
+
+private:
+    ChannelHandle channelHandle_;
+    SyncLock subscriberListSync_;
+    // Replaced by Subscribe and Unsubscribe, never changed in place, so the batch subscriber calls a list it took under the lock.
+    std::shared_ptr<std::vector<SubscriberEntry>> subscriberList_;
+    uint32_t lastSubscriberId_;
+};
+
+}
@@ -0,0 +1,122 @@
+/*!
+ * \author Ezbeat, Ji Hoon Park
+ */
+
+#include "PubSubLiteTest.h"
+
+#include <thread>
+
+namespace PubSubLiteTest
+{
+
+namespace
+{
+
+EzPubSub::Error PublishHandleString(_In_ const EzPubSub::ChannelHandle& channelHandle, _In_ const std::string& data)
+{
+    return EzPubSub::PubSubLite::PublishData(channelHandle, reinterpret_cast<const uint8_t*>(data.data()), static_cast<uint32_t>(data.size()));
+}
+
+}
+
+// A handle keeps referring to the channel it was created for, even after the channel is deleted and its name is created again.
+void TestChannelHandle()
+{
+    std::wstring channelName = L"TestChannelHandle";
+    EzPubSub::ChannelOption channelOption;
+    EzPubSub::ChannelHandle channelHandle;
+    EzPubSub::ChannelHandle openedChannelHandle;
+    EzPubSub::ChannelHandle recreatedChannelHandle;
+    uint64_t firedDataCount = 0;
+
+    ClearReceivedDataList();
+    channelOption.fireMode = EzPubSub::FireMode::kEvent;
+    TEST_CHECK(EzPubSub::PubSubLite::OpenChannel(channelName, openedChannelHandle) == EzPubSub::Error::kNotExistChannel);
+    TEST_CHECK(openedChannelHandle.IsValid() == false);
+    TEST_CHECK(EzPubSub::PubSubLite::CreateChannel(channelName, channelOption, channelHandle) == EzPubSub::Error::kSuccess);
+    TEST_CHECK((channelHandle.IsValid() == true) && (channelHandle.GetChannelName() == channelName));
+    TEST_CHECK(EzPubSub::PubSubLite::OpenChannel(channelName, openedChannelHandle) == EzPubSub::Error::kSuccess);
+    TEST_CHECK(EzPubSub::PubSubLite::RegisterSubscriber(openedChannelHandle, ReceivingSubscriberCallback) == EzPubSub::Error::kSuccess);
+    TEST_CHECK(PublishHandleString(channelHandle, "h0") == EzPubSub::Error::kSuccess);
+    TEST_CHECK(PublishString(channelName, "h1") == EzPubSub::Error::kSuccess);
+    TEST_CHECK(WaitReceivedDataCount(2) == true);
+    TEST_CHECK(GetReceivedDataList() == std::vector<std::string>({ "h0", "h1" }));
+    TEST_CHECK(EzPubSub::PubSubLite::GetFiredDataCount(openedChannelHandle, firedDataCount) == EzPubSub::Error::kSuccess);
+    TEST_CHECK(firedDataCount == 2);
+
+    // The deleted channel is not reached by its handles.
+    TEST_CHECK(EzPubSub::PubSubLite::DeleteChannel(channelName) == EzPubSub::Error::kSuccess);
+    TEST_CHECK(channelHandle.IsValid() == true);
+    TEST_CHECK(PublishHandleString(channelHandle, "h2") == EzPubSub::Error::kNotExistChannel);
+    TEST_CHECK(EzPubSub::PubSubLite::GetFiredDataCount(openedChannelHandle, firedDataCount) == EzPubSub::Error::kNotExistChannel);
+    TEST_CHECK(EzPubSub::PubSubLite::RegisterSubscriber(channelHandle, SecondReceivingSubscriberCallback) == EzPubSub::Error::kNotExistChannel);
+
+    // Nor the channel created again with its name, which DeleteChannel by the old handle does not delete.
+    TEST_CHECK(EzPubSub::PubSubLite::CreateChannel(channelName, channelOption, recreatedChannelHandle) == EzPubSub::Error::kSuccess);
+    TEST_CHECK(PublishHandleString(channelHandle, "h3") == EzPubSub::Error::kNotExistChannel);
+    TEST_CHECK(EzPubSub::PubSubLite::DeleteChannel(channelHandle) == EzPubSub::Error::kNotExistChannel);
+    TEST_CHECK(PublishHandleString(recreatedChannelHandle, "h4") == EzPubSub::Error::kSuccess);
+    TEST_CHECK(EzPubSub::PubSubLite::DeleteChannel(recreatedChannelHandle) == EzPubSub::Error::kSuccess);
+    TEST_CHECK(PublishString(channelName, "h5") == EzPubSub::Error::kNotExistChannel);
+
+    channelHandle.Reset();
+    TEST_CHECK(channelHandle.IsValid() == false);
+    TEST_CHECK(PublishHandleString(channelHandle, "h6") == EzPubSub::Error::kUnsuccess);
+}
+
+// Publishers holding a handle keep publishing while the channel is deleted, and every publish after it returns kNotExistChannel.
+void TestChannelHandleDeleteRace()
+{
+    std::wstring channelName = L"TestChannelHandleDeleteRace";
+    EzPubSub::ChannelOption channelOption;
+    EzPubSub::ChannelHandle channelHandle;
+    std::vector<std::thread> publisherList;
+    std::atomic<uint32_t> publishedDataCount(0);
+    std::atomic<uint32_t> unexpectedResultCount(0);
+
+    ClearReceivedDataList();
+    channelOption.fireMode = EzPubSub::FireMode::kEvent;
+    TEST_CHECK(EzPubSub::PubSubLite::CreateChannel(channelName, channelOption, channelHandle) == EzPubSub::Error::kSuccess);
+    TEST_CHECK(EzPubSub::PubSubLite::RegisterSubscriber(channelHandle, ReceivingSubscriberCallback) == EzPubSub::Error::kSuccess);
+
+    for (uint32_t publisherIndex = 0; publisherIndex < 4; publisherIndex++)
+    {
+        publisherList.emplace_back([&, publisherIndex]()
+        {
+            EzPubSub::ChannelHandle publisherChannelHandle = channelHandle;
+            EzPubSub::Error publishResult = EzPubSub::Error::kSuccess;
+            std::string data = MakeTestData("p", publisherIndex, 16);
+
+            for (;;)
+            {
+                publishResult = PublishHandleString(publisherChannelHandle, data);
+                if (publishResult == EzPubSub::Error::kNotExistChannel)
+                {
+                    break;
+                }
+                if (publishResult == EzPubSub::Error::kSuccess)
+                {
+                    publishedDataCount++;
+                }
+                else
+                {
+                    unexpectedResultCount++;
+                }
+                std::this_thread::yield();
+            }
+        });
+    }
+    while (publishedDataCount < 100)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    TEST_CHECK(EzPubSub::PubSubLite::DeleteChannel(channelName) == EzPubSub::Error::kSuccess);
+    for (auto& publisher : publisherList)
+    {
+        publisher.join();
+    }
+    TEST_CHECK(unexpectedResultCount == 0);
+    TEST_CHECK(PublishHandleString(channelHandle, "after") == EzPubSub::Error::kNotExistChannel);
+}
+
+}
@@ -0,0 +1,201 @@
+/*!
+ * \author Ezbeat, Ji Hoon Park
+ */
+
+#include "PubSubLiteTest.h"
+
+#if defined(__linux__)
+#include <algorithm>
+#include <filesystem>
+
+#include <unistd.h>
+#endif
+
+namespace PubSubLiteTest
+{
+
+#if defined(__linux__)
+namespace
+{
+
+std::vector<std::pair<uint64_t, std::string>> gReplayedDataList;
+
+void ReplayCallback(_In_ uint64_t logOffset, _In_ const uint8_t* data, _In_ uint32_t dataSize, _In_opt_ void* replayContext)
+{
+    (void)replayContext;
+
+    gReplayedDataList.emplace_back(logOffset, std::string(reinterpret_cast<const char*>(data), dataSize));
+}
+
+std::vector<uint64_t> GetReplayedOffsetList()
+{
+    std::vector<uint64_t> replayedOffsetList;
+
+    for (auto& replayedData : gReplayedDataList)
+    {
+        replayedOffsetList.push_back(replayedData.first);
+    }
+    return replayedOffsetList;
+}
+
+std::filesystem::path MakeLogDirectory(_In_ const std::string& testName)
+{
+    std::filesystem::path logDirectory = std::filesystem::temp_directory_path() / ("PubSubLiteTest." + testName + "." + std::to_string(::getpid()));
+
+    std::filesystem::remove_all(logDirectory);
+    return logDirectory;
+}
+
+std::filesystem::path GetSegmentPath(_In_ const std::filesystem::path& logDirectory, _In_ uint64_t baseOffset)
+{
+    char offsetName[32] = { 0, };
+
+    snprintf(offsetName, sizeof(offsetName), "%020llu", static_cast<unsigned long long>(baseOffset));
+    return logDirectory / (std::string("TestChannelLog.") + offsetName + ".log");
+}
+
+}
+
+// A record whose checksum does not match ends the log, and Replay returns the data before it.
+void TestChannelLogRecovery()
+{
+    std::filesystem::path logDirectory = MakeLogDirectory("Recovery");
+    EzPubSub::ChannelLogStatistics channelLogStatistics;
+    std::vector<std::string> dataList = MakeTestDataList("log", 0, 9, 20);
+    std::vector<uint8_t> segment;
+    std::string corruptedData = dataList[7];
+    FILE* segmentFile = nullptr;
+    uint64_t nextLogOffset = 0;
+
+    {
+        EzPubSub::ChannelLog channelLog;
+
+        TEST_CHECK(channelLog.Open(logDirectory.wstring(), L"TestChannelLog", 0, 0, 0, 0, 0, nullptr) == true);
+        for (auto& data : dataList)
+        {
+            channelLog.Append(reinterpret_cast<const uint8_t*>(data.data()), static_cast<uint32_t>(data.size()));
+        }
+        channelLog.GetStatistics(channelLogStatistics);
+        TEST_CHECK(channelLogStatistics.nextLogOffset == 10);
+        channelLog.Close();
+    }
+
+    // One byte of the data of offset 7 is changed on the disk.
+    segmentFile = fopen(GetSegmentPath(logDirectory, 0).string().c_str(), "r+b");
+    TEST_CHECK(segmentFile != nullptr);
+    if (segmentFile != nullptr)
+    {
+        segment.resize(static_cast<size_t>(std::filesystem::file_size(GetSegmentPath(logDirectory, 0))));
+        TEST_CHECK(fread(segment.data(), 1, segment.size(), segmentFile) == segment.size());
+        auto corruptedPosition = std::search(segment.begin(), segment.end(), corruptedData.begin(), corruptedData.end());
+        TEST_CHECK(corruptedPosition != segment.end());
+        if (corruptedPosition != segment.end())
+        {
+            fseek(segmentFile, static_cast<long>(corruptedPosition - segment.begin()), SEEK_SET);
+            fputc('X', segmentFile);
+        }
+        fclose(segmentFile);
+    }
+
+    {
+        EzPubSub::ChannelLog channelLog;
+        std::string newData = "new";
+
+        TEST_CHECK(channelLog.Open(logDirectory.wstring(), L"TestChannelLog", 0, 0, 0, 0, 0, nullptr) == true);
+        channelLog.GetStatistics(channelLogStatistics);
+        TEST_CHECK(channelLogStatistics.firstLogOffset == 0);
+        TEST_CHECK(channelLogStatistics.nextLogOffset == 7);
+
+        gReplayedDataList.clear();
+        nextLogOffset = channelLog.Replay(3, ReplayCallback, nullptr);
+        TEST_CHECK(nextLogOffset == 7);
+        TEST_CHECK(GetReplayedOffsetList() == std::vector<uint64_t>({ 3, 4, 5, 6 }));
+        TEST_CHECK((gReplayedDataList.size() == 4) && (gReplayedDataList[0].second == dataList[3]) && (gReplayedDataList[3].second == dataList[6]));
+
+        // The log continues at the corrupted record.
+        channelLog.Append(reinterpret_cast<const uint8_t*>(newData.data()), static_cast<uint32_t>(newData.size()));
+        gReplayedDataList.clear();
+        TEST_CHECK(channelLog.Replay(6, ReplayCallback, nullptr) == 8);
+        TEST_CHECK((gReplayedDataList.size() == 2) && (gReplayedDataList[1].first == 7) && (gReplayedDataList[1].second == newData));
+        channelLog.Close();
+    }
+
+    std::filesystem::remove_all(logDirectory);
+}
+
+// Old segments beyond the retention are deleted, and Replay starts from the oldest data kept.
+void TestChannelLogRetention()
+{
+    std::filesystem::path logDirectory = MakeLogDirectory("Retention");
+    EzPubSub::ChannelLogStatistics channelLogStatistics;
+    std::vector<std::string> dataList = MakeTestDataList("log", 0, 99, 1000);
+    EzPubSub::ChannelLog channelLog;
+
+    // 4 records of 1000 bytes fit in a segment of 4096 bytes.
+    TEST_CHECK(channelLog.Open(logDirectory.wstring(), L"TestChannelLog", 4096, 0, 0, 3, 0, nullptr) == true);
+    for (auto& data : dataList)
+    {
+        channelLog.Append(reinterpret_cast<const uint8_t*>(data.data()), static_cast<uint32_t>(data.size()));
+    }
+    channelLog.GetStatistics(channelLogStatistics);
+    TEST_CHECK(channelLogStatistics.segmentCount == 3);
+    TEST_CHECK(channelLogStatistics.firstLogOffset == 88);
+    TEST_CHECK(channelLogStatistics.nextLogOffset == 100);
+    TEST_CHECK(std::filesystem::exists(GetSegmentPath(logDirectory, 0)) == false);
+    TEST_CHECK(std::filesystem::exists(GetSegmentPath(logDirectory, 88)) == true);
+
+    gReplayedDataList.clear();
+    TEST_CHECK(channelLog.Replay(10, ReplayCallback, nullptr) == 100);
+    TEST_CHECK((gReplayedDataList.size() == 12) && (gReplayedDataList[0].first == 88) && (gReplayedDataList[0].second == dataList[88]));
+
+    // A segment deleted by someone else is skipped as well.
+    std::filesystem::remove(GetSegmentPath(logDirectory, 88));
+    gReplayedDataList.clear();
+    TEST_CHECK(channelLog.Replay(0, ReplayCallback, nullptr) == 100);
+    TEST_CHECK((gReplayedDataList.size() == 8) && (gReplayedDataList[0].first == 92));
+    channelLog.Close();
+
+    // A lower retention is applied when the log is opened.
+    TEST_CHECK(channelLog.Open(logDirectory.wstring(), L"TestChannelLog", 4096, 0, 0, 0, 4096, nullptr) == true);
+    channelLog.GetStatistics(channelLogStatistics);
+    TEST_CHECK(channelLogStatistics.segmentCount == 1);
+    TEST_CHECK(channelLogStatistics.firstLogOffset == 96);
+    TEST_CHECK(channelLogStatistics.nextLogOffset == 100);
+    channelLog.Close();
+
+    std::filesystem::remove_all(logDirectory);
+}
+
+// Data published to a channel with logDirectory is replayed by ReplayChannelLog, decompressed if the channel compressed it.
+void TestReplayChannelLog()
+{
+    std::wstring channelName = L"TestChannelLog";
+    std::filesystem::path logDirectory = MakeLogDirectory("Replay");
+    EzPubSub::ChannelOption channelOption;
+    std::vector<std::string> dataList;
+    uint64_t nextLogOffset = 0;
+
+    channelOption.logDirectory = logDirectory.wstring();
+    channelOption.compressionThreshold = 64;
+    TEST_CHECK(EzPubSub::PubSubLite::CreateChannel(channelName, channelOption) == EzPubSub::Error::kSuccess);
+    for (uint32_t index = 0; index < 10; index++)
+    {
+        dataList.push_back(MakeTestData("r", index, 0) + std::string(index * 20, 'r'));
+        TEST_CHECK(PublishString(channelName, dataList.back()) == EzPubSub::Error::kSuccess);
+    }
+
+    gReplayedDataList.clear();
+    TEST_CHECK(EzPubSub::PubSubLite::ReplayChannelLog(channelName, 0, ReplayCallback, nullptr, &nextLogOffset) == EzPubSub::Error::kSuccess);
+    TEST_CHECK(nextLogOffset == 10);
+    TEST_CHECK(gReplayedDataList.size() == dataList.size());
+    for (size_t index = 0; (index < gReplayedDataList.size()) && (index < dataList.size()); index++)
+    {
+        TEST_CHECK((gReplayedDataList[index].first == index) && (gReplayedDataList[index].second == dataList[index]));
+    }
+    TEST_CHECK(EzPubSub::PubSubLite::DeleteChannel(channelName) == EzPubSub::Error::kSuccess);
+
+    std::filesystem::remove_all(logDirectory);
+}
+#endif
+
+}
@@ -0,0 +1,146 @@
+/*!
+ * \author Ezbeat, Ji Hoon Park
+ */
+
+#include "PubSubLiteTest.h"
+
+#include <algorithm>
+
+namespace PubSubLiteTest
+{
+
+namespace
+{
+
+EzPubSub::Error PublishPriorityString(_In_ const std::wstring& channelName, _In_ uint32_t priority, _In_ const std::string& data)
+{
+    return EzPubSub::PubSubLite::PublishPriorityData(channelName, priority, reinterpret_cast<const uint8_t*>(data.data()), static_cast<uint32_t>(data.size()));
+}
+
+}
+
+void TestHistogram()
+{
+    EzPubSub::Histogram histogram;
+    EzPubSub::HistogramSnapshot histogramSnapshot;
+    uint32_t bucketIndex = 0;
+
+    // A value is kept within 1/16 of it.
+    TEST_CHECK(EzPubSub::GetHistogramBucketIndex(15) == 15);
+    TEST_CHECK(EzPubSub::GetHistogramBucketValue(15) == 15);
+    for (uint64_t value : { 16ull, 1000ull, 123456789ull })
+    {
+        bucketIndex = EzPubSub::GetHistogramBucketIndex(value);
+        TEST_CHECK((EzPubSub::GetHistogramBucketValue(bucketIndex) <= value) && (EzPubSub::GetHistogramBucketValue(bucketIndex + 1) > value));
+        TEST_CHECK(EzPubSub::GetHistogramBucketValue(bucketIndex + 1) - EzPubSub::GetHistogramBucketValue(bucketIndex) <= value / 16);
+    }
+
+    for (uint64_t value = 1; value <= 100; value++)
+    {
+        histogram.Record(value);
+    }
+    histogram.GetSnapshot(histogramSnapshot);
+    if (EzPubSub::kIsStatisticsEnabled == true)
+    {
+        TEST_CHECK(histogramSnapshot.count == 100);
+        TEST_CHECK((histogramSnapshot.minValue == 1) && (histogramSnapshot.maxValue == 100));
+        TEST_CHECK(histogramSnapshot.GetMean() == 50);
+        TEST_CHECK((histogramSnapshot.GetPercentile(50) >= 50) && (histogramSnapshot.GetPercentile(50) < 50 + 50 / 16 + 1));
+        TEST_CHECK(histogramSnapshot.GetPercentile(100) == 100);
+    }
+    else
+    {
+        TEST_CHECK(histogramSnapshot.count == 0);
+    }
+}
+
+// The counters of a channel and its lanes while data are buffered, after they are fired, and after some are dropped.
+void TestChannelStatistics()
+{
+    std::wstring channelName = L"TestChannelStatistics";
+    std::wstring secondChannelName = L"TestChannelStatistics2";
+    EzPubSub::ChannelOption channelOption;
+    EzPubSub::ChannelStatistics channelStatistics;
+    std::vector<EzPubSub::ChannelStatistics> channelStatisticsList;
+    std::vector<std::wstring> channelNameList;
+    uint32_t subscriberId = 0;
+
+    ClearReceivedDataList();
+    channelOption.fireMode = EzPubSub::FireMode::kEvent;
+    channelOption.maxBufferedDataSize = 100;
+    channelOption.priorityLaneCount = 2;
+    TEST_CHECK(EzPubSub::PubSubLite::GetChannelStatistics(channelName, channelStatistics) == EzPubSub::Error::kNotExistChannel);
+    TEST_CHECK(EzPubSub::PubSubLite::CreateChannel(channelName, channelOption) == EzPubSub::Error::kSuccess);
+    TEST_CHECK(EzPubSub::PubSubLite::RegisterSubscriber(channelName, ReceivingSubscriberCallback, &subscriberId) == EzPubSub::Error::kSuccess);
+
+    TEST_CHECK(CloseGate(channelName) == true);
+    for (uint32_t index = 0; index < 10; index++)
+    {
+        TEST_CHECK(PublishPriorityString(channelName, (index < 7) ? 0 : 1, MakeTestData("s", index, 10)) == EzPubSub::Error::kSuccess);
+    }
+    TEST_CHECK(EzPubSub::PubSubLite::GetChannelStatistics(channelName, channelStatistics) == EzPubSub::Error::kSuccess);
+    TEST_CHECK(channelStatistics.channelName == channelName);
+    TEST_CHECK((channelStatistics.bufferedDataCount == 10) && (channelStatistics.bufferedDataSize == 100));
+    TEST_CHECK(channelStatistics.laneStatisticsList.size() == 2);
+    if (channelStatistics.laneStatisticsList.size() == 2)
+    {
+        TEST_CHECK((channelStatistics.laneStatisticsList[0].bufferedDataCount == 7) && (channelStatistics.laneStatisticsList[0].bufferedDataSize == 70));
+        TEST_CHECK((channelStatistics.laneStatisticsList[1].bufferedDataCount == 3) && (channelStatistics.laneStatisticsList[1].bufferedDataSize == 30));
+    }
+    OpenGate();
+    TEST_CHECK(WaitReceivedDataCount(10) == true);
+
+    // 12 data to a buffer of 10, the 2 oldest are dropped.
+    TEST_CHECK(CloseGate(channelName) == true);
+    for (uint32_t index = 0; index < 12; index++)
+    {
+        TEST_CHECK(PublishPriorityString(channelName, 0, MakeTestData("t", index, 10)) == EzPubSub::Error::kSuccess);
+    }
+    OpenGate();
+    TEST_CHECK(WaitReceivedDataCount(20) == true);
+
+    // kGateData is fired twice from lane 0.
+    TEST_CHECK(EzPubSub::PubSubLite::GetChannelStatistics(channelName, channelStatistics) == EzPubSub::Error::kSuccess);
+    TEST_CHECK((channelStatistics.firedDataCount == 22) && (channelStatistics.lostDataCount == 2));
+    TEST_CHECK((channelStatistics.bufferedDataCount == 0) && (channelStatistics.bufferedDataSize == 0));
+    if (channelStatistics.laneStatisticsList.size() == 2)
+    {
+        TEST_CHECK((channelStatistics.laneStatisticsList[0].firedDataCount == 19) && (channelStatistics.laneStatisticsList[0].lostDataCount == 2));
+        TEST_CHECK((channelStatistics.laneStatisticsList[1].firedDataCount == 3) && (channelStatistics.laneStatisticsList[1].lostDataCount == 0));
+    }
+    TEST_CHECK((channelStatistics.subscriberStatisticsList.size() == 1) && (channelStatistics.subscriberStatisticsList[0].subscriberId == subscriberId));
+
+    // One in kStatisticsSampleInterval data published in a row is timed, which the data above may have been dropped with.
+    for (uint32_t index = 0; index < EzPubSub::kStatisticsSampleInterval; index++)
+    {
+        TEST_CHECK(PublishPriorityString(channelName, 1, MakeTestData("u", index, 10)) == EzPubSub::Error::kSuccess);
+        TEST_CHECK(WaitReceivedDataCount(20 + index + 1) == true);
+    }
+    TEST_CHECK(EzPubSub::PubSubLite::GetChannelStatistics(channelName, channelStatistics) == EzPubSub::Error::kSuccess);
+    if (EzPubSub::kIsStatisticsEnabled == true)
+    {
+        TEST_CHECK(channelStatistics.deliveryLatency.count >= 1);
+        TEST_CHECK((channelStatistics.subscriberStatisticsList.size() == 1) && (channelStatistics.subscriberStatisticsList[0].callbackTime.count >= 1));
+        TEST_CHECK(channelStatistics.bufferedDataCountSample.count >= 2);
+        TEST_CHECK(channelStatistics.bufferedDataCountSample.maxValue >= 10);
+    }
+    else
+    {
+        TEST_CHECK((channelStatistics.deliveryLatency.count == 0) && (channelStatistics.bufferedDataCountSample.count == 0));
+    }
+
+    // Every channel, each once.
+    TEST_CHECK(EzPubSub::PubSubLite::CreateChannel(secondChannelName, channelOption) == EzPubSub::Error::kSuccess);
+    TEST_CHECK(EzPubSub::PubSubLite::GetAllChannelStatistics(channelStatisticsList) == EzPubSub::Error::kSuccess);
+    for (auto& listedChannelStatistics : channelStatisticsList)
+    {
+        channelNameList.push_back(listedChannelStatistics.channelName);
+    }
+    std::sort(channelNameList.begin(), channelNameList.end());
+    TEST_CHECK(channelNameList == std::vector<std::wstring>({ channelName, secondChannelName }));
+
+    TEST_CHECK(EzPubSub::PubSubLite::DeleteChannel(channelName) == EzPubSub::Error::kSuccess);
+    TEST_CHECK(EzPubSub::PubSubLite::DeleteChannel(secondChannelName) == EzPubSub::Error::kSuccess);
+}
+
+}
@@ -0,0 +1,78 @@
+/*!
+ * \author Ezbeat, Ji Hoon Park
+ */
+
+#include "PubSubLiteTest.h"
+
+#include <thread>
+
+namespace PubSubLiteTest
+{
+
+namespace
+{
+
+const uint32_t kLongCoalescedTime = 10000000; // 10 Seconds, Unit: Microsecond
+const uint32_t kShortCoalescedTime = 100000; // 100 Milliseconds, Unit: Microsecond
+
+// Nothing of the data published so far is fired while the threshold is not reached.
+bool IsNothingReceived()
+{
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+
+    return (GetReceivedDataList().size() == 0);
+}
+
+}
+
+// Data are held until coalescedDataCount, coalescedDataSize or coalescedTime is reached, and then fired together.
+void TestCoalescing(_In_ EzPubSub::FireThreadType fireThreadType)
+{
+    std::wstring channelName = L"TestCoalescing";
+    EzPubSub::ChannelOption channelOption;
+
+    ClearReceivedDataList();
+    channelOption.fireMode = EzPubSub::FireMode::kEvent;
+    channelOption.fireThreadType = fireThreadType;
+    channelOption.flushTime = 10;
+    channelOption.coalescedDataCount = 5;
+    channelOption.coalescedTime = kLongCoalescedTime;
+    TEST_CHECK(EzPubSub::PubSubLite::CreateChannel(channelName, channelOption) == EzPubSub::Error::kSuccess);
+    TEST_CHECK(EzPubSub::PubSubLite::RegisterSubscriber(channelName, ReceivingBatchSubscriberCallback) == EzPubSub::Error::kSuccess);
+
+    // The 5th data fires the 4 held before it, in spite of the short flushTime.
+    for (uint32_t index = 0; index < 4; index++)
+    {
+        TEST_CHECK(PublishString(channelName, MakeTestData("c", index, 10)) == EzPubSub::Error::kSuccess);
+    }
+    TEST_CHECK(IsNothingReceived() == true);
+    TEST_CHECK(PublishString(channelName, MakeTestData("c", 4, 10)) == EzPubSub::Error::kSuccess);
+    TEST_CHECK(WaitReceivedDataCount(5) == true);
+    TEST_CHECK(GetReceivedDataList() == MakeTestDataList("c", 0, 4, 10));
+    TEST_CHECK(gReceivedBatchSizeList == std::vector<uint32_t>({ 5 }));
+
+    // 30 bytes by coalescedDataSize, set by UpdateChannel.
+    ClearReceivedDataList();
+    TEST_CHECK(EzPubSub::PubSubLite::UpdateChannel(channelName, 10, EzPubSub::kDefaultMaxBufferedDataSize, 0, 30, kLongCoalescedTime) == EzPubSub::Error::kSuccess);
+    for (uint32_t index = 0; index < 2; index++)
+    {
+        TEST_CHECK(PublishString(channelName, MakeTestData("d", index, 10)) == EzPubSub::Error::kSuccess);
+    }
+    TEST_CHECK(IsNothingReceived() == true);
+    TEST_CHECK(PublishString(channelName, MakeTestData("d", 2, 10)) == EzPubSub::Error::kSuccess);
+    TEST_CHECK(WaitReceivedDataCount(3) == true);
+    TEST_CHECK(GetReceivedDataList() == MakeTestDataList("d", 0, 2, 10));
+    TEST_CHECK(gReceivedBatchSizeList == std::vector<uint32_t>({ 3 }));
+
+    // Without a threshold reached, the data is fired by the timer after coalescedTime.
+    ClearReceivedDataList();
+    TEST_CHECK(EzPubSub::PubSubLite::UpdateChannel(channelName, 10, EzPubSub::kDefaultMaxBufferedDataSize, 0, 0, kShortCoalescedTime) == EzPubSub::Error::kSuccess);
+    TEST_CHECK(PublishString(channelName, "t0") == EzPubSub::Error::kSuccess);
+    TEST_CHECK(IsNothingReceived() == true);
+    TEST_CHECK(WaitReceivedDataCount(1) == true);
+    TEST_CHECK(GetReceivedDataList() == std::vector<std::string>({ "t0" }));
+
+    TEST_CHECK(EzPubSub::PubSubLite::DeleteChannel(channelName) == EzPubSub::Error::kSuccess);
+}
+
+}
@@ -0,0 +1,71 @@
+/*!
+ * \author Ezbeat, Ji Hoon Park
+ */
+
+#include "PubSubLiteTest.h"
+
+#include <algorithm>
+#include <thread>
+
+namespace PubSubLiteTest
+{
+
+namespace
+{
+
+EzPubSub::Error PublishKeyedString(_In_ const std::wstring& channelName, _In_ uint64_t dataKey, _In_ const std::string& data)
+{
+    return EzPubSub::PubSubLite::PublishKeyedData(channelName, dataKey, reinterpret_cast<const uint8_t*>(data.data()), static_cast<uint32_t>(data.size()));
+}
+
+}
+
+// Keyed data published while the FireThread is held replaces the buffered data of its key in its place.
+void TestConflation(_In_ EzPubSub::ConflationMode conflationMode)
+{
+    std::wstring channelName = L"TestConflation";
+    EzPubSub::ChannelOption channelOption;
+    std::vector<std::string> snapshotDataList;
+
+    ClearReceivedDataList();
+    channelOption.fireMode = EzPubSub::FireMode::kEvent;
+    channelOption.conflationMode = conflationMode;
+    TEST_CHECK(EzPubSub::PubSubLite::CreateChannel(channelName, channelOption) == EzPubSub::Error::kSuccess);
+    TEST_CHECK(EzPubSub::PubSubLite::RegisterSubscriber(channelName, ReceivingSubscriberCallback) == EzPubSub::Error::kSuccess);
+    TEST_CHECK(CloseGate(channelName) == true);
+
+    TEST_CHECK(PublishKeyedString(channelName, 1, "a1") == EzPubSub::Error::kSuccess);
+    TEST_CHECK(PublishKeyedString(channelName, 2, "b1") == EzPubSub::Error::kSuccess);
+    TEST_CHECK(PublishString(channelName, "n1") == EzPubSub::Error::kSuccess);
+    TEST_CHECK(PublishKeyedString(channelName, 1, "a2") == EzPubSub::Error::kSuccess);
+    TEST_CHECK(PublishKeyedString(channelName, 1, "a3") == EzPubSub::Error::kSuccess);
+
+    OpenGate();
+    TEST_CHECK(WaitReceivedDataCount(3) == true);
+    TEST_CHECK(GetReceivedDataList() == std::vector<std::string>({ "a3", "b1", "n1" }));
+
+    // A new subscriber receives the last fired data of each key, and not the data that is not keyed.
+    TEST_CHECK(EzPubSub::PubSubLite::RegisterSubscriber(channelName, SecondReceivingSubscriberCallback) == EzPubSub::Error::kSuccess);
+    if (conflationMode == EzPubSub::ConflationMode::kLastValueCache)
+    {
+        TEST_CHECK(WaitReceivedDataCount(2, true) == true);
+        snapshotDataList = GetReceivedDataList(true);
+        std::sort(snapshotDataList.begin(), snapshotDataList.end());
+        TEST_CHECK(snapshotDataList == std::vector<std::string>({ "a3", "b1" }));
+    }
+    else
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        TEST_CHECK(GetReceivedDataList(true).size() == 0);
+    }
+
+    // Keyed data published after the snapshot is fired to both subscribers.
+    TEST_CHECK(PublishKeyedString(channelName, 2, "b2") == EzPubSub::Error::kSuccess);
+    TEST_CHECK(WaitReceivedDataCount(4) == true);
+    TEST_CHECK(GetReceivedDataList().back() == "b2");
+    TEST_CHECK(GetReceivedDataList(true).back() == "b2");
+
+    TEST_CHECK(EzPubSub::PubSubLite::DeleteChannel(channelName) == EzPubSub::Error::kSuccess);
+}
+
+}
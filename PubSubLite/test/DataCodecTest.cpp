@@ -0,0 +1,82 @@
+/*!
+ * \author Ezbeat, Ji Hoon Park
+ */
+
+#include "PubSubLiteTest.h"
+
+namespace PubSubLiteTest
+{
+
+// Data compressed by DataCodec, with or without a dictionary, is decompressed back to the same bytes.
+void TestDataCodec()
+{
+    std::vector<uint8_t> dictionary;
+    std::vector<uint8_t> data;
+    std::vector<uint8_t> compressedData;
+    std::vector<uint8_t> decompressedData;
+    uint32_t compressedSize = 0;
+    uint32_t dictionaryCompressedSize = 0;
+    std::string message = "{\"symbol\":\"EZPS\",\"side\":\"buy\",\"price\":1024,\"quantity\":7}";
+    std::string dictionaryMessage = "{\"symbol\":\"EZPS\",\"side\":\"sell\",\"price\":2048,\"quantity\":3}";
+
+    // Repeated data is compressed and decompressed back to the same bytes.
+    for (uint32_t index = 0; index < 4096; index++)
+    {
+        data.push_back(static_cast<uint8_t>("pubsublite"[index % 10]));
+    }
+    EzPubSub::DataCodec dataCodec;
+    compressedData.resize(data.size());
+    compressedSize = dataCodec.Compress(data.data(), static_cast<uint32_t>(data.size()), compressedData.data(), static_cast<uint32_t>(compressedData.size()));
+    TEST_CHECK((compressedSize != 0) && (compressedSize < data.size() / 10));
+    TEST_CHECK(EzPubSub::DataCodec::GetDecompressedSize(compressedData.data(), compressedSize) == data.size());
+    decompressedData.resize(data.size());
+    TEST_CHECK(dataCodec.Decompress(compressedData.data(), compressedSize, decompressedData.data(), static_cast<uint32_t>(decompressedData.size())) == true);
+    TEST_CHECK(decompressedData == data);
+    // Not decompressed into a buffer of another size.
+    TEST_CHECK(dataCodec.Decompress(compressedData.data(), compressedSize, decompressedData.data(), static_cast<uint32_t>(decompressedData.size() - 1)) == false);
+
+    // A small message is only compressed with a dictionary of the same format.
+    data.assign(message.begin(), message.end());
+    dictionary.assign(dictionaryMessage.begin(), dictionaryMessage.end());
+    EzPubSub::DataCodec dictionaryDataCodec(dictionary);
+    compressedData.assign(data.size(), 0);
+    compressedSize = dataCodec.Compress(data.data(), static_cast<uint32_t>(data.size()), compressedData.data(), static_cast<uint32_t>(compressedData.size()));
+    TEST_CHECK(compressedSize == 0);
+    dictionaryCompressedSize = dictionaryDataCodec.Compress(data.data(), static_cast<uint32_t>(data.size()), compressedData.data(), static_cast<uint32_t>(compressedData.size()));
+    TEST_CHECK((dictionaryCompressedSize != 0) && (dictionaryCompressedSize < data.size()));
+    decompressedData.assign(data.size(), 0);
+    TEST_CHECK(dictionaryDataCodec.Decompress(compressedData.data(), dictionaryCompressedSize, decompressedData.data(), static_cast<uint32_t>(decompressedData.size())) == true);
+    TEST_CHECK(decompressedData == data);
+    // The matches in the dictionary are out of range without it.
+    TEST_CHECK(dataCodec.Decompress(compressedData.data(), dictionaryCompressedSize, decompressedData.data(), static_cast<uint32_t>(decompressedData.size())) == false);
+}
+
+// Data compressed by a channel is fired to the subscribers decompressed.
+void TestChannelCompression(_In_ EzPubSub::QueueType queueType)
+{
+    std::wstring channelName = L"TestChannelCompression";
+    EzPubSub::ChannelOption channelOption;
+    std::vector<std::string> expectedDataList;
+    std::string data;
+
+    ClearReceivedDataList();
+    channelOption.fireMode = EzPubSub::FireMode::kEvent;
+    channelOption.queueType = queueType;
+    channelOption.compressionThreshold = 16;
+    channelOption.compressionDictionary.assign(64, 'z');
+    TEST_CHECK(EzPubSub::PubSubLite::CreateChannel(channelName, channelOption) == EzPubSub::Error::kSuccess);
+    TEST_CHECK(EzPubSub::PubSubLite::RegisterSubscriber(channelName, ReceivingSubscriberCallback) == EzPubSub::Error::kSuccess);
+
+    for (uint32_t index = 0; index < 20; index++)
+    {
+        data = MakeTestData("c", index, 0) + std::string(index * 10, 'z');
+        expectedDataList.push_back(data);
+        TEST_CHECK(PublishString(channelName, data) == EzPubSub::Error::kSuccess);
+    }
+    TEST_CHECK(WaitReceivedDataCount(expectedDataList.size()) == true);
+    TEST_CHECK(GetReceivedDataList() == expectedDataList);
+
+    TEST_CHECK(EzPubSub::PubSubLite::DeleteChannel(channelName) == EzPubSub::Error::kSuccess);
+}
+
+}
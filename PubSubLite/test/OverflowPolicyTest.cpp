@@ -0,0 +1,65 @@
+/*!
+ * \author Ezbeat, Ji Hoon Park
+ */
+
+#include "PubSubLiteTest.h"
+
+namespace PubSubLiteTest
+{
+
+// 15 data of 10 bytes are published while the FireThread is held, to a channel that holds 10 of them.
+void TestOverflowPolicy(_In_ EzPubSub::QueueType queueType, _In_ EzPubSub::OverflowPolicy overflowPolicy)
+{
+    std::wstring channelName = L"TestOverflowPolicy";
+    EzPubSub::ChannelOption channelOption;
+    uint32_t successCount = 0;
+    uint32_t notEnoughBufferSizeCount = 0;
+    uint64_t lostDataCount = 0;
+    EzPubSub::Error publishResult = EzPubSub::Error::kUnsuccess;
+    TestClock::time_point startTime;
+
+    ClearReceivedDataList();
+    channelOption.fireMode = EzPubSub::FireMode::kEvent;
+    channelOption.queueType = queueType;
+    channelOption.ringCapacity = 64;
+    channelOption.maxBufferedDataSize = 100;
+    channelOption.overflowPolicy = overflowPolicy;
+    channelOption.blockTimeout = 50;
+    TEST_CHECK(EzPubSub::PubSubLite::CreateChannel(channelName, channelOption) == EzPubSub::Error::kSuccess);
+    TEST_CHECK(EzPubSub::PubSubLite::RegisterSubscriber(channelName, ReceivingSubscriberCallback) == EzPubSub::Error::kSuccess);
+    TEST_CHECK(CloseGate(channelName) == true);
+
+    startTime = TestClock::now();
+    for (uint32_t index = 0; index < 15; index++)
+    {
+        publishResult = PublishString(channelName, MakeTestData("d", index, 10));
+        successCount += (publishResult == EzPubSub::Error::kSuccess) ? 1 : 0;
+        notEnoughBufferSizeCount += (publishResult == EzPubSub::Error::kNotEnoughBufferSize) ? 1 : 0;
+    }
+
+    OpenGate();
+    TEST_CHECK(WaitReceivedDataCount(10) == true);
+    TEST_CHECK(EzPubSub::PubSubLite::GetLostDataCount(channelName, lostDataCount) == EzPubSub::Error::kSuccess);
+    if (overflowPolicy == EzPubSub::OverflowPolicy::kDropOldest)
+    {
+        TEST_CHECK(successCount == 15);
+        TEST_CHECK(lostDataCount == 5);
+        TEST_CHECK(GetReceivedDataList() == MakeTestDataList("d", 5, 14, 10));
+    }
+    else
+    {
+        TEST_CHECK(successCount == 10);
+        TEST_CHECK(notEnoughBufferSizeCount == 5);
+        TEST_CHECK(lostDataCount == 0);
+        TEST_CHECK(GetReceivedDataList() == MakeTestDataList("d", 0, 9, 10));
+    }
+    if (overflowPolicy == EzPubSub::OverflowPolicy::kBlock)
+    {
+        // Each of the 5 data waited for blockTimeout.
+        TEST_CHECK(TestClock::now() - startTime >= std::chrono::milliseconds(5 * 50));
+    }
+
+    TEST_CHECK(EzPubSub::PubSubLite::DeleteChannel(channelName) == EzPubSub::Error::kSuccess);
+}
+
+}
@@ -0,0 +1,71 @@
+/*!
+ * \author Ezbeat, Ji Hoon Park
+ */
+
+#include "PubSubLiteTest.h"
+
+namespace PubSubLiteTest
+{
+
+namespace
+{
+
+EzPubSub::Error PublishPriorityString(_In_ const std::wstring& channelName, _In_ uint32_t priority, _In_ const std::string& data)
+{
+    return EzPubSub::PubSubLite::PublishPriorityData(channelName, priority, reinterpret_cast<const uint8_t*>(data.data()), static_cast<uint32_t>(data.size()));
+}
+
+}
+
+// Data of two lanes published while the FireThread is held are fired by laneScheduling when it is resumed.
+void TestPriorityLane(_In_ EzPubSub::LaneScheduling laneScheduling)
+{
+    std::wstring channelName = L"TestPriorityLane";
+    EzPubSub::ChannelOption channelOption;
+    std::vector<std::string> expectedDataList;
+    std::string firedLaneList;
+
+    ClearReceivedDataList();
+    channelOption.fireMode = EzPubSub::FireMode::kEvent;
+    channelOption.priorityLaneCount = 2;
+    channelOption.laneScheduling = laneScheduling;
+    channelOption.laneWeight[0] = 1;
+    channelOption.laneWeight[1] = 3;
+    TEST_CHECK(EzPubSub::PubSubLite::CreateChannel(channelName, channelOption) == EzPubSub::Error::kSuccess);
+    TEST_CHECK(EzPubSub::PubSubLite::RegisterSubscriber(channelName, ReceivingSubscriberCallback) == EzPubSub::Error::kSuccess);
+    TEST_CHECK(CloseGate(channelName) == true);
+
+    for (uint32_t index = 0; index < 8; index++)
+    {
+        TEST_CHECK(PublishPriorityString(channelName, 0, MakeTestData("L", index, 0)) == EzPubSub::Error::kSuccess);
+        TEST_CHECK(PublishPriorityString(channelName, 1, MakeTestData("H", index, 0)) == EzPubSub::Error::kSuccess);
+    }
+    TEST_CHECK(PublishPriorityString(channelName, 2, "X") == EzPubSub::Error::kUnsuccess);
+
+    OpenGate();
+    TEST_CHECK(WaitReceivedDataCount(16) == true);
+
+    // Data of a lane keeps its published order.
+    for (auto& receivedData : GetReceivedDataList())
+    {
+        firedLaneList.push_back(receivedData[0]);
+        if (receivedData[0] == 'L')
+        {
+            expectedDataList.push_back(receivedData);
+        }
+    }
+    TEST_CHECK(expectedDataList == MakeTestDataList("L", 0, 7, 0));
+    if (laneScheduling == EzPubSub::LaneScheduling::kStrict)
+    {
+        TEST_CHECK(firedLaneList == "HHHHHHHHLLLLLLLL");
+    }
+    else
+    {
+        // 3 data of the high lane, then 1 of the low lane, until the high lane is empty.
+        TEST_CHECK(firedLaneList == "HHHLHHHLHHLLLLLL");
+    }
+
+    TEST_CHECK(EzPubSub::PubSubLite::DeleteChannel(channelName) == EzPubSub::Error::kSuccess);
+}
+
+}
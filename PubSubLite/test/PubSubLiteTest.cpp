@@ -0,0 +1,249 @@
+/*!
+ * \author Ezbeat, Ji Hoon Park
+ */
+
+#include "PubSubLiteTest.h"
+
+#include <algorithm>
+#include <cstring>
+#include <thread>
+
+namespace PubSubLiteTest
+{
+
+std::atomic<uint32_t> gFailedCheckCount(0);
+
+std::mutex gReceivedDataListSync;
+std::vector<std::string> gReceivedDataList;
+std::vector<std::string> gSecondReceivedDataList;
+std::vector<uint32_t> gReceivedBatchSizeList;
+
+const std::string kGateData = "gate";
+namespace
+{
+
+std::atomic<bool> gIsGateClosed(false);
+std::atomic<bool> gIsGateEntered(false);
+
+}
+
+// Returns true if data is kGateData, after the gate is opened.
+bool PassGate(_In_ const uint8_t* data, _In_ uint32_t dataSize)
+{
+    if ((dataSize != kGateData.size()) || (memcmp(data, kGateData.data(), dataSize) != 0))
+    {
+        return false;
+    }
+
+    gIsGateEntered = true;
+    while (gIsGateClosed == true)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return true;
+}
+
+void ReceivingSubscriberCallback(_In_ const uint8_t* data, _In_ uint32_t dataSize, _In_opt_ void* userContext)
+{
+    (void)userContext;
+
+    if (PassGate(data, dataSize) == true)
+    {
+        return;
+    }
+
+    std::lock_guard<std::mutex> receivedDataListGuard(gReceivedDataListSync);
+
+    gReceivedDataList.emplace_back(reinterpret_cast<const char*>(data), dataSize);
+}
+
+void SecondReceivingSubscriberCallback(_In_ const uint8_t* data, _In_ uint32_t dataSize, _In_opt_ void* userContext)
+{
+    (void)userContext;
+
+    if (PassGate(data, dataSize) == true)
+    {
+        return;
+    }
+
+    std::lock_guard<std::mutex> receivedDataListGuard(gReceivedDataListSync);
+
+    gSecondReceivedDataList.emplace_back(reinterpret_cast<const char*>(data), dataSize);
+}
+
+void UngatedSubscriberCallback(_In_ const uint8_t* data, _In_ uint32_t dataSize, _In_opt_ void* userContext)
+{
+    (void)userContext;
+
+    if ((dataSize == kGateData.size()) && (memcmp(data, kGateData.data(), dataSize) == 0))
+    {
+        return;
+    }
+
+    std::lock_guard<std::mutex> receivedDataListGuard(gReceivedDataListSync);
+
+    gSecondReceivedDataList.emplace_back(reinterpret_cast<const char*>(data), dataSize);
+}
+
+void ReceivingBatchSubscriberCallback(_In_ const EzPubSub::FiredData* firedDataList, _In_ uint32_t firedDataCount)
+{
+    uint32_t receivedDataCount = 0;
+
+    for (uint32_t index = 0; index < firedDataCount; index++)
+    {
+        if (PassGate(firedDataList[index].data, firedDataList[index].dataSize) == true)
+        {
+            continue;
+        }
+
+        std::lock_guard<std::mutex> receivedDataListGuard(gReceivedDataListSync);
+
+        gReceivedDataList.emplace_back(reinterpret_cast<const char*>(firedDataList[index].data), firedDataList[index].dataSize);
+        receivedDataCount++;
+    }
+
+    std::lock_guard<std::mutex> receivedDataListGuard(gReceivedDataListSync);
+
+    if (receivedDataCount != 0)
+    {
+        gReceivedBatchSizeList.push_back(receivedDataCount);
+    }
+}
+
+void ClearReceivedDataList()
+{
+    std::lock_guard<std::mutex> receivedDataListGuard(gReceivedDataListSync);
+
+    gReceivedDataList.clear();
+    gSecondReceivedDataList.clear();
+    gReceivedBatchSizeList.clear();
+}
+
+std::vector<std::string> GetReceivedDataList(_In_opt_ bool isSecond)
+{
+    std::lock_guard<std::mutex> receivedDataListGuard(gReceivedDataListSync);
+
+    return (isSecond == true) ? gSecondReceivedDataList : gReceivedDataList;
+}
+
+bool WaitReceivedDataCount(_In_ size_t expectedDataCount, _In_opt_ bool isSecond)
+{
+    TestClock::time_point deadline = TestClock::now() + std::chrono::seconds(5);
+
+    while (GetReceivedDataList(isSecond).size() < expectedDataCount)
+    {
+        if (TestClock::now() > deadline)
+        {
+            return false;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+
+    return true;
+}
+
+EzPubSub::Error PublishString(_In_ const std::wstring& channelName, _In_ const std::string& data)
+{
+    return EzPubSub::PubSubLite::PublishData(channelName, reinterpret_cast<const uint8_t*>(data.data()), static_cast<uint32_t>(data.size()));
+}
+
+bool CloseGate(_In_ const std::wstring& channelName)
+{
+    TestClock::time_point deadline = TestClock::now() + std::chrono::seconds(5);
+
+    gIsGateClosed = true;
+    gIsGateEntered = false;
+    if (PublishString(channelName, kGateData) != EzPubSub::Error::kSuccess)
+    {
+        gIsGateClosed = false;
+        return false;
+    }
+    while (gIsGateEntered == false)
+    {
+        if (TestClock::now() > deadline)
+        {
+            return false;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    return true;
+}
+
+void OpenGate()
+{
+    gIsGateClosed = false;
+}
+
+std::string MakeTestData(_In_ const std::string& prefix, _In_ uint32_t index, _In_ size_t dataSize)
+{
+    std::string data = prefix + std::to_string(index);
+
+    data.resize(std::max(dataSize, data.size()), '.');
+    return data;
+}
+
+std::vector<std::string> MakeTestDataList(_In_ const std::string& prefix, _In_ uint32_t firstIndex, _In_ uint32_t lastIndex, _In_ size_t dataSize)
+{
+    std::vector<std::string> dataList;
+
+    for (uint32_t index = firstIndex; index <= lastIndex; index++)
+    {
+        dataList.push_back(MakeTestData(prefix, index, dataSize));
+    }
+    return dataList;
+}
+
+}
+
+int main(void)
+{
+    PubSubLiteTest::TestSharedFireThread();
+    PubSubLiteTest::TestSubscriberCursor(EzPubSub::OverflowPolicy::kDropOldest);
+    PubSubLiteTest::TestSubscriberCursor(EzPubSub::OverflowPolicy::kDropNewest);
+    PubSubLiteTest::TestSubscriberCursorClear();
+    PubSubLiteTest::TestOverflowPolicy(EzPubSub::QueueType::kList, EzPubSub::OverflowPolicy::kDropOldest);
+    PubSubLiteTest::TestOverflowPolicy(EzPubSub::QueueType::kList, EzPubSub::OverflowPolicy::kDropNewest);
+    PubSubLiteTest::TestOverflowPolicy(EzPubSub::QueueType::kList, EzPubSub::OverflowPolicy::kBlock);
+    PubSubLiteTest::TestOverflowPolicy(EzPubSub::QueueType::kRing, EzPubSub::OverflowPolicy::kDropOldest);
+    PubSubLiteTest::TestOverflowPolicy(EzPubSub::QueueType::kRing, EzPubSub::OverflowPolicy::kDropNewest);
+    PubSubLiteTest::TestOverflowPolicy(EzPubSub::QueueType::kRing, EzPubSub::OverflowPolicy::kBlock);
+    PubSubLiteTest::TestPublishMode(EzPubSub::QueueType::kList);
+    PubSubLiteTest::TestPublishMode(EzPubSub::QueueType::kRing);
+    PubSubLiteTest::TestChannelHandle();
+    PubSubLiteTest::TestChannelHandleDeleteRace();
+    PubSubLiteTest::TestWildcardSubscriber();
+    PubSubLiteTest::TestWildcardSubscriberLimit();
+    PubSubLiteTest::TestTypedChannel();
+#if defined(__linux__)
+    PubSubLiteTest::TestSharedMemoryChannel();
+    PubSubLiteTest::TestSharedMemoryDeadReader();
+    PubSubLiteTest::TestChannelLogRecovery();
+    PubSubLiteTest::TestChannelLogRetention();
+    PubSubLiteTest::TestReplayChannelLog();
+#endif
+    PubSubLiteTest::TestHistogram();
+    PubSubLiteTest::TestChannelStatistics();
+    PubSubLiteTest::TestCoalescing(EzPubSub::FireThreadType::kDedicated);
+    PubSubLiteTest::TestCoalescing(EzPubSub::FireThreadType::kShared);
+    PubSubLiteTest::TestPriorityLane(EzPubSub::LaneScheduling::kStrict);
+    PubSubLiteTest::TestPriorityLane(EzPubSub::LaneScheduling::kWeighted);
+    PubSubLiteTest::TestSubscriberFilter();
+    PubSubLiteTest::TestConflation(EzPubSub::ConflationMode::kConflate);
+    PubSubLiteTest::TestConflation(EzPubSub::ConflationMode::kLastValueCache);
+    PubSubLiteTest::TestDataCodec();
+    PubSubLiteTest::TestChannelCompression(EzPubSub::QueueType::kList);
+    PubSubLiteTest::TestChannelCompression(EzPubSub::QueueType::kRing);
+    PubSubLiteTest::TestPublishBatch(EzPubSub::QueueType::kList);
+    PubSubLiteTest::TestPublishBatch(EzPubSub::QueueType::kRing);
+
+    if (PubSubLiteTest::gFailedCheckCount != 0)
+    {
+        printf("%u checks failed\n", PubSubLiteTest::gFailedCheckCount.load());
+        return 1;
+    }
+    printf("All checks passed\n");
+
+    return 0;
+}
@@ -0,0 +1,92 @@
+/*!
+ * \author Ezbeat, Ji Hoon Park
+ */
+
+#pragma once
+
+#include "PubSubLite.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace PubSubLiteTest
+{
+
+using TestClock = std::chrono::steady_clock;
+
+extern std::atomic<uint32_t> gFailedCheckCount;
+
+#define TEST_CHECK(condition) \
+    do \
+    { \
+        if (!(condition)) \
+        { \
+            printf("%s:%d: CHECK failed: %s\n", __FILE__, __LINE__, #condition); \
+            PubSubLiteTest::gFailedCheckCount++; \
+        } \
+    } while (false)
+
+// Every data received by ReceivingSubscriberCallback, as the string of its bytes, in fired order.
+extern std::mutex gReceivedDataListSync;
+extern std::vector<std::string> gReceivedDataList;
+extern std::vector<std::string> gSecondReceivedDataList;
+extern std::vector<uint32_t> gReceivedBatchSizeList;
+
+// Pause makes PublishData fail, so the FireThread is held in the callback of kGateData instead while a test fills the buffer.
+extern const std::string kGateData;
+
+bool PassGate(_In_ const uint8_t* data, _In_ uint32_t dataSize);
+// Returns once the FireThread of the channel holds kGateData, so the data published until OpenGate are buffered.
+bool CloseGate(_In_ const std::wstring& channelName);
+void OpenGate();
+
+void ReceivingSubscriberCallback(_In_ const uint8_t* data, _In_ uint32_t dataSize, _In_opt_ void* userContext);
+void SecondReceivingSubscriberCallback(_In_ const uint8_t* data, _In_ uint32_t dataSize, _In_opt_ void* userContext);
+// Skips kGateData without waiting, so it keeps receiving into gSecondReceivedDataList while a kShared channel holds the other subscribers at the gate.
+void UngatedSubscriberCallback(_In_ const uint8_t* data, _In_ uint32_t dataSize, _In_opt_ void* userContext);
+void ReceivingBatchSubscriberCallback(_In_ const EzPubSub::FiredData* firedDataList, _In_ uint32_t firedDataCount);
+
+void ClearReceivedDataList();
+std::vector<std::string> GetReceivedDataList(_In_opt_ bool isSecond = false);
+// Waits until expectedDataCount data are received, then a little longer so that data received beyond it are seen too.
+bool WaitReceivedDataCount(_In_ size_t expectedDataCount, _In_opt_ bool isSecond = false);
+
+EzPubSub::Error PublishString(_In_ const std::wstring& channelName, _In_ const std::string& data);
+// "<prefix><index>" padded to dataSize bytes, so every data of a test has the same size.
+std::string MakeTestData(_In_ const std::string& prefix, _In_ uint32_t index, _In_ size_t dataSize);
+std::vector<std::string> MakeTestDataList(_In_ const std::string& prefix, _In_ uint32_t firstIndex, _In_ uint32_t lastIndex, _In_ size_t dataSize);
+
+// The checks of each feature, in PubSubLite/test/<feature>Test.cpp.
+void TestSharedFireThread();
+void TestSubscriberCursor(_In_ EzPubSub::OverflowPolicy overflowPolicy);
+void TestSubscriberCursorClear();
+void TestOverflowPolicy(_In_ EzPubSub::QueueType queueType, _In_ EzPubSub::OverflowPolicy overflowPolicy);
+void TestPublishMode(_In_ EzPubSub::QueueType queueType);
+void TestChannelHandle();
+void TestChannelHandleDeleteRace();
+void TestWildcardSubscriber();
+void TestWildcardSubscriberLimit();
+void TestTypedChannel();
+#if defined(__linux__)
+void TestSharedMemoryChannel();
+void TestSharedMemoryDeadReader();
+void TestChannelLogRecovery();
+void TestChannelLogRetention();
+void TestReplayChannelLog();
+#endif
+void TestHistogram();
+void TestChannelStatistics();
+void TestCoalescing(_In_ EzPubSub::FireThreadType fireThreadType);
+void TestPriorityLane(_In_ EzPubSub::LaneScheduling laneScheduling);
+void TestSubscriberFilter();
+void TestConflation(_In_ EzPubSub::ConflationMode conflationMode);
+void TestDataCodec();
+void TestChannelCompression(_In_ EzPubSub::QueueType queueType);
+void TestPublishBatch(_In_ EzPubSub::QueueType queueType);
+
+}
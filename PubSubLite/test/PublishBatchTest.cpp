@@ -0,0 +1,64 @@
+/*!
+ * \author Ezbeat, Ji Hoon Park
+ */
+
+#include "PubSubLiteTest.h"
+
+namespace PubSubLiteTest
+{
+
+// A batch is buffered whole or not at all, and its data are fired in list order.
+void TestPublishBatch(_In_ EzPubSub::QueueType queueType)
+{
+    std::wstring channelName = L"TestPublishBatch";
+    EzPubSub::ChannelOption channelOption;
+    std::vector<std::string> dataList = MakeTestDataList("b", 0, 99, 10);
+    std::vector<EzPubSub::PublishBatchData> batchDataList(dataList.size());
+    EzPubSub::DataPoolStatistics dataPoolStatistics;
+    uint32_t receivedDataCount = 0;
+
+    ClearReceivedDataList();
+    channelOption.fireMode = EzPubSub::FireMode::kEvent;
+    channelOption.queueType = queueType;
+    channelOption.ringCapacity = 256;
+    channelOption.maxBufferedDataSize = 1500;
+    channelOption.overflowPolicy = EzPubSub::OverflowPolicy::kDropNewest;
+    TEST_CHECK(EzPubSub::PubSubLite::CreateChannel(channelName, channelOption) == EzPubSub::Error::kSuccess);
+    TEST_CHECK(EzPubSub::PubSubLite::RegisterSubscriber(channelName, ReceivingBatchSubscriberCallback) == EzPubSub::Error::kSuccess);
+
+    for (size_t index = 0; index < dataList.size(); index++)
+    {
+        batchDataList[index].data = reinterpret_cast<const uint8_t*>(dataList[index].data());
+        batchDataList[index].dataSize = static_cast<uint32_t>(dataList[index].size());
+    }
+
+    // Every data of the batch is buffered, and fired in list order.
+    TEST_CHECK(CloseGate(channelName) == true);
+    TEST_CHECK(EzPubSub::PubSubLite::PublishBatch(channelName, batchDataList.data(), 50) == EzPubSub::Error::kSuccess);
+    TEST_CHECK(EzPubSub::PubSubLite::PublishBatch(channelName, batchDataList.data() + 50, 50) == EzPubSub::Error::kSuccess);
+    TEST_CHECK(EzPubSub::PubSubLite::GetDataPoolStatistics(channelName, dataPoolStatistics) == EzPubSub::Error::kSuccess);
+    // A block for each data, and the block of kGateData.
+    TEST_CHECK(dataPoolStatistics.usedBlockCount == 101);
+    // The buffer holds 1000 bytes of the 1500, so a batch of 1000 bytes more is not buffered at all.
+    TEST_CHECK(EzPubSub::PubSubLite::PublishBatch(channelName, batchDataList.data(), 100) == EzPubSub::Error::kNotEnoughBufferSize);
+    TEST_CHECK(EzPubSub::PubSubLite::PublishBatch(channelName, batchDataList.data(), 0) == EzPubSub::Error::kUnsuccess);
+    OpenGate();
+
+    TEST_CHECK(WaitReceivedDataCount(dataList.size()) == true);
+    TEST_CHECK(GetReceivedDataList() == dataList);
+    {
+        std::lock_guard<std::mutex> receivedDataListGuard(gReceivedDataListSync);
+
+        for (auto receivedBatchSize : gReceivedBatchSizeList)
+        {
+            receivedDataCount += receivedBatchSize;
+        }
+    }
+    TEST_CHECK(receivedDataCount == dataList.size());
+    TEST_CHECK(EzPubSub::PubSubLite::GetDataPoolStatistics(channelName, dataPoolStatistics) == EzPubSub::Error::kSuccess);
+    TEST_CHECK(dataPoolStatistics.usedBlockCount == 0);
+
+    TEST_CHECK(EzPubSub::PubSubLite::DeleteChannel(channelName) == EzPubSub::Error::kSuccess);
+}
+
+}
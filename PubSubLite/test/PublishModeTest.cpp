@@ -0,0 +1,159 @@
+/*!
+ * \author Ezbeat, Ji Hoon Park
+ */
+
+#include "PubSubLiteTest.h"
+
+#include <thread>
+#include <utility>
+
+namespace PubSubLiteTest
+{
+
+namespace
+{
+
+// publishResult and the index given as completionContext of every completed PublishDataAsync, in completed order.
+std::mutex gCompletedDataListSync;
+std::vector<std::pair<EzPubSub::Error, uintptr_t>> gCompletedDataList;
+
+void CompletionCallback(_In_ EzPubSub::Error publishResult, _In_opt_ void* completionContext)
+{
+    std::lock_guard<std::mutex> completedDataListGuard(gCompletedDataListSync);
+
+    gCompletedDataList.emplace_back(publishResult, reinterpret_cast<uintptr_t>(completionContext));
+}
+
+std::vector<std::pair<EzPubSub::Error, uintptr_t>> GetCompletedDataList()
+{
+    std::lock_guard<std::mutex> completedDataListGuard(gCompletedDataListSync);
+
+    return gCompletedDataList;
+}
+
+// Holds the FireThread and fills the buffer of 100 bytes with 10 data of 10 bytes.
+bool FillBuffer(_In_ const std::wstring& channelName, _In_ const std::string& prefix)
+{
+    if (CloseGate(channelName) == false)
+    {
+        return false;
+    }
+    for (uint32_t index = 0; index < 10; index++)
+    {
+        if (PublishString(channelName, MakeTestData(prefix, index, 10)) != EzPubSub::Error::kSuccess)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+}
+
+// TryPublishData, PublishData with a deadline and PublishDataAsync to a full kDropOldest channel, which would drop data for PublishData.
+void TestPublishMode(_In_ EzPubSub::QueueType queueType)
+{
+    std::wstring channelName = L"TestPublishMode";
+    EzPubSub::ChannelOption channelOption;
+    std::string data = MakeTestData("x", 0, 10);
+    std::vector<std::string> expectedDataList;
+    std::vector<std::pair<EzPubSub::Error, uintptr_t>> expectedCompletedDataList;
+    std::atomic<bool> isPublished(false);
+    EzPubSub::Error publishResult = EzPubSub::Error::kUnsuccess;
+    uint64_t lostDataCount = 0;
+    TestClock::time_point startTime;
+
+    ClearReceivedDataList();
+    gCompletedDataList.clear();
+    channelOption.fireMode = EzPubSub::FireMode::kEvent;
+    channelOption.queueType = queueType;
+    channelOption.ringCapacity = 64;
+    channelOption.maxBufferedDataSize = 100;
+    channelOption.overflowPolicy = EzPubSub::OverflowPolicy::kDropOldest;
+    TEST_CHECK(EzPubSub::PubSubLite::CreateChannel(channelName, channelOption) == EzPubSub::Error::kSuccess);
+    TEST_CHECK(EzPubSub::PubSubLite::RegisterSubscriber(channelName, ReceivingSubscriberCallback) == EzPubSub::Error::kSuccess);
+    TEST_CHECK(FillBuffer(channelName, "d") == true);
+    expectedDataList = MakeTestDataList("d", 0, 9, 10);
+
+    // kTry
+    TEST_CHECK(EzPubSub::PubSubLite::TryPublishData(channelName, reinterpret_cast<const uint8_t*>(data.data()), static_cast<uint32_t>(data.size())) ==
+        EzPubSub::Error::kNotEnoughBufferSize);
+
+    // kWait
+    startTime = TestClock::now();
+    TEST_CHECK(EzPubSub::PubSubLite::PublishData(
+        channelName,
+        reinterpret_cast<const uint8_t*>(data.data()),
+        static_cast<uint32_t>(data.size()),
+        nullptr,
+        startTime + std::chrono::milliseconds(50)
+    ) == EzPubSub::Error::kNotEnoughBufferSize);
+    TEST_CHECK(TestClock::now() - startTime >= std::chrono::milliseconds(50));
+    TEST_CHECK(EzPubSub::PubSubLite::GetLostDataCount(channelName, lostDataCount) == EzPubSub::Error::kSuccess);
+    TEST_CHECK(lostDataCount == 0);
+
+    // kAsync, queued while the buffer is full, and buffered in published order once it is released.
+    for (uintptr_t index = 0; index < 3; index++)
+    {
+        std::string queuedData = MakeTestData("q", static_cast<uint32_t>(index), 10);
+
+        expectedDataList.push_back(queuedData);
+        expectedCompletedDataList.emplace_back(EzPubSub::Error::kSuccess, index);
+        TEST_CHECK(EzPubSub::PubSubLite::PublishDataAsync(
+            channelName,
+            reinterpret_cast<const uint8_t*>(queuedData.data()),
+            static_cast<uint32_t>(queuedData.size()),
+            nullptr,
+            CompletionCallback,
+            reinterpret_cast<void*>(index)
+        ) == EzPubSub::Error::kSuccess);
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    TEST_CHECK(GetCompletedDataList().size() == 0);
+    OpenGate();
+    TEST_CHECK(WaitReceivedDataCount(expectedDataList.size()) == true);
+    TEST_CHECK(GetReceivedDataList() == expectedDataList);
+    TEST_CHECK(GetCompletedDataList() == expectedCompletedDataList);
+
+    // kWait, buffered once the buffer is released before the deadline.
+    TEST_CHECK(FillBuffer(channelName, "e") == true);
+    std::thread waitingPublisher([&]()
+    {
+        publishResult = EzPubSub::PubSubLite::PublishData(
+            channelName,
+            reinterpret_cast<const uint8_t*>(data.data()),
+            static_cast<uint32_t>(data.size()),
+            nullptr,
+            TestClock::now() + std::chrono::seconds(5)
+        );
+        isPublished = true;
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    TEST_CHECK(isPublished == false);
+    OpenGate();
+    waitingPublisher.join();
+    TEST_CHECK(publishResult == EzPubSub::Error::kSuccess);
+    TEST_CHECK(WaitReceivedDataCount(expectedDataList.size() + 11) == true);
+    TEST_CHECK(GetReceivedDataList().back() == data);
+
+    // Queued data is given up with kBeStoppedFire when the channel is paused.
+    TEST_CHECK(FillBuffer(channelName, "f") == true);
+    TEST_CHECK(EzPubSub::PubSubLite::PublishDataAsync(
+        channelName,
+        reinterpret_cast<const uint8_t*>(data.data()),
+        static_cast<uint32_t>(data.size()),
+        nullptr,
+        CompletionCallback,
+        reinterpret_cast<void*>(3)
+    ) == EzPubSub::Error::kSuccess);
+    TEST_CHECK(EzPubSub::PubSubLite::Pause(channelName) == EzPubSub::Error::kSuccess);
+    TEST_CHECK((GetCompletedDataList().size() == 4) && (GetCompletedDataList().back() == std::make_pair(EzPubSub::Error::kBeStoppedFire, static_cast<uintptr_t>(3))));
+    TEST_CHECK(EzPubSub::PubSubLite::Resume(channelName) == EzPubSub::Error::kSuccess);
+    OpenGate();
+    TEST_CHECK(WaitReceivedDataCount(expectedDataList.size() + 21) == true);
+    TEST_CHECK(GetReceivedDataList().size() == expectedDataList.size() + 21);
+
+    TEST_CHECK(EzPubSub::PubSubLite::DeleteChannel(channelName) == EzPubSub::Error::kSuccess);
+}
+
+}
@@ -0,0 +1,80 @@
+/*!
+ * \author Ezbeat, Ji Hoon Park
+ */
+
+#include "PubSubLiteTest.h"
+
+namespace PubSubLiteTest
+{
+
+namespace
+{
+
+// Data of a prefix in receivedDataList, in received order.
+std::vector<std::string> SelectReceivedDataList(_In_ const std::vector<std::string>& receivedDataList, _In_ char prefix)
+{
+    std::vector<std::string> selectedDataList;
+
+    for (auto& receivedData : receivedDataList)
+    {
+        if (receivedData[0] == prefix)
+        {
+            selectedDataList.push_back(receivedData);
+        }
+    }
+    return selectedDataList;
+}
+
+}
+
+// kShared channels share the FireExecutor, and a subscriber held in its callback does not hold the others.
+void TestSharedFireThread()
+{
+    std::wstring channelName = L"TestSharedFireThread";
+    std::wstring secondChannelName = L"TestSharedFireThread2";
+    EzPubSub::ChannelOption channelOption;
+
+    ClearReceivedDataList();
+    channelOption.fireThreadType = EzPubSub::FireThreadType::kShared;
+    TEST_CHECK(EzPubSub::PubSubLite::SetSharedFireThreadCount(2) == EzPubSub::Error::kSuccess);
+    TEST_CHECK(EzPubSub::PubSubLite::CreateChannel(channelName, channelOption) == EzPubSub::Error::kSuccess);
+    TEST_CHECK(EzPubSub::PubSubLite::SetSharedFireThreadCount(4) == EzPubSub::Error::kExistChannel);
+    TEST_CHECK(EzPubSub::PubSubLite::RegisterSubscriber(channelName, ReceivingSubscriberCallback) == EzPubSub::Error::kSuccess);
+    TEST_CHECK(EzPubSub::PubSubLite::RegisterSubscriber(channelName, UngatedSubscriberCallback) == EzPubSub::Error::kSuccess);
+
+    // The ungated subscriber receives every data while a worker is held by the other one.
+    TEST_CHECK(CloseGate(channelName) == true);
+    for (uint32_t index = 0; index < 10; index++)
+    {
+        TEST_CHECK(PublishString(channelName, MakeTestData("a", index, 0)) == EzPubSub::Error::kSuccess);
+    }
+    TEST_CHECK(WaitReceivedDataCount(10, true) == true);
+    TEST_CHECK(GetReceivedDataList(true) == MakeTestDataList("a", 0, 9, 0));
+    TEST_CHECK(GetReceivedDataList().size() == 0);
+    OpenGate();
+    TEST_CHECK(WaitReceivedDataCount(10) == true);
+    TEST_CHECK(GetReceivedDataList() == MakeTestDataList("a", 0, 9, 0));
+
+    // Data of two channels fired by the same workers keep the published order of each channel.
+    ClearReceivedDataList();
+    TEST_CHECK(EzPubSub::PubSubLite::CreateChannel(secondChannelName, channelOption) == EzPubSub::Error::kSuccess);
+    TEST_CHECK(EzPubSub::PubSubLite::RegisterSubscriber(secondChannelName, ReceivingSubscriberCallback) == EzPubSub::Error::kSuccess);
+    for (uint32_t index = 0; index < 100; index++)
+    {
+        TEST_CHECK(PublishString(channelName, MakeTestData("a", index, 0)) == EzPubSub::Error::kSuccess);
+        TEST_CHECK(PublishString(secondChannelName, MakeTestData("b", index, 0)) == EzPubSub::Error::kSuccess);
+    }
+    TEST_CHECK(WaitReceivedDataCount(200) == true);
+    TEST_CHECK(WaitReceivedDataCount(100, true) == true);
+    TEST_CHECK(GetReceivedDataList().size() == 200);
+    TEST_CHECK(SelectReceivedDataList(GetReceivedDataList(), 'a') == MakeTestDataList("a", 0, 99, 0));
+    TEST_CHECK(SelectReceivedDataList(GetReceivedDataList(), 'b') == MakeTestDataList("b", 0, 99, 0));
+    TEST_CHECK(GetReceivedDataList(true) == MakeTestDataList("a", 0, 99, 0));
+
+    TEST_CHECK(EzPubSub::PubSubLite::DeleteChannel(channelName) == EzPubSub::Error::kSuccess);
+    TEST_CHECK(EzPubSub::PubSubLite::SetSharedFireThreadCount(4) == EzPubSub::Error::kExistChannel);
+    TEST_CHECK(EzPubSub::PubSubLite::DeleteChannel(secondChannelName) == EzPubSub::Error::kSuccess);
+    TEST_CHECK(EzPubSub::PubSubLite::SetSharedFireThreadCount(EzPubSub::kDefaultSharedFireThreadCount) == EzPubSub::Error::kSuccess);
+}
+
+}
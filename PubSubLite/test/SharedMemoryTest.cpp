@@ -0,0 +1,147 @@
+/*!
+ * \author Ezbeat, Ji Hoon Park
+ */
+
+#include "PubSubLiteTest.h"
+
+#if defined(__linux__)
+#include "ChannelName.h"
+
+#include <csignal>
+#include <filesystem>
+
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+namespace PubSubLiteTest
+{
+
+#if defined(__linux__)
+namespace
+{
+
+// The name of this run, so a segment left by a run that crashed is not attached.
+std::wstring MakeSharedMemoryChannelName(_In_ const std::wstring& testName)
+{
+    return testName + L"." + std::to_wstring(::getpid());
+}
+
+std::filesystem::path GetSegmentPath(_In_ const std::wstring& channelName)
+{
+    return std::filesystem::path("/dev/shm") / ("PubSubLite." + EzPubSub::EncodeChannelName(channelName));
+}
+
+EzPubSub::ChannelOption MakeSharedMemoryChannelOption()
+{
+    EzPubSub::ChannelOption channelOption;
+
+    channelOption.fireMode = EzPubSub::FireMode::kEvent;
+    channelOption.queueType = EzPubSub::QueueType::kSharedMemory;
+    channelOption.maxBufferedDataSize = 4096;
+    channelOption.overflowPolicy = EzPubSub::OverflowPolicy::kBlock;
+    channelOption.blockTimeout = 1000;
+    return channelOption;
+}
+
+}
+
+// Data published by one process is fired to the subscribers of every process attached to the channel.
+void TestSharedMemoryChannel()
+{
+    std::wstring channelName = MakeSharedMemoryChannelName(L"TestSharedMemory");
+    EzPubSub::ChannelOption channelOption = MakeSharedMemoryChannelOption();
+    std::vector<std::string> dataList = MakeTestDataList("s", 0, 99, 100);
+    int readyPipe[2] = { -1, -1 };
+    int receivedPipe[2] = { -1, -1 };
+    pid_t subscriberProcessId = -1;
+    uint8_t isReceived = 0;
+
+    ClearReceivedDataList();
+    TEST_CHECK((pipe(readyPipe) == 0) && (pipe(receivedPipe) == 0));
+    fflush(stdout);
+    subscriberProcessId = fork();
+    if (subscriberProcessId == 0)
+    {
+        isReceived = ((EzPubSub::PubSubLite::CreateChannel(channelName, channelOption) == EzPubSub::Error::kSuccess) &&
+            (EzPubSub::PubSubLite::RegisterSubscriber(channelName, ReceivingSubscriberCallback) == EzPubSub::Error::kSuccess)) ? 1 : 0;
+        (void)!write(readyPipe[1], &isReceived, sizeof(isReceived));
+
+        isReceived = ((WaitReceivedDataCount(dataList.size()) == true) && (GetReceivedDataList() == dataList)) ? 1 : 0;
+        (void)!write(receivedPipe[1], &isReceived, sizeof(isReceived));
+        EzPubSub::PubSubLite::DeleteChannel(channelName);
+        _exit(0);
+    }
+    TEST_CHECK(subscriberProcessId > 0);
+    TEST_CHECK((read(readyPipe[0], &isReceived, sizeof(isReceived)) == sizeof(isReceived)) && (isReceived == 1));
+
+    // Attached to the segment of the other process, whose reader holds the data of the 4096 bytes ring until it fires them.
+    TEST_CHECK(EzPubSub::PubSubLite::CreateChannel(channelName, channelOption) == EzPubSub::Error::kSuccess);
+    TEST_CHECK(EzPubSub::PubSubLite::RegisterSubscriber(channelName, ReceivingSubscriberCallback) == EzPubSub::Error::kSuccess);
+    TEST_CHECK(std::filesystem::exists(GetSegmentPath(channelName)) == true);
+    for (auto& data : dataList)
+    {
+        TEST_CHECK(PublishString(channelName, data) == EzPubSub::Error::kSuccess);
+    }
+    TEST_CHECK(WaitReceivedDataCount(dataList.size()) == true);
+    TEST_CHECK(GetReceivedDataList() == dataList);
+    TEST_CHECK((read(receivedPipe[0], &isReceived, sizeof(isReceived)) == sizeof(isReceived)) && (isReceived == 1));
+    waitpid(subscriberProcessId, nullptr, 0);
+
+    // The segment is removed by the last process detaching from it.
+    TEST_CHECK(std::filesystem::exists(GetSegmentPath(channelName)) == true);
+    TEST_CHECK(EzPubSub::PubSubLite::DeleteChannel(channelName) == EzPubSub::Error::kSuccess);
+    TEST_CHECK(std::filesystem::exists(GetSegmentPath(channelName)) == false);
+
+    close(readyPipe[0]);
+    close(readyPipe[1]);
+    close(receivedPipe[0]);
+    close(receivedPipe[1]);
+}
+
+// The reader of a process killed while attached is reclaimed by the publisher it blocks, and does not keep the segment.
+void TestSharedMemoryDeadReader()
+{
+    std::wstring channelName = MakeSharedMemoryChannelName(L"TestSharedMemoryDeadReader");
+    EzPubSub::ChannelOption channelOption = MakeSharedMemoryChannelOption();
+    std::vector<std::string> dataList = MakeTestDataList("r", 0, 99, 100);
+    int readyPipe[2] = { -1, -1 };
+    pid_t readerProcessId = -1;
+    uint8_t isReady = 0;
+
+    ClearReceivedDataList();
+    TEST_CHECK(pipe(readyPipe) == 0);
+    fflush(stdout);
+    readerProcessId = fork();
+    if (readerProcessId == 0)
+    {
+        isReady = (EzPubSub::PubSubLite::CreateChannel(channelName, channelOption) == EzPubSub::Error::kSuccess) ? 1 : 0;
+        (void)!write(readyPipe[1], &isReady, sizeof(isReady));
+        for (;;)
+        {
+            pause();
+        }
+    }
+    TEST_CHECK(readerProcessId > 0);
+    TEST_CHECK((read(readyPipe[0], &isReady, sizeof(isReady)) == sizeof(isReady)) && (isReady == 1));
+    TEST_CHECK(EzPubSub::PubSubLite::CreateChannel(channelName, channelOption) == EzPubSub::Error::kSuccess);
+    TEST_CHECK(EzPubSub::PubSubLite::RegisterSubscriber(channelName, ReceivingSubscriberCallback) == EzPubSub::Error::kSuccess);
+    kill(readerProcessId, SIGKILL);
+    waitpid(readerProcessId, nullptr, 0);
+
+    // 10000 bytes through the ring of 4096 bytes, the data the dead reader never fires would block kBlock for blockTimeout.
+    for (auto& data : dataList)
+    {
+        TEST_CHECK(PublishString(channelName, data) == EzPubSub::Error::kSuccess);
+    }
+    TEST_CHECK(WaitReceivedDataCount(dataList.size()) == true);
+    TEST_CHECK(GetReceivedDataList() == dataList);
+    TEST_CHECK(EzPubSub::PubSubLite::DeleteChannel(channelName) == EzPubSub::Error::kSuccess);
+    TEST_CHECK(std::filesystem::exists(GetSegmentPath(channelName)) == false);
+
+    close(readyPipe[0]);
+    close(readyPipe[1]);
+}
+#endif
+
+}
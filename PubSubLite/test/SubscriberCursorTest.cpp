@@ -0,0 +1,115 @@
+/*!
+ * \author Ezbeat, Ji Hoon Park
+ */
+
+#include "PubSubLiteTest.h"
+
+namespace PubSubLiteTest
+{
+
+// 15 data of 10 bytes are published to a kShared channel while one of its subscribers is held, whose maxLagDataSize holds 10 of them.
+void TestSubscriberCursor(_In_ EzPubSub::OverflowPolicy overflowPolicy)
+{
+    std::wstring channelName = L"TestSubscriberCursor";
+    EzPubSub::ChannelOption channelOption;
+    EzPubSub::SubscriberOption subscriberOption;
+    EzPubSub::SubscriberStatistics subscriberStatistics;
+    uint32_t subscriberId = 0;
+    uint32_t ungatedSubscriberId = 0;
+
+    ClearReceivedDataList();
+    // A worker for the held subscriber, and one for the other.
+    TEST_CHECK(EzPubSub::PubSubLite::SetSharedFireThreadCount(2) == EzPubSub::Error::kSuccess);
+    channelOption.fireThreadType = EzPubSub::FireThreadType::kShared;
+    subscriberOption.overflowPolicy = overflowPolicy;
+    // kGateData is in the lag until its callback returns.
+    subscriberOption.maxLagDataSize = static_cast<uint32_t>(kGateData.size()) + 100;
+    TEST_CHECK(EzPubSub::PubSubLite::CreateChannel(channelName, channelOption) == EzPubSub::Error::kSuccess);
+    TEST_CHECK(EzPubSub::PubSubLite::RegisterSubscriber(channelName, ReceivingSubscriberCallback, subscriberOption, &subscriberId) == EzPubSub::Error::kSuccess);
+    TEST_CHECK(EzPubSub::PubSubLite::RegisterSubscriber(channelName, UngatedSubscriberCallback, &ungatedSubscriberId) == EzPubSub::Error::kSuccess);
+    TEST_CHECK(CloseGate(channelName) == true);
+
+    for (uint32_t index = 0; index < 15; index++)
+    {
+        TEST_CHECK(PublishString(channelName, MakeTestData("d", index, 10)) == EzPubSub::Error::kSuccess);
+    }
+    TEST_CHECK(WaitReceivedDataCount(15, true) == true);
+    TEST_CHECK(EzPubSub::PubSubLite::GetSubscriberStatistics(channelName, subscriberId, subscriberStatistics) == EzPubSub::Error::kSuccess);
+    TEST_CHECK(subscriberStatistics.lagDataCount == 11);
+    TEST_CHECK(subscriberStatistics.lagDataSize == kGateData.size() + 100);
+    TEST_CHECK(subscriberStatistics.lostDataCount == 5);
+    TEST_CHECK(subscriberStatistics.firedDataCount == 0);
+
+    OpenGate();
+    TEST_CHECK(WaitReceivedDataCount(10) == true);
+    if (overflowPolicy == EzPubSub::OverflowPolicy::kDropOldest)
+    {
+        TEST_CHECK(GetReceivedDataList() == MakeTestDataList("d", 5, 14, 10));
+    }
+    else
+    {
+        TEST_CHECK(GetReceivedDataList() == MakeTestDataList("d", 0, 9, 10));
+    }
+    TEST_CHECK(EzPubSub::PubSubLite::GetSubscriberStatistics(channelName, subscriberId, subscriberStatistics) == EzPubSub::Error::kSuccess);
+    TEST_CHECK(subscriberStatistics.lagDataCount == 0);
+    TEST_CHECK(subscriberStatistics.lagDataSize == 0);
+    TEST_CHECK(subscriberStatistics.lostDataCount == 5);
+    TEST_CHECK(subscriberStatistics.firedDataCount == 11);
+
+    // The other subscriber lost nothing.
+    TEST_CHECK(GetReceivedDataList(true) == MakeTestDataList("d", 0, 14, 10));
+    TEST_CHECK(EzPubSub::PubSubLite::GetSubscriberStatistics(channelName, ungatedSubscriberId, subscriberStatistics) == EzPubSub::Error::kSuccess);
+    TEST_CHECK(subscriberStatistics.lostDataCount == 0);
+    TEST_CHECK(subscriberStatistics.firedDataCount == 16);
+
+    TEST_CHECK(EzPubSub::PubSubLite::DeleteChannel(channelName) == EzPubSub::Error::kSuccess);
+    TEST_CHECK(EzPubSub::PubSubLite::SetSharedFireThreadCount(EzPubSub::kDefaultSharedFireThreadCount) == EzPubSub::Error::kSuccess);
+}
+
+// Resume with clearBuffer drops the data a held subscriber did not take from the log yet, and the data it is firing is still fired.
+void TestSubscriberCursorClear()
+{
+    std::wstring channelName = L"TestSubscriberCursorClear";
+    EzPubSub::ChannelOption channelOption;
+    EzPubSub::SubscriberStatistics subscriberStatistics;
+    EzPubSub::DataPoolStatistics dataPoolStatistics;
+    uint32_t subscriberId = 0;
+
+    ClearReceivedDataList();
+    // A worker for the held subscriber, and one for the other.
+    TEST_CHECK(EzPubSub::PubSubLite::SetSharedFireThreadCount(2) == EzPubSub::Error::kSuccess);
+    channelOption.fireThreadType = EzPubSub::FireThreadType::kShared;
+    TEST_CHECK(EzPubSub::PubSubLite::CreateChannel(channelName, channelOption) == EzPubSub::Error::kSuccess);
+    TEST_CHECK(EzPubSub::PubSubLite::RegisterSubscriber(channelName, ReceivingSubscriberCallback, &subscriberId) == EzPubSub::Error::kSuccess);
+    TEST_CHECK(EzPubSub::PubSubLite::RegisterSubscriber(channelName, UngatedSubscriberCallback) == EzPubSub::Error::kSuccess);
+    TEST_CHECK(CloseGate(channelName) == true);
+
+    for (uint32_t index = 0; index < 3; index++)
+    {
+        TEST_CHECK(PublishString(channelName, MakeTestData("c", index, 0)) == EzPubSub::Error::kSuccess);
+    }
+    TEST_CHECK(WaitReceivedDataCount(3, true) == true);
+    TEST_CHECK(EzPubSub::PubSubLite::Pause(channelName) == EzPubSub::Error::kSuccess);
+    TEST_CHECK(EzPubSub::PubSubLite::Resume(channelName, true) == EzPubSub::Error::kSuccess);
+    TEST_CHECK(EzPubSub::PubSubLite::GetSubscriberStatistics(channelName, subscriberId, subscriberStatistics) == EzPubSub::Error::kSuccess);
+    TEST_CHECK(subscriberStatistics.lostDataCount == 3);
+    TEST_CHECK(subscriberStatistics.lagDataCount == 1);
+
+    OpenGate();
+    TEST_CHECK(PublishString(channelName, "after") == EzPubSub::Error::kSuccess);
+    TEST_CHECK(WaitReceivedDataCount(1) == true);
+    TEST_CHECK(GetReceivedDataList() == std::vector<std::string>({ "after" }));
+    TEST_CHECK(WaitReceivedDataCount(4, true) == true);
+    TEST_CHECK(GetReceivedDataList(true).back() == "after");
+    TEST_CHECK(EzPubSub::PubSubLite::GetSubscriberStatistics(channelName, subscriberId, subscriberStatistics) == EzPubSub::Error::kSuccess);
+    TEST_CHECK(subscriberStatistics.firedDataCount == 2);
+    TEST_CHECK(subscriberStatistics.lagDataCount == 0);
+    // The cleared data were released from the log.
+    TEST_CHECK(EzPubSub::PubSubLite::GetDataPoolStatistics(channelName, dataPoolStatistics) == EzPubSub::Error::kSuccess);
+    TEST_CHECK(dataPoolStatistics.usedBlockCount == 0);
+
+    TEST_CHECK(EzPubSub::PubSubLite::DeleteChannel(channelName) == EzPubSub::Error::kSuccess);
+    TEST_CHECK(EzPubSub::PubSubLite::SetSharedFireThreadCount(EzPubSub::kDefaultSharedFireThreadCount) == EzPubSub::Error::kSuccess);
+}
+
+}
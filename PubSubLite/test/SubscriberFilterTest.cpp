@@ -0,0 +1,64 @@
+/*!
+ * \author Ezbeat, Ji Hoon Park
+ */
+
+#include "PubSubLiteTest.h"
+
+#include <algorithm>
+
+namespace PubSubLiteTest
+{
+
+// Filters match the key of data as IsMatched and SubscriberFilterColumn do, and each subscriber receives only the data its filter matches.
+void TestSubscriberFilter()
+{
+    std::wstring channelName = L"TestSubscriberFilter";
+    EzPubSub::ChannelOption channelOption;
+    EzPubSub::SubscriberOption rangeSubscriberOption;
+    EzPubSub::SubscriberOption maskValueSubscriberOption;
+    EzPubSub::SubscriberFilter bigEndianFilter = EzPubSub::SubscriberFilter::MakeRange(1, 2, 0x0102, 0x0102, true);
+    EzPubSub::SubscriberFilterColumn subscriberFilterColumn;
+    const uint8_t keyData[3] = { 0xFF, 0x01, 0x02 };
+    const uint8_t* matchList = nullptr;
+    std::string data;
+
+    // The key is read in its byte order, and data too short for the key does not match.
+    TEST_CHECK(bigEndianFilter.IsMatched(keyData, sizeof(keyData)) == true);
+    TEST_CHECK(EzPubSub::SubscriberFilter::MakeRange(1, 2, 0x0102, 0x0102).IsMatched(keyData, sizeof(keyData)) == false);
+    TEST_CHECK(bigEndianFilter.IsMatched(keyData, 2) == false);
+    TEST_CHECK(EzPubSub::SubscriberFilter().IsMatched(nullptr, 0) == true);
+    TEST_CHECK(EzPubSub::SubscriberFilter::MakeRange(0, 1, 5, 4).IsValid() == false);
+    TEST_CHECK(EzPubSub::SubscriberFilter::MakeMaskValue(0, 9, 1, 1).IsValid() == false);
+
+    // The column evaluates each filter as IsMatched does.
+    for (uint8_t key = 0; key < 10; key++)
+    {
+        subscriberFilterColumn.Append(&keyData[0] + ((key == 9) ? 3 : 0), (key == 9) ? 0 : 1);
+    }
+    matchList = subscriberFilterColumn.Evaluate(EzPubSub::SubscriberFilter::MakeMaskValue(0, 1, 0x0F, 0x0F));
+    TEST_CHECK(std::count(matchList, matchList + subscriberFilterColumn.GetDataCount(), 1) == 9);
+
+    ClearReceivedDataList();
+    channelOption.fireMode = EzPubSub::FireMode::kEvent;
+    rangeSubscriberOption.subscriberFilter = EzPubSub::SubscriberFilter::MakeRange(0, 1, 3, 5);
+    maskValueSubscriberOption.subscriberFilter = EzPubSub::SubscriberFilter::MakeMaskValue(0, 1, 0x01, 0x01);
+    TEST_CHECK(EzPubSub::PubSubLite::CreateChannel(channelName, channelOption) == EzPubSub::Error::kSuccess);
+    TEST_CHECK(EzPubSub::PubSubLite::RegisterSubscriber(channelName, ReceivingSubscriberCallback, rangeSubscriberOption) == EzPubSub::Error::kSuccess);
+    TEST_CHECK(EzPubSub::PubSubLite::RegisterSubscriber(channelName, SecondReceivingSubscriberCallback, maskValueSubscriberOption) == EzPubSub::Error::kSuccess);
+
+    for (char key = 0; key < 10; key++)
+    {
+        data.assign(1, key);
+        data.push_back('k');
+        TEST_CHECK(PublishString(channelName, data) == EzPubSub::Error::kSuccess);
+    }
+    TEST_CHECK(WaitReceivedDataCount(3) == true);
+    TEST_CHECK(WaitReceivedDataCount(5, true) == true);
+    TEST_CHECK(GetReceivedDataList() == std::vector<std::string>({ std::string("\x03k", 2), std::string("\x04k", 2), std::string("\x05k", 2) }));
+    TEST_CHECK(GetReceivedDataList(true) ==
+        std::vector<std::string>({ std::string("\x01k", 2), std::string("\x03k", 2), std::string("\x05k", 2), std::string("\x07k", 2), std::string("\x09k", 2) }));
+
+    TEST_CHECK(EzPubSub::PubSubLite::DeleteChannel(channelName) == EzPubSub::Error::kSuccess);
+}
+
+}
@@ -0,0 +1,152 @@
+/*!
+ * \author Ezbeat, Ji Hoon Park
+ */
+
+#include "PubSubLiteTest.h"
+#include "TypedChannel.h"
+
+#include <functional>
+#include <thread>
+
+namespace PubSubLiteTest
+{
+
+namespace
+{
+
+struct Quote
+{
+    uint32_t symbolId;
+    double price;
+};
+
+// Values received by a Subscriber, each list under its own lock.
+struct ReceivedQuoteList
+{
+    ReceivedQuoteList()
+    {
+        priceSum = 0;
+    }
+
+    std::vector<uint32_t> GetSymbolIdList()
+    {
+        std::lock_guard<std::mutex> quoteListGuard(quoteListSync);
+
+        return symbolIdList;
+    }
+
+    void Append(_In_ const Quote& quote)
+    {
+        std::lock_guard<std::mutex> quoteListGuard(quoteListSync);
+
+        symbolIdList.push_back(quote.symbolId);
+        priceSum += quote.price;
+    }
+
+    std::mutex quoteListSync;
+    std::vector<uint32_t> symbolIdList;
+    double priceSum;
+};
+
+// A functor Subscriber, called directly by the TypedChannel.
+struct SumSubscriber
+{
+    void operator()(_In_ const uint64_t& value)
+    {
+        *valueSum += value;
+    }
+
+    std::atomic<uint64_t>* valueSum;
+};
+
+bool WaitCondition(_In_ const std::function<bool()>& condition)
+{
+    TestClock::time_point deadline = TestClock::now() + std::chrono::seconds(5);
+
+    while (condition() == false)
+    {
+        if (TestClock::now() > deadline)
+        {
+            return false;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+
+    return true;
+}
+
+}
+
+// Values published to a TypedChannel reach its Subscribers as they were published.
+void TestTypedChannel()
+{
+    std::wstring channelName = L"TestTypedChannel";
+    EzPubSub::ChannelOption channelOption;
+    EzPubSub::TypedChannel<Quote> typedChannel;
+    EzPubSub::TypedChannel<Quote> sharedMemoryTypedChannel;
+    EzPubSub::TypedChannel<uint64_t, SumSubscriber> sumTypedChannel;
+    ReceivedQuoteList firstQuoteList;
+    ReceivedQuoteList secondQuoteList;
+    ReceivedQuoteList nestedQuoteList;
+    std::atomic<bool> isNestedSubscribed(false);
+    std::atomic<uint64_t> valueSum(0);
+    uint32_t secondSubscriberId = 0;
+
+    channelOption.fireMode = EzPubSub::FireMode::kEvent;
+    TEST_CHECK(typedChannel.Create(channelName, channelOption) == EzPubSub::Error::kSuccess);
+    TEST_CHECK(typedChannel.Create(channelName, channelOption) == EzPubSub::Error::kExistChannel);
+    channelOption.queueType = EzPubSub::QueueType::kSharedMemory;
+    TEST_CHECK(sharedMemoryTypedChannel.Create(L"TestTypedChannelSharedMemory", channelOption) == EzPubSub::Error::kUnsuccess);
+    channelOption.queueType = EzPubSub::QueueType::kList;
+
+    TEST_CHECK(typedChannel.Subscribe([&](const Quote& quote) { firstQuoteList.Append(quote); }) == EzPubSub::Error::kSuccess);
+    TEST_CHECK(typedChannel.Subscribe([&](const Quote& quote) { secondQuoteList.Append(quote); }, &secondSubscriberId) == EzPubSub::Error::kSuccess);
+    for (uint32_t symbolId = 0; symbolId < 3; symbolId++)
+    {
+        TEST_CHECK(typedChannel.Publish(Quote({ symbolId, 0.5 * symbolId })) == EzPubSub::Error::kSuccess);
+    }
+    TEST_CHECK(WaitCondition([&]() { return (firstQuoteList.GetSymbolIdList().size() >= 3) && (secondQuoteList.GetSymbolIdList().size() >= 3); }) == true);
+    TEST_CHECK(firstQuoteList.GetSymbolIdList() == std::vector<uint32_t>({ 0, 1, 2 }));
+    TEST_CHECK(secondQuoteList.GetSymbolIdList() == std::vector<uint32_t>({ 0, 1, 2 }));
+    TEST_CHECK(firstQuoteList.priceSum == 1.5);
+
+    // An unsubscribed Subscriber is not called, and a Subscriber may subscribe another one.
+    TEST_CHECK(typedChannel.Unsubscribe(secondSubscriberId) == EzPubSub::Error::kSuccess);
+    TEST_CHECK(typedChannel.Unsubscribe(secondSubscriberId) == EzPubSub::Error::kNotExistSubscriber);
+    TEST_CHECK(typedChannel.Subscribe([&](const Quote& quote)
+    {
+        (void)quote;
+
+        if (isNestedSubscribed.exchange(true) == false)
+        {
+            typedChannel.Subscribe([&](const Quote& nestedQuote) { nestedQuoteList.Append(nestedQuote); });
+        }
+    }) == EzPubSub::Error::kSuccess);
+    TEST_CHECK(typedChannel.Publish(Quote({ 3, 0 })) == EzPubSub::Error::kSuccess);
+    TEST_CHECK(WaitCondition([&]() { return isNestedSubscribed == true; }) == true);
+    TEST_CHECK(typedChannel.Publish(Quote({ 4, 0 })) == EzPubSub::Error::kSuccess);
+    TEST_CHECK(WaitCondition([&]() { return nestedQuoteList.GetSymbolIdList().size() >= 1; }) == true);
+    TEST_CHECK(firstQuoteList.GetSymbolIdList() == std::vector<uint32_t>({ 0, 1, 2, 3, 4 }));
+    TEST_CHECK(secondQuoteList.GetSymbolIdList() == std::vector<uint32_t>({ 0, 1, 2 }));
+    TEST_CHECK(nestedQuoteList.GetSymbolIdList() == std::vector<uint32_t>({ 4 }));
+
+    // Delete does not delete the channel created again with its name after it was deleted elsewhere.
+    TEST_CHECK(EzPubSub::PubSubLite::DeleteChannel(channelName) == EzPubSub::Error::kSuccess);
+    TEST_CHECK(EzPubSub::PubSubLite::CreateChannel(channelName, channelOption) == EzPubSub::Error::kSuccess);
+    TEST_CHECK(typedChannel.Delete() == EzPubSub::Error::kNotExistChannel);
+    TEST_CHECK(PublishString(channelName, "after") == EzPubSub::Error::kSuccess);
+    TEST_CHECK(EzPubSub::PubSubLite::DeleteChannel(channelName) == EzPubSub::Error::kSuccess);
+    TEST_CHECK(typedChannel.Publish(Quote({ 5, 0 })) == EzPubSub::Error::kUnsuccess);
+
+    TEST_CHECK(sumTypedChannel.Create(L"TestTypedChannelSum", channelOption) == EzPubSub::Error::kSuccess);
+    TEST_CHECK(sumTypedChannel.Subscribe(SumSubscriber({ &valueSum })) == EzPubSub::Error::kSuccess);
+    for (uint64_t value = 1; value <= 100; value++)
+    {
+        TEST_CHECK(sumTypedChannel.Publish(value) == EzPubSub::Error::kSuccess);
+    }
+    TEST_CHECK(WaitCondition([&]() { return valueSum == 5050; }) == true);
+    TEST_CHECK(sumTypedChannel.Delete() == EzPubSub::Error::kSuccess);
+}
+
+}
@@ -0,0 +1,102 @@
+/*!
+ * \author Ezbeat, Ji Hoon Park
+ */
+
+#include "PubSubLiteTest.h"
+
+#include <algorithm>
+
+namespace PubSubLiteTest
+{
+
+// Wildcard subscribers are registered to the matching channels, created before or after them, until they are unregistered.
+void TestWildcardSubscriber()
+{
+    std::wstring priceFilter = L"TestWildcard/*/price";
+    std::wstring allFilter = L"TestWildcard/#";
+    std::vector<std::wstring> channelNameList = { L"TestWildcard/MSFT/price", L"TestWildcard/AAPL/price", L"TestWildcard/AAPL/volume", L"TestWildcard/AAPL/price/bid" };
+    EzPubSub::ChannelOption channelOption;
+    std::vector<std::string> receivedDataList;
+
+    ClearReceivedDataList();
+    channelOption.fireMode = EzPubSub::FireMode::kEvent;
+    TEST_CHECK(EzPubSub::PubSubLite::CreateChannel(channelNameList[0], channelOption) == EzPubSub::Error::kSuccess);
+    TEST_CHECK(EzPubSub::PubSubLite::RegisterWildcardSubscriber(priceFilter, ReceivingSubscriberCallback) == EzPubSub::Error::kSuccess);
+    TEST_CHECK(EzPubSub::PubSubLite::RegisterWildcardSubscriber(priceFilter, ReceivingSubscriberCallback) == EzPubSub::Error::kExistSubscriber);
+    TEST_CHECK(EzPubSub::PubSubLite::RegisterWildcardSubscriber(allFilter, SecondReceivingSubscriberCallback) == EzPubSub::Error::kSuccess);
+    TEST_CHECK(EzPubSub::PubSubLite::RegisterWildcardSubscriber(L"TestWildcard/#/price", ReceivingSubscriberCallback) == EzPubSub::Error::kUnsuccess);
+    for (size_t index = 1; index < channelNameList.size(); index++)
+    {
+        TEST_CHECK(EzPubSub::PubSubLite::CreateChannel(channelNameList[index], channelOption) == EzPubSub::Error::kSuccess);
+    }
+
+    for (size_t index = 0; index < channelNameList.size(); index++)
+    {
+        TEST_CHECK(PublishString(channelNameList[index], MakeTestData("w", static_cast<uint32_t>(index), 0)) == EzPubSub::Error::kSuccess);
+    }
+    TEST_CHECK(WaitReceivedDataCount(2) == true);
+    TEST_CHECK(WaitReceivedDataCount(4, true) == true);
+    receivedDataList = GetReceivedDataList();
+    std::sort(receivedDataList.begin(), receivedDataList.end());
+    TEST_CHECK(receivedDataList == MakeTestDataList("w", 0, 1, 0));
+    receivedDataList = GetReceivedDataList(true);
+    std::sort(receivedDataList.begin(), receivedDataList.end());
+    TEST_CHECK(receivedDataList == MakeTestDataList("w", 0, 3, 0));
+
+    // Unregistered from the channels, and not registered to the channels created after it.
+    ClearReceivedDataList();
+    TEST_CHECK(EzPubSub::PubSubLite::UnregisterWildcardSubscriber(priceFilter, ReceivingSubscriberCallback) == EzPubSub::Error::kSuccess);
+    TEST_CHECK(EzPubSub::PubSubLite::UnregisterWildcardSubscriber(priceFilter, ReceivingSubscriberCallback) == EzPubSub::Error::kNotExistSubscriber);
+    channelNameList.push_back(L"TestWildcard/IBM/price");
+    TEST_CHECK(EzPubSub::PubSubLite::CreateChannel(channelNameList.back(), channelOption) == EzPubSub::Error::kSuccess);
+    TEST_CHECK(PublishString(channelNameList[0], "after0") == EzPubSub::Error::kSuccess);
+    TEST_CHECK(PublishString(channelNameList.back(), "after1") == EzPubSub::Error::kSuccess);
+    TEST_CHECK(WaitReceivedDataCount(2, true) == true);
+    TEST_CHECK(GetReceivedDataList().size() == 0);
+
+    TEST_CHECK(EzPubSub::PubSubLite::UnregisterWildcardSubscriber(allFilter, SecondReceivingSubscriberCallback) == EzPubSub::Error::kSuccess);
+    for (auto& channelName : channelNameList)
+    {
+        TEST_CHECK(EzPubSub::PubSubLite::DeleteChannel(channelName) == EzPubSub::Error::kSuccess);
+    }
+}
+
+// A channel matched by more wildcard subscribers than kMaxSubscriberCount is not created.
+void TestWildcardSubscriberLimit()
+{
+    std::wstring channelName = L"TestWildcardLimit/1/2/3/4/5/6";
+    std::vector<std::wstring> topicFilterList;
+    EzPubSub::ChannelOption channelOption;
+    EzPubSub::ChannelHandle channelHandle;
+
+    // Each of the 7 levels of the name, or '*' for it.
+    for (uint32_t wildcardMask = 0; wildcardMask < EzPubSub::kMaxSubscriberCount; wildcardMask++)
+    {
+        std::wstring topicFilter = ((wildcardMask & 1) != 0) ? L"*" : L"TestWildcardLimit";
+
+        for (uint32_t level = 1; level < 7; level++)
+        {
+            topicFilter += ((wildcardMask & (1u << level)) != 0) ? L"/*" : (L"/" + std::to_wstring(level));
+        }
+        topicFilterList.push_back(topicFilter);
+        TEST_CHECK(EzPubSub::PubSubLite::RegisterWildcardSubscriber(topicFilter, ReceivingSubscriberCallback) == EzPubSub::Error::kSuccess);
+    }
+    topicFilterList.push_back(L"TestWildcardLimit/#");
+    TEST_CHECK(EzPubSub::PubSubLite::RegisterWildcardSubscriber(topicFilterList.back(), ReceivingSubscriberCallback) == EzPubSub::Error::kSuccess);
+
+    TEST_CHECK(EzPubSub::PubSubLite::CreateChannel(channelName, channelOption) == EzPubSub::Error::kExceedSubscriberCount);
+    TEST_CHECK(EzPubSub::PubSubLite::OpenChannel(channelName, channelHandle) == EzPubSub::Error::kNotExistChannel);
+
+    // Created once they fit.
+    TEST_CHECK(EzPubSub::PubSubLite::UnregisterWildcardSubscriber(topicFilterList.back(), ReceivingSubscriberCallback) == EzPubSub::Error::kSuccess);
+    topicFilterList.pop_back();
+    TEST_CHECK(EzPubSub::PubSubLite::CreateChannel(channelName, channelOption) == EzPubSub::Error::kSuccess);
+    TEST_CHECK(EzPubSub::PubSubLite::DeleteChannel(channelName) == EzPubSub::Error::kSuccess);
+
+    for (auto& topicFilter : topicFilterList)
+    {
+        TEST_CHECK(EzPubSub::PubSubLite::UnregisterWildcardSubscriber(topicFilter, ReceivingSubscriberCallback) == EzPubSub::Error::kSuccess);
+    }
+}
+
+}